@@ -58,6 +58,8 @@ uint8_t sgp30_advance_init(void)
     DRIVER_SGP30_LINK_IIC_READ_COMMAND(&gs_handle, sgp30_interface_iic_read_cmd);
     DRIVER_SGP30_LINK_DELAY_MS(&gs_handle, sgp30_interface_delay_ms);
     DRIVER_SGP30_LINK_DEBUG_PRINT(&gs_handle, sgp30_interface_debug_print);
+    DRIVER_SGP30_LINK_LOCK(&gs_handle, sgp30_interface_lock);
+    DRIVER_SGP30_LINK_UNLOCK(&gs_handle, sgp30_interface_unlock);
     
     /* sgp30 init */
     res = sgp30_init(&gs_handle);
@@ -135,6 +137,28 @@ uint8_t sgp30_advance_read(uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb)
     }
 }
 
+/**
+ * @brief      advance example read the raw signals
+ * @param[out] *h2_raw pointer to a h2 raw buffer
+ * @param[out] *ethanol_raw pointer to an ethanol raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sgp30_advance_read_raw(uint16_t *h2_raw, uint16_t *ethanol_raw)
+{
+    /* read raw */
+    if (sgp30_get_measure_raw(&gs_handle, h2_raw, ethanol_raw) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief      advance example get the serial id
  * @param[out] *id pointer to a serial id buffer
@@ -252,3 +276,31 @@ uint8_t sgp30_advance_set_absolute_humidity(float temp, float rh)
     
     return 0;
 }
+
+/**
+ * @brief      advance example recover the chip
+ * @param[in]  tvoc_baseline restored tvoc baseline
+ * @param[in]  co2_eq_baseline restored co2 eq baseline
+ * @param[in]  *power_set pointer to a power_set function of the board, NULL skips the power cycle
+ * @param[out] *level pointer to a recovery level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 recover failed
+ * @note       the chip is retried, soft reset and power cycled in order
+ */
+uint8_t sgp30_advance_recover(uint16_t tvoc_baseline, uint16_t co2_eq_baseline,
+                              uint8_t (*power_set)(uint8_t enable), sgp30_recovery_level_t *level)
+{
+    /* only a board with a power enable can power cycle the chip */
+    DRIVER_SGP30_LINK_POWER_SET(&gs_handle, power_set);
+    
+    /* recover */
+    if (sgp30_recover(&gs_handle, tvoc_baseline, co2_eq_baseline, level) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
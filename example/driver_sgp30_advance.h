@@ -78,6 +78,17 @@ uint8_t sgp30_advance_deinit(void);
  */
 uint8_t sgp30_advance_read(uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb);
 
+/**
+ * @brief      advance example read the raw signals
+ * @param[out] *h2_raw pointer to a h2 raw buffer
+ * @param[out] *ethanol_raw pointer to an ethanol raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sgp30_advance_read_raw(uint16_t *h2_raw, uint16_t *ethanol_raw);
+
 /**
  * @brief      advance example get the serial id
  * @param[out] *id pointer to a serial id buffer
@@ -132,6 +143,20 @@ uint8_t sgp30_advance_get_iaq_baseline(uint16_t *tvoc, uint16_t *co2_eq);
  */
 uint8_t sgp30_advance_set_absolute_humidity(float temp, float rh);
 
+/**
+ * @brief      advance example recover the chip
+ * @param[in]  tvoc_baseline restored tvoc baseline
+ * @param[in]  co2_eq_baseline restored co2 eq baseline
+ * @param[in]  *power_set pointer to a power_set function of the board, NULL skips the power cycle
+ * @param[out] *level pointer to a recovery level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 recover failed
+ * @note       the chip is retried, soft reset and power cycled in order
+ */
+uint8_t sgp30_advance_recover(uint16_t tvoc_baseline, uint16_t co2_eq_baseline,
+                              uint8_t (*power_set)(uint8_t enable), sgp30_recovery_level_t *level);
+
 /**
  * @}
  */
@@ -58,6 +58,8 @@ uint8_t sgp30_basic_init(void)
     DRIVER_SGP30_LINK_IIC_READ_COMMAND(&gs_handle, sgp30_interface_iic_read_cmd);
     DRIVER_SGP30_LINK_DELAY_MS(&gs_handle, sgp30_interface_delay_ms);
     DRIVER_SGP30_LINK_DEBUG_PRINT(&gs_handle, sgp30_interface_debug_print);
+    DRIVER_SGP30_LINK_LOCK(&gs_handle, sgp30_interface_lock);
+    DRIVER_SGP30_LINK_UNLOCK(&gs_handle, sgp30_interface_unlock);
     
     /* sgp30 init */
     res = sgp30_init(&gs_handle);
@@ -110,3 +110,34 @@ void sgp30_interface_debug_print(const char *const fmt, ...)
 {
     
 }
+
+/**
+ * @brief     interface set the power
+ * @param[in] enable power enable
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      drive the power enable gpio of the chip, it is used to power cycle a latched chip
+ */
+uint8_t sgp30_interface_power_set(uint8_t enable)
+{
+    return 0;
+}
+
+/**
+ * @brief interface lock the bus
+ * @note  it serializes the transactions of every device sharing the bus
+ */
+void sgp30_interface_lock(void)
+{
+    
+}
+
+/**
+ * @brief interface unlock the bus
+ * @note  none
+ */
+void sgp30_interface_unlock(void)
+{
+    
+}
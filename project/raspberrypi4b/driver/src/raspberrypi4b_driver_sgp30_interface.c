@@ -37,6 +37,8 @@
 
 #include "driver_sgp30_interface.h"
 #include "iic.h"
+#include "replay.h"
+#include "power.h"
 #include <stdarg.h>
 
 /**
@@ -44,11 +46,40 @@
  */
 #define IIC_DEVICE_NAME "/dev/i2c-1"        /**< iic device name */
 
+/**
+ * @brief iic bus recovery definition
+ */
+#define IIC_RECOVERY_GPIO_CHIP    "gpiochip0"        /**< gpio chip */
+#define IIC_RECOVERY_SCL          3                  /**< scl is GPIO3 */
+#define IIC_RECOVERY_SDA          2                  /**< sda is GPIO2 */
+#define IIC_RECOVERY_THRESHOLD    3                  /**< consecutive failures before recovery */
+
+/**
+ * @brief iic bus lock definition
+ */
+#ifndef IIC_LOCK_ENABLE
+    #define IIC_LOCK_ENABLE       0                  /**< 1 shares the bus with other processes by /run/lock/i2c-1.lock */
+#endif
+
 /**
  * @brief iic device handle definition
  */
 static int gs_fd;                           /**< iic handle */
 
+/**
+ * @brief  interface get the bound trace player
+ * @return pointer to the replay structure, NULL if the bus is real
+ * @note   a bound recorder leaves the bus real and captures it
+ */
+static replay_t *a_replay_play(void)
+{
+    replay_t *replay;
+    
+    replay = replay_get_bound();
+    
+    return ((replay != NULL) && (replay->mode == REPLAY_MODE_PLAY)) ? replay : NULL;
+}
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -58,7 +89,30 @@ static int gs_fd;                           /**< iic handle */
  */
 uint8_t sgp30_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_fd);
+    /* a bound trace serves the bus */
+    if (a_replay_play() != NULL)
+    {
+        return 0;
+    }
+    
+    if (iic_init(IIC_DEVICE_NAME, &gs_fd) != 0)
+    {
+        return 1;
+    }
+    
+    /* recover the bus when sda is stuck */
+    (void)iic_set_recovery(gs_fd, IIC_RECOVERY_GPIO_CHIP, IIC_RECOVERY_SCL, IIC_RECOVERY_SDA, IIC_RECOVERY_THRESHOLD);
+    
+    /* serialize with other processes, the threads of this process are serialized anyway */
+    if (IIC_LOCK_ENABLE != 0)
+    {
+        if (iic_set_lock(gs_fd, NULL) != 0)
+        {
+            sgp30_interface_debug_print("sgp30: cross-process bus lock is disabled.\n");
+        }
+    }
+    
+    return 0;
 }
 
 /**
@@ -70,6 +124,11 @@ uint8_t sgp30_interface_iic_init(void)
  */
 uint8_t sgp30_interface_iic_deinit(void)
 {
+    if (a_replay_play() != NULL)
+    {
+        return 0;
+    }
+    
     return iic_deinit(gs_fd);
 }
 
@@ -85,7 +144,21 @@ uint8_t sgp30_interface_iic_deinit(void)
  */
 uint8_t sgp30_interface_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
 {
-    return iic_write_cmd(gs_fd, addr, buf, len);
+    replay_t *replay;
+    uint8_t res;
+    
+    replay = replay_get_bound();
+    if ((replay != NULL) && (replay->mode == REPLAY_MODE_PLAY))
+    {
+        return replay_write_cmd(replay, addr, buf, len);
+    }
+    res = iic_write_cmd(gs_fd, addr, buf, len);
+    if (replay != NULL)
+    {
+        (void)replay_capture(replay, REPLAY_RECORD_WRITE, addr, buf, len, res);
+    }
+    
+    return res;
 }
 
 /**
@@ -100,7 +173,21 @@ uint8_t sgp30_interface_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
  */
 uint8_t sgp30_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
 {
-    return iic_read_cmd(gs_fd, addr, buf, len);
+    replay_t *replay;
+    uint8_t res;
+    
+    replay = replay_get_bound();
+    if ((replay != NULL) && (replay->mode == REPLAY_MODE_PLAY))
+    {
+        return replay_read_cmd(replay, addr, buf, len);
+    }
+    res = iic_read_cmd(gs_fd, addr, buf, len);
+    if (replay != NULL)
+    {
+        (void)replay_capture(replay, REPLAY_RECORD_READ, addr, buf, len, res);
+    }
+    
+    return res;
 }
 
 /**
@@ -110,6 +197,17 @@ uint8_t sgp30_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
  */
 void sgp30_interface_delay_ms(uint32_t ms)
 {
+    replay_t *replay;
+    
+    /* a bound trace runs on virtual time */
+    replay = a_replay_play();
+    if (replay != NULL)
+    {
+        replay_delay_ms(replay, ms);
+        
+        return;
+    }
+    
     usleep(1000 * ms);
 }
 
@@ -130,3 +228,50 @@ void sgp30_interface_debug_print(const char *const fmt, ...)
     
     (void)printf((uint8_t *)str);
 }
+
+/**
+ * @brief     interface set the power
+ * @param[in] enable power enable
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the line is set by power_init, link it to the handle only when the board has a power enable
+ */
+uint8_t sgp30_interface_power_set(uint8_t enable)
+{
+    /* the trace has no power line */
+    if (a_replay_play() != NULL)
+    {
+        return 0;
+    }
+    
+    return power_set(enable);
+}
+
+/**
+ * @brief interface lock the bus
+ * @note  the iic lock serializes the threads of the process and the processes sharing the lock file
+ */
+void sgp30_interface_lock(void)
+{
+    if (a_replay_play() != NULL)
+    {
+        return;
+    }
+    
+    (void)iic_lock(gs_fd);
+}
+
+/**
+ * @brief interface unlock the bus
+ * @note  none
+ */
+void sgp30_interface_unlock(void)
+{
+    if (a_replay_play() != NULL)
+    {
+        return;
+    }
+    
+    (void)iic_unlock(gs_fd);
+}
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      archive.h
+ * @brief     archive header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include "series.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup archive archive function
+ * @brief    archive function modules
+ * @{
+ */
+
+/**
+ * @brief archive chunk state enumeration definition
+ */
+typedef enum
+{
+    ARCHIVE_CHUNK_UNCHECKED = 0,        /**< crc not checked yet */
+    ARCHIVE_CHUNK_VALID     = 1,        /**< crc is right */
+    ARCHIVE_CHUNK_CORRUPTED = 2,        /**< crc or payload is wrong */
+} archive_chunk_state_t;
+
+/**
+ * @brief archive index entry structure definition
+ */
+typedef struct archive_index_s
+{
+    uint64_t offset;                /**< chunk header offset in the file */
+    series_chunk_t chunk;           /**< parsed chunk header with the summary */
+    uint8_t state;                  /**< archive chunk state */
+} archive_index_t;
+
+/**
+ * @brief archive structure definition
+ */
+typedef struct archive_s
+{
+    int fd;                             /**< file descriptor */
+    const uint8_t *map;                 /**< mapped file */
+    size_t size;                        /**< mapped bytes */
+    archive_index_t *index;             /**< one entry per chunk */
+    uint32_t chunks;                    /**< indexed chunks */
+    uint8_t sorted;                     /**< chunks do not overlap in time */
+    uint64_t samples;                   /**< indexed samples */
+    uint64_t first_ts;                  /**< first timestamp */
+    uint64_t last_ts;                   /**< last timestamp */
+    uint64_t tail_bytes;                /**< damaged bytes outside the indexed chunks */
+    series_sample_t *sample;            /**< decode buffer */
+    int32_t decoded;                    /**< index of the chunk in the decode buffer, -1 means none */
+} archive_t;
+
+/**
+ * @brief archive aggregate structure definition
+ */
+typedef struct archive_aggregate_s
+{
+    uint64_t count;                         /**< samples in the range */
+    uint16_t min[SERIES_CHANNEL];           /**< min values */
+    uint16_t max[SERIES_CHANNEL];           /**< max values */
+    uint64_t sum[SERIES_CHANNEL];           /**< sum of the values */
+    double avg[SERIES_CHANNEL];             /**< average values */
+    uint32_t summary_chunks;                /**< chunks answered by the summary */
+    uint32_t decoded_chunks;                /**< chunks decoded */
+    uint32_t corrupted_chunks;              /**< chunks skipped */
+} archive_aggregate_t;
+
+/**
+ * @brief archive sample callback definition
+ */
+typedef uint8_t (*archive_callback_t)(const series_sample_t *sample, uint32_t count, void *arg);
+
+/**
+ * @brief     archive open
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] *path pointer to a series file path
+ * @param[in] verify 1 checks the crc of every chunk now, 0 checks a chunk when it is decoded
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the file is mapped and only the chunk headers are read to build the index,
+ *            a broken header is skipped up to the next SERIES_CHUNK_MAGIC, and a chunk that is not
+ *            followed by a valid header gets its crc checked so a torn one does not hide the next
+ */
+uint8_t archive_open(archive_t *archive, const char *path, uint8_t verify);
+
+/**
+ * @brief     archive query the samples in a time range
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] start_ms first timestamp in the range
+ * @param[in] end_ms timestamp after the range
+ * @param[in] callback called with runs of samples in time order
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 query failed
+ *            - 2 stopped by the callback
+ * @note      only the chunks that overlap the range are decoded, corrupted chunks are skipped,
+ *            a non zero return of the callback stops the query
+ */
+uint8_t archive_query(archive_t *archive, uint64_t start_ms, uint64_t end_ms, archive_callback_t callback, void *arg);
+
+/**
+ * @brief      archive aggregate a time range
+ * @param[in]  *archive pointer to an archive structure
+ * @param[in]  start_ms first timestamp in the range
+ * @param[in]  end_ms timestamp after the range
+ * @param[out] *aggregate pointer to an archive aggregate structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 aggregate failed
+ * @note       a chunk inside the range is answered by its summary, only the chunks cut by
+ *             the range edges are decoded, min and max are 0 if the range is empty,
+ *             the crc of a chunk is checked before its summary is used and the result is kept,
+ *             so the first call reads the payloads at crc speed and later calls read only the index
+ */
+uint8_t archive_aggregate(archive_t *archive, uint64_t start_ms, uint64_t end_ms, archive_aggregate_t *aggregate);
+
+/**
+ * @brief     archive close
+ * @param[in] *archive pointer to an archive structure
+ * @note      none
+ */
+void archive_close(archive_t *archive);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
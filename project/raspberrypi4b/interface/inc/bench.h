@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.h
+ * @brief     bench header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup bench bench function
+ * @brief    bench function modules
+ * @{
+ */
+
+/**
+ * @brief      bench the batched iic transfer against one ioctl per message
+ * @param[in]  *name pointer to an iic device name buffer
+ * @param[in]  addr iic device write address
+ * @param[in]  mux_addr iic mux write address, 0 means no mux
+ * @param[in]  channel mux channel number
+ * @param[in]  rounds polling rounds
+ * @return     status code
+ *             - 0 success
+ *             - 1 bench failed
+ * @note       one round starts a measurement on every channel, waits 12 ms and reads every channel,
+ *             ioctls and bus time per round are printed for both modes
+ */
+uint8_t bench_iic_batch(char *name, uint8_t addr, uint8_t mux_addr, uint8_t channel, uint32_t rounds);
+
+/**
+ * @brief     bench the bus lock contention of one shared handle
+ * @param[in] *name pointer to an iic device name buffer
+ * @param[in] peer_addr iic write address of a peer device on the bus, 0 simulates its transfer
+ * @param[in] rounds measure rounds of every worker
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      two workers share one handle and alternate measure iaq and get iaq baseline while
+ *            the peer device polls the bus, it runs with the bus released during the wait first
+ *            and with the bus held as the baseline, and prints the errors, the throughput and
+ *            the lock wait of the peer device
+ */
+uint8_t bench_lock_contention(char *name, uint8_t peer_addr, uint32_t rounds);
+
+/**
+ * @brief     bench the series file format
+ * @param[in] *path pointer to a scratch file path
+ * @param[in] days days of 1 Hz samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      a random walk of the four channels is written, read back and compared,
+ *            bytes per sample and channel, the encode rate and the decode rate are printed,
+ *            then the archive range queries are timed and checked against a scan,
+ *            the file is kept for the raw codec bench
+ */
+uint8_t bench_series(const char *path, uint32_t days);
+
+/**
+ * @brief     bench the raw signal codec on a captured trace
+ * @param[in] *path pointer to a series file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      h2 raw and ethanol raw of the file are encoded, decoded by the scalar and the simd
+ *            decoder and compared, the ratio against 16 bits values and the delta varints of the
+ *            series format and the decode rates are printed
+ */
+uint8_t bench_rawcodec(const char *path);
+
+/**
+ * @brief     bench the rolling windows
+ * @param[in] sensors sensor number
+ * @param[in] samples samples of every sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      1 min, 15 min and 1 h windows run over a 1 Hz random walk of every sensor,
+ *            the windows of sensor 0 are checked against a scan of its samples now and then
+ */
+uint8_t bench_window(uint32_t sensors, uint32_t samples);
+
+/**
+ * @brief     bench the quantile sketch
+ * @param[in] sensors sensor number
+ * @param[in] samples samples of every sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      every sensor sketches a 1 Hz tvoc like stream, the p50, p95 and p99 of every sensor,
+ *            of the merge of the encoded sensor sketches and of the last hour of a 1 min bucket ring
+ *            are checked against the sorted samples
+ */
+uint8_t bench_sketch(uint32_t sensors, uint32_t samples);
+
+/**
+ * @brief     bench the event detector
+ * @param[in] sensors sensor number
+ * @param[in] samples samples of every sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      1 Hz tvoc and ethanol raw noise of every sensor gets a solvent burst and a small step
+ *            in turn, the hits, misses, false alarms, the latency from the true onset and the
+ *            time per sample are printed
+ */
+uint8_t bench_detect(uint32_t sensors, uint32_t samples);
+
+/**
+ * @brief     bench the batch raw signal conversion
+ * @param[in] rounds round number
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      every round converts a buffer of raw h2 signals with expf one at a time, with the
+ *            portable polynomial and with the simd polynomial, the error of the polynomial is
+ *            checked over the whole uint16 range against a double exp, then a temperature and
+ *            humidity grid is converted by the driver formula and by the batch and compared
+ */
+uint8_t bench_convert(uint32_t rounds);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
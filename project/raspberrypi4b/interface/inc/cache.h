@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      cache.h
+ * @brief     cache header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include "sampler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup cache cache function
+ * @brief    cache function modules
+ * @{
+ */
+
+/**
+ * @brief cache sample structure definition
+ */
+typedef struct cache_sample_s
+{
+    uint64_t timestamp_us;          /**< CLOCK_MONOTONIC time of the read */
+    uint32_t seq;                   /**< sample number, 0 means no sample yet */
+    uint8_t res;                    /**< 0 means the read succeeded */
+    uint16_t co2_eq_ppm;            /**< co2 eq */
+    uint16_t tvoc_ppb;              /**< tvoc */
+} cache_sample_t;
+
+/**
+ * @brief cache stats structure definition
+ */
+typedef struct cache_stats_s
+{
+    uint64_t measurements;          /**< measurement number */
+    uint64_t failed;                /**< failed measurement number */
+    uint64_t missed;                /**< missed deadline number */
+    uint64_t reads;                 /**< cache read number */
+    uint64_t hits;                  /**< reads served from a fresh sample */
+    uint64_t coalesced;             /**< reads which waited for the in-flight measurement */
+    uint64_t timeouts;              /**< reads which timed out */
+} cache_stats_t;
+
+/**
+ * @brief cache structure definition
+ */
+typedef struct cache_s
+{
+    pthread_mutex_t mutex;                                          /**< mutex */
+    pthread_cond_t cond;                                            /**< signalled on a new sample */
+    pthread_t thread;                                               /**< measurement thread */
+    uint8_t (*read)(uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb);      /**< measurement function */
+    uint32_t period_ms;                                             /**< measurement period */
+    uint32_t ttl_ms;                                                /**< max age of a cached sample */
+    cache_sample_t sample;                                          /**< latest sample */
+    cache_stats_t stats;                                            /**< stats */
+    sampler_t sampler;                                              /**< deadlines */
+    uint8_t running;                                                /**< thread running flag */
+    volatile uint8_t stop;                                          /**< stop flag */
+} cache_t;
+
+/**
+ * @brief     cache init
+ * @param[in] *cache pointer to a cache structure
+ * @param[in] period_ms measurement period, 1000 keeps the iaq algorithm on its 1 Hz cadence
+ * @param[in] ttl_ms max age of a cached sample, 0 means period_ms
+ * @param[in] *read pointer to a measurement function such as sgp30_basic_read
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the chip must be initialized before cache_start
+ */
+uint8_t cache_init(cache_t *cache, uint32_t period_ms, uint32_t ttl_ms, uint8_t (*read)(uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb));
+
+/**
+ * @brief     cache start the measurement thread
+ * @param[in] *cache pointer to a cache structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the thread owns the chip, it measures once at the start and then on every period deadline
+ */
+uint8_t cache_start(cache_t *cache);
+
+/**
+ * @brief      cache read the latest sample
+ * @param[in]  *cache pointer to a cache structure
+ * @param[out] *sample pointer to a sample buffer
+ * @param[out] *age_ms pointer to an age buffer, it can be NULL
+ * @param[in]  timeout_ms max wait for the in-flight measurement
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or timeout
+ * @note       a sample younger than ttl_ms is returned at once, otherwise the caller waits for the
+ *             in-flight measurement together with every other caller, no reader ever starts a measurement
+ */
+uint8_t cache_read(cache_t *cache, cache_sample_t *sample, uint32_t *age_ms, uint32_t timeout_ms);
+
+/**
+ * @brief      cache get the stats
+ * @param[in]  *cache pointer to a cache structure
+ * @param[out] *stats pointer to a stats buffer
+ * @note       none
+ */
+void cache_get_stats(cache_t *cache, cache_stats_t *stats);
+
+/**
+ * @brief     cache print the stats
+ * @param[in] *cache pointer to a cache structure
+ * @note      none
+ */
+void cache_print_stats(cache_t *cache);
+
+/**
+ * @brief     cache stop the measurement thread
+ * @param[in] *cache pointer to a cache structure
+ * @note      the waiting readers return with a failure
+ */
+void cache_stop(cache_t *cache);
+
+/**
+ * @brief     cache deinit
+ * @param[in] *cache pointer to a cache structure
+ * @note      the thread is stopped first
+ */
+void cache_deinit(cache_t *cache);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      detect.h
+ * @brief     detect header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DETECT_H
+#define DETECT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup detect detect function
+ * @brief    detect function modules
+ * @{
+ */
+
+/**
+ * @brief detect channel enumeration definition
+ */
+typedef enum
+{
+    DETECT_CHANNEL_TVOC    = 0,        /**< tvoc in ppb, an event raises it */
+    DETECT_CHANNEL_ETHANOL = 1,        /**< ethanol raw signal, an event lowers it */
+    DETECT_CHANNEL_MAX     = 2,        /**< channel number */
+} detect_channel_t;
+
+/**
+ * @brief detect event type enumeration definition
+ */
+typedef enum
+{
+    DETECT_EVENT_START = 0,        /**< an excursion is detected */
+    DETECT_EVENT_END   = 1,        /**< the channel is back at its baseline */
+} detect_event_type_t;
+
+/**
+ * @brief detect config structure definition
+ */
+typedef struct detect_config_s
+{
+    float alpha;                            /**< ewma weight of a new sample */
+    float k;                                /**< cusum slack in scales */
+    float h;                                /**< cusum threshold in scales */
+    float spike;                            /**< single sample threshold in scales */
+    float floor[DETECT_CHANNEL_MAX];        /**< min scale of every channel */
+    uint32_t warmup;                        /**< samples before the first detection */
+} detect_config_t;
+
+/**
+ * @brief detect channel state structure definition
+ */
+typedef struct detect_state_s
+{
+    float mean;                 /**< ewma baseline */
+    float dev;                  /**< ewma of the absolute deviation */
+    float cusum;                /**< one sided cusum in scales */
+    uint64_t onset_ms;          /**< timestamp where the cusum left 0 */
+    uint8_t alarm;              /**< excursion in progress */
+} detect_state_t;
+
+/**
+ * @brief detect event structure definition
+ */
+typedef struct detect_event_s
+{
+    detect_event_type_t type;           /**< event type */
+    uint32_t sensor;                    /**< sensor index */
+    detect_channel_t channel;           /**< channel */
+    uint64_t timestamp_ms;              /**< timestamp of the sample that raised the event */
+    uint64_t onset_ms;                  /**< timestamp the excursion began */
+    uint64_t latency_ms;                /**< timestamp_ms - onset_ms, the excursion duration for an end */
+    uint16_t value;                     /**< sample value */
+    float baseline;                     /**< baseline before the excursion */
+    float score;                        /**< cusum or spike score in scales */
+} detect_event_t;
+
+/**
+ * @brief detect callback definition
+ */
+typedef void (*detect_callback_t)(const detect_event_t *event, void *arg);
+
+/**
+ * @brief detect structure definition
+ */
+typedef struct detect_s
+{
+    detect_config_t config;             /**< config */
+    uint32_t sensors;                   /**< sensor number */
+    detect_state_t *state;              /**< [sensor][channel] states */
+    uint32_t *samples;                  /**< [sensor] samples seen */
+    detect_callback_t callback;         /**< event callback */
+    void *arg;                          /**< callback argument */
+    uint64_t events;                    /**< start events */
+} detect_t;
+
+/**
+ * @brief      detect get the default config
+ * @param[out] *config pointer to a detect config structure
+ * @note       alpha 0.02 tracks a baseline of about 50 samples, a spike of 8 scales is raised at
+ *             once and a shift of 1.5 scales after about 5 samples
+ */
+void detect_default_config(detect_config_t *config);
+
+/**
+ * @brief     detect init
+ * @param[in] *detect pointer to a detect structure
+ * @param[in] sensors sensor number
+ * @param[in] *config pointer to a detect config structure, NULL means the default
+ * @param[in] callback event callback
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t detect_init(detect_t *detect, uint32_t sensors, const detect_config_t *config, detect_callback_t callback, void *arg);
+
+/**
+ * @brief     detect push a sample of a sensor
+ * @param[in] *detect pointer to a detect structure
+ * @param[in] sensor sensor index
+ * @param[in] timestamp_ms sample timestamp
+ * @param[in] tvoc_ppb tvoc
+ * @param[in] ethanol_raw ethanol raw signal
+ * @return    status code
+ *            - 0 success
+ *            - 1 push failed
+ * @note      the callback runs inside this call, during an excursion the noise scale is frozen and the
+ *            baseline adapts 10 times slower, so a step that stays is taken as the new baseline in the end
+ */
+uint8_t detect_push(detect_t *detect, uint32_t sensor, uint64_t timestamp_ms, uint16_t tvoc_ppb, uint16_t ethanol_raw);
+
+/**
+ * @brief     detect deinit
+ * @param[in] *detect pointer to a detect structure
+ * @note      none
+ */
+void detect_deinit(detect_t *detect);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      event.h
+ * @brief     event header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include "driver_sgp30.h"
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup event event function
+ * @brief    event function modules
+ * @{
+ */
+
+/**
+ * @brief event reinit threshold definition
+ */
+#ifndef EVENT_REINIT_THRESHOLD
+    #define EVENT_REINIT_THRESHOLD        3        /**< consecutive failures before the sensor is initialized again */
+#endif
+
+/**
+ * @brief event stagger definition
+ */
+#ifndef EVENT_STAGGER_MS
+    #define EVENT_STAGGER_MS              2        /**< first deadline offset between two sensors */
+#endif
+
+/**
+ * @brief event state enumeration definition
+ */
+typedef enum
+{
+    EVENT_STATE_INIT       = 0x00,        /**< waiting to send iaq init */
+    EVENT_STATE_WARMUP     = 0x01,        /**< iaq init is running */
+    EVENT_STATE_IDLE       = 0x02,        /**< waiting the next cadence deadline */
+    EVENT_STATE_CONVERTING = 0x03,        /**< measure iaq is running */
+} event_state_t;
+
+struct event_sensor_s;
+
+/**
+ * @brief event sample callback definition
+ */
+typedef void (*event_callback_t)(struct event_sensor_s *sensor, uint8_t res,
+                                 uint16_t co2_eq_ppm, uint16_t tvoc_ppb, void *arg);
+
+/**
+ * @brief event sensor structure definition
+ */
+typedef struct event_sensor_s
+{
+    sgp30_handle_t handle;          /**< sgp30 handle */
+    int iic_fd;                     /**< iic handle, it can be shared by the sensors of one adapter */
+    uint8_t mux_addr;               /**< iic mux write address, 0 means no mux */
+    uint8_t channel;                /**< mux channel */
+    int timer_fd;                   /**< timerfd of the conversion window and the cadence */
+    event_state_t state;            /**< state */
+    uint32_t period_ms;             /**< cadence */
+    struct timespec next;           /**< next absolute cadence deadline */
+    uint32_t pending_ms;            /**< delay requested by the driver during one step */
+    uint8_t failures;               /**< consecutive failure number */
+    event_callback_t callback;      /**< sample callback */
+    void *arg;                      /**< callback argument */
+    uint64_t samples;               /**< good sample number */
+    uint64_t failed;                /**< failed sample number */
+    uint64_t missed;                /**< missed deadline number */
+    uint64_t reinit;                /**< reinit number */
+} event_sensor_t;
+
+/**
+ * @brief event loop structure definition
+ */
+typedef struct event_loop_s
+{
+    int epoll_fd;                   /**< epoll fd of every sensor timer */
+    uint32_t sensor_num;            /**< sensor number */
+} event_loop_t;
+
+/**
+ * @brief     event loop init
+ * @param[in] *loop pointer to an event loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t event_init(event_loop_t *loop);
+
+/**
+ * @brief     event loop deinit
+ * @param[in] *loop pointer to an event loop structure
+ * @note      the sensors must be removed first
+ */
+void event_deinit(event_loop_t *loop);
+
+/**
+ * @brief     event loop get the fd
+ * @param[in] *loop pointer to an event loop structure
+ * @return    epoll fd, it is readable when any sensor is ready
+ * @note      add it to the epoll set of the service and call event_process_ready when it is readable
+ */
+int event_get_fd(event_loop_t *loop);
+
+/**
+ * @brief     event loop add a sensor
+ * @param[in] *loop pointer to an event loop structure
+ * @param[in] *sensor pointer to a sensor structure owned by the caller
+ * @param[in] iic_fd iic handle opened by iic_init
+ * @param[in] mux_addr iic mux write address, 0 means no mux
+ * @param[in] channel mux channel
+ * @param[in] period_ms cadence
+ * @param[in] callback sample callback
+ * @param[in] *arg pointer to the callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the first step is staggered by EVENT_STAGGER_MS per sensor, nothing blocks in this call
+ */
+uint8_t event_add_sensor(event_loop_t *loop, event_sensor_t *sensor, int iic_fd, uint8_t mux_addr, uint8_t channel,
+                         uint32_t period_ms, event_callback_t callback, void *arg);
+
+/**
+ * @brief     event loop remove a sensor
+ * @param[in] *loop pointer to an event loop structure
+ * @param[in] *sensor pointer to a sensor structure
+ * @note      the iic fd is not closed
+ */
+void event_remove_sensor(event_loop_t *loop, event_sensor_t *sensor);
+
+/**
+ * @brief     event loop advance every ready sensor
+ * @param[in] *loop pointer to an event loop structure
+ * @return    advanced sensor number
+ * @note      it never sleeps, the conversion and init waits are timerfd deadlines,
+ *            only the iic transfers of the ready sensors run in the call
+ */
+uint32_t event_process_ready(event_loop_t *loop);
+
+/**
+ * @brief     event sensor get the fd
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    timerfd of the sensor
+ * @note      for services which register every timer themselves instead of event_get_fd
+ */
+int event_sensor_get_fd(event_sensor_t *sensor);
+
+/**
+ * @brief     event sensor advance the state machine
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 advanced
+ *            - 1 the timer has not expired
+ * @note      call it when the sensor timerfd is readable
+ */
+uint8_t event_sensor_process(event_sensor_t *sensor);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
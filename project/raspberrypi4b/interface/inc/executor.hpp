@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      executor.hpp
+ * @brief     executor header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include "driver_sgp30_coro.hpp"
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @defgroup executor executor function
+ * @brief    executor function modules
+ * @{
+ */
+
+namespace sgp30
+{
+
+/**
+ * @brief epoll executor class definition
+ * @note  a single-threaded executor, every suspended coroutine waits in one timer queue
+ *        which is armed on one timerfd, fd() can be added to the epoll set of a service
+ */
+class EpollExecutor
+{
+    public:
+        /**
+         * @brief create the epoll fd and the timerfd
+         * @note  ok() is false when they cannot be created
+         */
+        EpollExecutor() noexcept
+        {
+            struct epoll_event ev = {};
+            
+            m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            m_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if ((m_epoll_fd >= 0) && (m_timer_fd >= 0))
+            {
+                ev.events = EPOLLIN;
+                ev.data.fd = m_timer_fd;
+                m_ok = (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_timer_fd, &ev) == 0);
+            }
+        }
+        
+        EpollExecutor(const EpollExecutor &) = delete;
+        EpollExecutor &operator=(const EpollExecutor &) = delete;
+        
+        /**
+         * @brief close the fds
+         * @note  the coroutines still suspended are not resumed
+         */
+        ~EpollExecutor()
+        {
+            if (m_timer_fd >= 0)
+            {
+                (void)close(m_timer_fd);
+            }
+            if (m_epoll_fd >= 0)
+            {
+                (void)close(m_epoll_fd);
+            }
+        }
+        
+        /**
+         * @brief  check the executor is usable
+         * @return true if the fds are created
+         * @note   none
+         */
+        bool ok() const noexcept { return m_ok; }
+        
+        /**
+         * @brief  get the fd
+         * @return epoll fd, it is readable when a timer has expired
+         * @note   none
+         */
+        int fd() const noexcept { return m_epoll_fd; }
+        
+        /**
+         * @brief     resume a coroutine after a time
+         * @param[in] time relative time
+         * @param[in] h coroutine handle
+         * @note      none
+         */
+        void schedule_after(std::chrono::milliseconds time, std::coroutine_handle<> h)
+        {
+            Entry e;
+            
+            e.deadline = now_ns() + static_cast<int64_t>(time.count()) * 1000000LL;
+            e.seq = m_seq++;
+            e.handle = h;
+            m_queue.push(e);
+            if (m_queue.top().seq == e.seq)
+            {
+                arm(e.deadline);
+            }
+        }
+        
+        /**
+         * @brief     start a task which is not awaited by any coroutine
+         * @param[in] task task
+         * @note      the frame is destroyed when it returns, run() returns when every spawned task is done
+         */
+        void spawn(Task<void> task)
+        {
+            m_live++;
+            (void)detached(std::move(task));
+        }
+        
+        /**
+         * @brief      resume the coroutines whose timers have expired
+         * @param[in]  timeout_ms max wait time, -1 means forever and 0 means no wait
+         * @return     resumed coroutine number
+         * @note       none
+         */
+        uint32_t run_once(int timeout_ms)
+        {
+            struct epoll_event ev;
+            uint64_t expirations;
+            uint32_t count;
+            int n;
+            
+            do
+            {
+                n = epoll_wait(m_epoll_fd, &ev, 1, timeout_ms);
+            } while ((n < 0) && (errno == EINTR));
+            if (n > 0)
+            {
+                (void)read(m_timer_fd, &expirations, sizeof(expirations));
+            }
+            
+            /* resume every expired entry, a resumed coroutine can schedule again */
+            count = 0;
+            while ((!m_queue.empty()) && (m_queue.top().deadline <= now_ns()))
+            {
+                std::coroutine_handle<> h = m_queue.top().handle;
+                
+                m_queue.pop();
+                h.resume();
+                count++;
+            }
+            if (!m_queue.empty())
+            {
+                arm(m_queue.top().deadline);
+            }
+            
+            return count;
+        }
+        
+        /**
+         * @brief run until every spawned task is done
+         * @note  none
+         */
+        void run()
+        {
+            while ((m_live != 0) && (!m_queue.empty()))
+            {
+                (void)run_once(-1);
+            }
+        }
+    
+    private:
+        /**
+         * @brief timer entry structure definition
+         */
+        struct Entry
+        {
+            int64_t deadline;                   /**< CLOCK_MONOTONIC deadline */
+            uint64_t seq;                       /**< insertion order of equal deadlines */
+            std::coroutine_handle<> handle;     /**< coroutine */
+            
+            /**
+             * @brief     order the entries
+             * @param[in] &other compared entry
+             * @return    true if this entry is later
+             * @note      none
+             */
+            bool operator>(const Entry &other) const noexcept
+            {
+                return (deadline != other.deadline) ? (deadline > other.deadline) : (seq > other.seq);
+            }
+        };
+        
+        /**
+         * @brief detached coroutine class definition
+         */
+        struct Detached
+        {
+            /**
+             * @brief detached promise structure definition
+             * @note  it starts at once and frees the frame at the end
+             */
+            struct promise_type
+            {
+                Detached get_return_object() const noexcept { return {}; }
+                std::suspend_never initial_suspend() const noexcept { return {}; }
+                std::suspend_never final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() const noexcept { std::terminate(); }
+            };
+        };
+        
+        /**
+         * @brief     run a spawned task to the end
+         * @param[in] task task
+         * @return    detached coroutine
+         * @note      none
+         */
+        Detached detached(Task<void> task)
+        {
+            co_await std::move(task);
+            m_live--;
+        }
+        
+        /**
+         * @brief  get the monotonic time
+         * @return time in nanoseconds
+         * @note   none
+         */
+        static int64_t now_ns() noexcept
+        {
+            struct timespec ts;
+            
+            (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+            
+            return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+        }
+        
+        /**
+         * @brief     arm the timerfd
+         * @param[in] deadline CLOCK_MONOTONIC deadline
+         * @note      none
+         */
+        void arm(int64_t deadline) noexcept
+        {
+            struct itimerspec its = {};
+            
+            if (deadline <= 0)
+            {
+                deadline = 1;
+            }
+            its.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000LL);
+            its.it_value.tv_nsec = static_cast<long>(deadline % 1000000000LL);
+            (void)timerfd_settime(m_timer_fd, TFD_TIMER_ABSTIME, &its, nullptr);
+        }
+    
+    private:
+        int m_epoll_fd = -1;                                                          /**< epoll fd */
+        int m_timer_fd = -1;                                                          /**< timerfd */
+        bool m_ok = false;                                                            /**< fds flag */
+        uint64_t m_seq = 0;                                                           /**< insertion counter */
+        uint64_t m_live = 0;                                                          /**< running spawned task number */
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_queue;  /**< timer queue */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
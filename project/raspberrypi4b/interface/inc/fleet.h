@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      fleet.h
+ * @brief     fleet header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef FLEET_H
+#define FLEET_H
+
+#include "driver_sgp30.h"
+#include <pthread.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup fleet fleet function
+ * @brief    fleet function modules
+ * @{
+ */
+
+/**
+ * @brief fleet max definition
+ */
+#define FLEET_MAX_BUS            8         /**< max iic adapter */
+#define FLEET_MAX_CHANNEL        8         /**< max sensor on one adapter */
+
+/**
+ * @brief fleet sample structure definition
+ */
+typedef struct fleet_sample_s
+{
+    uint64_t timestamp_ns;          /**< CLOCK_MONOTONIC time of the read */
+    uint32_t round;                 /**< round number of the bus */
+    uint8_t bus;                    /**< bus index */
+    uint8_t channel;                /**< mux channel */
+    uint8_t res;                    /**< 0 means the read succeeded */
+    uint16_t co2_eq_ppm;            /**< co2 eq */
+    uint16_t tvoc_ppb;              /**< tvoc */
+} fleet_sample_t;
+
+/**
+ * @brief fleet sink structure definition
+ */
+typedef struct fleet_sink_s
+{
+    pthread_mutex_t mutex;          /**< mutex */
+    pthread_cond_t cond;            /**< signalled on publish */
+    fleet_sample_t *buf;            /**< sample ring */
+    uint32_t size;                  /**< ring size */
+    uint64_t head;                  /**< published sample number */
+    uint64_t tail;                  /**< consumed sample number */
+    uint64_t dropped;               /**< overwritten sample number */
+} fleet_sink_t;
+
+/**
+ * @brief fleet bus stats structure definition
+ */
+typedef struct fleet_stats_s
+{
+    uint64_t rounds;                /**< round number */
+    uint64_t samples;               /**< good sample number */
+    uint64_t failed;                /**< failed read number */
+    uint64_t missed;                /**< missed deadline number */
+    uint64_t round_max_us;          /**< max round time */
+    uint64_t round_sum_us;          /**< sum of the round time */
+    uint64_t lock_count;            /**< bus lock number */
+    uint64_t lock_contended;        /**< bus lock number which had to wait */
+    uint64_t lock_wait_sum_us;      /**< sum of the bus lock wait */
+    uint64_t lock_wait_max_us;      /**< max bus lock wait */
+    uint64_t lock_hold_sum_us;      /**< sum of the bus lock hold */
+    uint64_t lock_hold_max_us;      /**< max bus lock hold */
+} fleet_stats_t;
+
+/**
+ * @brief fleet bus structure definition
+ */
+typedef struct fleet_bus_s
+{
+    char name[32];                                 /**< iic device name */
+    uint8_t index;                                 /**< bus index */
+    uint8_t mux_addr;                              /**< iic mux write address, 0 means no mux */
+    uint8_t channel;                               /**< sensor number */
+    uint8_t ready[FLEET_MAX_CHANNEL];              /**< channel init flag */
+    sgp30_handle_t handle[FLEET_MAX_CHANNEL];      /**< sensor handle */
+    int fd;                                        /**< iic handle owned by the worker */
+    pthread_t thread;                              /**< worker thread */
+    uint8_t running;                               /**< worker started flag */
+    fleet_stats_t stats;                           /**< stats */
+    struct fleet_s *fleet;                         /**< owner */
+} fleet_bus_t;
+
+/**
+ * @brief fleet structure definition
+ */
+typedef struct fleet_s
+{
+    fleet_bus_t bus[FLEET_MAX_BUS];         /**< bus */
+    uint8_t bus_num;                        /**< bus number */
+    uint32_t period_ms;                     /**< round period */
+    uint32_t rounds;                        /**< round number, 0 means until stop */
+    volatile uint8_t stop;                  /**< stop flag */
+    uint8_t active;                         /**< running worker number */
+    uint64_t start_us;                      /**< start time */
+    fleet_sink_t sink;                      /**< shared sample sink */
+} fleet_t;
+
+/**
+ * @brief     fleet init
+ * @param[in] *fleet pointer to a fleet structure
+ * @param[in] period_ms round period
+ * @param[in] sink_size sink ring size in samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t fleet_init(fleet_t *fleet, uint32_t period_ms, uint32_t sink_size);
+
+/**
+ * @brief     fleet add an iic adapter
+ * @param[in] *fleet pointer to a fleet structure
+ * @param[in] *name pointer to an iic device name buffer
+ * @param[in] mux_addr iic mux write address, 0 means no mux
+ * @param[in] channel sensor number, it must be 1 without a mux
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      call it before fleet_start
+ */
+uint8_t fleet_add_bus(fleet_t *fleet, const char *name, uint8_t mux_addr, uint8_t channel);
+
+/**
+ * @brief     fleet start one worker per adapter
+ * @param[in] *fleet pointer to a fleet structure
+ * @param[in] rounds round number, 0 means until fleet_stop
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      every worker opens its own fd, inits its sensors and runs its own round on absolute deadlines,
+ *            the adapters are independent so the throughput grows with the adapter number
+ */
+uint8_t fleet_start(fleet_t *fleet, uint32_t rounds);
+
+/**
+ * @brief      fleet read samples from the sink
+ * @param[in]  *fleet pointer to a fleet structure
+ * @param[out] *sample pointer to a sample buffer
+ * @param[in]  len buffer length
+ * @return     read sample number, 0 means every worker has finished and the sink is empty
+ * @note       it blocks until a worker publishes
+ */
+uint32_t fleet_read(fleet_t *fleet, fleet_sample_t *sample, uint32_t len);
+
+/**
+ * @brief     fleet stop and join the workers
+ * @param[in] *fleet pointer to a fleet structure
+ * @note      none
+ */
+void fleet_stop(fleet_t *fleet);
+
+/**
+ * @brief     fleet print the stats
+ * @param[in] *fleet pointer to a fleet structure
+ * @note      none
+ */
+void fleet_print_stats(fleet_t *fleet);
+
+/**
+ * @brief     fleet deinit
+ * @param[in] *fleet pointer to a fleet structure
+ * @note      the workers are stopped first
+ */
+void fleet_deinit(fleet_t *fleet);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
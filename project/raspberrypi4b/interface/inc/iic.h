@@ -23,13 +23,14 @@
  *
  * @file      iic.h
  * @brief     iic header file
- * @version   1.0.0
+ * @version   1.1.0
  * @author    Shifeng Li
- * @date      2022-11-11
+ * @date      2026-10-19
  *
  * <h3>history</h3>
  * <table>
  * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.1      <td>Shifeng Li  <td>add bus recovery and batch transfer
  * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
  * </table>
  */
@@ -42,6 +43,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <linux/i2c.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +55,48 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic recovery stats structure definition
+ */
+typedef struct iic_recovery_stats_s
+{
+    uint32_t count;           /**< recovery count */
+    uint32_t failed;          /**< failed recovery count */
+    uint64_t last_us;         /**< last recovery time in microseconds */
+    uint64_t max_us;          /**< max recovery time in microseconds */
+    uint64_t total_us;        /**< total recovery time in microseconds */
+} iic_recovery_stats_t;
+
+/**
+ * @brief iic lock stats structure definition
+ */
+typedef struct iic_lock_stats_s
+{
+    uint64_t count;                /**< lock count */
+    uint64_t contended;            /**< lock count which had to wait */
+    uint64_t wait_total_us;        /**< total lock wait in microseconds */
+    uint64_t wait_max_us;          /**< max lock wait in microseconds */
+    uint64_t hold_total_us;        /**< total lock hold in microseconds */
+    uint64_t hold_max_us;          /**< max lock hold in microseconds */
+} iic_lock_stats_t;
+
+/**
+ * @brief iic batch size definition
+ */
+#ifndef IIC_BATCH_MAX_MSG
+    #define IIC_BATCH_MAX_MSG 64
+#endif
+
+/**
+ * @brief iic batch structure definition
+ */
+typedef struct iic_batch_s
+{
+    struct i2c_msg msgs[IIC_BATCH_MAX_MSG];        /**< queued messages */
+    uint8_t stop[IIC_BATCH_MAX_MSG];               /**< stop after the message */
+    uint32_t num;                                  /**< queued message number */
+} iic_batch_t;
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -60,7 +104,7 @@ extern "C" {
  * @return     status code
  *             - 0 success
  *             - 1 init failed
- * @note       none
+ * @note       at most 8 buses can be opened at once, one more fails
  */
 uint8_t iic_init(char *name, int *fd);
 
@@ -74,6 +118,85 @@ uint8_t iic_init(char *name, int *fd);
  */
 uint8_t iic_deinit(int fd);
 
+/**
+ * @brief     iic bus set the recovery
+ * @param[in] fd iic handle
+ * @param[in] *chip pointer to a gpio chip name, path or number
+ * @param[in] scl scl gpio line
+ * @param[in] sda sda gpio line
+ * @param[in] threshold consecutive bus stuck failures before recovery, 0 means disabled
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the recovery needs the permission to request the gpio lines and to write the driver bind files
+ */
+uint8_t iic_set_recovery(int fd, char *chip, uint32_t scl, uint32_t sda, uint32_t threshold);
+
+/**
+ * @brief     iic bus recover now
+ * @param[in] fd iic handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 recover failed
+ * @note      iic_set_recovery must be called before
+ */
+uint8_t iic_recover(int fd);
+
+/**
+ * @brief      iic bus get the recovery stats
+ * @param[in]  fd iic handle
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t iic_get_recovery_stats(int fd, iic_recovery_stats_t *stats);
+
+/**
+ * @brief     iic bus enable the cross-process lock
+ * @param[in] fd iic handle
+ * @param[in] *path pointer to a lock file path, NULL means IIC_LOCK_DIR/<adapter>.lock
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      every process opening the same lock file shares the bus,
+ *            an OFD lock is taken on the file, so fds of the same process exclude each other as well
+ */
+uint8_t iic_set_lock(int fd, char *path);
+
+/**
+ * @brief     iic bus lock
+ * @param[in] fd iic handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the lock nests in one thread, so a caller can hold the bus over a write, wait and read,
+ *            every transfer takes it, the threads of the process are serialized even without iic_set_lock
+ */
+uint8_t iic_lock(int fd);
+
+/**
+ * @brief     iic bus unlock
+ * @param[in] fd iic handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t iic_unlock(int fd);
+
+/**
+ * @brief      iic bus get the lock stats
+ * @param[in]  fd iic handle
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the wait and hold are counted at the outermost lock only
+ */
+uint8_t iic_get_lock_stats(int fd, iic_lock_stats_t *stats);
+
 /**
  * @brief      iic bus read command
  * @param[in]  fd iic handle
@@ -156,6 +279,62 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus get the I2C_RDWR ioctl count
+ * @param[in] fd iic handle
+ * @return    ioctl count
+ * @note      a recovered transfer counts twice
+ */
+uint64_t iic_get_ioctl_count(int fd);
+
+/**
+ * @brief     iic batch init
+ * @param[in] *batch pointer to an iic batch structure
+ * @note      none
+ */
+void iic_batch_init(iic_batch_t *batch);
+
+/**
+ * @brief     iic batch add a write message
+ * @param[in] *batch pointer to an iic batch structure
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @param[in] stop stop after the message
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch is full
+ * @note      addr = device_address_7bits << 1, the buffer must be valid until the batch is submitted
+ */
+uint8_t iic_batch_add_write(iic_batch_t *batch, uint8_t addr, uint8_t *buf, uint16_t len, uint8_t stop);
+
+/**
+ * @brief      iic batch add a read message
+ * @param[in]  *batch pointer to an iic batch structure
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  stop stop after the message
+ * @return     status code
+ *             - 0 success
+ *             - 1 batch is full
+ * @note       addr = device_address_7bits << 1, the buffer is filled when the batch is submitted
+ */
+uint8_t iic_batch_add_read(iic_batch_t *batch, uint8_t addr, uint8_t *buf, uint16_t len, uint8_t stop);
+
+/**
+ * @brief         iic batch submit all messages
+ * @param[in]     fd iic handle
+ * @param[in,out] *batch pointer to an iic batch structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 submit failed
+ * @note          messages are sent with as few I2C_RDWR calls as I2C_RDWR_IOCTL_MAX_MSGS allows,
+ *                a stop inside one call needs I2C_FUNC_PROTOCOL_MANGLING, otherwise the call ends at that message,
+ *                the batch is empty after the submit
+ */
+uint8_t iic_batch_submit(int fd, iic_batch_t *batch);
+
 /**
  * @}
  */
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rawcodec.h
+ * @brief     rawcodec header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RAWCODEC_H
+#define RAWCODEC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rawcodec rawcodec function
+ * @brief    rawcodec function modules
+ * @{
+ */
+
+/**
+ * @brief rawcodec format definition
+ */
+#define RAWCODEC_BLOCK               128        /**< values in one block */
+#define RAWCODEC_LANE                4          /**< interleaved 32 bits lanes */
+#define RAWCODEC_MAX_BITS            17         /**< max width of a zigzag 16 bits delta */
+#define RAWCODEC_BLOCK_HEADER_SIZE   4          /**< base value, bit width and a reserved byte */
+
+/**
+ * @brief rawcodec simd definition
+ */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define RAWCODEC_SIMD            "neon"     /**< arm neon decode */
+#elif defined(__SSE2__)
+    #define RAWCODEC_SIMD            "sse2"     /**< x86 sse2 decode */
+#else
+    #define RAWCODEC_SIMD            "none"     /**< scalar decode only */
+#endif
+
+/**
+ * @brief     rawcodec get the max encoded size
+ * @param[in] count value number
+ * @return    max encoded bytes
+ * @note      none
+ */
+uint32_t rawcodec_bound(uint32_t count);
+
+/**
+ * @brief      rawcodec encode a raw signal
+ * @param[in]  *in pointer to the values
+ * @param[in]  count value number
+ * @param[out] *out pointer to a buffer of rawcodec_bound(count) bytes
+ * @return     encoded bytes
+ * @note       every block of 128 values keeps its first value and the zigzag deltas packed
+ *             at the width of the largest one, the last block is padded with zero deltas
+ */
+uint32_t rawcodec_encode(const uint16_t *in, uint32_t count, uint8_t *out);
+
+/**
+ * @brief      rawcodec decode a raw signal
+ * @param[in]  *in pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *out pointer to a buffer of count values
+ * @param[in]  count value number
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed
+ * @note       the simd path of RAWCODEC_SIMD is used if there is one
+ */
+uint8_t rawcodec_decode(const uint8_t *in, uint32_t len, uint16_t *out, uint32_t count);
+
+/**
+ * @brief      rawcodec decode a raw signal without simd
+ * @param[in]  *in pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *out pointer to a buffer of count values
+ * @param[in]  count value number
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed
+ * @note       the reference for the simd path
+ */
+uint8_t rawcodec_decode_scalar(const uint8_t *in, uint32_t len, uint16_t *out, uint32_t count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
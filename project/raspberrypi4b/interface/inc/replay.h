@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      replay.h
+ * @brief     replay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup replay replay function
+ * @brief    replay function modules
+ * @{
+ */
+
+/**
+ * @brief replay format definition
+ */
+#define REPLAY_MAGIC                 0x52504753U        /**< "SGPR" */
+#define REPLAY_VERSION               1                  /**< format version */
+#define REPLAY_HEADER_SIZE           32                 /**< file header bytes */
+#define REPLAY_RECORD_HEADER_SIZE    16                 /**< record header bytes */
+#define REPLAY_MAX_DATA              64                 /**< max bytes of one transfer */
+#define REPLAY_SYNC_WINDOW           16                 /**< records searched ahead for a matching transfer */
+
+/**
+ * @brief replay mode enumeration definition
+ */
+typedef enum
+{
+    REPLAY_MODE_NONE   = 0x00,        /**< closed */
+    REPLAY_MODE_PLAY   = 0x01,        /**< the bus is served from a trace */
+    REPLAY_MODE_RECORD = 0x02,        /**< the bus is captured to a trace */
+} replay_mode_t;
+
+/**
+ * @brief replay record type enumeration definition
+ */
+typedef enum
+{
+    REPLAY_RECORD_WRITE = 0x00,        /**< iic write */
+    REPLAY_RECORD_READ  = 0x01,        /**< iic read */
+} replay_record_type_t;
+
+/**
+ * @brief replay record structure definition
+ */
+typedef struct replay_record_s
+{
+    uint64_t timestamp_ns;                  /**< time from the start of the capture */
+    uint8_t type;                           /**< replay_record_type_t */
+    uint8_t addr;                           /**< iic device write address */
+    uint8_t res;                            /**< result of the transfer, 1 is a nack or a bus error */
+    uint16_t len;                           /**< data length */
+    uint8_t data[REPLAY_MAX_DATA];          /**< written or read bytes */
+} replay_record_t;
+
+/**
+ * @brief replay stats structure definition
+ */
+typedef struct replay_stats_s
+{
+    uint64_t writes;                        /**< served or captured writes */
+    uint64_t reads;                         /**< served or captured reads */
+    uint64_t failed;                        /**< transfers which failed on the bus */
+    uint64_t skipped;                       /**< trace records skipped to find a match */
+    uint64_t mismatched;                    /**< transfers without a match in the trace */
+    uint64_t virtual_ns;                    /**< virtual time from the start */
+    uint64_t real_ns;                       /**< real time from the start */
+    uint8_t eof;                            /**< the trace is used up */
+} replay_stats_t;
+
+/**
+ * @brief replay structure definition
+ */
+typedef struct replay_s
+{
+    FILE *fp;                                       /**< trace file */
+    uint8_t mode;                                   /**< replay_mode_t */
+    float speed;                                    /**< virtual time per real time, 0 means no throttle */
+    pthread_mutex_t mutex;                          /**< serializes the bus callbacks and the clock */
+    uint64_t mono_base_ns;                          /**< CLOCK_MONOTONIC at the start of the capture */
+    uint64_t real_base_ns;                          /**< CLOCK_REALTIME at the start of the capture */
+    uint64_t start_ns;                              /**< CLOCK_MONOTONIC at the open */
+    uint64_t now_ns;                                /**< virtual time from the start */
+    replay_record_t ahead[REPLAY_SYNC_WINDOW];      /**< records read ahead */
+    uint32_t head;                                  /**< first record read ahead */
+    uint32_t count;                                 /**< records read ahead */
+    replay_stats_t stats;                           /**< stats */
+} replay_t;
+
+/**
+ * @brief     replay open a trace to serve the bus from
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *path pointer to a trace file path
+ * @param[in] speed virtual time per real time, 0 means as fast as possible and 1 means real time
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the virtual clock starts at the clocks of the capture
+ */
+uint8_t replay_open(replay_t *replay, const char *path, float speed);
+
+/**
+ * @brief     replay open a trace to capture the bus to
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *path pointer to a trace file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      an existing file is truncated
+ */
+uint8_t replay_record_open(replay_t *replay, const char *path);
+
+/**
+ * @brief     replay close
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      a bound replay is unbound first
+ */
+uint8_t replay_close(replay_t *replay);
+
+/**
+ * @brief     replay bind the interface callbacks and the clock
+ * @param[in] *replay pointer to a replay structure, NULL unbinds
+ * @note      none
+ */
+void replay_bind(replay_t *replay);
+
+/**
+ * @brief  replay get the bound replay
+ * @return pointer to the bound replay structure, NULL if none
+ * @note   none
+ */
+replay_t *replay_get_bound(void);
+
+/**
+ * @brief     replay serve an iic write
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the write must match a captured write within REPLAY_SYNC_WINDOW records, the records
+ *            before it are skipped, the captured result is returned so a nack is replayed as a nack
+ */
+uint8_t replay_write_cmd(replay_t *replay, uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      replay serve an iic read
+ * @param[in]  *replay pointer to a replay structure
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the captured bytes are returned as they were, crc errors included
+ */
+uint8_t replay_read_cmd(replay_t *replay, uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay capture a transfer
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] type replay record type
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] res result of the transfer
+ * @return    status code
+ *            - 0 success
+ *            - 1 capture failed
+ * @note      none
+ */
+uint8_t replay_capture(replay_t *replay, replay_record_type_t type, uint8_t addr, const uint8_t *buf, uint16_t len, uint8_t res);
+
+/**
+ * @brief     replay delay in virtual time
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] ms delay time
+ * @note      none
+ */
+void replay_delay_ms(replay_t *replay, uint32_t ms);
+
+/**
+ * @brief      replay get the time of a clock
+ * @param[in]  clock CLOCK_MONOTONIC or CLOCK_REALTIME
+ * @param[out] *ts pointer to a timespec structure
+ * @return     0 on success, -1 on error
+ * @note       the virtual time of the bound trace, clock_gettime without one
+ */
+int replay_clock_gettime(clockid_t clock, struct timespec *ts);
+
+/**
+ * @brief     replay sleep on a clock
+ * @param[in] clock CLOCK_MONOTONIC or CLOCK_REALTIME
+ * @param[in] flags 0 or TIMER_ABSTIME
+ * @param[in] *request pointer to a timespec structure
+ * @param[in] *remain pointer to a remaining time buffer, it can be NULL
+ * @return    0 on success, an error number on error
+ * @note      the virtual clock jumps to the wake up of the bound trace, clock_nanosleep without one
+ */
+int replay_clock_nanosleep(clockid_t clock, int flags, const struct timespec *request, struct timespec *remain);
+
+/**
+ * @brief      replay get the stats
+ * @param[in]  *replay pointer to a replay structure
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void replay_get_stats(replay_t *replay, replay_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
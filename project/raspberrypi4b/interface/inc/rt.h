@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.h
+ * @brief     rt header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RT_H
+#define RT_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rt rt function
+ * @brief    rt function modules
+ * @{
+ */
+
+/**
+ * @brief rt default stack size definition
+ */
+#ifndef RT_DEFAULT_STACK_SIZE
+    #define RT_DEFAULT_STACK_SIZE        (256 * 1024)        /**< 256 KiB */
+#endif
+
+/**
+ * @brief rt prefaulted stack size definition
+ */
+#ifndef RT_PREFAULT_STACK_SIZE
+    #define RT_PREFAULT_STACK_SIZE       (64 * 1024)         /**< 64 KiB */
+#endif
+
+/**
+ * @brief rt config structure definition
+ */
+typedef struct rt_config_s
+{
+    int32_t priority;               /**< SCHED_FIFO priority, 0 means SCHED_OTHER */
+    int32_t cpu;                    /**< cpu to pin the thread on, -1 means no pinning */
+    uint32_t stack_size;            /**< thread stack size */
+    uint8_t lock_memory;            /**< 1 locks the current and future pages of the process */
+} rt_config_t;
+
+/**
+ * @brief      rt init the config with the defaults
+ * @param[out] *config pointer to a config structure
+ * @note       priority 80, no pinning, RT_DEFAULT_STACK_SIZE and locked memory
+ */
+void rt_config_init(rt_config_t *config);
+
+/**
+ * @brief     rt prefault a buffer
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len buffer length
+ * @note      every page is written once so the later accesses never fault,
+ *            call it on the sample buffers before the acquisition thread starts
+ */
+void rt_prefault(void *buf, size_t len);
+
+/**
+ * @brief      rt create an acquisition thread
+ * @param[out] *thread pointer to a thread buffer
+ * @param[in]  *config pointer to a config structure
+ * @param[in]  *entry pointer to the thread entry
+ * @param[in]  *arg pointer to the thread argument
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       the memory is locked before the thread starts and RT_PREFAULT_STACK_SIZE of the stack
+ *             is touched before entry runs, SCHED_FIFO needs CAP_SYS_NICE or an rtprio limit,
+ *             the thread is not downgraded silently when the policy is refused
+ */
+uint8_t rt_thread_create(pthread_t *thread, const rt_config_t *config, void *(*entry)(void *), void *arg);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sampler.h
+ * @brief     sampler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sampler sampler function
+ * @brief    sampler function modules
+ * @{
+ */
+
+/**
+ * @brief sampler stats structure definition
+ */
+typedef struct sampler_stats_s
+{
+    uint64_t samples;               /**< sample number */
+    uint64_t missed;                /**< missed deadline number */
+    int64_t jitter_last_ns;         /**< last wake up jitter */
+    int64_t jitter_min_ns;          /**< min wake up jitter */
+    int64_t jitter_max_ns;          /**< max wake up jitter */
+    int64_t jitter_sum_ns;          /**< sum of the wake up jitter */
+} sampler_stats_t;
+
+/**
+ * @brief sampler structure definition
+ */
+typedef struct sampler_s
+{
+    struct timespec next;           /**< next absolute deadline */
+    uint64_t period_ns;             /**< period */
+    sampler_stats_t stats;          /**< stats */
+} sampler_t;
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] period_ms sampling period
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the first deadline is one period from now
+ */
+uint8_t sampler_init(sampler_t *sampler, uint32_t period_ms);
+
+/**
+ * @brief      sampler wait the next deadline
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *missed pointer to a missed deadline number buffer, it can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ * @note       deadlines are absolute on CLOCK_MONOTONIC, so the period does not drift with the work done between waits,
+ *             the deadlines that have already passed are skipped and counted as missed, a bound replay
+ *             runs them on its virtual clock
+ */
+uint8_t sampler_wait(sampler_t *sampler, uint32_t *missed);
+
+/**
+ * @brief      sampler get the stats
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void sampler_get_stats(sampler_t *sampler, sampler_stats_t *stats);
+
+/**
+ * @brief     sampler print the stats
+ * @param[in] *sampler pointer to a sampler structure
+ * @note      none
+ */
+void sampler_print_stats(sampler_t *sampler);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
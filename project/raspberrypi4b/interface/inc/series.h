@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      series.h
+ * @brief     series header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup series series function
+ * @brief    series function modules
+ * @{
+ */
+
+/**
+ * @brief series format definition
+ */
+#define SERIES_FILE_MAGIC            0x53504753U        /**< "SGPS" */
+#define SERIES_CHUNK_MAGIC           0x43504753U        /**< "SGPC" */
+#define SERIES_VERSION               1                  /**< format version */
+#define SERIES_CHANNEL               4                  /**< co2 eq, tvoc, h2 raw and ethanol raw */
+#define SERIES_FILE_HEADER_SIZE      16                 /**< file header bytes */
+#define SERIES_CHUNK_HEADER_SIZE     80                 /**< chunk header bytes */
+#define SERIES_MAX_CHUNK             4096               /**< max samples in one chunk */
+#define SERIES_DEFAULT_CHUNK         3600               /**< one hour of 1 Hz samples */
+#define SERIES_MAX_SAMPLE_BYTES      22                 /**< 10 bytes timestamp and 3 bytes per channel */
+
+/**
+ * @brief series channel enumeration definition
+ */
+typedef enum
+{
+    SERIES_CHANNEL_CO2_EQ  = 0,        /**< co2 eq in ppm */
+    SERIES_CHANNEL_TVOC    = 1,        /**< tvoc in ppb */
+    SERIES_CHANNEL_H2      = 2,        /**< h2 raw signal */
+    SERIES_CHANNEL_ETHANOL = 3,        /**< ethanol raw signal */
+} series_channel_t;
+
+/**
+ * @brief series sample structure definition
+ */
+typedef struct series_sample_s
+{
+    uint64_t timestamp_ms;                  /**< timestamp in milliseconds */
+    uint16_t value[SERIES_CHANNEL];         /**< channel values */
+} series_sample_t;
+
+/**
+ * @brief series chunk structure definition
+ */
+typedef struct series_chunk_s
+{
+    uint16_t count;                         /**< sample number */
+    uint16_t flags;                         /**< reserved flags */
+    uint32_t payload_len;                   /**< encoded payload bytes */
+    uint32_t crc;                           /**< crc-32 of the header and the payload */
+    uint64_t first_ts;                      /**< first timestamp */
+    uint64_t last_ts;                       /**< last timestamp */
+    uint16_t first[SERIES_CHANNEL];         /**< first values */
+    uint16_t min[SERIES_CHANNEL];           /**< min values */
+    uint16_t max[SERIES_CHANNEL];           /**< max values */
+    uint32_t sum[SERIES_CHANNEL];           /**< sum of the values */
+} series_chunk_t;
+
+/**
+ * @brief series writer structure definition
+ */
+typedef struct series_writer_s
+{
+    FILE *fp;                               /**< file handle */
+    uint8_t *payload;                       /**< payload buffer */
+    uint32_t pos;                           /**< payload bytes */
+    uint32_t chunk_samples;                 /**< samples per chunk */
+    series_chunk_t chunk;                   /**< open chunk */
+    int64_t prev_delta;                     /**< last timestamp delta */
+    uint16_t prev[SERIES_CHANNEL];          /**< last values */
+    uint64_t samples;                       /**< written samples */
+    uint64_t bytes;                         /**< written chunk bytes */
+} series_writer_t;
+
+/**
+ * @brief series reader structure definition
+ */
+typedef struct series_reader_s
+{
+    FILE *fp;                                       /**< file handle */
+    uint8_t header[SERIES_CHUNK_HEADER_SIZE];       /**< raw chunk header */
+    uint8_t *payload;                               /**< payload buffer */
+    series_chunk_t chunk;                           /**< current chunk */
+    uint64_t offset;                                /**< next chunk offset in the file */
+} series_reader_t;
+
+/**
+ * @brief     series crc-32
+ * @param[in] crc running crc, 0 at the start
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc-32 of the data
+ * @note      the ieee 802.3 polynomial
+ */
+uint32_t series_crc32(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief     series check a file header
+ * @param[in] *header pointer to SERIES_FILE_HEADER_SIZE bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 header is invalid
+ * @note      none
+ */
+uint8_t series_file_check(const uint8_t *header);
+
+/**
+ * @brief      series parse a chunk header
+ * @param[in]  *header pointer to SERIES_CHUNK_HEADER_SIZE bytes
+ * @param[out] *chunk pointer to a chunk structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 header is invalid
+ * @note       the payload is not checked
+ */
+uint8_t series_chunk_parse(const uint8_t *header, series_chunk_t *chunk);
+
+/**
+ * @brief     series check the crc of a chunk
+ * @param[in] *header pointer to SERIES_CHUNK_HEADER_SIZE bytes
+ * @param[in] *payload pointer to the payload
+ * @param[in] *chunk pointer to the parsed chunk
+ * @return    status code
+ *            - 0 success
+ *            - 1 crc is wrong
+ * @note      none
+ */
+uint8_t series_chunk_check(const uint8_t *header, const uint8_t *payload, const series_chunk_t *chunk);
+
+/**
+ * @brief      series decode a chunk
+ * @param[in]  *chunk pointer to the parsed chunk
+ * @param[in]  *payload pointer to the payload
+ * @param[out] *sample pointer to a buffer of chunk->count samples
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is malformed
+ * @note       the payload is read in place, it can be a mapped file
+ */
+uint8_t series_chunk_decode(const series_chunk_t *chunk, const uint8_t *payload, series_sample_t *sample);
+
+/**
+ * @brief     series writer open
+ * @param[in] *writer pointer to a series writer structure
+ * @param[in] *path pointer to a file path
+ * @param[in] chunk_samples samples per chunk, 0 means SERIES_DEFAULT_CHUNK
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      an existing file is read once and cut back to the end of its last valid chunk before it is
+ *            appended to, so a chunk torn by a crash does not hide the chunks written after it,
+ *            the walk reads and checks the crc of the whole file
+ */
+uint8_t series_writer_open(series_writer_t *writer, const char *path, uint32_t chunk_samples);
+
+/**
+ * @brief     series writer add a sample
+ * @param[in] *writer pointer to a series writer structure
+ * @param[in] *sample pointer to a sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 timestamp goes back
+ * @note      a full chunk is written at once
+ */
+uint8_t series_writer_write(series_writer_t *writer, const series_sample_t *sample);
+
+/**
+ * @brief     series writer write the open chunk
+ * @param[in] *writer pointer to a series writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      the next sample starts a new chunk, so flush only as often as losing a chunk hurts
+ */
+uint8_t series_writer_flush(series_writer_t *writer);
+
+/**
+ * @brief     series writer close
+ * @param[in] *writer pointer to a series writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the open chunk is written first
+ */
+uint8_t series_writer_close(series_writer_t *writer);
+
+/**
+ * @brief     series reader open
+ * @param[in] *reader pointer to a series reader structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+uint8_t series_reader_open(series_reader_t *reader, const char *path);
+
+/**
+ * @brief      series reader read the next chunk
+ * @param[in]  *reader pointer to a series reader structure
+ * @param[out] *chunk pointer to a chunk structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 end of file
+ *             - 2 chunk is damaged, the next call reads the following chunk
+ * @note       a damaged chunk is skipped up to the next SERIES_CHUNK_MAGIC that starts a valid header,
+ *             so the chunks after a torn one are still read, the chunk of a damaged run is cleared
+ *             when its header is not valid
+ */
+uint8_t series_reader_next(series_reader_t *reader, series_chunk_t *chunk);
+
+/**
+ * @brief      series reader decode the current chunk
+ * @param[in]  *reader pointer to a series reader structure
+ * @param[out] *sample pointer to a buffer of chunk.count samples
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode failed
+ * @note       none
+ */
+uint8_t series_reader_decode(series_reader_t *reader, series_sample_t *sample);
+
+/**
+ * @brief     series reader close
+ * @param[in] *reader pointer to a series reader structure
+ * @note      none
+ */
+void series_reader_close(series_reader_t *reader);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
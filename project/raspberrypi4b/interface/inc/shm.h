@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm.h
+ * @brief     shm header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SHM_H
+#define SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup shm shm function
+ * @brief    shm function modules
+ * @{
+ */
+
+/**
+ * @brief shm definition
+ */
+#define SHM_MAGIC             0x53475033U        /**< "SGP3" */
+#define SHM_VERSION           1                  /**< region layout version */
+#define SHM_MAX_SLOT          64                 /**< max sensor slot */
+#define SHM_READ_RETRY        1000               /**< reader retries before it gives up */
+
+/**
+ * @brief shm sample state enumeration definition
+ */
+typedef enum
+{
+    SHM_STATE_NONE    = 0x00,        /**< nothing is published yet */
+    SHM_STATE_WARMUP  = 0x01,        /**< iaq init warm-up, the chip returns fixed values */
+    SHM_STATE_VALID   = 0x02,        /**< valid sample */
+    SHM_STATE_FAILED  = 0x03,        /**< the last read failed, the values are the last good ones */
+    SHM_STATE_STOPPED = 0x04,        /**< the publisher has exited */
+} shm_state_t;
+
+/**
+ * @brief shm sample structure definition
+ */
+typedef struct shm_sample_s
+{
+    uint64_t seq;                   /**< sample number of the slot */
+    uint64_t timestamp_ns;          /**< CLOCK_MONOTONIC time of the read */
+    uint8_t state;                  /**< shm_state_t */
+    uint16_t co2_eq_ppm;            /**< co2 eq */
+    uint16_t tvoc_ppb;              /**< tvoc */
+} shm_sample_t;
+
+/**
+ * @brief shm slot structure definition
+ */
+typedef struct shm_slot_s
+{
+    uint32_t lock;                  /**< seqlock, odd while the writer is inside */
+    uint32_t state;                 /**< shm_state_t */
+    uint64_t seq;                   /**< sample number */
+    uint64_t timestamp_ns;          /**< CLOCK_MONOTONIC time of the read */
+    uint32_t co2_eq_ppm;            /**< co2 eq */
+    uint32_t tvoc_ppb;              /**< tvoc */
+    uint8_t reserved[32];           /**< pad to one cache line */
+} shm_slot_t;
+
+/**
+ * @brief shm region header structure definition
+ */
+typedef struct shm_header_s
+{
+    uint32_t magic;                 /**< SHM_MAGIC */
+    uint32_t version;               /**< SHM_VERSION */
+    uint32_t slots;                 /**< slot number */
+    uint32_t slot_size;             /**< sizeof(shm_slot_t) */
+    uint32_t pid;                   /**< publisher pid */
+    uint8_t reserved[44];           /**< pad to one cache line */
+} shm_header_t;
+
+/**
+ * @brief shm writer structure definition
+ */
+typedef struct shm_writer_s
+{
+    char name[64];                  /**< shm object name */
+    int fd;                         /**< shm object handle */
+    void *region;                   /**< mapped region */
+    size_t size;                    /**< region size */
+    uint32_t slots;                 /**< slot number */
+} shm_writer_t;
+
+/**
+ * @brief shm reader structure definition
+ */
+typedef struct shm_reader_s
+{
+    const void *region;             /**< mapped region */
+    size_t size;                    /**< region size */
+    uint32_t slots;                 /**< slot number */
+} shm_reader_t;
+
+/**
+ * @brief     shm writer open
+ * @param[in] *writer pointer to a shm writer structure
+ * @param[in] *name pointer to a shm object name such as "/sgp30"
+ * @param[in] slots sensor slot number
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the object is created readable by every user and all slots start as SHM_STATE_NONE,
+ *            there must be only one writer per object
+ */
+uint8_t shm_writer_open(shm_writer_t *writer, const char *name, uint32_t slots);
+
+/**
+ * @brief     shm publish a sample
+ * @param[in] *writer pointer to a shm writer structure
+ * @param[in] slot sensor slot
+ * @param[in] *sample pointer to a sample, its seq is ignored and counted by the slot
+ * @return    status code
+ *            - 0 success
+ *            - 1 slot is invalid
+ * @note      the writer never waits for a reader, a reader inside the slot simply retries,
+ *            a SHM_STATE_FAILED sample keeps the last values of the slot
+ */
+uint8_t shm_publish(shm_writer_t *writer, uint32_t slot, const shm_sample_t *sample);
+
+/**
+ * @brief     shm writer close
+ * @param[in] *writer pointer to a shm writer structure
+ * @param[in] unlink 1 removes the object, 0 leaves it for the readers
+ * @note      every slot is marked as SHM_STATE_STOPPED first
+ */
+void shm_writer_close(shm_writer_t *writer, uint8_t unlink);
+
+/**
+ * @brief     shm reader open
+ * @param[in] *reader pointer to a shm reader structure
+ * @param[in] *name pointer to a shm object name such as "/sgp30"
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the region is mapped read only, the fd is closed at once
+ */
+uint8_t shm_reader_open(shm_reader_t *reader, const char *name);
+
+/**
+ * @brief      shm read the latest sample of a slot
+ * @param[in]  *reader pointer to a shm reader structure
+ * @param[in]  slot sensor slot
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 slot is invalid
+ *             - 2 the writer stayed inside the slot for SHM_READ_RETRY retries
+ * @note       no syscall and no lock, the copy is retried while the writer is inside the slot
+ */
+uint8_t shm_read(const shm_reader_t *reader, uint32_t slot, shm_sample_t *sample);
+
+/**
+ * @brief     shm reader close
+ * @param[in] *reader pointer to a shm reader structure
+ * @note      none
+ */
+void shm_reader_close(shm_reader_t *reader);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
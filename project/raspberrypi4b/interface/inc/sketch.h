@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sketch.h
+ * @brief     sketch header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sketch sketch function
+ * @brief    sketch function modules
+ * @{
+ */
+
+/**
+ * @brief sketch definition
+ */
+#define SKETCH_ALPHA             0.01               /**< relative accuracy */
+#define SKETCH_BIN               562                /**< ceil(ln(65535) / ln((1 + a) / (1 - a))) + 1 bins */
+#define SKETCH_MAGIC             0x51504753U        /**< "SGPQ" */
+#define SKETCH_MAX_ENCODED       (12 + 10 + SKETCH_BIN * 12)        /**< max encoded bytes */
+
+/**
+ * @brief sketch structure definition
+ * @note  a ddsketch over the 16 bits values, bin i counts the values in (g^(i-1), g^i]
+ *        with g = (1 + a) / (1 - a), 0 has its own counter
+ */
+typedef struct sketch_s
+{
+    uint64_t count;                 /**< value number */
+    uint64_t zero;                  /**< zero values */
+    uint16_t min;                   /**< exact min */
+    uint16_t max;                   /**< exact max */
+    uint16_t lo;                    /**< lowest used bin */
+    uint16_t hi;                    /**< highest used bin */
+    uint64_t bin[SKETCH_BIN];       /**< bin counts, as wide as count so merges do not wrap */
+} sketch_t;
+
+/**
+ * @brief sketch ring structure definition
+ */
+typedef struct sketch_ring_s
+{
+    uint64_t bucket_ms;         /**< bucket length */
+    uint32_t buckets;           /**< bucket number */
+    uint64_t *start;            /**< bucket start times, UINT64_MAX means unused */
+    sketch_t *sketch;           /**< one sketch per bucket */
+} sketch_ring_t;
+
+/**
+ * @brief     sketch clear
+ * @param[in] *sketch pointer to a sketch structure
+ * @note      none
+ */
+void sketch_clear(sketch_t *sketch);
+
+/**
+ * @brief     sketch add a value
+ * @param[in] *sketch pointer to a sketch structure
+ * @param[in] value value
+ * @note      none
+ */
+void sketch_add(sketch_t *sketch, uint16_t value);
+
+/**
+ * @brief     sketch merge a sketch into another
+ * @param[in] *dst pointer to the sketch merged into
+ * @param[in] *src pointer to the sketch merged
+ * @note      the result is the sketch of both streams, the error bound stays the same
+ */
+void sketch_merge(sketch_t *dst, const sketch_t *src);
+
+/**
+ * @brief      sketch get a quantile
+ * @param[in]  *sketch pointer to a sketch structure
+ * @param[in]  q quantile in [0, 1]
+ * @param[out] *value pointer to the quantile
+ * @return     status code
+ *             - 0 success
+ *             - 1 sketch is empty or q is invalid
+ * @note       for the value v of rank floor(q * (count - 1)) the result is within SKETCH_ALPHA * v,
+ *             0 is exact and the result is clamped to the exact min and max
+ */
+uint8_t sketch_quantile(const sketch_t *sketch, double q, double *value);
+
+/**
+ * @brief      sketch encode
+ * @param[in]  *sketch pointer to a sketch structure
+ * @param[out] *buf pointer to a buffer of SKETCH_MAX_ENCODED bytes
+ * @return     encoded bytes
+ * @note       only the used bins are written, so a sketch can be sent to be merged elsewhere
+ */
+uint32_t sketch_encode(const sketch_t *sketch, uint8_t *buf);
+
+/**
+ * @brief      sketch decode
+ * @param[in]  *buf pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *sketch pointer to a sketch structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed or has another accuracy
+ * @note       none
+ */
+uint8_t sketch_decode(const uint8_t *buf, uint32_t len, sketch_t *sketch);
+
+/**
+ * @brief     sketch ring init
+ * @param[in] *ring pointer to a sketch ring structure
+ * @param[in] buckets bucket number
+ * @param[in] bucket_ms bucket length
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the ring covers buckets * bucket_ms of history
+ */
+uint8_t sketch_ring_init(sketch_ring_t *ring, uint32_t buckets, uint64_t bucket_ms);
+
+/**
+ * @brief     sketch ring add a value
+ * @param[in] *ring pointer to a sketch ring structure
+ * @param[in] timestamp_ms value timestamp
+ * @param[in] value value
+ * @note      a bucket is cleared when a new span of time reuses it
+ */
+void sketch_ring_add(sketch_ring_t *ring, uint64_t timestamp_ms, uint16_t value);
+
+/**
+ * @brief      sketch ring merge the buckets of a window
+ * @param[in]  *ring pointer to a sketch ring structure
+ * @param[in]  now_ms window end
+ * @param[in]  window_ms window length
+ * @param[out] *sketch pointer to a sketch structure
+ * @note       the buckets that start in (now_ms - window_ms, now_ms] are merged, so the window
+ *             is rounded to whole buckets
+ */
+void sketch_ring_window(const sketch_ring_t *ring, uint64_t now_ms, uint64_t window_ms, sketch_t *sketch);
+
+/**
+ * @brief     sketch ring deinit
+ * @param[in] *ring pointer to a sketch ring structure
+ * @note      none
+ */
+void sketch_ring_deinit(sketch_ring_t *ring);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
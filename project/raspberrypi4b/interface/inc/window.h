@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      window.h
+ * @brief     window header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WINDOW_H
+#define WINDOW_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup window window function
+ * @brief    window function modules
+ * @{
+ */
+
+/**
+ * @brief window definition
+ */
+#define WINDOW_CHANNEL           4        /**< co2 eq, tvoc, h2 raw and ethanol raw */
+#define WINDOW_MAX_WINDOW        8        /**< max windows of one engine */
+
+/**
+ * @brief window engine structure definition
+ * @note  every array is one block of the arena, indexed sensor first, so one push walks
+ *        contiguous memory, the sample history of a sensor is shared by all its windows
+ */
+typedef struct window_s
+{
+    uint32_t sensors;                               /**< sensor number */
+    uint32_t windows;                               /**< window number */
+    uint32_t cap;                                   /**< history ring size of a sensor */
+    uint32_t mask;                                  /**< history ring mask */
+    uint32_t total;                                 /**< deque slots of a sensor channel */
+    uint64_t length_ms[WINDOW_MAX_WINDOW];          /**< window lengths */
+    uint32_t window_cap[WINDOW_MAX_WINDOW];         /**< max samples of every window */
+    uint32_t window_mask[WINDOW_MAX_WINDOW];        /**< deque ring mask of every window */
+    uint32_t window_off[WINDOW_MAX_WINDOW];         /**< deque offset of every window */
+    void *arena;                                    /**< one allocation for all arrays */
+    uint64_t *ts;                                   /**< [sensor][cap] timestamps */
+    uint16_t *value;                                /**< [sensor][channel][cap] values */
+    uint32_t *head;                                 /**< [sensor] next sample sequence */
+    uint32_t *tail;                                 /**< [sensor][window] oldest sample sequence */
+    uint64_t *sum;                                  /**< [sensor][window][channel] sum */
+    uint64_t *sumsq;                                /**< [sensor][window][channel] sum of squares */
+    uint32_t *min_front;                            /**< [sensor][window][channel] min deque front */
+    uint32_t *min_back;                             /**< [sensor][window][channel] min deque back */
+    uint32_t *max_front;                            /**< [sensor][window][channel] max deque front */
+    uint32_t *max_back;                             /**< [sensor][window][channel] max deque back */
+    uint32_t *min_q;                                /**< [sensor][channel][total] min deque sequences */
+    uint32_t *max_q;                                /**< [sensor][channel][total] max deque sequences */
+} window_t;
+
+/**
+ * @brief window stat structure definition
+ */
+typedef struct window_stat_s
+{
+    uint32_t count;         /**< samples in the window */
+    uint64_t sum;           /**< sum */
+    double mean;            /**< mean */
+    uint16_t min;           /**< min */
+    uint16_t max;           /**< max */
+    double variance;        /**< population variance */
+} window_stat_t;
+
+/**
+ * @brief     window init
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensors sensor number
+ * @param[in] *length_ms pointer to the window lengths
+ * @param[in] windows window number
+ * @param[in] period_ms shortest sample period
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      a window holds length_ms / period_ms + 1 samples at most, a faster stream keeps
+ *            only the newest of them, all memory is allocated here
+ */
+uint8_t window_init(window_t *window, uint32_t sensors, const uint64_t *length_ms, uint32_t windows, uint32_t period_ms);
+
+/**
+ * @brief     window push a sample of a sensor
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensor sensor index
+ * @param[in] timestamp_ms sample timestamp
+ * @param[in] *value pointer to WINDOW_CHANNEL values
+ * @return    status code
+ *            - 0 success
+ *            - 1 push failed
+ *            - 2 timestamp goes back
+ * @note      amortized O(1) per window and channel, samples older than a window length
+ *            before this one leave the window
+ */
+uint8_t window_push(window_t *window, uint32_t sensor, uint64_t timestamp_ms, const uint16_t *value);
+
+/**
+ * @brief      window get the stat of a window
+ * @param[in]  *window pointer to a window engine structure
+ * @param[in]  sensor sensor index
+ * @param[in]  index window index
+ * @param[in]  channel channel index
+ * @param[out] *stat pointer to a window stat structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       O(1), an empty window gives a zero stat
+ */
+uint8_t window_get(window_t *window, uint32_t sensor, uint32_t index, uint32_t channel, window_stat_t *stat);
+
+/**
+ * @brief     window reset the windows of a sensor
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensor sensor index
+ * @return    status code
+ *            - 0 success
+ *            - 1 reset failed
+ * @note      none
+ */
+uint8_t window_reset(window_t *window, uint32_t sensor);
+
+/**
+ * @brief     window deinit
+ * @param[in] *window pointer to a window engine structure
+ * @note      none
+ */
+void window_deinit(window_t *window);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,537 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      archive.c
+ * @brief     archive source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "archive.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief     archive find the first chunk which may hold a timestamp
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] start_ms timestamp
+ * @return    chunk index
+ * @note      the index is searched by the last timestamp when the chunks are sorted
+ */
+static uint32_t a_archive_find(archive_t *archive, uint64_t start_ms)
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    
+    if (archive->sorted == 0)
+    {
+        return 0;
+    }
+    lo = 0;
+    hi = archive->chunks;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (archive->index[mid].chunk.last_ts < start_ms)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    
+    return lo;
+}
+
+/**
+ * @brief     archive find the first decoded sample at or after a timestamp
+ * @param[in] *sample pointer to the decoded samples
+ * @param[in] count sample number
+ * @param[in] ts timestamp
+ * @return    sample index
+ * @note      none
+ */
+static uint32_t a_archive_lower_bound(const series_sample_t *sample, uint32_t count, uint64_t ts)
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    
+    lo = 0;
+    hi = count;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (sample[mid].timestamp_ms < ts)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    
+    return lo;
+}
+
+/**
+ * @brief     archive check a chunk
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] i chunk index
+ * @return    status code
+ *            - 0 success
+ *            - 1 chunk is corrupted
+ * @note      the result is kept in the index
+ */
+static uint8_t a_archive_check(archive_t *archive, uint32_t i)
+{
+    archive_index_t *entry;
+    const uint8_t *header;
+    
+    entry = &archive->index[i];
+    if (entry->state == ARCHIVE_CHUNK_UNCHECKED)
+    {
+        header = archive->map + entry->offset;
+        if (series_chunk_check(header, header + SERIES_CHUNK_HEADER_SIZE, &entry->chunk) != 0)
+        {
+            entry->state = ARCHIVE_CHUNK_CORRUPTED;
+        }
+        else
+        {
+            entry->state = ARCHIVE_CHUNK_VALID;
+        }
+    }
+    
+    return (entry->state == ARCHIVE_CHUNK_VALID) ? 0 : 1;
+}
+
+/**
+ * @brief     archive decode a chunk into the decode buffer
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] i chunk index
+ * @return    status code
+ *            - 0 success
+ *            - 1 chunk is corrupted
+ * @note      the last decoded chunk is kept
+ */
+static uint8_t a_archive_load(archive_t *archive, uint32_t i)
+{
+    archive_index_t *entry;
+    
+    if (archive->decoded == (int32_t)i)
+    {
+        return 0;
+    }
+    if (a_archive_check(archive, i) != 0)
+    {
+        return 1;
+    }
+    entry = &archive->index[i];
+    archive->decoded = -1;
+    if (series_chunk_decode(&entry->chunk, archive->map + entry->offset + SERIES_CHUNK_HEADER_SIZE,
+                            archive->sample) != 0)
+    {
+        entry->state = ARCHIVE_CHUNK_CORRUPTED;
+        
+        return 1;
+    }
+    archive->decoded = (int32_t)i;
+    
+    return 0;
+}
+
+/**
+ * @brief     archive search the next chunk magic
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] offset file offset to search from
+ * @return    offset of the next magic, the file size when no magic is left
+ * @note      none
+ */
+static uint64_t a_archive_resync(const archive_t *archive, uint64_t offset)
+{
+    const uint8_t *p;
+    
+    while ((offset + SERIES_CHUNK_HEADER_SIZE) <= archive->size)
+    {
+        p = archive->map + offset;
+        if (((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24)) ==
+            SERIES_CHUNK_MAGIC)
+        {
+            return offset;
+        }
+        offset++;
+    }
+    
+    return archive->size;
+}
+
+/**
+ * @brief     archive open
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] *path pointer to a series file path
+ * @param[in] verify 1 checks the crc of every chunk now, 0 checks a chunk when it is decoded
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the file is mapped and only the chunk headers are read to build the index,
+ *            a broken header is skipped up to the next SERIES_CHUNK_MAGIC, and a chunk that is not
+ *            followed by a valid header gets its crc checked so a torn one does not hide the next
+ */
+uint8_t archive_open(archive_t *archive, const char *path, uint8_t verify)
+{
+    struct stat st;
+    archive_index_t *entry;
+    void *index;
+    series_chunk_t next_chunk;
+    void *map;
+    uint64_t offset;
+    uint64_t next;
+    uint64_t last_ts;
+    uint32_t capacity;
+    
+    memset(archive, 0, sizeof(archive_t));
+    archive->decoded = -1;
+    archive->sorted = 1;
+    archive->fd = open(path, O_RDONLY);
+    if (archive->fd < 0)
+    {
+        perror("archive: open failed.\n");
+        
+        return 1;
+    }
+    if ((fstat(archive->fd, &st) != 0) || (st.st_size < SERIES_FILE_HEADER_SIZE))
+    {
+        printf("archive: file is not a series file.\n");
+        archive_close(archive);
+        
+        return 1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, archive->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("archive: mmap failed.\n");
+        archive_close(archive);
+        
+        return 1;
+    }
+    archive->map = (const uint8_t *)map;
+    archive->size = (size_t)st.st_size;
+    if (series_file_check(archive->map) != 0)
+    {
+        printf("archive: file is not a series file.\n");
+        archive_close(archive);
+        
+        return 1;
+    }
+    archive->sample = (series_sample_t *)malloc(sizeof(series_sample_t) * SERIES_MAX_CHUNK);
+    if (archive->sample == NULL)
+    {
+        archive_close(archive);
+        
+        return 1;
+    }
+    
+    /* walk the chunk headers, the payloads are not touched */
+    capacity = 0;
+    last_ts = 0;
+    offset = SERIES_FILE_HEADER_SIZE;
+    while ((offset + SERIES_CHUNK_HEADER_SIZE) <= archive->size)
+    {
+        if (archive->chunks == capacity)
+        {
+            capacity = (capacity == 0) ? 64 : capacity * 2;
+            index = realloc(archive->index, sizeof(archive_index_t) * capacity);
+            if (index == NULL)
+            {
+                archive_close(archive);
+                
+                return 1;
+            }
+            archive->index = (archive_index_t *)index;
+        }
+        entry = &archive->index[archive->chunks];
+        entry->offset = offset;
+        entry->state = ARCHIVE_CHUNK_UNCHECKED;
+        if ((series_chunk_parse(archive->map + offset, &entry->chunk) != 0) ||
+            ((offset + SERIES_CHUNK_HEADER_SIZE + entry->chunk.payload_len) > archive->size))
+        {
+            next = a_archive_resync(archive, offset + 1);
+            archive->tail_bytes += next - offset;
+            offset = next;
+            
+            continue;
+        }
+        
+        /* a torn chunk runs over the chunks after it, so the chain breaks behind it */
+        next = offset + SERIES_CHUNK_HEADER_SIZE + entry->chunk.payload_len;
+        if ((next != archive->size) && (((next + SERIES_CHUNK_HEADER_SIZE) > archive->size) ||
+            (series_chunk_parse(archive->map + next, &next_chunk) != 0)))
+        {
+            if (a_archive_check(archive, archive->chunks) != 0)
+            {
+                next = a_archive_resync(archive, offset + 1);
+                archive->tail_bytes += next - offset;
+                offset = next;
+                
+                continue;
+            }
+        }
+        else if (verify != 0)
+        {
+            (void)a_archive_check(archive, archive->chunks);
+        }
+        
+        /* an appended run that goes back in time makes the index unsorted */
+        if (archive->chunks == 0)
+        {
+            archive->first_ts = entry->chunk.first_ts;
+        }
+        else if (entry->chunk.first_ts < last_ts)
+        {
+            archive->sorted = 0;
+        }
+        if (entry->chunk.first_ts < archive->first_ts)
+        {
+            archive->first_ts = entry->chunk.first_ts;
+        }
+        if (entry->chunk.last_ts > last_ts)
+        {
+            last_ts = entry->chunk.last_ts;
+        }
+        archive->samples += entry->chunk.count;
+        archive->chunks++;
+        offset = next;
+    }
+    archive->last_ts = last_ts;
+    archive->tail_bytes += archive->size - offset;
+    
+    return 0;
+}
+
+/**
+ * @brief     archive query the samples in a time range
+ * @param[in] *archive pointer to an archive structure
+ * @param[in] start_ms first timestamp in the range
+ * @param[in] end_ms timestamp after the range
+ * @param[in] callback called with runs of samples in time order
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 query failed
+ *            - 2 stopped by the callback
+ * @note      only the chunks that overlap the range are decoded, corrupted chunks are skipped,
+ *            a non zero return of the callback stops the query
+ */
+uint8_t archive_query(archive_t *archive, uint64_t start_ms, uint64_t end_ms, archive_callback_t callback, void *arg)
+{
+    const series_chunk_t *chunk;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t i;
+    
+    if ((archive->map == NULL) || (callback == NULL))
+    {
+        return 1;
+    }
+    for (i = a_archive_find(archive, start_ms); i < archive->chunks; i++)
+    {
+        chunk = &archive->index[i].chunk;
+        if ((archive->sorted != 0) && (chunk->first_ts >= end_ms))
+        {
+            break;
+        }
+        if ((chunk->last_ts < start_ms) || (chunk->first_ts >= end_ms))
+        {
+            continue;
+        }
+        if (a_archive_load(archive, i) != 0)
+        {
+            continue;
+        }
+        lo = a_archive_lower_bound(archive->sample, chunk->count, start_ms);
+        hi = a_archive_lower_bound(archive->sample, chunk->count, end_ms);
+        if ((hi > lo) && (callback(&archive->sample[lo], hi - lo, arg) != 0))
+        {
+            return 2;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      archive aggregate a time range
+ * @param[in]  *archive pointer to an archive structure
+ * @param[in]  start_ms first timestamp in the range
+ * @param[in]  end_ms timestamp after the range
+ * @param[out] *aggregate pointer to an archive aggregate structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 aggregate failed
+ * @note       a chunk inside the range is answered by its summary, only the chunks cut by
+ *             the range edges are decoded, min and max are 0 if the range is empty,
+ *             the crc of a chunk is checked before its summary is used and the result is kept,
+ *             so the first call reads the payloads at crc speed and later calls read only the index
+ */
+uint8_t archive_aggregate(archive_t *archive, uint64_t start_ms, uint64_t end_ms, archive_aggregate_t *aggregate)
+{
+    archive_index_t *entry;
+    const series_chunk_t *chunk;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t i;
+    uint32_t j;
+    uint32_t c;
+    
+    if (archive->map == NULL)
+    {
+        return 1;
+    }
+    memset(aggregate, 0, sizeof(archive_aggregate_t));
+    for (c = 0; c < SERIES_CHANNEL; c++)
+    {
+        aggregate->min[c] = 0xFFFF;
+    }
+    for (i = a_archive_find(archive, start_ms); i < archive->chunks; i++)
+    {
+        entry = &archive->index[i];
+        chunk = &entry->chunk;
+        if ((archive->sorted != 0) && (chunk->first_ts >= end_ms))
+        {
+            break;
+        }
+        if ((chunk->last_ts < start_ms) || (chunk->first_ts >= end_ms))
+        {
+            continue;
+        }
+        
+        /* the summary is trusted only after the crc, the result is kept in the index */
+        if (a_archive_check(archive, i) != 0)
+        {
+            aggregate->corrupted_chunks++;
+            
+            continue;
+        }
+        
+        /* a whole chunk is answered by its header */
+        if ((chunk->first_ts >= start_ms) && (chunk->last_ts < end_ms))
+        {
+            aggregate->count += chunk->count;
+            for (c = 0; c < SERIES_CHANNEL; c++)
+            {
+                aggregate->sum[c] += chunk->sum[c];
+                if (chunk->min[c] < aggregate->min[c])
+                {
+                    aggregate->min[c] = chunk->min[c];
+                }
+                if (chunk->max[c] > aggregate->max[c])
+                {
+                    aggregate->max[c] = chunk->max[c];
+                }
+            }
+            aggregate->summary_chunks++;
+            
+            continue;
+        }
+        
+        /* an edge chunk is decoded */
+        if (a_archive_load(archive, i) != 0)
+        {
+            aggregate->corrupted_chunks++;
+            
+            continue;
+        }
+        lo = a_archive_lower_bound(archive->sample, chunk->count, start_ms);
+        hi = a_archive_lower_bound(archive->sample, chunk->count, end_ms);
+        for (j = lo; j < hi; j++)
+        {
+            for (c = 0; c < SERIES_CHANNEL; c++)
+            {
+                aggregate->sum[c] += archive->sample[j].value[c];
+                if (archive->sample[j].value[c] < aggregate->min[c])
+                {
+                    aggregate->min[c] = archive->sample[j].value[c];
+                }
+                if (archive->sample[j].value[c] > aggregate->max[c])
+                {
+                    aggregate->max[c] = archive->sample[j].value[c];
+                }
+            }
+        }
+        aggregate->count += hi - lo;
+        aggregate->decoded_chunks++;
+    }
+    for (c = 0; c < SERIES_CHANNEL; c++)
+    {
+        if (aggregate->count == 0)
+        {
+            aggregate->min[c] = 0;
+        }
+        else
+        {
+            aggregate->avg[c] = (double)aggregate->sum[c] / (double)aggregate->count;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     archive close
+ * @param[in] *archive pointer to an archive structure
+ * @note      none
+ */
+void archive_close(archive_t *archive)
+{
+    if (archive->map != NULL)
+    {
+        (void)munmap((void *)archive->map, archive->size);
+        archive->map = NULL;
+    }
+    if (archive->fd >= 0)
+    {
+        (void)close(archive->fd);
+        archive->fd = -1;
+    }
+    free(archive->index);
+    archive->index = NULL;
+    free(archive->sample);
+    archive->sample = NULL;
+    archive->chunks = 0;
+    archive->decoded = -1;
+}
@@ -0,0 +1,1709 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.c
+ * @brief     bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "bench.h"
+#include "iic.h"
+#include "driver_sgp30_interface.h"
+#include "series.h"
+#include "archive.h"
+#include "rawcodec.h"
+#include "window.h"
+#include "sketch.h"
+#include "detect.h"
+#include "driver_sgp30_convert.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_MAX_CHANNEL        8             /**< max mux channel */
+#define BENCH_MEASURE_WAIT_MS    12            /**< measure iaq execution time */
+#define BENCH_LOCK_WORKER        2             /**< workers sharing one handle */
+#define BENCH_LOCK_HOLD_US       200           /**< simulated transfer of the other device */
+#define BENCH_LOCK_PERIOD_US     1000          /**< poll period of the other device */
+#define BENCH_RAW_DECODE_VALUES  50000000      /**< decoded values per timed run */
+#define BENCH_DETECT_PERIOD      1800          /**< samples between injected events */
+#define BENCH_DETECT_LENGTH      120           /**< samples of an injected event */
+#define BENCH_DETECT_MATCH_MS    60000         /**< a detection this close to an onset is a hit */
+#define BENCH_CONVERT_SAMPLES    (1 << 20)     /**< samples of a convert round */
+#define BENCH_CONVERT_TEMP       2501          /**< temperature steps of 0.05 degrees from -40 */
+#define BENCH_CONVERT_RH         201           /**< relative humidity steps of 0.5 % from 0 */
+
+/**
+ * @brief bench lock worker structure definition
+ */
+typedef struct bench_lock_worker_s
+{
+    pthread_t thread;        /**< thread */
+    uint32_t rounds;         /**< measure rounds */
+    uint32_t ops;            /**< finished operations */
+    uint32_t errors;         /**< failed operations */
+} bench_lock_worker_t;
+
+/**
+ * @brief bench lock device structure definition
+ */
+typedef struct bench_lock_device_s
+{
+    pthread_t thread;            /**< thread */
+    int fd;                      /**< iic handle, -1 simulates the transfer */
+    uint8_t addr;                /**< iic write address */
+    volatile uint8_t stop;       /**< stop flag */
+    uint32_t count;              /**< transfers */
+    uint32_t errors;             /**< failed transfers */
+    uint64_t wait_us;            /**< total lock wait */
+    uint64_t wait_max_us;        /**< max lock wait */
+} bench_lock_device_t;
+
+/**
+ * @brief bench raw trace structure definition
+ */
+typedef struct bench_raw_trace_s
+{
+    uint16_t *value[2];        /**< h2 raw and ethanol raw */
+    uint32_t count;            /**< samples */
+    uint32_t capacity;         /**< allocated samples */
+} bench_raw_trace_t;
+
+/**
+ * @brief bench detect result structure definition
+ */
+typedef struct bench_detect_result_s
+{
+    int64_t *last;                 /**< [sensor] last event already detected */
+    uint32_t hits;                 /**< detected events */
+    uint32_t false_alarms;         /**< starts away from any event */
+    uint64_t latency_ms;           /**< total latency from the true onset */
+    uint64_t latency_max_ms;       /**< max latency from the true onset */
+} bench_detect_result_t;
+
+/**
+ * @brief bench lock handle definition
+ */
+static sgp30_handle_t gs_lock_handle;        /**< shared sgp30 handle */
+
+/**
+ * @brief  bench get the monotonic time
+ * @return time in microseconds
+ * @note   none
+ */
+static uint64_t a_bench_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     bench run one round with one ioctl per message
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] mux_addr iic mux write address, 0 means no mux
+ * @param[in] channel mux channel number
+ * @param[in] *buf pointer to a read buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_bench_single(int fd, uint8_t addr, uint8_t mux_addr, uint8_t channel, uint8_t (*buf)[6])
+{
+    uint8_t cmd[2] = {0x20, 0x08};
+    uint8_t sel;
+    uint8_t i;
+    uint8_t res;
+    
+    /* start the measurement on every channel */
+    res = 0;
+    for (i = 0; i < channel; i++)
+    {
+        if (mux_addr != 0)
+        {
+            sel = (uint8_t)(1 << i);
+            res |= iic_write_cmd(fd, mux_addr, &sel, 1);
+        }
+        res |= iic_write_cmd(fd, addr, cmd, 2);
+    }
+    
+    /* wait the conversion */
+    usleep(BENCH_MEASURE_WAIT_MS * 1000);
+    
+    /* read every channel */
+    for (i = 0; i < channel; i++)
+    {
+        if (mux_addr != 0)
+        {
+            sel = (uint8_t)(1 << i);
+            res |= iic_write_cmd(fd, mux_addr, &sel, 1);
+        }
+        res |= iic_read_cmd(fd, addr, buf[i], 6);
+    }
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     bench run one round with the batch api
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] mux_addr iic mux write address, 0 means no mux
+ * @param[in] channel mux channel number
+ * @param[in] *buf pointer to a read buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_bench_batch(int fd, uint8_t addr, uint8_t mux_addr, uint8_t channel, uint8_t (*buf)[6])
+{
+    static iic_batch_t batch;
+    uint8_t cmd[2] = {0x20, 0x08};
+    uint8_t sel[BENCH_MAX_CHANNEL];
+    uint8_t i;
+    uint8_t res;
+    
+    /* the mux switches the channel at the stop and the chip runs the command at the stop */
+    iic_batch_init(&batch);
+    for (i = 0; i < channel; i++)
+    {
+        sel[i] = (uint8_t)(1 << i);
+        if (mux_addr != 0)
+        {
+            (void)iic_batch_add_write(&batch, mux_addr, &sel[i], 1, 1);
+        }
+        (void)iic_batch_add_write(&batch, addr, cmd, 2, 1);
+    }
+    res = iic_batch_submit(fd, &batch);
+    
+    /* wait the conversion */
+    usleep(BENCH_MEASURE_WAIT_MS * 1000);
+    
+    /* read every channel */
+    for (i = 0; i < channel; i++)
+    {
+        if (mux_addr != 0)
+        {
+            (void)iic_batch_add_write(&batch, mux_addr, &sel[i], 1, 1);
+        }
+        (void)iic_batch_add_read(&batch, addr, buf[i], 6, 1);
+    }
+    res |= iic_batch_submit(fd, &batch);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      bench the batched iic transfer against one ioctl per message
+ * @param[in]  *name pointer to an iic device name buffer
+ * @param[in]  addr iic device write address
+ * @param[in]  mux_addr iic mux write address, 0 means no mux
+ * @param[in]  channel mux channel number
+ * @param[in]  rounds polling rounds
+ * @return     status code
+ *             - 0 success
+ *             - 1 bench failed
+ * @note       one round starts a measurement on every channel, waits 12 ms and reads every channel,
+ *             ioctls and bus time per round are printed for both modes
+ */
+uint8_t bench_iic_batch(char *name, uint8_t addr, uint8_t mux_addr, uint8_t channel, uint32_t rounds)
+{
+    const char *mode[2] = {"single", "batch"};
+    uint8_t buf[BENCH_MAX_CHANNEL][6];
+    uint64_t ioctls;
+    uint64_t start;
+    uint64_t us;
+    uint32_t failed;
+    uint32_t i;
+    uint8_t m;
+    uint8_t res;
+    int fd;
+    
+    /* check the param */
+    if ((rounds == 0) || (channel == 0) || (channel > BENCH_MAX_CHANNEL) || ((mux_addr == 0) && (channel != 1)))
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* open the bus */
+    if (iic_init(name, &fd) != 0)
+    {
+        return 1;
+    }
+    
+    for (m = 0; m < 2; m++)
+    {
+        failed = 0;
+        us = 0;
+        ioctls = iic_get_ioctl_count(fd);
+        for (i = 0; i < rounds; i++)
+        {
+            start = a_bench_now_us();
+            if (m == 0)
+            {
+                res = a_bench_single(fd, addr, mux_addr, channel, buf);
+            }
+            else
+            {
+                res = a_bench_batch(fd, addr, mux_addr, channel, buf);
+            }
+            
+            /* the conversion wait is not bus time */
+            us += a_bench_now_us() - start - BENCH_MEASURE_WAIT_MS * 1000;
+            if (res != 0)
+            {
+                failed++;
+            }
+        }
+        ioctls = iic_get_ioctl_count(fd) - ioctls;
+        
+        /* output */
+        printf("bench: %s %d channels, %0.2f ioctls/round, %0.1f us/round, %d failed rounds.\n",
+               mode[m], channel, (double)ioctls / rounds, (double)us / rounds, failed);
+    }
+    
+    /* close the bus */
+    (void)iic_deinit(fd);
+    
+    return 0;
+}
+
+/**
+ * @brief      bench lock worker thread
+ * @param[in]  *arg pointer to a bench lock worker structure
+ * @return     NULL
+ * @note       none
+ */
+static void *a_bench_lock_worker(void *arg)
+{
+    bench_lock_worker_t *worker = (bench_lock_worker_t *)arg;
+    uint16_t co2_eq_ppm;
+    uint16_t tvoc_ppb;
+    uint32_t i;
+    
+    for (i = 0; i < worker->rounds; i++)
+    {
+        if (sgp30_measure_iaq(&gs_lock_handle, &co2_eq_ppm, &tvoc_ppb) != 0)
+        {
+            worker->errors++;
+        }
+        if (sgp30_get_iaq_baseline(&gs_lock_handle, &tvoc_ppb, &co2_eq_ppm) != 0)
+        {
+            worker->errors++;
+        }
+        worker->ops += 2;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief      bench lock peer device thread
+ * @param[in]  *arg pointer to a bench lock device structure
+ * @return     NULL
+ * @note       it reads one byte of its device, or holds the lock for BENCH_LOCK_HOLD_US without a device
+ */
+static void *a_bench_lock_device(void *arg)
+{
+    bench_lock_device_t *device = (bench_lock_device_t *)arg;
+    uint64_t start;
+    uint64_t wait;
+    uint8_t buf;
+    
+    while (device->stop == 0)
+    {
+        start = a_bench_now_us();
+        sgp30_interface_lock();
+        wait = a_bench_now_us() - start;
+        if (device->fd >= 0)
+        {
+            if (iic_read_cmd(device->fd, device->addr, &buf, 1) != 0)
+            {
+                device->errors++;
+            }
+        }
+        else
+        {
+            usleep(BENCH_LOCK_HOLD_US);
+        }
+        sgp30_interface_unlock();
+        device->count++;
+        device->wait_us += wait;
+        if (wait > device->wait_max_us)
+        {
+            device->wait_max_us = wait;
+        }
+        usleep(BENCH_LOCK_PERIOD_US);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     bench the bus lock contention of one shared handle
+ * @param[in] *name pointer to an iic device name buffer
+ * @param[in] peer_addr iic write address of a peer device on the bus, 0 simulates its transfer
+ * @param[in] rounds measure rounds of every worker
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      two workers share one handle and alternate measure iaq and get iaq baseline while
+ *            the peer device polls the bus, it runs with the bus released during the wait first
+ *            and with the bus held as the baseline, and prints the errors, the throughput and
+ *            the lock wait of the peer device
+ */
+uint8_t bench_lock_contention(char *name, uint8_t peer_addr, uint32_t rounds)
+{
+    const char *mode[2] = {"release", "hold"};
+    bench_lock_worker_t worker[BENCH_LOCK_WORKER];
+    bench_lock_device_t device;
+    uint32_t ops;
+    uint32_t errors;
+    uint64_t start;
+    uint64_t us;
+    uint8_t m;
+    uint8_t i;
+    
+    /* check the param */
+    if (rounds == 0)
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link the shared handle */
+    DRIVER_SGP30_LINK_INIT(&gs_lock_handle, sgp30_handle_t);
+    DRIVER_SGP30_LINK_IIC_INIT(&gs_lock_handle, sgp30_interface_iic_init);
+    DRIVER_SGP30_LINK_IIC_DEINIT(&gs_lock_handle, sgp30_interface_iic_deinit);
+    DRIVER_SGP30_LINK_IIC_WRITE_COMMAND(&gs_lock_handle, sgp30_interface_iic_write_cmd);
+    DRIVER_SGP30_LINK_IIC_READ_COMMAND(&gs_lock_handle, sgp30_interface_iic_read_cmd);
+    DRIVER_SGP30_LINK_DELAY_MS(&gs_lock_handle, sgp30_interface_delay_ms);
+    DRIVER_SGP30_LINK_DEBUG_PRINT(&gs_lock_handle, sgp30_interface_debug_print);
+    DRIVER_SGP30_LINK_LOCK(&gs_lock_handle, sgp30_interface_lock);
+    DRIVER_SGP30_LINK_UNLOCK(&gs_lock_handle, sgp30_interface_unlock);
+    
+    /* init the chip */
+    if (sgp30_init(&gs_lock_handle) != 0)
+    {
+        return 1;
+    }
+    if (sgp30_iaq_init(&gs_lock_handle) != 0)
+    {
+        (void)sgp30_deinit(&gs_lock_handle);
+        
+        return 1;
+    }
+    
+    /* the peer device has its own adapter handle */
+    device.fd = -1;
+    if ((peer_addr != 0) && (iic_init(name, &device.fd) != 0))
+    {
+        (void)sgp30_deinit(&gs_lock_handle);
+        
+        return 1;
+    }
+    device.addr = peer_addr;
+    
+    /* the released wait is the contention case, the held wait is its baseline */
+    for (m = 0; m < 2; m++)
+    {
+        (void)sgp30_set_bus_release(&gs_lock_handle, (m == 0) ? 1 : 0);
+        device.stop = 0;
+        device.count = 0;
+        device.errors = 0;
+        device.wait_us = 0;
+        device.wait_max_us = 0;
+        (void)pthread_create(&device.thread, NULL, a_bench_lock_device, &device);
+        start = a_bench_now_us();
+        for (i = 0; i < BENCH_LOCK_WORKER; i++)
+        {
+            worker[i].rounds = rounds;
+            worker[i].ops = 0;
+            worker[i].errors = 0;
+            (void)pthread_create(&worker[i].thread, NULL, a_bench_lock_worker, &worker[i]);
+        }
+        ops = 0;
+        errors = 0;
+        for (i = 0; i < BENCH_LOCK_WORKER; i++)
+        {
+            (void)pthread_join(worker[i].thread, NULL);
+            ops += worker[i].ops;
+            errors += worker[i].errors;
+        }
+        us = a_bench_now_us() - start;
+        device.stop = 1;
+        (void)pthread_join(device.thread, NULL);
+        
+        /* output */
+        printf("bench: %s %d workers, %d ops, %d errors, %0.1f ops/s.\n",
+               mode[m], BENCH_LOCK_WORKER, ops, errors, (double)ops * 1000000.0 / (double)us);
+        printf("bench: %s peer device %d transfers, %d errors, lock wait avg %0.1f us, max %llu us.\n",
+               mode[m], device.count, device.errors,
+               (device.count != 0) ? (double)device.wait_us / device.count : 0.0,
+               (unsigned long long)device.wait_max_us);
+    }
+    
+    /* close */
+    if (device.fd >= 0)
+    {
+        (void)iic_deinit(device.fd);
+    }
+    (void)sgp30_deinit(&gs_lock_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     count the samples of a query
+ * @param[in] *sample pointer to a run of samples
+ * @param[in] count sample number
+ * @param[in] *arg pointer to the counter
+ * @return    status code
+ *            - 0 continue
+ * @note      none
+ */
+static uint8_t a_bench_archive_count(const series_sample_t *sample, uint32_t count, void *arg)
+{
+    (void)sample;
+    *(uint64_t *)arg += count;
+    
+    return 0;
+}
+
+/**
+ * @brief     bench the archive queries against a scan of the samples
+ * @param[in] *path pointer to the series file path
+ * @param[in] *in pointer to the written samples
+ * @param[in] samples sample number
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      a one hour query, a one hour aggregate and an aggregate of the whole file are timed
+ */
+static uint8_t a_bench_archive(const char *path, const series_sample_t *in, uint32_t samples)
+{
+    archive_t archive;
+    archive_aggregate_t aggregate;
+    uint64_t range[2][2];
+    uint64_t sum[SERIES_CHANNEL];
+    uint16_t min[SERIES_CHANNEL];
+    uint16_t max[SERIES_CHANNEL];
+    uint64_t start;
+    uint64_t open_us;
+    uint64_t query_us;
+    uint64_t count;
+    uint64_t n;
+    uint32_t r;
+    uint32_t i;
+    uint32_t c;
+    uint8_t res;
+    
+    start = a_bench_now_us();
+    if (archive_open(&archive, path, 0) != 0)
+    {
+        return 1;
+    }
+    open_us = a_bench_now_us() - start;
+    
+    /* one hour starting in the middle of a chunk, then the whole file */
+    i = samples / 2 + 1234;
+    range[0][0] = in[i].timestamp_ms;
+    range[0][1] = in[i].timestamp_ms + 3600000ULL;
+    range[1][0] = 0;
+    range[1][1] = UINT64_MAX;
+    
+    /* the query returns exactly the samples in the range */
+    count = 0;
+    start = a_bench_now_us();
+    res = archive_query(&archive, range[0][0], range[0][1], a_bench_archive_count, &count);
+    query_us = a_bench_now_us() - start;
+    n = 0;
+    for (i = 0; i < samples; i++)
+    {
+        if ((in[i].timestamp_ms >= range[0][0]) && (in[i].timestamp_ms < range[0][1]))
+        {
+            n++;
+        }
+    }
+    if (count != n)
+    {
+        printf("bench: archive query returns %llu samples, expect %llu.\n",
+               (unsigned long long)count, (unsigned long long)n);
+        res = 1;
+    }
+    printf("bench: archive %d chunks indexed in %llu us, 1 h query of %llu samples in %llu us.\n",
+           archive.chunks, (unsigned long long)open_us, (unsigned long long)count, (unsigned long long)query_us);
+    
+    /* the aggregates match a scan */
+    for (r = 0; r < 2; r++)
+    {
+        start = a_bench_now_us();
+        res |= archive_aggregate(&archive, range[r][0], range[r][1], &aggregate);
+        query_us = a_bench_now_us() - start;
+        n = 0;
+        for (c = 0; c < SERIES_CHANNEL; c++)
+        {
+            sum[c] = 0;
+            min[c] = 0xFFFF;
+            max[c] = 0;
+        }
+        for (i = 0; i < samples; i++)
+        {
+            if ((in[i].timestamp_ms < range[r][0]) || (in[i].timestamp_ms >= range[r][1]))
+            {
+                continue;
+            }
+            for (c = 0; c < SERIES_CHANNEL; c++)
+            {
+                sum[c] += in[i].value[c];
+                min[c] = (in[i].value[c] < min[c]) ? in[i].value[c] : min[c];
+                max[c] = (in[i].value[c] > max[c]) ? in[i].value[c] : max[c];
+            }
+            n++;
+        }
+        if ((aggregate.count != n) || (memcmp(aggregate.sum, sum, sizeof(sum)) != 0) ||
+            (memcmp(aggregate.min, min, sizeof(min)) != 0) || (memcmp(aggregate.max, max, sizeof(max)) != 0))
+        {
+            printf("bench: archive aggregate differs from the scan.\n");
+            res = 1;
+        }
+        printf("bench: archive %s aggregate in %llu us, %d chunks by summary, %d decoded.\n",
+               (r == 0) ? "1 h" : "full", (unsigned long long)query_us,
+               aggregate.summary_chunks, aggregate.decoded_chunks);
+    }
+    archive_close(&archive);
+    
+    return res;
+}
+
+/**
+ * @brief     bench the series file format
+ * @param[in] *path pointer to a scratch file path
+ * @param[in] days days of 1 Hz samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      a random walk of the four channels is written, read back and compared,
+ *            bytes per sample and channel, the encode rate and the decode rate are printed,
+ *            the file is kept for the raw codec bench
+ */
+uint8_t bench_series(const char *path, uint32_t days)
+{
+    series_writer_t writer;
+    series_reader_t reader;
+    series_chunk_t chunk;
+    series_sample_t *in;
+    series_sample_t *out;
+    uint16_t value[SERIES_CHANNEL] = {400, 0, 13500, 18500};
+    uint64_t ts;
+    uint64_t start;
+    uint64_t encode_us;
+    uint64_t decode_us;
+    uint32_t samples;
+    uint32_t n;
+    uint32_t i;
+    uint32_t c;
+    uint8_t res;
+    
+    /* check the param */
+    if ((days == 0) || (days > 365))
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    samples = days * 86400;
+    in = (series_sample_t *)malloc(sizeof(series_sample_t) * samples);
+    out = (series_sample_t *)malloc(sizeof(series_sample_t) * samples);
+    if ((in == NULL) || (out == NULL))
+    {
+        free(in);
+        free(out);
+        
+        return 1;
+    }
+    
+    /* 1 Hz with a little jitter, iaq values move rarely and raw values by a few counts */
+    srand(1);
+    ts = (uint64_t)time(NULL) * 1000;
+    for (i = 0; i < samples; i++)
+    {
+        ts += 1000 + (((rand() % 8) == 0) ? (uint64_t)(rand() % 3) : 0);
+        in[i].timestamp_ms = ts;
+        for (c = 0; c < SERIES_CHANNEL; c++)
+        {
+            if ((c >= SERIES_CHANNEL_H2) || ((rand() % 4) == 0))
+            {
+                value[c] = (uint16_t)(value[c] + (rand() % 5) - 2);
+            }
+            in[i].value[c] = value[c];
+        }
+    }
+    
+    /* encode */
+    (void)remove(path);
+    if (series_writer_open(&writer, path, 0) != 0)
+    {
+        free(in);
+        free(out);
+        
+        return 1;
+    }
+    start = a_bench_now_us();
+    res = 0;
+    for (i = 0; i < samples; i++)
+    {
+        res |= series_writer_write(&writer, &in[i]);
+    }
+    res |= series_writer_flush(&writer);
+    encode_us = a_bench_now_us() - start;
+    printf("bench: series %d samples, %llu bytes, %0.3f bytes/sample, %0.3f bytes/channel.\n",
+           samples, (unsigned long long)(writer.bytes + SERIES_FILE_HEADER_SIZE),
+           (double)(writer.bytes + SERIES_FILE_HEADER_SIZE) / samples,
+           (double)(writer.bytes + SERIES_FILE_HEADER_SIZE) / samples / SERIES_CHANNEL);
+    res |= series_writer_close(&writer);
+    
+    /* decode with the crc check */
+    n = 0;
+    decode_us = 0;
+    if (series_reader_open(&reader, path) != 0)
+    {
+        res = 1;
+    }
+    else
+    {
+        while ((n < samples) && (series_reader_next(&reader, &chunk) == 0))
+        {
+            if ((n + chunk.count) > samples)
+            {
+                res = 1;
+                
+                break;
+            }
+            start = a_bench_now_us();
+            res |= series_reader_decode(&reader, &out[n]);
+            decode_us += a_bench_now_us() - start;
+            n += chunk.count;
+        }
+        series_reader_close(&reader);
+    }
+    if ((n != samples) || (memcmp(in, out, sizeof(series_sample_t) * samples) != 0))
+    {
+        printf("bench: series read back differs.\n");
+        res = 1;
+    }
+    if (encode_us == 0)
+    {
+        encode_us = 1;
+    }
+    if (decode_us == 0)
+    {
+        decode_us = 1;
+    }
+    printf("bench: series encode %0.1f Msamples/s, decode %0.1f Msamples/s, %0.1f MB/s of samples.\n",
+           (double)samples / encode_us, (double)samples / decode_us,
+           (double)samples * sizeof(series_sample_t) / decode_us);
+    
+    /* range queries */
+    if (a_bench_archive(path, in, samples) != 0)
+    {
+        res = 1;
+    }
+    
+    /* clean up, the file is kept for the raw codec bench */
+    free(in);
+    free(out);
+    
+    return res;
+}
+
+/**
+ * @brief     collect the raw signals of a query
+ * @param[in] *sample pointer to a run of samples
+ * @param[in] count sample number
+ * @param[in] *arg pointer to a bench raw trace structure
+ * @return    status code
+ *            - 0 continue
+ *            - 1 out of memory
+ * @note      none
+ */
+static uint8_t a_bench_raw_collect(const series_sample_t *sample, uint32_t count, void *arg)
+{
+    bench_raw_trace_t *trace;
+    uint16_t *value;
+    uint32_t capacity;
+    uint32_t i;
+    uint32_t c;
+    
+    trace = (bench_raw_trace_t *)arg;
+    if ((trace->count + count) > trace->capacity)
+    {
+        capacity = (trace->capacity == 0) ? 65536 : trace->capacity;
+        while (capacity < (trace->count + count))
+        {
+            capacity *= 2;
+        }
+        for (c = 0; c < 2; c++)
+        {
+            value = (uint16_t *)realloc(trace->value[c], sizeof(uint16_t) * capacity);
+            if (value == NULL)
+            {
+                return 1;
+            }
+            trace->value[c] = value;
+        }
+        trace->capacity = capacity;
+    }
+    for (i = 0; i < count; i++)
+    {
+        trace->value[0][trace->count + i] = sample[i].value[SERIES_CHANNEL_H2];
+        trace->value[1][trace->count + i] = sample[i].value[SERIES_CHANNEL_ETHANOL];
+    }
+    trace->count += count;
+    
+    return 0;
+}
+
+/**
+ * @brief     time one raw decoder
+ * @param[in] *in pointer to the encoded bytes
+ * @param[in] len encoded bytes
+ * @param[in] *out pointer to a buffer of count values
+ * @param[in] count value number
+ * @param[in] simd 1 means the simd decoder, 0 means the scalar one
+ * @return    decoded values per microsecond, 0 means the decode failed
+ * @note      the trace is decoded again until BENCH_RAW_DECODE_VALUES values are done
+ */
+static double a_bench_raw_decode(const uint8_t *in, uint32_t len, uint16_t *out, uint32_t count, uint8_t simd)
+{
+    uint64_t start;
+    uint64_t us;
+    uint32_t rounds;
+    uint32_t i;
+    uint8_t res;
+    
+    rounds = BENCH_RAW_DECODE_VALUES / count + 1;
+    res = 0;
+    start = a_bench_now_us();
+    for (i = 0; i < rounds; i++)
+    {
+        res |= (simd != 0) ? rawcodec_decode(in, len, out, count) : rawcodec_decode_scalar(in, len, out, count);
+    }
+    us = a_bench_now_us() - start;
+    if (res != 0)
+    {
+        return 0.0;
+    }
+    
+    return (double)count * rounds / ((us == 0) ? 1 : us);
+}
+
+/**
+ * @brief     bench the raw signal codec on a captured trace
+ * @param[in] *path pointer to a series file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      h2 raw and ethanol raw of the file are encoded, decoded by the scalar and the simd
+ *            decoder and compared, the ratio against 16 bits values and the delta varints of the
+ *            series format and the decode rates are printed
+ */
+uint8_t bench_rawcodec(const char *path)
+{
+    static const char *const name[2] = {"h2 raw", "ethanol raw"};
+    bench_raw_trace_t trace;
+    archive_t archive;
+    uint8_t *packed;
+    uint16_t *out;
+    uint64_t varint;
+    uint32_t len;
+    uint32_t zz;
+    uint32_t i;
+    uint32_t c;
+    int32_t delta;
+    double scalar;
+    double simd;
+    uint8_t res;
+    
+    /* load the trace */
+    memset(&trace, 0, sizeof(bench_raw_trace_t));
+    if (archive_open(&archive, path, 1) != 0)
+    {
+        return 1;
+    }
+    res = archive_query(&archive, 0, UINT64_MAX, a_bench_raw_collect, &trace);
+    archive_close(&archive);
+    if ((res != 0) || (trace.count < RAWCODEC_BLOCK))
+    {
+        printf("bench: trace needs %d samples at least.\n", RAWCODEC_BLOCK);
+        free(trace.value[0]);
+        free(trace.value[1]);
+        
+        return 1;
+    }
+    packed = (uint8_t *)malloc(rawcodec_bound(trace.count));
+    out = (uint16_t *)malloc(sizeof(uint16_t) * trace.count);
+    if ((packed == NULL) || (out == NULL))
+    {
+        free(packed);
+        free(out);
+        free(trace.value[0]);
+        free(trace.value[1]);
+        
+        return 1;
+    }
+    
+    printf("bench: rawcodec %d samples, %s decode.\n", trace.count, RAWCODEC_SIMD);
+    for (c = 0; c < 2; c++)
+    {
+        /* the delta varints the series format spends on the channel */
+        varint = 1;
+        for (i = 1; i < trace.count; i++)
+        {
+            delta = (int32_t)trace.value[c][i] - (int32_t)trace.value[c][i - 1];
+            zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            varint += (zz < 0x80) ? 1 : ((zz < 0x4000) ? 2 : 3);
+        }
+        
+        /* encode, then both decoders must give the trace back */
+        len = rawcodec_encode(trace.value[c], trace.count, packed);
+        scalar = a_bench_raw_decode(packed, len, out, trace.count, 0);
+        if ((scalar == 0.0) || (memcmp(out, trace.value[c], sizeof(uint16_t) * trace.count) != 0))
+        {
+            printf("bench: rawcodec %s scalar decode differs.\n", name[c]);
+            res = 1;
+        }
+        memset(out, 0, sizeof(uint16_t) * trace.count);
+        simd = a_bench_raw_decode(packed, len, out, trace.count, 1);
+        if ((simd == 0.0) || (memcmp(out, trace.value[c], sizeof(uint16_t) * trace.count) != 0))
+        {
+            printf("bench: rawcodec %s simd decode differs.\n", name[c]);
+            res = 1;
+        }
+        printf("bench: rawcodec %s %d bytes, %0.2f bits/sample, ratio %0.2f against 16 bits, %0.2f against varints.\n",
+               name[c], len, (double)len * 8 / trace.count, (double)trace.count * 2 / len, (double)varint / len);
+        printf("bench: rawcodec %s decode scalar %0.1f Msamples/s, simd %0.1f Msamples/s, %0.2f GB/s.\n",
+               name[c], scalar, simd, simd * sizeof(uint16_t) / 1000.0);
+    }
+    
+    /* clean up */
+    free(packed);
+    free(out);
+    free(trace.value[0]);
+    free(trace.value[1]);
+    
+    return res;
+}
+
+/**
+ * @brief     bench the rolling windows
+ * @param[in] sensors sensor number
+ * @param[in] samples samples of every sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      1 min, 15 min and 1 h windows run over a 1 Hz random walk of every sensor,
+ *            the windows of sensor 0 are checked against a scan of its samples now and then
+ */
+uint8_t bench_window(uint32_t sensors, uint32_t samples)
+{
+    static const uint64_t length[3] = {60000, 900000, 3600000};
+    window_t window;
+    window_stat_t stat;
+    uint64_t *ts;
+    uint16_t (*value)[WINDOW_CHANNEL];
+    uint16_t *walk;
+    uint64_t start;
+    uint64_t us;
+    uint64_t sum;
+    uint64_t sumsq;
+    uint32_t count;
+    uint32_t checks;
+    uint32_t i;
+    uint32_t j;
+    uint32_t s;
+    uint32_t w;
+    uint32_t c;
+    uint16_t min;
+    uint16_t max;
+    double mean;
+    double variance;
+    uint8_t res;
+    
+    /* check the param */
+    if ((sensors == 0) || (samples == 0))
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    ts = (uint64_t *)malloc(sizeof(uint64_t) * samples);
+    value = (uint16_t (*)[WINDOW_CHANNEL])malloc(sizeof(uint16_t) * WINDOW_CHANNEL * samples);
+    walk = (uint16_t *)malloc(sizeof(uint16_t) * WINDOW_CHANNEL * sensors);
+    if ((ts == NULL) || (value == NULL) || (walk == NULL) || (window_init(&window, sensors, length, 3, 1000) != 0))
+    {
+        free(ts);
+        free(value);
+        free(walk);
+        
+        return 1;
+    }
+    srand(1);
+    for (s = 0; s < sensors * WINDOW_CHANNEL; s++)
+    {
+        walk[s] = (uint16_t)(400 + rand() % 20000);
+    }
+    
+    /* every sensor gets the same timestamps and its own walk */
+    res = 0;
+    checks = 0;
+    us = 0;
+    for (i = 0; i < samples; i++)
+    {
+        ts[i] = (i == 0) ? 1000 : (ts[i - 1] + 1000 + (uint64_t)(rand() % 3));
+        for (s = 0; s < sensors * WINDOW_CHANNEL; s++)
+        {
+            walk[s] = (uint16_t)(walk[s] + (rand() % 9) - 4);
+        }
+        memcpy(value[i], walk, sizeof(uint16_t) * WINDOW_CHANNEL);
+        start = a_bench_now_us();
+        for (s = 0; s < sensors; s++)
+        {
+            res |= window_push(&window, s, ts[i], &walk[s * WINDOW_CHANNEL]);
+        }
+        us += a_bench_now_us() - start;
+        
+        /* check sensor 0 against a scan */
+        if ((i % 997) != 0)
+        {
+            continue;
+        }
+        for (w = 0; w < 3; w++)
+        {
+            for (c = 0; c < WINDOW_CHANNEL; c++)
+            {
+                count = 0;
+                sum = 0;
+                sumsq = 0;
+                min = 0xFFFF;
+                max = 0;
+                for (j = 0; j <= i; j++)
+                {
+                    if ((ts[j] + length[w]) <= ts[i])
+                    {
+                        continue;
+                    }
+                    count++;
+                    sum += value[j][c];
+                    sumsq += (uint64_t)value[j][c] * value[j][c];
+                    min = (value[j][c] < min) ? value[j][c] : min;
+                    max = (value[j][c] > max) ? value[j][c] : max;
+                }
+                mean = (double)sum / count;
+                variance = (double)sumsq / count - mean * mean;
+                res |= window_get(&window, 0, w, c, &stat);
+                if ((stat.count != count) || (stat.sum != sum) || (stat.min != min) || (stat.max != max) ||
+                    (((stat.variance - variance) > 1e-6 * (variance + 1.0)) ||
+                     ((variance - stat.variance) > 1e-6 * (variance + 1.0))))
+                {
+                    printf("bench: window %d channel %d differs from the scan at sample %d.\n", w, c, i);
+                    res = 1;
+                }
+                checks++;
+            }
+        }
+    }
+    if (us == 0)
+    {
+        us = 1;
+    }
+    printf("bench: window %d sensors, 3 windows, %d samples each, %d checks.\n", sensors, samples, checks);
+    printf("bench: window %0.2f Msamples/s, %0.1f ns per window and channel.\n",
+           (double)sensors * samples / us, (double)us * 1000.0 / ((double)sensors * samples * 3 * WINDOW_CHANNEL));
+    
+    /* clean up */
+    window_deinit(&window);
+    free(ts);
+    free(value);
+    free(walk);
+    
+    return res;
+}
+
+/**
+ * @brief     compare two values
+ * @param[in] *a pointer to a value
+ * @param[in] *b pointer to a value
+ * @return    order
+ * @note      qsort callback
+ */
+static int a_bench_sketch_cmp(const void *a, const void *b)
+{
+    return (int)(*(const uint16_t *)a) - (int)(*(const uint16_t *)b);
+}
+
+/**
+ * @brief         check the quantiles of a sketch against the exact ones
+ * @param[in]     *sketch pointer to a sketch structure
+ * @param[in]     *value pointer to the sorted values
+ * @param[in]     count value number
+ * @param[in,out] *error pointer to the max relative error
+ * @return        status code
+ *                - 0 success
+ *                - 1 a quantile is out of the bound
+ * @note          p50, p95 and p99 are checked
+ */
+static uint8_t a_bench_sketch_check(const sketch_t *sketch, const uint16_t *value, uint32_t count, double *error)
+{
+    static const double q[3] = {0.50, 0.95, 0.99};
+    double exact;
+    double est;
+    double e;
+    uint32_t i;
+    
+    for (i = 0; i < 3; i++)
+    {
+        if (sketch_quantile(sketch, q[i], &est) != 0)
+        {
+            return 1;
+        }
+        exact = (double)value[(uint32_t)(q[i] * (double)(count - 1))];
+        e = (exact == 0.0) ? est : (fabs(est - exact) / exact);
+        if (e > *error)
+        {
+            *error = e;
+        }
+        if (e > (SKETCH_ALPHA + 1e-9))
+        {
+            printf("bench: sketch p%g is %0.2f, expect %0.0f.\n", q[i] * 100.0, est, exact);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bench the quantile sketch
+ * @param[in] sensors sensor number
+ * @param[in] samples samples of every sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      every sensor sketches a 1 Hz tvoc like stream, the p50, p95 and p99 of every sensor,
+ *            of the merge of the encoded sensor sketches and of the last hour of a 1 min bucket ring
+ *            are checked against the sorted samples
+ */
+uint8_t bench_sketch(uint32_t sensors, uint32_t samples)
+{
+    sketch_ring_t ring;
+    sketch_t *sensor;
+    sketch_t building;
+    sketch_t decoded;
+    sketch_t hour;
+    uint16_t *value;
+    uint16_t *sorted;
+    uint8_t buf[SKETCH_MAX_ENCODED];
+    uint64_t start;
+    uint64_t add_us;
+    uint64_t merge_us;
+    uint64_t encoded;
+    uint64_t now;
+    uint32_t level;
+    uint32_t len;
+    uint32_t n;
+    uint32_t i;
+    uint32_t s;
+    double error;
+    uint8_t res;
+    
+    /* check the param */
+    if ((sensors == 0) || (samples == 0) || (((uint64_t)sensors * samples) > 0x10000000ULL))
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    sensor = (sketch_t *)malloc(sizeof(sketch_t) * sensors);
+    value = (uint16_t *)malloc(sizeof(uint16_t) * sensors * samples);
+    sorted = (uint16_t *)malloc(sizeof(uint16_t) * samples);
+    if ((sensor == NULL) || (value == NULL) || (sorted == NULL) || (sketch_ring_init(&ring, 60, 60000) != 0))
+    {
+        free(sensor);
+        free(value);
+        free(sorted);
+        
+        return 1;
+    }
+    
+    /* a clean room sits at 0 ppb, cooking and cleaning give spikes that decay */
+    srand(1);
+    for (s = 0; s < sensors; s++)
+    {
+        level = 0;
+        for (i = 0; i < samples; i++)
+        {
+            if ((rand() % 3000) == 0)
+            {
+                level += 500 + (uint32_t)(rand() % 5000);
+            }
+            level = level - level / 200;
+            n = level + (uint32_t)(rand() % 40);
+            value[s * samples + i] = (uint16_t)((n > 60000) ? 60000 : ((n < 20) ? 0 : n - 20));
+        }
+    }
+    
+    /* sketch every sensor, the first one also goes into the ring */
+    start = a_bench_now_us();
+    for (s = 0; s < sensors; s++)
+    {
+        sketch_clear(&sensor[s]);
+        for (i = 0; i < samples; i++)
+        {
+            sketch_add(&sensor[s], value[s * samples + i]);
+        }
+    }
+    add_us = a_bench_now_us() - start;
+    for (i = 0; i < samples; i++)
+    {
+        sketch_ring_add(&ring, (uint64_t)i * 1000, value[i]);
+    }
+    
+    /* per sensor quantiles */
+    res = 0;
+    error = 0.0;
+    for (s = 0; s < sensors; s++)
+    {
+        memcpy(sorted, &value[s * samples], sizeof(uint16_t) * samples);
+        qsort(sorted, samples, sizeof(uint16_t), a_bench_sketch_cmp);
+        res |= a_bench_sketch_check(&sensor[s], sorted, samples, &error);
+    }
+    
+    /* the last hour of the first sensor from the ring, rounded to whole buckets */
+    now = (uint64_t)(samples - 1) * 1000;
+    sketch_ring_window(&ring, now, 3600000, &hour);
+    n = 0;
+    for (i = 0; i < samples; i++)
+    {
+        if (((uint64_t)i * 1000 - ((uint64_t)i * 1000) % 60000 + 3600000) > now)
+        {
+            sorted[n++] = value[i];
+        }
+    }
+    if (n != hour.count)
+    {
+        printf("bench: sketch ring holds %llu values, expect %d.\n", (unsigned long long)hour.count, n);
+        res = 1;
+    }
+    else
+    {
+        qsort(sorted, n, sizeof(uint16_t), a_bench_sketch_cmp);
+        res |= a_bench_sketch_check(&hour, sorted, n, &error);
+    }
+    
+    /* the building merges what every sensor sends */
+    encoded = 0;
+    sketch_clear(&building);
+    start = a_bench_now_us();
+    for (s = 0; s < sensors; s++)
+    {
+        len = sketch_encode(&sensor[s], buf);
+        encoded += len;
+        if (sketch_decode(buf, len, &decoded) != 0)
+        {
+            res = 1;
+        }
+        sketch_merge(&building, &decoded);
+    }
+    merge_us = a_bench_now_us() - start;
+    qsort(value, (size_t)sensors * samples, sizeof(uint16_t), a_bench_sketch_cmp);
+    res |= a_bench_sketch_check(&building, value, sensors * samples, &error);
+    printf("bench: sketch %d sensors, %d samples each, %d bytes per sketch, %0.1f bytes encoded.\n",
+           sensors, samples, (uint32_t)sizeof(sketch_t), (double)encoded / sensors);
+    printf("bench: sketch add %0.1f ns/value, encode, decode and merge %0.2f us/sketch.\n",
+           (double)add_us * 1000.0 / ((double)sensors * samples), (double)merge_us / sensors);
+    printf("bench: sketch p50, p95 and p99 max relative error %0.4f, bound %0.4f.\n", error, SKETCH_ALPHA);
+    
+    /* clean up */
+    sketch_ring_deinit(&ring);
+    free(sensor);
+    free(value);
+    free(sorted);
+    
+    return res;
+}
+
+/**
+ * @brief     get the injected event onset of a sensor
+ * @param[in] sensor sensor index
+ * @param[in] event event index
+ * @return    onset sample
+ * @note      the sensors are staggered
+ */
+static uint64_t a_bench_detect_onset(uint32_t sensor, uint64_t event)
+{
+    return event * BENCH_DETECT_PERIOD + BENCH_DETECT_PERIOD / 2 + (sensor * 37) % 300;
+}
+
+/**
+ * @brief     score a detect event
+ * @param[in] *event pointer to a detect event structure
+ * @param[in] *arg pointer to a bench detect result structure
+ * @note      the first start near an injected event is a hit, a start away from all is a false alarm
+ */
+static void a_bench_detect_event(const detect_event_t *event, void *arg)
+{
+    bench_detect_result_t *result;
+    uint64_t onset_ms;
+    uint64_t latency;
+    uint64_t index;
+    
+    result = (bench_detect_result_t *)arg;
+    if (event->type != DETECT_EVENT_START)
+    {
+        return;
+    }
+    index = event->timestamp_ms / 1000 / BENCH_DETECT_PERIOD;
+    onset_ms = a_bench_detect_onset(event->sensor, index) * 1000;
+    if ((event->timestamp_ms < onset_ms) || ((event->timestamp_ms - onset_ms) > BENCH_DETECT_MATCH_MS))
+    {
+        result->false_alarms++;
+        
+        return;
+    }
+    if (result->last[event->sensor] == (int64_t)index)
+    {
+        /* the other channel of the same event */
+        return;
+    }
+    result->last[event->sensor] = (int64_t)index;
+    latency = event->timestamp_ms - onset_ms;
+    result->hits++;
+    result->latency_ms += latency;
+    if (latency > result->latency_max_ms)
+    {
+        result->latency_max_ms = latency;
+    }
+}
+
+/**
+ * @brief     bench the event detector
+ * @param[in] sensors sensor number
+ * @param[in] samples samples of every sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      1 Hz tvoc and ethanol raw noise of every sensor gets a solvent burst and a small step
+ *            in turn, the hits, misses, false alarms, the latency from the true onset and the
+ *            time per sample are printed
+ */
+uint8_t bench_detect(uint32_t sensors, uint32_t samples)
+{
+    bench_detect_result_t result;
+    detect_t detect;
+    uint16_t *tvoc;
+    uint16_t *ethanol;
+    uint64_t start;
+    uint64_t us;
+    uint64_t onset;
+    uint64_t event;
+    uint32_t injected;
+    uint32_t noise;
+    uint32_t i;
+    uint32_t s;
+    float k;
+    float t;
+    float e;
+    
+    /* check the param */
+    if ((sensors == 0) || (samples == 0))
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    memset(&result, 0, sizeof(bench_detect_result_t));
+    result.last = (int64_t *)malloc(sizeof(int64_t) * sensors);
+    tvoc = (uint16_t *)malloc(sizeof(uint16_t) * sensors);
+    ethanol = (uint16_t *)malloc(sizeof(uint16_t) * sensors);
+    if ((result.last == NULL) || (tvoc == NULL) || (ethanol == NULL) ||
+        (detect_init(&detect, sensors, NULL, a_bench_detect_event, &result) != 0))
+    {
+        free(result.last);
+        free(tvoc);
+        free(ethanol);
+        
+        return 1;
+    }
+    for (s = 0; s < sensors; s++)
+    {
+        result.last[s] = -1;
+    }
+    
+    /* an even event is a solvent burst that decays, an odd one a small step */
+    srand(1);
+    us = 0;
+    injected = 0;
+    for (i = 0; i < samples; i++)
+    {
+        for (s = 0; s < sensors; s++)
+        {
+            noise = (uint32_t)(rand() % 7 + rand() % 7 + rand() % 7);
+            t = 30.0f + (float)noise - 9.0f;
+            e = 18500.0f + (float)(rand() % 5) - 2.0f;
+            event = i / BENCH_DETECT_PERIOD;
+            onset = a_bench_detect_onset(s, event);
+            if ((i >= onset) && (i < (onset + BENCH_DETECT_LENGTH)))
+            {
+                k = (float)(i - onset);
+                if ((event % 2) == 0)
+                {
+                    t += 400.0f * (1.0f - k / BENCH_DETECT_LENGTH);
+                    e -= 200.0f * (1.0f - k / BENCH_DETECT_LENGTH);
+                }
+                else
+                {
+                    t += 20.0f;
+                    e -= 10.0f;
+                }
+                if (i == onset)
+                {
+                    injected++;
+                }
+            }
+            tvoc[s] = (uint16_t)t;
+            ethanol[s] = (uint16_t)e;
+        }
+        start = a_bench_now_us();
+        for (s = 0; s < sensors; s++)
+        {
+            (void)detect_push(&detect, s, (uint64_t)i * 1000, tvoc[s], ethanol[s]);
+        }
+        us += a_bench_now_us() - start;
+    }
+    printf("bench: detect %d sensors, %d samples each, %d events, %d detected, %d missed, %d false alarms.\n",
+           sensors, samples, injected, result.hits, injected - result.hits, result.false_alarms);
+    printf("bench: detect latency avg %0.1f s, max %0.1f s from the onset at 1 Hz.\n",
+           (result.hits == 0) ? 0.0 : (double)result.latency_ms / result.hits / 1000.0,
+           (double)result.latency_max_ms / 1000.0);
+    printf("bench: detect %0.1f ns per sensor sample, %0.0f sensors per core at 1 Hz.\n",
+           (double)us * 1000.0 / ((double)sensors * samples),
+           ((double)sensors * samples) / ((us == 0) ? 1 : us) * 1000000.0);
+    
+    /* clean up */
+    detect_deinit(&detect);
+    free(result.last);
+    free(tvoc);
+    free(ethanol);
+    
+    return 0;
+}
+
+/**
+ * @brief      absolute humidity of the driver formula
+ * @param[in]  temp temperature in degrees
+ * @param[in]  rh relative humidity in %
+ * @param[out] *ah pointer to an absolute humidity buffer
+ * @return     register data
+ * @note       the body of sgp30_absolute_humidity_convert_to_register without the handle, clamped
+ *             where the batch conversion clamps
+ */
+static uint16_t a_bench_convert_ah_reference(float temp, float rh, float *ah)
+{
+    float absolute_humidity;
+    float fractpart;
+    float intpart;
+    
+    absolute_humidity = (rh / 100.0f * 6.112f * expf((17.62f * temp) / (243.12f + temp))) / (273.15f + temp) * 216.7f;
+    *ah = absolute_humidity;
+    if (!(absolute_humidity > 0.0f))
+    {
+        return 0;
+    }
+    if (absolute_humidity >= 256.0f)
+    {
+        return 0xFFFF;
+    }
+    fractpart = modff(absolute_humidity, &intpart);
+    
+    return (uint16_t)((uint16_t)(intpart) << 8 | (uint8_t)(fractpart * 256));
+}
+
+/**
+ * @brief     bench the batch absolute humidity conversion
+ * @param[in] rounds round number
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      a grid from -40 to 85 degrees and 0 to 100 %rh is converted by the driver formula
+ *            one pair at a time and by the batch, and the results are compared
+ */
+static uint8_t a_bench_convert_humidity(uint32_t rounds)
+{
+    float *temp;
+    float *rh;
+    float *ah;
+    float *ref_ah;
+    uint16_t *reg;
+    uint16_t *ref_reg;
+    uint64_t start;
+    uint64_t us[2];
+    uint32_t len;
+    uint32_t mismatch;
+    uint32_t diff_max;
+    uint32_t r;
+    uint32_t i;
+    double err;
+    double max_err;
+    
+    len = BENCH_CONVERT_TEMP * BENCH_CONVERT_RH;
+    temp = (float *)malloc(sizeof(float) * len);
+    rh = (float *)malloc(sizeof(float) * len);
+    ah = (float *)malloc(sizeof(float) * len);
+    ref_ah = (float *)malloc(sizeof(float) * len);
+    reg = (uint16_t *)malloc(sizeof(uint16_t) * len);
+    ref_reg = (uint16_t *)malloc(sizeof(uint16_t) * len);
+    if ((temp == NULL) || (rh == NULL) || (ah == NULL) || (ref_ah == NULL) || (reg == NULL) || (ref_reg == NULL))
+    {
+        free(temp);
+        free(rh);
+        free(ah);
+        free(ref_ah);
+        free(reg);
+        free(ref_reg);
+        
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        temp[i] = -40.0f + (float)(i / BENCH_CONVERT_RH) * 0.05f;
+        rh[i] = (float)(i % BENCH_CONVERT_RH) * 0.5f;
+    }
+    
+    /* time the driver formula and the batch */
+    memset(us, 0, sizeof(uint64_t) * 2);
+    for (r = 0; r < rounds; r++)
+    {
+        start = a_bench_now_us();
+        for (i = 0; i < len; i++)
+        {
+            ref_reg[i] = a_bench_convert_ah_reference(temp[i], rh[i], &ref_ah[i]);
+        }
+        us[0] += a_bench_now_us() - start;
+        start = a_bench_now_us();
+        (void)sgp30_convert_absolute_humidity(temp, rh, len, reg, ah);
+        us[1] += a_bench_now_us() - start;
+    }
+    
+    /* compare the batch with the driver formula */
+    max_err = 0.0;
+    mismatch = 0;
+    diff_max = 0;
+    for (i = 0; i < len; i++)
+    {
+        if (ref_ah[i] > 0.0f)
+        {
+            err = fabs((double)ah[i] - (double)ref_ah[i]) / (double)ref_ah[i];
+            if (err > max_err)
+            {
+                max_err = err;
+            }
+        }
+        if (reg[i] != ref_reg[i])
+        {
+            mismatch++;
+            if ((uint32_t)abs((int32_t)reg[i] - (int32_t)ref_reg[i]) > diff_max)
+            {
+                diff_max = (uint32_t)abs((int32_t)reg[i] - (int32_t)ref_reg[i]);
+            }
+        }
+    }
+    printf("bench: humidity %d pairs, max relative error %0.2e, bound %0.2e.\n",
+           len, max_err, (double)SGP30_CONVERT_AH_ERROR);
+    printf("bench: humidity %d registers differ from the driver, by %d lsb at most.\n", mismatch, diff_max);
+    for (i = 0; i < 2; i++)
+    {
+        printf("bench: humidity %-6s %0.2f ns per pair, %0.1f Mpairs/s.\n",
+               (i == 0) ? "driver" : SGP30_CONVERT_SIMD,
+               (double)us[i] * 1000.0 / ((double)rounds * len),
+               ((double)rounds * len) / ((us[i] == 0) ? 1 : us[i]));
+    }
+    
+    /* clean up */
+    free(temp);
+    free(rh);
+    free(ah);
+    free(ref_ah);
+    free(reg);
+    free(ref_reg);
+    
+    return ((max_err > (double)SGP30_CONVERT_AH_ERROR) || (diff_max > 1)) ? 1 : 0;
+}
+
+/**
+ * @brief     bench the batch raw signal conversion
+ * @param[in] rounds round number
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      every round converts a buffer of raw h2 signals with expf one at a time, with the
+ *            portable polynomial and with the simd polynomial, the error of the polynomial is
+ *            checked over the whole uint16 range against a double exp, then a temperature and
+ *            humidity grid is converted by the driver formula and by the batch and compared
+ */
+uint8_t bench_convert(uint32_t rounds)
+{
+    uint16_t *raw;
+    float *ppm;
+    uint64_t start;
+    uint64_t us[3];
+    uint32_t r;
+    uint32_t i;
+    double expect;
+    double err;
+    double max_err;
+    float sink;
+    
+    /* check the param */
+    if (rounds == 0)
+    {
+        printf("bench: param is invalid.\n");
+        
+        return 1;
+    }
+    raw = (uint16_t *)malloc(sizeof(uint16_t) * BENCH_CONVERT_SAMPLES);
+    ppm = (float *)malloc(sizeof(float) * BENCH_CONVERT_SAMPLES);
+    if ((raw == NULL) || (ppm == NULL))
+    {
+        free(raw);
+        free(ppm);
+        
+        return 1;
+    }
+    
+    /* the whole uint16 range around a centered reference keeps every argument inside the clamp */
+    max_err = 0.0;
+    for (r = 0; r < 2; r++)
+    {
+        for (i = 0; i < 65536; i++)
+        {
+            raw[i] = (uint16_t)i;
+        }
+        if (r == 0)
+        {
+            (void)sgp30_convert_raw(raw, 65536, 32768, 1.0f, ppm);
+        }
+        else
+        {
+            (void)sgp30_convert_raw_scalar(raw, 65536, 32768, 1.0f, ppm);
+        }
+        for (i = 0; i < 65536; i++)
+        {
+            expect = exp(((double)32768 - (double)i) / 512.0);
+            err = fabs((double)ppm[i] - expect) / expect;
+            if (err > max_err)
+            {
+                max_err = err;
+            }
+        }
+    }
+    printf("bench: convert %s path, max relative error %0.2e, bound %0.2e.\n",
+           SGP30_CONVERT_SIMD, max_err, (double)SGP30_CONVERT_EXP_ERROR);
+    if (max_err > (double)SGP30_CONVERT_EXP_ERROR)
+    {
+        printf("bench: convert error is over the bound.\n");
+        free(raw);
+        free(ppm);
+        
+        return 1;
+    }
+    
+    /* h2 raw signals around a typical clean air reference */
+    srand(1);
+    for (i = 0; i < BENCH_CONVERT_SAMPLES; i++)
+    {
+        raw[i] = (uint16_t)(13000 + rand() % 2000);
+    }
+    memset(us, 0, sizeof(uint64_t) * 3);
+    sink = 0.0f;
+    for (r = 0; r < rounds; r++)
+    {
+        start = a_bench_now_us();
+        for (i = 0; i < BENCH_CONVERT_SAMPLES; i++)
+        {
+            ppm[i] = SGP30_CONVERT_H2_REF_PPM * expf((float)(13119 - (int32_t)raw[i]) / 512.0f);
+        }
+        us[0] += a_bench_now_us() - start;
+        sink += ppm[r];
+        start = a_bench_now_us();
+        (void)sgp30_convert_raw_scalar(raw, BENCH_CONVERT_SAMPLES, 13119, SGP30_CONVERT_H2_REF_PPM, ppm);
+        us[1] += a_bench_now_us() - start;
+        sink += ppm[r];
+        start = a_bench_now_us();
+        (void)sgp30_convert_raw(raw, BENCH_CONVERT_SAMPLES, 13119, SGP30_CONVERT_H2_REF_PPM, ppm);
+        us[2] += a_bench_now_us() - start;
+        sink += ppm[r];
+    }
+    for (i = 0; i < 3; i++)
+    {
+        printf("bench: convert %-6s %0.2f ns per sample, %0.1f Msamples/s.\n",
+               (i == 0) ? "expf" : ((i == 1) ? "scalar" : SGP30_CONVERT_SIMD),
+               (double)us[i] * 1000.0 / ((double)rounds * BENCH_CONVERT_SAMPLES),
+               ((double)rounds * BENCH_CONVERT_SAMPLES) / ((us[i] == 0) ? 1 : us[i]));
+    }
+    printf("bench: convert checksum %0.3f.\n", (double)sink);
+    
+    /* clean up */
+    free(raw);
+    free(ppm);
+    
+    /* the absolute humidity of the compensation */
+    if (a_bench_convert_humidity(rounds) != 0)
+    {
+        printf("bench: humidity error is over the bound.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,332 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      cache.c
+ * @brief     cache source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "cache.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief  cache get the monotonic time
+ * @return time in microseconds
+ * @note   none
+ */
+static uint64_t a_cache_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     cache run one measurement and publish it
+ * @param[in] *cache pointer to a cache structure
+ * @param[in] missed missed deadline number
+ * @note      the bus is read without the mutex, so readers of the old sample never wait for the bus
+ */
+static void a_cache_measure(cache_t *cache, uint32_t missed)
+{
+    uint16_t co2_eq_ppm;
+    uint16_t tvoc_ppb;
+    uint8_t res;
+    
+    /* measure */
+    co2_eq_ppm = 0;
+    tvoc_ppb = 0;
+    res = cache->read(&co2_eq_ppm, &tvoc_ppb);
+    
+    /* publish */
+    (void)pthread_mutex_lock(&cache->mutex);
+    cache->sample.timestamp_us = a_cache_now_us();
+    cache->sample.seq++;
+    cache->sample.res = (res != 0) ? 1 : 0;
+    cache->sample.co2_eq_ppm = co2_eq_ppm;
+    cache->sample.tvoc_ppb = tvoc_ppb;
+    cache->stats.measurements++;
+    cache->stats.missed += missed;
+    if (res != 0)
+    {
+        cache->stats.failed++;
+    }
+    (void)pthread_cond_broadcast(&cache->cond);
+    (void)pthread_mutex_unlock(&cache->mutex);
+}
+
+/**
+ * @brief     cache measurement thread
+ * @param[in] *arg pointer to a cache structure
+ * @return    NULL
+ * @note      the cadence only depends on the deadlines, never on the readers
+ */
+static void *a_cache_thread(void *arg)
+{
+    cache_t *cache;
+    uint32_t missed;
+    
+    cache = (cache_t *)arg;
+    
+    /* the first sample is measured at once */
+    a_cache_measure(cache, 0);
+    
+    /* one measurement per deadline */
+    while (cache->stop == 0)
+    {
+        if (sampler_wait(&cache->sampler, &missed) != 0)
+        {
+            break;
+        }
+        if (cache->stop != 0)
+        {
+            break;
+        }
+        a_cache_measure(cache, missed);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     cache init
+ * @param[in] *cache pointer to a cache structure
+ * @param[in] period_ms measurement period, 1000 keeps the iaq algorithm on its 1 Hz cadence
+ * @param[in] ttl_ms max age of a cached sample, 0 means period_ms
+ * @param[in] *read pointer to a measurement function such as sgp30_basic_read
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the chip must be initialized before cache_start
+ */
+uint8_t cache_init(cache_t *cache, uint32_t period_ms, uint32_t ttl_ms, uint8_t (*read)(uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb))
+{
+    pthread_condattr_t attr;
+    
+    /* check the param */
+    if ((period_ms == 0) || (read == NULL))
+    {
+        printf("cache: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* init the state */
+    memset(cache, 0, sizeof(cache_t));
+    cache->read = read;
+    cache->period_ms = period_ms;
+    cache->ttl_ms = (ttl_ms != 0) ? ttl_ms : period_ms;
+    
+    /* the readers time out on the monotonic clock */
+    if (pthread_mutex_init(&cache->mutex, NULL) != 0)
+    {
+        return 1;
+    }
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&cache->cond, &attr) != 0)
+    {
+        (void)pthread_condattr_destroy(&attr);
+        (void)pthread_mutex_destroy(&cache->mutex);
+        
+        return 1;
+    }
+    (void)pthread_condattr_destroy(&attr);
+    
+    return 0;
+}
+
+/**
+ * @brief     cache start the measurement thread
+ * @param[in] *cache pointer to a cache structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the thread owns the chip, it measures once at the start and then on every period deadline
+ */
+uint8_t cache_start(cache_t *cache)
+{
+    if (cache->running != 0)
+    {
+        return 1;
+    }
+    if (sampler_init(&cache->sampler, cache->period_ms) != 0)
+    {
+        return 1;
+    }
+    cache->stop = 0;
+    if (pthread_create(&cache->thread, NULL, a_cache_thread, cache) != 0)
+    {
+        perror("cache: create thread failed.\n");
+        
+        return 1;
+    }
+    cache->running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      cache read the latest sample
+ * @param[in]  *cache pointer to a cache structure
+ * @param[out] *sample pointer to a sample buffer
+ * @param[out] *age_ms pointer to an age buffer, it can be NULL
+ * @param[in]  timeout_ms max wait for the in-flight measurement
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or timeout
+ * @note       a sample younger than ttl_ms is returned at once, otherwise the caller waits for the
+ *             in-flight measurement together with every other caller, no reader ever starts a measurement
+ */
+uint8_t cache_read(cache_t *cache, cache_sample_t *sample, uint32_t *age_ms, uint32_t timeout_ms)
+{
+    struct timespec deadline;
+    uint64_t now;
+    uint32_t seq;
+    uint8_t res;
+    
+    (void)pthread_mutex_lock(&cache->mutex);
+    cache->stats.reads++;
+    now = a_cache_now_us();
+    
+    /* serve a fresh sample */
+    if ((cache->sample.seq != 0) && (cache->sample.res == 0) &&
+        ((now - cache->sample.timestamp_us) <= (uint64_t)cache->ttl_ms * 1000))
+    {
+        cache->stats.hits++;
+    }
+    else
+    {
+        /* join the in-flight measurement */
+        cache->stats.coalesced++;
+        (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        seq = cache->sample.seq;
+        while ((cache->sample.seq == seq) && (cache->stop == 0))
+        {
+            if (pthread_cond_timedwait(&cache->cond, &cache->mutex, &deadline) != 0)
+            {
+                break;
+            }
+        }
+        if (cache->sample.seq == seq)
+        {
+            cache->stats.timeouts++;
+            (void)pthread_mutex_unlock(&cache->mutex);
+            
+            return 1;
+        }
+        now = a_cache_now_us();
+    }
+    
+    /* copy the sample */
+    *sample = cache->sample;
+    res = cache->sample.res;
+    (void)pthread_mutex_unlock(&cache->mutex);
+    if (age_ms != NULL)
+    {
+        *age_ms = (uint32_t)((now - sample->timestamp_us) / 1000);
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      cache get the stats
+ * @param[in]  *cache pointer to a cache structure
+ * @param[out] *stats pointer to a stats buffer
+ * @note       none
+ */
+void cache_get_stats(cache_t *cache, cache_stats_t *stats)
+{
+    (void)pthread_mutex_lock(&cache->mutex);
+    *stats = cache->stats;
+    (void)pthread_mutex_unlock(&cache->mutex);
+}
+
+/**
+ * @brief     cache print the stats
+ * @param[in] *cache pointer to a cache structure
+ * @note      none
+ */
+void cache_print_stats(cache_t *cache)
+{
+    cache_stats_t stats;
+    
+    cache_get_stats(cache, &stats);
+    printf("cache: %llu measurements, %llu failed, %llu missed deadlines.\n",
+           (unsigned long long)stats.measurements, (unsigned long long)stats.failed,
+           (unsigned long long)stats.missed);
+    printf("cache: %llu reads, %llu hits, %llu coalesced, %llu timeouts.\n",
+           (unsigned long long)stats.reads, (unsigned long long)stats.hits,
+           (unsigned long long)stats.coalesced, (unsigned long long)stats.timeouts);
+}
+
+/**
+ * @brief     cache stop the measurement thread
+ * @param[in] *cache pointer to a cache structure
+ * @note      the waiting readers return with a failure
+ */
+void cache_stop(cache_t *cache)
+{
+    if (cache->running == 0)
+    {
+        return;
+    }
+    (void)pthread_mutex_lock(&cache->mutex);
+    cache->stop = 1;
+    (void)pthread_cond_broadcast(&cache->cond);
+    (void)pthread_mutex_unlock(&cache->mutex);
+    (void)pthread_join(cache->thread, NULL);
+    cache->running = 0;
+}
+
+/**
+ * @brief     cache deinit
+ * @param[in] *cache pointer to a cache structure
+ * @note      the thread is stopped first
+ */
+void cache_deinit(cache_t *cache)
+{
+    cache_stop(cache);
+    (void)pthread_cond_destroy(&cache->cond);
+    (void)pthread_mutex_destroy(&cache->mutex);
+}
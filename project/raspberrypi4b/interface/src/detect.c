@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      detect.c
+ * @brief     detect source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "detect.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief detect definition
+ */
+#define DETECT_MAD_TO_SIGMA        1.2533f        /**< sigma of a normal noise over its mean absolute deviation */
+#define DETECT_ALARM_SLOWDOWN      0.1f           /**< baseline weight during an excursion */
+#define DETECT_END_SCALE           1.0f           /**< an excursion ends within this many scales */
+
+/**
+ * @brief     detect run one channel
+ * @param[in] *detect pointer to a detect structure
+ * @param[in] sensor sensor index
+ * @param[in] channel channel
+ * @param[in] n samples seen before this one
+ * @param[in] timestamp_ms sample timestamp
+ * @param[in] value sample value
+ * @note      none
+ */
+static void a_detect_channel(detect_t *detect, uint32_t sensor, detect_channel_t channel, uint32_t n,
+                             uint64_t timestamp_ms, uint16_t value)
+{
+    detect_state_t *st;
+    detect_event_t event;
+    float alpha;
+    float scale;
+    float d;
+    float z;
+    
+    st = &detect->state[sensor * DETECT_CHANNEL_MAX + channel];
+    if (n == 0)
+    {
+        memset(st, 0, sizeof(detect_state_t));
+        st->mean = (float)value;
+        
+        return;
+    }
+    
+    /* deviation in scales, positive towards an event */
+    d = (float)value - st->mean;
+    scale = DETECT_MAD_TO_SIGMA * st->dev;
+    if (scale < detect->config.floor[channel])
+    {
+        scale = detect->config.floor[channel];
+    }
+    z = ((channel == DETECT_CHANNEL_ETHANOL) ? -d : d) / scale;
+    
+    /* cusum and the single sample spike */
+    if (n >= detect->config.warmup)
+    {
+        if (st->cusum == 0.0f)
+        {
+            st->onset_ms = timestamp_ms;
+        }
+        st->cusum += z - detect->config.k;
+        if (st->cusum < 0.0f)
+        {
+            st->cusum = 0.0f;
+        }
+        if ((st->alarm == 0) && ((st->cusum > detect->config.h) || (z > detect->config.spike)))
+        {
+            st->alarm = 1;
+            detect->events++;
+            if (detect->callback != NULL)
+            {
+                event.type = DETECT_EVENT_START;
+                event.sensor = sensor;
+                event.channel = channel;
+                event.timestamp_ms = timestamp_ms;
+                event.onset_ms = st->onset_ms;
+                event.latency_ms = timestamp_ms - st->onset_ms;
+                event.value = value;
+                event.baseline = st->mean;
+                event.score = (z > st->cusum) ? z : st->cusum;
+                detect->callback(&event, detect->arg);
+            }
+        }
+        else if ((st->alarm != 0) && (z < DETECT_END_SCALE))
+        {
+            st->alarm = 0;
+            st->cusum = 0.0f;
+            if (detect->callback != NULL)
+            {
+                event.type = DETECT_EVENT_END;
+                event.sensor = sensor;
+                event.channel = channel;
+                event.timestamp_ms = timestamp_ms;
+                event.onset_ms = st->onset_ms;
+                event.latency_ms = timestamp_ms - st->onset_ms;
+                event.value = value;
+                event.baseline = st->mean;
+                event.score = z;
+                detect->callback(&event, detect->arg);
+            }
+        }
+    }
+    
+    /* the baseline starts as a plain mean and then forgets at alpha */
+    alpha = 1.0f / (float)(n + 1);
+    if (alpha < detect->config.alpha)
+    {
+        alpha = detect->config.alpha;
+    }
+    if (st->alarm != 0)
+    {
+        /* the noise scale must not learn the event itself */
+        st->mean += alpha * DETECT_ALARM_SLOWDOWN * d;
+        
+        return;
+    }
+    st->mean += alpha * d;
+    st->dev += alpha * (((d < 0.0f) ? -d : d) - st->dev);
+}
+
+/**
+ * @brief      detect get the default config
+ * @param[out] *config pointer to a detect config structure
+ * @note       alpha 0.02 tracks a baseline of about 50 samples, a spike of 8 scales is raised at
+ *             once and a shift of 1.5 scales after about 5 samples
+ */
+void detect_default_config(detect_config_t *config)
+{
+    config->alpha = 0.02f;
+    config->k = 0.5f;
+    config->h = 5.0f;
+    config->spike = 8.0f;
+    config->floor[DETECT_CHANNEL_TVOC] = 5.0f;
+    config->floor[DETECT_CHANNEL_ETHANOL] = 4.0f;
+    config->warmup = 30;
+}
+
+/**
+ * @brief     detect init
+ * @param[in] *detect pointer to a detect structure
+ * @param[in] sensors sensor number
+ * @param[in] *config pointer to a detect config structure, NULL means the default
+ * @param[in] callback event callback
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t detect_init(detect_t *detect, uint32_t sensors, const detect_config_t *config, detect_callback_t callback, void *arg)
+{
+    memset(detect, 0, sizeof(detect_t));
+    if (sensors == 0)
+    {
+        return 1;
+    }
+    if (config != NULL)
+    {
+        detect->config = *config;
+    }
+    else
+    {
+        detect_default_config(&detect->config);
+    }
+    if ((detect->config.alpha <= 0.0f) || (detect->config.alpha > 1.0f) ||
+        (detect->config.floor[DETECT_CHANNEL_TVOC] <= 0.0f) || (detect->config.floor[DETECT_CHANNEL_ETHANOL] <= 0.0f))
+    {
+        return 1;
+    }
+    detect->state = (detect_state_t *)calloc((size_t)sensors * DETECT_CHANNEL_MAX, sizeof(detect_state_t));
+    detect->samples = (uint32_t *)calloc(sensors, sizeof(uint32_t));
+    if ((detect->state == NULL) || (detect->samples == NULL))
+    {
+        detect_deinit(detect);
+        
+        return 1;
+    }
+    detect->sensors = sensors;
+    detect->callback = callback;
+    detect->arg = arg;
+    
+    return 0;
+}
+
+/**
+ * @brief     detect push a sample of a sensor
+ * @param[in] *detect pointer to a detect structure
+ * @param[in] sensor sensor index
+ * @param[in] timestamp_ms sample timestamp
+ * @param[in] tvoc_ppb tvoc
+ * @param[in] ethanol_raw ethanol raw signal
+ * @return    status code
+ *            - 0 success
+ *            - 1 push failed
+ * @note      the callback runs inside this call, during an excursion the noise scale is frozen and the
+ *            baseline adapts 10 times slower, so a step that stays is taken as the new baseline in the end
+ */
+uint8_t detect_push(detect_t *detect, uint32_t sensor, uint64_t timestamp_ms, uint16_t tvoc_ppb, uint16_t ethanol_raw)
+{
+    uint32_t n;
+    
+    if ((detect->state == NULL) || (sensor >= detect->sensors))
+    {
+        return 1;
+    }
+    n = detect->samples[sensor];
+    a_detect_channel(detect, sensor, DETECT_CHANNEL_TVOC, n, timestamp_ms, tvoc_ppb);
+    a_detect_channel(detect, sensor, DETECT_CHANNEL_ETHANOL, n, timestamp_ms, ethanol_raw);
+    if (n != 0xFFFFFFFFU)
+    {
+        detect->samples[sensor] = n + 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     detect deinit
+ * @param[in] *detect pointer to a detect structure
+ * @note      none
+ */
+void detect_deinit(detect_t *detect)
+{
+    free(detect->state);
+    free(detect->samples);
+    memset(detect, 0, sizeof(detect_t));
+}
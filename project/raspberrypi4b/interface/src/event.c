@@ -0,0 +1,538 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      event.c
+ * @brief     event source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "event.h"
+#include "iic.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+/**
+ * @brief event definition
+ */
+#define EVENT_NS_PER_S           1000000000LL        /**< 1 s */
+#define EVENT_MAX_READY          64                  /**< max sensors advanced by one epoll_wait */
+
+/**
+ * @brief sensor being advanced, the driver callbacks have no context argument
+ */
+static __thread event_sensor_t *gs_sensor = NULL;
+
+/**
+ * @brief  event iic init callback
+ * @return status code
+ *         - 0 success
+ * @note   the caller owns the iic fd
+ */
+static uint8_t a_event_iic_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  event iic deinit callback
+ * @return status code
+ *         - 0 success
+ * @note   the caller owns the iic fd
+ */
+static uint8_t a_event_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     event iic write command callback
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_event_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_write_cmd(gs_sensor->iic_fd, addr, buf, len);
+}
+
+/**
+ * @brief      event iic read command callback
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_event_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_read_cmd(gs_sensor->iic_fd, addr, buf, len);
+}
+
+/**
+ * @brief     event delay callback
+ * @param[in] ms time
+ * @note      the delay is not slept, it is added to the next timer of the sensor,
+ *            the driver only waits after the last command of a call so the order is kept
+ */
+static void a_event_delay_ms(uint32_t ms)
+{
+    gs_sensor->pending_ms += ms;
+}
+
+/**
+ * @brief     event print callback
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_event_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    va_start(args, fmt);
+    (void)vsnprintf(str, sizeof(str), fmt, args);
+    va_end(args);
+    (void)printf("%s", str);
+}
+
+/**
+ * @brief     event select the mux channel of the sensor
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      nothing is written without a mux
+ */
+static uint8_t a_event_select(event_sensor_t *sensor)
+{
+    uint8_t sel;
+    
+    if (sensor->mux_addr == 0)
+    {
+        return 0;
+    }
+    sel = (uint8_t)(1 << sensor->channel);
+    
+    return iic_write_cmd(sensor->iic_fd, sensor->mux_addr, &sel, 1);
+}
+
+/**
+ * @brief     event arm the timer after a relative time
+ * @param[in] *sensor pointer to a sensor structure
+ * @param[in] ms relative time
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      none
+ */
+static uint8_t a_event_arm_after(event_sensor_t *sensor, uint32_t ms)
+{
+    struct itimerspec its;
+    
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = ms / 1000;
+    its.it_value.tv_nsec = (long)(ms % 1000) * 1000000L;
+    if ((its.it_value.tv_sec == 0) && (its.it_value.tv_nsec == 0))
+    {
+        its.it_value.tv_nsec = 1;
+    }
+    
+    return (timerfd_settime(sensor->timer_fd, 0, &its, NULL) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     event arm the timer at the next cadence deadline
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      the deadlines stay on one grid, the deadlines which have passed are skipped and counted
+ */
+static uint8_t a_event_arm_next(event_sensor_t *sensor)
+{
+    struct itimerspec its;
+    struct timespec now;
+    int64_t period;
+    int64_t next;
+    int64_t late;
+    
+    period = (int64_t)sensor->period_ms * 1000000LL;
+    next = (int64_t)sensor->next.tv_sec * EVENT_NS_PER_S + sensor->next.tv_nsec + period;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    late = ((int64_t)now.tv_sec * EVENT_NS_PER_S + now.tv_nsec) - next;
+    if (late >= 0)
+    {
+        sensor->missed += (uint64_t)(late / period) + 1;
+        next += (late / period + 1) * period;
+    }
+    sensor->next.tv_sec = (time_t)(next / EVENT_NS_PER_S);
+    sensor->next.tv_nsec = (long)(next % EVENT_NS_PER_S);
+    memset(&its, 0, sizeof(its));
+    its.it_value = sensor->next;
+    
+    return (timerfd_settime(sensor->timer_fd, TFD_TIMER_ABSTIME, &its, NULL) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     event report a failure
+ * @param[in] *sensor pointer to a sensor structure
+ * @note      the sensor is initialized again after EVENT_REINIT_THRESHOLD consecutive failures
+ */
+static void a_event_fail(event_sensor_t *sensor)
+{
+    sensor->failed++;
+    sensor->failures++;
+    if (sensor->callback != NULL)
+    {
+        sensor->callback(sensor, 1, 0, 0, sensor->arg);
+    }
+    if (sensor->failures >= EVENT_REINIT_THRESHOLD)
+    {
+        sensor->failures = 0;
+        sensor->reinit++;
+        sensor->state = EVENT_STATE_INIT;
+    }
+    else
+    {
+        sensor->state = EVENT_STATE_IDLE;
+    }
+    (void)a_event_arm_next(sensor);
+}
+
+/**
+ * @brief     event sensor advance the state machine
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 advanced
+ *            - 1 the timer has not expired
+ * @note      call it when the sensor timerfd is readable
+ */
+uint8_t event_sensor_process(event_sensor_t *sensor)
+{
+    uint64_t expirations;
+    uint16_t co2_eq_ppm;
+    uint16_t tvoc_ppb;
+    
+    /* consume the expiration */
+    if (read(sensor->timer_fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations))
+    {
+        return 1;
+    }
+    gs_sensor = sensor;
+    sensor->pending_ms = 0;
+    
+    switch (sensor->state)
+    {
+        /* send iaq init, the init wait becomes the timer */
+        case EVENT_STATE_INIT :
+        {
+            if ((a_event_select(sensor) != 0) ||
+                ((sensor->handle.inited == 0) && (sgp30_init(&sensor->handle) != 0)) ||
+                (sgp30_iaq_init(&sensor->handle) != 0))
+            {
+                sensor->failed++;
+                if (sensor->callback != NULL)
+                {
+                    sensor->callback(sensor, 1, 0, 0, sensor->arg);
+                }
+                (void)a_event_arm_next(sensor);
+                
+                break;
+            }
+            sensor->state = EVENT_STATE_WARMUP;
+            (void)a_event_arm_after(sensor, sensor->pending_ms);
+            
+            break;
+        }
+        
+        /* iaq init is done */
+        case EVENT_STATE_WARMUP :
+        {
+            sensor->state = EVENT_STATE_IDLE;
+            (void)a_event_arm_next(sensor);
+            
+            break;
+        }
+        
+        /* cadence deadline, start the measurement */
+        case EVENT_STATE_IDLE :
+        {
+            if ((a_event_select(sensor) != 0) || (sgp30_start_measure_iaq(&sensor->handle) != 0))
+            {
+                a_event_fail(sensor);
+                
+                break;
+            }
+            sensor->state = EVENT_STATE_CONVERTING;
+            (void)a_event_arm_after(sensor, SGP30_MEASURE_IAQ_TIME_MS);
+            
+            break;
+        }
+        
+        /* conversion window is over, fetch the result */
+        case EVENT_STATE_CONVERTING :
+        {
+            if ((a_event_select(sensor) != 0) ||
+                (sgp30_get_measure_iaq_result(&sensor->handle, &co2_eq_ppm, &tvoc_ppb) != 0))
+            {
+                a_event_fail(sensor);
+                
+                break;
+            }
+            sensor->samples++;
+            sensor->failures = 0;
+            if (sensor->callback != NULL)
+            {
+                sensor->callback(sensor, 0, co2_eq_ppm, tvoc_ppb, sensor->arg);
+            }
+            sensor->state = EVENT_STATE_IDLE;
+            (void)a_event_arm_next(sensor);
+            
+            break;
+        }
+        
+        default :
+        {
+            sensor->state = EVENT_STATE_INIT;
+            (void)a_event_arm_next(sensor);
+            
+            break;
+        }
+    }
+    gs_sensor = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief     event loop init
+ * @param[in] *loop pointer to an event loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t event_init(event_loop_t *loop)
+{
+    memset(loop, 0, sizeof(event_loop_t));
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd < 0)
+    {
+        perror("event: epoll create failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     event loop deinit
+ * @param[in] *loop pointer to an event loop structure
+ * @note      the sensors must be removed first
+ */
+void event_deinit(event_loop_t *loop)
+{
+    if (loop->epoll_fd >= 0)
+    {
+        (void)close(loop->epoll_fd);
+        loop->epoll_fd = -1;
+    }
+}
+
+/**
+ * @brief     event loop get the fd
+ * @param[in] *loop pointer to an event loop structure
+ * @return    epoll fd, it is readable when any sensor is ready
+ * @note      add it to the epoll set of the service and call event_process_ready when it is readable
+ */
+int event_get_fd(event_loop_t *loop)
+{
+    return loop->epoll_fd;
+}
+
+/**
+ * @brief     event loop add a sensor
+ * @param[in] *loop pointer to an event loop structure
+ * @param[in] *sensor pointer to a sensor structure owned by the caller
+ * @param[in] iic_fd iic handle opened by iic_init
+ * @param[in] mux_addr iic mux write address, 0 means no mux
+ * @param[in] channel mux channel
+ * @param[in] period_ms cadence
+ * @param[in] callback sample callback
+ * @param[in] *arg pointer to the callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the first step is staggered by EVENT_STAGGER_MS per sensor, nothing blocks in this call
+ */
+uint8_t event_add_sensor(event_loop_t *loop, event_sensor_t *sensor, int iic_fd, uint8_t mux_addr, uint8_t channel,
+                         uint32_t period_ms, event_callback_t callback, void *arg)
+{
+    struct epoll_event ev;
+    struct timespec now;
+    uint32_t stagger;
+    int64_t next;
+    
+    if ((period_ms <= SGP30_MEASURE_IAQ_TIME_MS) || (channel > 7))
+    {
+        printf("event: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link the driver */
+    memset(sensor, 0, sizeof(event_sensor_t));
+    DRIVER_SGP30_LINK_INIT(&sensor->handle, sgp30_handle_t);
+    DRIVER_SGP30_LINK_IIC_INIT(&sensor->handle, a_event_iic_init);
+    DRIVER_SGP30_LINK_IIC_DEINIT(&sensor->handle, a_event_iic_deinit);
+    DRIVER_SGP30_LINK_IIC_WRITE_COMMAND(&sensor->handle, a_event_iic_write_cmd);
+    DRIVER_SGP30_LINK_IIC_READ_COMMAND(&sensor->handle, a_event_iic_read_cmd);
+    DRIVER_SGP30_LINK_DELAY_MS(&sensor->handle, a_event_delay_ms);
+    DRIVER_SGP30_LINK_DEBUG_PRINT(&sensor->handle, a_event_debug_print);
+    sensor->iic_fd = iic_fd;
+    sensor->mux_addr = mux_addr;
+    sensor->channel = channel;
+    sensor->period_ms = period_ms;
+    sensor->callback = callback;
+    sensor->arg = arg;
+    sensor->state = EVENT_STATE_INIT;
+    
+    /* the timer */
+    sensor->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (sensor->timer_fd < 0)
+    {
+        perror("event: timerfd create failed.\n");
+        
+        return 1;
+    }
+    
+    /* the cadence grid of the sensor starts at the staggered first step */
+    stagger = (loop->sensor_num * EVENT_STAGGER_MS) % period_ms;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    next = (int64_t)now.tv_sec * EVENT_NS_PER_S + now.tv_nsec + (int64_t)stagger * 1000000LL;
+    sensor->next.tv_sec = (time_t)(next / EVENT_NS_PER_S);
+    sensor->next.tv_nsec = (long)(next % EVENT_NS_PER_S);
+    if (a_event_arm_after(sensor, stagger) != 0)
+    {
+        (void)close(sensor->timer_fd);
+        sensor->timer_fd = -1;
+        
+        return 1;
+    }
+    
+    /* watch it */
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = sensor;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, sensor->timer_fd, &ev) != 0)
+    {
+        perror("event: epoll add failed.\n");
+        (void)close(sensor->timer_fd);
+        sensor->timer_fd = -1;
+        
+        return 1;
+    }
+    loop->sensor_num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     event loop remove a sensor
+ * @param[in] *loop pointer to an event loop structure
+ * @param[in] *sensor pointer to a sensor structure
+ * @note      the iic fd is not closed
+ */
+void event_remove_sensor(event_loop_t *loop, event_sensor_t *sensor)
+{
+    if (sensor->timer_fd < 0)
+    {
+        return;
+    }
+    (void)epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, sensor->timer_fd, NULL);
+    (void)close(sensor->timer_fd);
+    sensor->timer_fd = -1;
+    sensor->handle.inited = 0;
+    loop->sensor_num--;
+}
+
+/**
+ * @brief     event loop advance every ready sensor
+ * @param[in] *loop pointer to an event loop structure
+ * @return    advanced sensor number
+ * @note      it never sleeps, the conversion and init waits are timerfd deadlines,
+ *            only the iic transfers of the ready sensors run in the call
+ */
+uint32_t event_process_ready(event_loop_t *loop)
+{
+    struct epoll_event ev[EVENT_MAX_READY];
+    uint32_t count;
+    int n;
+    int i;
+    
+    count = 0;
+    do
+    {
+        n = epoll_wait(loop->epoll_fd, ev, EVENT_MAX_READY, 0);
+    } while ((n < 0) && (errno == EINTR));
+    for (i = 0; i < n; i++)
+    {
+        if (event_sensor_process((event_sensor_t *)ev[i].data.ptr) == 0)
+        {
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief     event sensor get the fd
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    timerfd of the sensor
+ * @note      for services which register every timer themselves instead of event_get_fd
+ */
+int event_sensor_get_fd(event_sensor_t *sensor)
+{
+    return sensor->timer_fd;
+}
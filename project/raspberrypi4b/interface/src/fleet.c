@@ -0,0 +1,609 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      fleet.c
+ * @brief     fleet source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "fleet.h"
+#include "iic.h"
+#include "sampler.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief iic bus lock definition
+ */
+#ifndef IIC_LOCK_ENABLE
+    #define IIC_LOCK_ENABLE 0        /**< 1 shares every adapter with other processes by /run/lock/i2c-N.lock */
+#endif
+
+/**
+ * @brief bus of the calling worker, the driver callbacks have no context argument
+ */
+static __thread fleet_bus_t *gs_bus = NULL;
+
+/**
+ * @brief  fleet get the monotonic time
+ * @return time in microseconds
+ * @note   none
+ */
+static uint64_t a_fleet_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief  fleet iic init callback
+ * @return status code
+ *         - 0 success
+ * @note   the worker owns the fd, so there is nothing to open
+ */
+static uint8_t a_fleet_iic_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  fleet iic deinit callback
+ * @return status code
+ *         - 0 success
+ * @note   the worker closes the fd when it exits
+ */
+static uint8_t a_fleet_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     fleet iic write command callback
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_fleet_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_write_cmd(gs_bus->fd, addr, buf, len);
+}
+
+/**
+ * @brief      fleet iic read command callback
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_fleet_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_read_cmd(gs_bus->fd, addr, buf, len);
+}
+
+/**
+ * @brief fleet lock callback
+ * @note  none
+ */
+static void a_fleet_lock(void)
+{
+    (void)iic_lock(gs_bus->fd);
+}
+
+/**
+ * @brief fleet unlock callback
+ * @note  none
+ */
+static void a_fleet_unlock(void)
+{
+    (void)iic_unlock(gs_bus->fd);
+}
+
+/**
+ * @brief     fleet delay callback
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_fleet_delay_ms(uint32_t ms)
+{
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     fleet print callback
+ * @param[in] fmt format data
+ * @note      the bus name is prefixed
+ */
+static void a_fleet_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    va_start(args, fmt);
+    (void)vsnprintf(str, sizeof(str), fmt, args);
+    va_end(args);
+    (void)printf("%s: %s", gs_bus->name, str);
+}
+
+/**
+ * @brief     fleet select the mux channel
+ * @param[in] *bus pointer to a bus structure
+ * @param[in] channel mux channel
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      nothing is written without a mux
+ */
+static uint8_t a_fleet_select(fleet_bus_t *bus, uint8_t channel)
+{
+    uint8_t sel;
+    
+    if (bus->mux_addr == 0)
+    {
+        return 0;
+    }
+    sel = (uint8_t)(1 << channel);
+    
+    return iic_write_cmd(bus->fd, bus->mux_addr, &sel, 1);
+}
+
+/**
+ * @brief     fleet publish samples into the sink
+ * @param[in] *sink pointer to a sink structure
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] len sample number
+ * @note      a full ring overwrites the oldest samples, the workers never wait for the reader
+ */
+static void a_fleet_publish(fleet_sink_t *sink, const fleet_sample_t *sample, uint32_t len)
+{
+    uint32_t i;
+    
+    if (len == 0)
+    {
+        return;
+    }
+    (void)pthread_mutex_lock(&sink->mutex);
+    for (i = 0; i < len; i++)
+    {
+        sink->buf[sink->head % sink->size] = sample[i];
+        sink->head++;
+    }
+    if (sink->head - sink->tail > sink->size)
+    {
+        sink->dropped += sink->head - sink->tail - sink->size;
+        sink->tail = sink->head - sink->size;
+    }
+    (void)pthread_cond_broadcast(&sink->cond);
+    (void)pthread_mutex_unlock(&sink->mutex);
+}
+
+/**
+ * @brief     fleet worker thread
+ * @param[in] *arg pointer to a bus structure
+ * @return    NULL
+ * @note      one round starts a measurement on every sensor, waits the conversion once and fetches every sensor
+ */
+static void *a_fleet_worker(void *arg)
+{
+    fleet_bus_t *bus;
+    fleet_t *fleet;
+    fleet_sample_t sample[FLEET_MAX_CHANNEL];
+    uint8_t started[FLEET_MAX_CHANNEL];
+    iic_lock_stats_t lock;
+    sampler_t sampler;
+    uint64_t start;
+    uint64_t us;
+    uint32_t missed;
+    uint32_t round;
+    uint32_t n;
+    uint8_t ch;
+    
+    bus = (fleet_bus_t *)arg;
+    fleet = bus->fleet;
+    gs_bus = bus;
+    
+    /* init every sensor, the soft reset is a general call so it is not used here */
+    for (ch = 0; ch < bus->channel; ch++)
+    {
+        DRIVER_SGP30_LINK_INIT(&bus->handle[ch], sgp30_handle_t);
+        DRIVER_SGP30_LINK_IIC_INIT(&bus->handle[ch], a_fleet_iic_init);
+        DRIVER_SGP30_LINK_IIC_DEINIT(&bus->handle[ch], a_fleet_iic_deinit);
+        DRIVER_SGP30_LINK_IIC_WRITE_COMMAND(&bus->handle[ch], a_fleet_iic_write_cmd);
+        DRIVER_SGP30_LINK_IIC_READ_COMMAND(&bus->handle[ch], a_fleet_iic_read_cmd);
+        DRIVER_SGP30_LINK_DELAY_MS(&bus->handle[ch], a_fleet_delay_ms);
+        DRIVER_SGP30_LINK_DEBUG_PRINT(&bus->handle[ch], a_fleet_debug_print);
+        DRIVER_SGP30_LINK_LOCK(&bus->handle[ch], a_fleet_lock);
+        DRIVER_SGP30_LINK_UNLOCK(&bus->handle[ch], a_fleet_unlock);
+        (void)iic_lock(bus->fd);
+        if ((a_fleet_select(bus, ch) == 0) && (sgp30_init(&bus->handle[ch]) == 0) &&
+            (sgp30_iaq_init(&bus->handle[ch]) == 0))
+        {
+            bus->ready[ch] = 1;
+        }
+        (void)iic_unlock(bus->fd);
+    }
+    
+    /* run the rounds */
+    if (sampler_init(&sampler, fleet->period_ms) == 0)
+    {
+        for (round = 0; (fleet->rounds == 0) || (round < fleet->rounds); round++)
+        {
+            if ((fleet->stop != 0) || (sampler_wait(&sampler, &missed) != 0) || (fleet->stop != 0))
+            {
+                break;
+            }
+            start = a_fleet_now_us();
+            
+            /* start every sensor */
+            for (ch = 0; ch < bus->channel; ch++)
+            {
+                started[ch] = 0;
+                
+                /* the mux must not be switched by another process between the select and the command */
+                (void)iic_lock(bus->fd);
+                if ((bus->ready[ch] != 0) && (a_fleet_select(bus, ch) == 0) &&
+                    (sgp30_start_measure_iaq(&bus->handle[ch]) == 0))
+                {
+                    started[ch] = 1;
+                }
+                (void)iic_unlock(bus->fd);
+            }
+            
+            /* one conversion wait for the whole bus */
+            usleep(SGP30_MEASURE_IAQ_TIME_MS * 1000);
+            
+            /* fetch every sensor */
+            n = 0;
+            for (ch = 0; ch < bus->channel; ch++)
+            {
+                if (bus->ready[ch] == 0)
+                {
+                    continue;
+                }
+                sample[n].round = round;
+                sample[n].bus = bus->index;
+                sample[n].channel = ch;
+                sample[n].co2_eq_ppm = 0;
+                sample[n].tvoc_ppb = 0;
+                sample[n].res = 1;
+                (void)iic_lock(bus->fd);
+                if ((started[ch] != 0) && (a_fleet_select(bus, ch) == 0) &&
+                    (sgp30_get_measure_iaq_result(&bus->handle[ch], &sample[n].co2_eq_ppm, &sample[n].tvoc_ppb) == 0))
+                {
+                    sample[n].res = 0;
+                    bus->stats.samples++;
+                }
+                else
+                {
+                    bus->stats.failed++;
+                }
+                (void)iic_unlock(bus->fd);
+                sample[n].timestamp_ns = a_fleet_now_us() * 1000ULL;
+                n++;
+            }
+            a_fleet_publish(&fleet->sink, sample, n);
+            
+            /* update the stats */
+            us = a_fleet_now_us() - start;
+            bus->stats.rounds++;
+            bus->stats.missed += missed;
+            bus->stats.round_sum_us += us;
+            if (us > bus->stats.round_max_us)
+            {
+                bus->stats.round_max_us = us;
+            }
+        }
+    }
+    
+    /* keep the lock stats and close the bus */
+    if (iic_get_lock_stats(bus->fd, &lock) == 0)
+    {
+        bus->stats.lock_count = lock.count;
+        bus->stats.lock_contended = lock.contended;
+        bus->stats.lock_wait_sum_us = lock.wait_total_us;
+        bus->stats.lock_wait_max_us = lock.wait_max_us;
+        bus->stats.lock_hold_sum_us = lock.hold_total_us;
+        bus->stats.lock_hold_max_us = lock.hold_max_us;
+    }
+    (void)iic_deinit(bus->fd);
+    bus->fd = -1;
+    
+    /* wake the reader once the last worker is done */
+    (void)pthread_mutex_lock(&fleet->sink.mutex);
+    fleet->active--;
+    (void)pthread_cond_broadcast(&fleet->sink.cond);
+    (void)pthread_mutex_unlock(&fleet->sink.mutex);
+    
+    return NULL;
+}
+
+/**
+ * @brief     fleet init
+ * @param[in] *fleet pointer to a fleet structure
+ * @param[in] period_ms round period
+ * @param[in] sink_size sink ring size in samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t fleet_init(fleet_t *fleet, uint32_t period_ms, uint32_t sink_size)
+{
+    if ((period_ms == 0) || (sink_size == 0))
+    {
+        printf("fleet: param is invalid.\n");
+        
+        return 1;
+    }
+    memset(fleet, 0, sizeof(fleet_t));
+    fleet->period_ms = period_ms;
+    fleet->sink.size = sink_size;
+    fleet->sink.buf = (fleet_sample_t *)calloc(sink_size, sizeof(fleet_sample_t));
+    if (fleet->sink.buf == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_mutex_init(&fleet->sink.mutex, NULL);
+    (void)pthread_cond_init(&fleet->sink.cond, NULL);
+    
+    return 0;
+}
+
+/**
+ * @brief     fleet add an iic adapter
+ * @param[in] *fleet pointer to a fleet structure
+ * @param[in] *name pointer to an iic device name buffer
+ * @param[in] mux_addr iic mux write address, 0 means no mux
+ * @param[in] channel sensor number, it must be 1 without a mux
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      call it before fleet_start
+ */
+uint8_t fleet_add_bus(fleet_t *fleet, const char *name, uint8_t mux_addr, uint8_t channel)
+{
+    fleet_bus_t *bus;
+    
+    if ((fleet->bus_num >= FLEET_MAX_BUS) || (channel == 0) || (channel > FLEET_MAX_CHANNEL) ||
+        ((mux_addr == 0) && (channel != 1)) || (strlen(name) >= sizeof(bus->name)))
+    {
+        printf("fleet: param is invalid.\n");
+        
+        return 1;
+    }
+    bus = &fleet->bus[fleet->bus_num];
+    memset(bus, 0, sizeof(fleet_bus_t));
+    strcpy(bus->name, name);
+    bus->index = fleet->bus_num;
+    bus->mux_addr = mux_addr;
+    bus->channel = channel;
+    bus->fd = -1;
+    bus->fleet = fleet;
+    fleet->bus_num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     fleet start one worker per adapter
+ * @param[in] *fleet pointer to a fleet structure
+ * @param[in] rounds round number, 0 means until fleet_stop
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      every worker opens its own fd, inits its sensors and runs its own round on absolute deadlines,
+ *            the adapters are independent so the throughput grows with the adapter number
+ */
+uint8_t fleet_start(fleet_t *fleet, uint32_t rounds)
+{
+    fleet_bus_t *bus;
+    uint8_t i;
+    
+    if (fleet->bus_num == 0)
+    {
+        printf("fleet: no bus.\n");
+        
+        return 1;
+    }
+    fleet->rounds = rounds;
+    fleet->stop = 0;
+    fleet->start_us = a_fleet_now_us();
+    
+    /* open every adapter first, a missing one fails the start */
+    for (i = 0; i < fleet->bus_num; i++)
+    {
+        if (iic_init(fleet->bus[i].name, &fleet->bus[i].fd) != 0)
+        {
+            while (i > 0)
+            {
+                i--;
+                (void)iic_deinit(fleet->bus[i].fd);
+                fleet->bus[i].fd = -1;
+            }
+            
+            return 1;
+        }
+        
+        /* share the adapter with other processes, same as the sgp30 interface */
+        if (IIC_LOCK_ENABLE != 0)
+        {
+            if (iic_set_lock(fleet->bus[i].fd, NULL) != 0)
+            {
+                printf("fleet: %s cross-process bus lock is disabled.\n", fleet->bus[i].name);
+            }
+        }
+    }
+    
+    /* one worker per adapter */
+    for (i = 0; i < fleet->bus_num; i++)
+    {
+        bus = &fleet->bus[i];
+        (void)pthread_mutex_lock(&fleet->sink.mutex);
+        fleet->active++;
+        (void)pthread_mutex_unlock(&fleet->sink.mutex);
+        if (pthread_create(&bus->thread, NULL, a_fleet_worker, bus) != 0)
+        {
+            (void)pthread_mutex_lock(&fleet->sink.mutex);
+            fleet->active--;
+            (void)pthread_mutex_unlock(&fleet->sink.mutex);
+            perror("fleet: create worker failed.\n");
+            fleet_stop(fleet);
+            for (; i < fleet->bus_num; i++)
+            {
+                (void)iic_deinit(fleet->bus[i].fd);
+                fleet->bus[i].fd = -1;
+            }
+            
+            return 1;
+        }
+        bus->running = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      fleet read samples from the sink
+ * @param[in]  *fleet pointer to a fleet structure
+ * @param[out] *sample pointer to a sample buffer
+ * @param[in]  len buffer length
+ * @return     read sample number, 0 means every worker has finished and the sink is empty
+ * @note       it blocks until a worker publishes
+ */
+uint32_t fleet_read(fleet_t *fleet, fleet_sample_t *sample, uint32_t len)
+{
+    fleet_sink_t *sink;
+    uint32_t n;
+    
+    sink = &fleet->sink;
+    (void)pthread_mutex_lock(&sink->mutex);
+    while ((sink->head == sink->tail) && (fleet->active != 0))
+    {
+        (void)pthread_cond_wait(&sink->cond, &sink->mutex);
+    }
+    for (n = 0; (n < len) && (sink->tail != sink->head); n++)
+    {
+        sample[n] = sink->buf[sink->tail % sink->size];
+        sink->tail++;
+    }
+    (void)pthread_mutex_unlock(&sink->mutex);
+    
+    return n;
+}
+
+/**
+ * @brief     fleet stop and join the workers
+ * @param[in] *fleet pointer to a fleet structure
+ * @note      none
+ */
+void fleet_stop(fleet_t *fleet)
+{
+    uint8_t i;
+    
+    fleet->stop = 1;
+    for (i = 0; i < fleet->bus_num; i++)
+    {
+        if (fleet->bus[i].running != 0)
+        {
+            (void)pthread_join(fleet->bus[i].thread, NULL);
+            fleet->bus[i].running = 0;
+        }
+    }
+}
+
+/**
+ * @brief     fleet print the stats
+ * @param[in] *fleet pointer to a fleet structure
+ * @note      none
+ */
+void fleet_print_stats(fleet_t *fleet)
+{
+    fleet_stats_t *s;
+    uint64_t samples;
+    uint64_t us;
+    uint8_t i;
+    
+    samples = 0;
+    for (i = 0; i < fleet->bus_num; i++)
+    {
+        s = &fleet->bus[i].stats;
+        samples += s->samples;
+        printf("fleet: %s %llu rounds, %llu samples, %llu failed, %llu missed deadlines.\n", fleet->bus[i].name,
+               (unsigned long long)s->rounds, (unsigned long long)s->samples,
+               (unsigned long long)s->failed, (unsigned long long)s->missed);
+        if (s->rounds != 0)
+        {
+            printf("fleet: %s round avg %llu us, max %llu us.\n", fleet->bus[i].name,
+                   (unsigned long long)(s->round_sum_us / s->rounds), (unsigned long long)s->round_max_us);
+        }
+        if (s->lock_count != 0)
+        {
+            printf("fleet: %s %llu bus locks, %llu contended, wait avg %llu us, max %llu us, hold avg %llu us, max %llu us.\n",
+                   fleet->bus[i].name, (unsigned long long)s->lock_count, (unsigned long long)s->lock_contended,
+                   (unsigned long long)(s->lock_wait_sum_us / s->lock_count), (unsigned long long)s->lock_wait_max_us,
+                   (unsigned long long)(s->lock_hold_sum_us / s->lock_count), (unsigned long long)s->lock_hold_max_us);
+        }
+    }
+    us = a_fleet_now_us() - fleet->start_us;
+    if (us != 0)
+    {
+        printf("fleet: %d buses, %llu samples, %0.2f samples/s, %llu dropped.\n", fleet->bus_num,
+               (unsigned long long)samples, (double)samples * 1000000.0 / (double)us,
+               (unsigned long long)fleet->sink.dropped);
+    }
+}
+
+/**
+ * @brief     fleet deinit
+ * @param[in] *fleet pointer to a fleet structure
+ * @note      the workers are stopped first
+ */
+void fleet_deinit(fleet_t *fleet)
+{
+    fleet_stop(fleet);
+    (void)pthread_cond_destroy(&fleet->sink.cond);
+    (void)pthread_mutex_destroy(&fleet->sink.mutex);
+    free(fleet->sink.buf);
+    fleet->sink.buf = NULL;
+}
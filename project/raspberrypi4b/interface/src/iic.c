@@ -23,22 +23,564 @@
  *
  * @file      iic.c
  * @brief     iic source file
- * @version   1.0.0
+ * @version   1.1.0
  * @author    Shifeng Li
- * @date      2022-11-11
+ * @date      2026-10-19
  *
  * <h3>history</h3>
  * <table>
  * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.1      <td>Shifeng Li  <td>add bus recovery and batch transfer
  * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
  * </table>
  */
 
+#define _GNU_SOURCE
 #include "iic.h"
-#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <gpiod.h>
+
+/**
+ * @brief iic bus table size definition
+ */
+#define IIC_MAX_BUS        8        /**< max opened iic bus */
+
+/**
+ * @brief iic recovery timing definition
+ */
+#define IIC_RECOVERY_HALF_PERIOD_US        5          /**< 100 kHz clock */
+#define IIC_RECOVERY_REOPEN_TIMEOUT_MS     1000       /**< wait for the device node after the rebind */
+
+/**
+ * @brief iic lock definition
+ */
+#ifndef IIC_LOCK_DIR
+    #define IIC_LOCK_DIR "/run/lock"        /**< default lock file directory */
+#endif
+
+/**
+ * @brief iic bus structure definition
+ */
+typedef struct iic_bus_s
+{
+    uint8_t used;                            /**< used flag */
+    int fd;                                  /**< iic handle */
+    char name[64];                           /**< iic device name */
+    char chip[32];                           /**< gpio chip */
+    uint32_t scl;                            /**< scl gpio line */
+    uint32_t sda;                            /**< sda gpio line */
+    uint32_t threshold;                      /**< consecutive failures before recovery, 0 means disabled */
+    uint32_t failures;                       /**< consecutive bus stuck failures */
+    iic_recovery_stats_t stats;              /**< recovery stats */
+    uint64_t ioctls;                         /**< I2C_RDWR ioctl count */
+    unsigned long funcs;                     /**< adapter functionality */
+    uint8_t funcs_valid;                     /**< adapter functionality valid flag */
+    pthread_mutex_t lock;                    /**< bus lock, recursive */
+    uint32_t depth;                          /**< bus lock depth */
+    int lock_fd;                             /**< lock file handle, -1 means no cross-process lock */
+    uint64_t hold_start_us;                  /**< outermost lock time */
+    iic_lock_stats_t lock_stats;             /**< lock stats */
+} iic_bus_t;
+
+static iic_bus_t gs_bus[IIC_MAX_BUS];                           /**< iic bus table */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;    /**< iic bus table mutex */
+
+/**
+ * @brief  iic get the monotonic time
+ * @return time in microseconds
+ * @note   none
+ */
+static uint64_t a_iic_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     iic find the bus of a handle
+ * @param[in] fd iic handle
+ * @return    pointer to the bus or NULL
+ * @note      none
+ */
+static iic_bus_t *a_iic_find(int fd)
+{
+    iic_bus_t *bus;
+    uint32_t i;
+    
+    bus = NULL;
+    (void)pthread_mutex_lock(&gs_mutex);
+    for (i = 0; i < IIC_MAX_BUS; i++)
+    {
+        if ((gs_bus[i].used != 0) && (gs_bus[i].fd == fd))
+        {
+            bus = &gs_bus[i];
+            
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&gs_mutex);
+    
+    return bus;
+}
+
+/**
+ * @brief     iic lock a bus
+ * @param[in] *bus pointer to an iic bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the thread lock is taken first, the file lock only at the outermost level
+ */
+static uint8_t a_iic_lock(iic_bus_t *bus)
+{
+    struct flock fl;
+    uint64_t start;
+    uint64_t wait;
+    uint8_t contended;
+    
+    /* lock the threads */
+    start = a_iic_now_us();
+    contended = 0;
+    if (pthread_mutex_trylock(&bus->lock) != 0)
+    {
+        contended = 1;
+        (void)pthread_mutex_lock(&bus->lock);
+    }
+    bus->depth++;
+    if (bus->depth > 1)
+    {
+        return 0;
+    }
+    
+    /* lock the processes */
+    if (bus->lock_fd >= 0)
+    {
+        memset(&fl, 0, sizeof(struct flock));
+        fl.l_type = F_WRLCK;
+        fl.l_whence = SEEK_SET;
+        if (fcntl(bus->lock_fd, F_OFD_SETLK, &fl) < 0)
+        {
+            contended = 1;
+            while (fcntl(bus->lock_fd, F_OFD_SETLKW, &fl) < 0)
+            {
+                if (errno != EINTR)
+                {
+                    perror("iic: lock failed.\n");
+                    bus->depth--;
+                    (void)pthread_mutex_unlock(&bus->lock);
+                    
+                    return 1;
+                }
+            }
+        }
+    }
+    
+    /* update the stats */
+    bus->hold_start_us = a_iic_now_us();
+    wait = bus->hold_start_us - start;
+    bus->lock_stats.count++;
+    bus->lock_stats.contended += contended;
+    bus->lock_stats.wait_total_us += wait;
+    if (wait > bus->lock_stats.wait_max_us)
+    {
+        bus->lock_stats.wait_max_us = wait;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     iic unlock a bus
+ * @param[in] *bus pointer to an iic bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      the calling thread must hold the lock
+ */
+static uint8_t a_iic_unlock(iic_bus_t *bus)
+{
+    struct flock fl;
+    uint64_t hold;
+    
+    if (bus->depth == 0)
+    {
+        return 1;
+    }
+    bus->depth--;
+    if (bus->depth == 0)
+    {
+        /* update the stats */
+        hold = a_iic_now_us() - bus->hold_start_us;
+        bus->lock_stats.hold_total_us += hold;
+        if (hold > bus->lock_stats.hold_max_us)
+        {
+            bus->lock_stats.hold_max_us = hold;
+        }
+        
+        /* unlock the processes */
+        if (bus->lock_fd >= 0)
+        {
+            memset(&fl, 0, sizeof(struct flock));
+            fl.l_type = F_UNLCK;
+            fl.l_whence = SEEK_SET;
+            (void)fcntl(bus->lock_fd, F_OFD_SETLK, &fl);
+        }
+    }
+    (void)pthread_mutex_unlock(&bus->lock);
+    
+    return 0;
+}
+
+/**
+ * @brief     iic clear a stuck bus by gpio
+ * @param[in] *bus pointer to an iic bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 sda is still low
+ * @note      up to nine scl pulses are sent until the slave releases sda, then a stop is sent
+ */
+static uint8_t a_iic_bus_clear(iic_bus_t *bus)
+{
+    struct gpiod_chip *chip;
+    struct gpiod_line *scl;
+    struct gpiod_line *sda;
+    uint8_t res;
+    uint8_t i;
+    
+    /* open the lines as open drain outputs, so sda can be read back */
+    chip = gpiod_chip_open_lookup(bus->chip);
+    if (chip == NULL)
+    {
+        perror("iic: open gpio chip failed.\n");
+        
+        return 1;
+    }
+    scl = gpiod_chip_get_line(chip, bus->scl);
+    sda = gpiod_chip_get_line(chip, bus->sda);
+    if ((scl == NULL) || (sda == NULL))
+    {
+        perror("iic: get gpio line failed.\n");
+        gpiod_chip_close(chip);
+        
+        return 1;
+    }
+    if (gpiod_line_request_output_flags(scl, "iic-recovery", GPIOD_LINE_REQUEST_FLAG_OPEN_DRAIN, 1) < 0)
+    {
+        perror("iic: request scl failed.\n");
+        gpiod_chip_close(chip);
+        
+        return 1;
+    }
+    if (gpiod_line_request_output_flags(sda, "iic-recovery", GPIOD_LINE_REQUEST_FLAG_OPEN_DRAIN, 1) < 0)
+    {
+        perror("iic: request sda failed.\n");
+        gpiod_line_release(scl);
+        gpiod_chip_close(chip);
+        
+        return 1;
+    }
+    
+    /* clock out the byte the slave is sending */
+    for (i = 0; i < 9; i++)
+    {
+        if (gpiod_line_get_value(sda) == 1)
+        {
+            break;
+        }
+        (void)gpiod_line_set_value(scl, 0);
+        usleep(IIC_RECOVERY_HALF_PERIOD_US);
+        (void)gpiod_line_set_value(scl, 1);
+        usleep(IIC_RECOVERY_HALF_PERIOD_US);
+    }
+    
+    /* send a stop */
+    (void)gpiod_line_set_value(scl, 0);
+    usleep(IIC_RECOVERY_HALF_PERIOD_US);
+    (void)gpiod_line_set_value(sda, 0);
+    usleep(IIC_RECOVERY_HALF_PERIOD_US);
+    (void)gpiod_line_set_value(scl, 1);
+    usleep(IIC_RECOVERY_HALF_PERIOD_US);
+    (void)gpiod_line_set_value(sda, 1);
+    usleep(IIC_RECOVERY_HALF_PERIOD_US);
+    
+    /* check the bus is idle */
+    res = ((gpiod_line_get_value(sda) == 1) && (gpiod_line_get_value(scl) == 1)) ? 0 : 1;
+    
+    /* release the lines */
+    gpiod_line_release(sda);
+    gpiod_line_release(scl);
+    gpiod_chip_close(chip);
+    
+    return res;
+}
+
+/**
+ * @brief     iic write a string to a sysfs file
+ * @param[in] *path pointer to a file path
+ * @param[in] *str pointer to a string
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_iic_sysfs_write(const char *path, const char *str)
+{
+    int fd;
+    ssize_t res;
+    
+    fd = open(path, O_WRONLY);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    res = write(fd, str, strlen(str));
+    (void)close(fd);
+    
+    return (res == (ssize_t)strlen(str)) ? 0 : 1;
+}
+
+/**
+ * @brief     iic rebind the adapter driver and reopen the device
+ * @param[in] *bus pointer to an iic bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 rebind failed
+ * @note      the gpio request leaves the pins in gpio mode, binding the driver again restores the pin mux,
+ *            the handle number is kept so the caller's fd stays valid
+ */
+static uint8_t a_iic_rebind(iic_bus_t *bus)
+{
+    char path[PATH_MAX + 16];
+    char dev[PATH_MAX];
+    char drv[PATH_MAX];
+    const char *adapter;
+    const char *dev_name;
+    uint64_t start;
+    int fd;
+    
+    /* find the adapter device and its driver, path has room for a resolved path and the sysfs suffix */
+    adapter = strrchr(bus->name, '/');
+    adapter = (adapter != NULL) ? (adapter + 1) : bus->name;
+    (void)snprintf(path, sizeof(path), "/sys/class/i2c-dev/%s/device/..", adapter);
+    if (realpath(path, dev) == NULL)
+    {
+        perror("iic: find adapter failed.\n");
+        
+        return 1;
+    }
+    (void)snprintf(path, sizeof(path), "%s/driver", dev);
+    if (realpath(path, drv) == NULL)
+    {
+        perror("iic: find driver failed.\n");
+        
+        return 1;
+    }
+    dev_name = strrchr(dev, '/') + 1;
+    
+    /* unbind and bind */
+    (void)snprintf(path, sizeof(path), "%s/unbind", drv);
+    if (a_iic_sysfs_write(path, dev_name) != 0)
+    {
+        perror("iic: unbind failed.\n");
+        
+        return 1;
+    }
+    (void)snprintf(path, sizeof(path), "%s/bind", drv);
+    if (a_iic_sysfs_write(path, dev_name) != 0)
+    {
+        perror("iic: bind failed.\n");
+        
+        return 1;
+    }
+    
+    /* wait for the device node */
+    start = a_iic_now_us();
+    while (1)
+    {
+        fd = open(bus->name, O_RDWR);
+        if (fd >= 0)
+        {
+            break;
+        }
+        if ((a_iic_now_us() - start) > (uint64_t)IIC_RECOVERY_REOPEN_TIMEOUT_MS * 1000)
+        {
+            perror("iic: reopen failed.\n");
+            
+            return 1;
+        }
+        usleep(10 * 1000);
+    }
+    
+    /* keep the handle number */
+    if (dup2(fd, bus->fd) < 0)
+    {
+        perror("iic: dup2 failed.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    (void)close(fd);
+    
+    return 0;
+}
+
+/**
+ * @brief     iic run the bus recovery
+ * @param[in] *bus pointer to an iic bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 recovery failed
+ * @note      none
+ */
+static uint8_t a_iic_recover(iic_bus_t *bus)
+{
+    uint64_t start;
+    uint64_t t;
+    uint8_t res;
+    
+    /* clear the bus and restore the adapter */
+    start = a_iic_now_us();
+    res = a_iic_bus_clear(bus);
+    if (a_iic_rebind(bus) != 0)
+    {
+        res = 1;
+    }
+    t = a_iic_now_us() - start;
+    
+    /* update the stats */
+    bus->stats.count++;
+    if (res != 0)
+    {
+        bus->stats.failed++;
+    }
+    bus->stats.last_us = t;
+    bus->stats.total_us += t;
+    if (t > bus->stats.max_us)
+    {
+        bus->stats.max_us = t;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief         iic transmit the messages with the bus locked
+ * @param[in]     fd iic handle
+ * @param[in]     *bus pointer to an iic bus, NULL means the fd is not in the bus table
+ * @param[in,out] *msgs pointer to a message buffer
+ * @param[in]     num message number
+ * @param[in]     *err pointer to an error string
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          the bus is recovered and the messages are sent again after the failure threshold is reached,
+ *                only a timeout, a lost arbitration or a bus error counts, a nack means the bus still works,
+ *                the bcm2835 adapter reports a clock stretch timeout as EIO
+ */
+static uint8_t a_iic_transfer_locked(int fd, iic_bus_t *bus, struct i2c_msg *msgs, uint32_t num, const char *err)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    int e;
+    
+    /* set the param */
+    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+    i2c_rdwr_data.msgs = msgs;
+    i2c_rdwr_data.nmsgs = num;
+    
+    /* transmit */
+    if (bus != NULL)
+    {
+        bus->ioctls++;
+    }
+    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) >= 0)
+    {
+        if (bus != NULL)
+        {
+            bus->failures = 0;
+        }
+        
+        return 0;
+    }
+    e = errno;
+    perror(err);
+    
+    /* check the failure threshold */
+    if ((bus == NULL) || (bus->threshold == 0))
+    {
+        return 1;
+    }
+    
+    /* an absent or power cycled device nacks with ENXIO or EREMOTEIO, the rebind would only
+       invalidate the other handles of the adapter */
+    if ((e != ETIMEDOUT) && (e != EAGAIN) && (e != EIO))
+    {
+        bus->failures = 0;
+        
+        return 1;
+    }
+    bus->failures++;
+    if (bus->failures < bus->threshold)
+    {
+        return 1;
+    }
+    bus->failures = 0;
+    
+    /* recover and try again */
+    if (a_iic_recover(bus) != 0)
+    {
+        return 1;
+    }
+    bus->ioctls++;
+    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    {
+        perror(err);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief         iic transmit the messages
+ * @param[in]     fd iic handle
+ * @param[in,out] *msgs pointer to a message buffer
+ * @param[in]     num message number
+ * @param[in]     *err pointer to an error string
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          the bus is locked over the transfer and the recovery
+ */
+static uint8_t a_iic_transfer(int fd, struct i2c_msg *msgs, uint32_t num, const char *err)
+{
+    iic_bus_t *bus;
+    uint8_t res;
+    
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return a_iic_transfer_locked(fd, NULL, msgs, num, err);
+    }
+    if (a_iic_lock(bus) != 0)
+    {
+        return 1;
+    }
+    res = a_iic_transfer_locked(fd, bus, msgs, num, err);
+    (void)a_iic_unlock(bus);
+    
+    return res;
+}
 
 /**
  * @brief      iic bus init
@@ -47,10 +589,13 @@
  * @return     status code
  *             - 0 success
  *             - 1 init failed
- * @note       none
+ * @note       at most 8 buses can be opened at once, one more fails
  */
 uint8_t iic_init(char *name, int *fd)
 {
+    pthread_mutexattr_t attr;
+    uint32_t i;
+    
     /* open the device */
     *fd = open(name, O_RDWR);
     
@@ -61,10 +606,39 @@ uint8_t iic_init(char *name, int *fd)
      
         return 1;
     }
-    else
+    
+    /* add to the bus table, recovery is disabled by default */
+    (void)pthread_mutex_lock(&gs_mutex);
+    for (i = 0; i < IIC_MAX_BUS; i++)
     {
-        return 0;
+        if (gs_bus[i].used == 0)
+        {
+            memset(&gs_bus[i], 0, sizeof(iic_bus_t));
+            gs_bus[i].used = 1;
+            gs_bus[i].fd = *fd;
+            gs_bus[i].lock_fd = -1;
+            (void)strncpy(gs_bus[i].name, name, sizeof(gs_bus[i].name) - 1);
+            (void)pthread_mutexattr_init(&attr);
+            (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+            (void)pthread_mutex_init(&gs_bus[i].lock, &attr);
+            (void)pthread_mutexattr_destroy(&attr);
+            
+            break;
+        }
     }
+    (void)pthread_mutex_unlock(&gs_mutex);
+    
+    /* a bus out of the table would have no lock and no recovery */
+    if (i == IIC_MAX_BUS)
+    {
+        printf("iic: bus table is full.\n");
+        (void)close(*fd);
+        *fd = -1;
+        
+        return 1;
+    }
+    
+    return 0;
 }
 
 /**
@@ -77,6 +651,27 @@ uint8_t iic_init(char *name, int *fd)
  */
 uint8_t iic_deinit(int fd)
 {
+    uint32_t i;
+    
+    /* remove from the bus table */
+    (void)pthread_mutex_lock(&gs_mutex);
+    for (i = 0; i < IIC_MAX_BUS; i++)
+    {
+        if ((gs_bus[i].used != 0) && (gs_bus[i].fd == fd))
+        {
+            gs_bus[i].used = 0;
+            if (gs_bus[i].lock_fd >= 0)
+            {
+                (void)close(gs_bus[i].lock_fd);
+                gs_bus[i].lock_fd = -1;
+            }
+            (void)pthread_mutex_destroy(&gs_bus[i].lock);
+            
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&gs_mutex);
+    
     /* close the device */
     if (close(fd) < 0)
     {
@@ -90,6 +685,236 @@ uint8_t iic_deinit(int fd)
     }
 }
 
+/**
+ * @brief     iic bus set the recovery
+ * @param[in] fd iic handle
+ * @param[in] *chip pointer to a gpio chip name, path or number
+ * @param[in] scl scl gpio line
+ * @param[in] sda sda gpio line
+ * @param[in] threshold consecutive bus stuck failures before recovery, 0 means disabled
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the recovery needs the permission to request the gpio lines and to write the driver bind files
+ */
+uint8_t iic_set_recovery(int fd, char *chip, uint32_t scl, uint32_t sda, uint32_t threshold)
+{
+    iic_bus_t *bus;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 1;
+    }
+    
+    /* save the config */
+    memset(bus->chip, 0, sizeof(bus->chip));
+    (void)strncpy(bus->chip, chip, sizeof(bus->chip) - 1);
+    bus->scl = scl;
+    bus->sda = sda;
+    bus->threshold = threshold;
+    bus->failures = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     iic bus recover now
+ * @param[in] fd iic handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 recover failed
+ * @note      iic_set_recovery must be called before
+ */
+uint8_t iic_recover(int fd)
+{
+    iic_bus_t *bus;
+    uint8_t res;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if ((bus == NULL) || (bus->chip[0] == 0))
+    {
+        return 1;
+    }
+    if (a_iic_lock(bus) != 0)
+    {
+        return 1;
+    }
+    res = a_iic_recover(bus);
+    (void)a_iic_unlock(bus);
+    
+    return res;
+}
+
+/**
+ * @brief      iic bus get the recovery stats
+ * @param[in]  fd iic handle
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t iic_get_recovery_stats(int fd, iic_recovery_stats_t *stats)
+{
+    iic_bus_t *bus;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 1;
+    }
+    
+    /* the stats are updated by a recovery under the bus lock */
+    if (a_iic_lock(bus) != 0)
+    {
+        return 1;
+    }
+    *stats = bus->stats;
+    (void)a_iic_unlock(bus);
+    
+    return 0;
+}
+
+/**
+ * @brief     iic bus enable the cross-process lock
+ * @param[in] fd iic handle
+ * @param[in] *path pointer to a lock file path, NULL means IIC_LOCK_DIR/<adapter>.lock
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      every process opening the same lock file shares the bus,
+ *            an OFD lock is taken on the file, so fds of the same process exclude each other as well
+ */
+uint8_t iic_set_lock(int fd, char *path)
+{
+    char file[PATH_MAX];
+    const char *adapter;
+    iic_bus_t *bus;
+    int lock_fd;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 1;
+    }
+    
+    /* the default file is named after the adapter, /dev/i2c-1 locks /run/lock/i2c-1.lock */
+    if (path == NULL)
+    {
+        adapter = strrchr(bus->name, '/');
+        adapter = (adapter != NULL) ? (adapter + 1) : bus->name;
+        (void)snprintf(file, sizeof(file), "%s/%s.lock", IIC_LOCK_DIR, adapter);
+    }
+    else
+    {
+        (void)snprintf(file, sizeof(file), "%s", path);
+    }
+    
+    /* open the lock file, every user of the bus must be able to open it */
+    lock_fd = open(file, O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (lock_fd < 0)
+    {
+        perror("iic: open lock file failed.\n");
+        
+        return 1;
+    }
+    (void)fchmod(lock_fd, 0666);
+    
+    /* replace the lock file while nobody holds the bus, the caller must not hold it either */
+    (void)pthread_mutex_lock(&bus->lock);
+    if (bus->depth != 0)
+    {
+        (void)pthread_mutex_unlock(&bus->lock);
+        (void)close(lock_fd);
+        
+        return 1;
+    }
+    if (bus->lock_fd >= 0)
+    {
+        (void)close(bus->lock_fd);
+    }
+    bus->lock_fd = lock_fd;
+    (void)pthread_mutex_unlock(&bus->lock);
+    
+    return 0;
+}
+
+/**
+ * @brief     iic bus lock
+ * @param[in] fd iic handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the lock nests in one thread, so a caller can hold the bus over a write, wait and read,
+ *            every transfer takes it, the threads of the process are serialized even without iic_set_lock
+ */
+uint8_t iic_lock(int fd)
+{
+    iic_bus_t *bus;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 1;
+    }
+    
+    return a_iic_lock(bus);
+}
+
+/**
+ * @brief     iic bus unlock
+ * @param[in] fd iic handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t iic_unlock(int fd)
+{
+    iic_bus_t *bus;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 1;
+    }
+    
+    return a_iic_unlock(bus);
+}
+
+/**
+ * @brief      iic bus get the lock stats
+ * @param[in]  fd iic handle
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       the wait and hold are counted at the outermost lock only
+ */
+uint8_t iic_get_lock_stats(int fd, iic_lock_stats_t *stats)
+{
+    iic_bus_t *bus;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 1;
+    }
+    (void)pthread_mutex_lock(&bus->lock);
+    *stats = bus->lock_stats;
+    (void)pthread_mutex_unlock(&bus->lock);
+    
+    return 0;
+}
+
 /**
  * @brief      iic bus read command
  * @param[in]  fd iic handle
@@ -103,12 +928,8 @@ uint8_t iic_deinit(int fd)
  */
 uint8_t iic_read_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
 {
-    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[1];
     
-    /* clear ioctl data */
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
-
     /* clear msgs data */
     memset(msgs, 0, sizeof(struct i2c_msg) * 1);
     
@@ -117,18 +938,9 @@ uint8_t iic_read_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
     msgs[0].flags = I2C_M_RD;
     msgs[0].buf = buf;
     msgs[0].len = len;
-    i2c_rdwr_data.msgs = msgs;
-    i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
-    {
-        perror("iic: read failed.\n");
-        
-        return 1;
-    }
-     
-    return 0;
+    return a_iic_transfer(fd, msgs, 1, "iic: read failed.\n");
 }
 
 /**
@@ -145,12 +957,8 @@ uint8_t iic_read_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[2];
     
-    /* clear ioctl data */
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
-    
     /* clear msgs data */
     memset(msgs, 0, sizeof(struct i2c_msg) * 2);
     
@@ -163,18 +971,9 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     msgs[1].flags = I2C_M_RD;
     msgs[1].buf = buf;
     msgs[1].len = len;
-    i2c_rdwr_data.msgs = msgs;
-    i2c_rdwr_data.nmsgs = 2;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
-    {
-        perror("iic: read failed.\n");
-        
-        return 1;
-    }
-     
-    return 0;
+    return a_iic_transfer(fd, msgs, 2, "iic: read failed.\n");
 }
 
 /**
@@ -191,13 +990,9 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[2];
     uint8_t addr_buf[2];
     
-    /* clear ioctl data */
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
-    
     /* clear msgs data */
     memset(msgs, 0, sizeof(struct i2c_msg) * 2);
     
@@ -212,18 +1007,9 @@ uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uin
     msgs[1].flags = I2C_M_RD;
     msgs[1].buf = buf;
     msgs[1].len = len;
-    i2c_rdwr_data.msgs = msgs;
-    i2c_rdwr_data.nmsgs = 2;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
-    {
-        perror("iic: read failed.\n");
-        
-        return 1;
-    }
-     
-    return 0;
+    return a_iic_transfer(fd, msgs, 2, "iic: read failed.\n");
 }
 
 /**
@@ -239,12 +1025,8 @@ uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uin
  */
 uint8_t iic_write_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
 {
-    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[1];
     
-    /* clear ioctl data */
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
-    
     /* clear msgs data */
     memset(msgs, 0, sizeof(struct i2c_msg) * 1);
     
@@ -253,18 +1035,9 @@ uint8_t iic_write_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
     msgs[0].flags = 0;
     msgs[0].buf = buf;
     msgs[0].len = len;
-    i2c_rdwr_data.msgs = msgs;
-    i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
-    {
-        perror("iic: write failed.\n");
-        
-        return 1;
-    }
-     
-    return 0;
+    return a_iic_transfer(fd, msgs, 1, "iic: write failed.\n");
 }
 
 /**
@@ -281,13 +1054,9 @@ uint8_t iic_write_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[1];
     uint8_t buf_send[len + 1];
     
-    /* clear ioctl data */
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
-    
     /* clear msgs data */
     memset(msgs, 0, sizeof(struct i2c_msg) * 1);
     
@@ -301,18 +1070,9 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     memcpy(&buf_send[1], buf, len);
     msgs[0].buf = buf_send;
     msgs[0].len = len + 1;
-    i2c_rdwr_data.msgs = msgs;
-    i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
-    {
-        perror("iic: write failed.\n");
-        
-        return 1;
-    }
-     
-    return 0;
+    return a_iic_transfer(fd, msgs, 1, "iic: write failed.\n");
 }
 
 /**
@@ -329,13 +1089,9 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
     struct i2c_msg msgs[1];
     uint8_t buf_send[len + 2];
     
-    /* clear ioctl data */
-    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
-    
     /* clear msgs data */
     memset(msgs, 0, sizeof(struct i2c_msg) * 1);
     
@@ -350,16 +1106,182 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
     memcpy(&buf_send[2], buf, len);
     msgs[0].buf = buf_send;
     msgs[0].len = len + 2;
-    i2c_rdwr_data.msgs = msgs;
-    i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    return a_iic_transfer(fd, msgs, 1, "iic: write failed.\n");
+}
+
+/**
+ * @brief     iic bus get the I2C_RDWR ioctl count
+ * @param[in] fd iic handle
+ * @return    ioctl count
+ * @note      a recovered transfer counts twice
+ */
+uint64_t iic_get_ioctl_count(int fd)
+{
+    iic_bus_t *bus;
+    
+    /* find the bus */
+    bus = a_iic_find(fd);
+    if (bus == NULL)
+    {
+        return 0;
+    }
+    
+    return bus->ioctls;
+}
+
+/**
+ * @brief     iic batch init
+ * @param[in] *batch pointer to an iic batch structure
+ * @note      none
+ */
+void iic_batch_init(iic_batch_t *batch)
+{
+    memset(batch, 0, sizeof(iic_batch_t));
+}
+
+/**
+ * @brief     iic batch add a message
+ * @param[in] *batch pointer to an iic batch structure
+ * @param[in] addr iic device write address
+ * @param[in] flags message flags
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @param[in] stop stop after the message
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch is full
+ * @note      none
+ */
+static uint8_t a_iic_batch_add(iic_batch_t *batch, uint8_t addr, uint16_t flags, uint8_t *buf, uint16_t len, uint8_t stop)
+{
+    struct i2c_msg *msg;
+    
+    if (batch->num >= IIC_BATCH_MAX_MSG)
     {
-        perror("iic: write failed.\n");
-        
         return 1;
     }
-     
+    
+    /* set the param */
+    msg = &batch->msgs[batch->num];
+    memset(msg, 0, sizeof(struct i2c_msg));
+    msg->addr = addr >> 1;
+    msg->flags = flags;
+    msg->buf = buf;
+    msg->len = len;
+    batch->stop[batch->num] = (stop != 0) ? 1 : 0;
+    batch->num++;
+    
     return 0;
 }
+
+/**
+ * @brief     iic batch add a write message
+ * @param[in] *batch pointer to an iic batch structure
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @param[in] stop stop after the message
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch is full
+ * @note      addr = device_address_7bits << 1, the buffer must be valid until the batch is submitted
+ */
+uint8_t iic_batch_add_write(iic_batch_t *batch, uint8_t addr, uint8_t *buf, uint16_t len, uint8_t stop)
+{
+    return a_iic_batch_add(batch, addr, 0, buf, len, stop);
+}
+
+/**
+ * @brief      iic batch add a read message
+ * @param[in]  *batch pointer to an iic batch structure
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  stop stop after the message
+ * @return     status code
+ *             - 0 success
+ *             - 1 batch is full
+ * @note       addr = device_address_7bits << 1, the buffer is filled when the batch is submitted
+ */
+uint8_t iic_batch_add_read(iic_batch_t *batch, uint8_t addr, uint8_t *buf, uint16_t len, uint8_t stop)
+{
+    return a_iic_batch_add(batch, addr, I2C_M_RD, buf, len, stop);
+}
+
+/**
+ * @brief         iic batch submit all messages
+ * @param[in]     fd iic handle
+ * @param[in,out] *batch pointer to an iic batch structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 submit failed
+ * @note          messages are sent with as few I2C_RDWR calls as I2C_RDWR_IOCTL_MAX_MSGS allows,
+ *                a stop inside one call needs I2C_FUNC_PROTOCOL_MANGLING, otherwise the call ends at that message,
+ *                the batch is empty after the submit
+ */
+uint8_t iic_batch_submit(int fd, iic_batch_t *batch)
+{
+    iic_bus_t *bus;
+    unsigned long funcs;
+    uint8_t mangling;
+    uint32_t start;
+    uint32_t i;
+    uint8_t res;
+    
+    /* get the adapter functionality once */
+    funcs = 0;
+    bus = a_iic_find(fd);
+    if ((bus != NULL) && (bus->funcs_valid != 0))
+    {
+        funcs = bus->funcs;
+    }
+    else
+    {
+        if (ioctl(fd, I2C_FUNCS, &funcs) < 0)
+        {
+            funcs = 0;
+        }
+        if (bus != NULL)
+        {
+            bus->funcs = funcs;
+            bus->funcs_valid = 1;
+        }
+    }
+    mangling = ((funcs & I2C_FUNC_PROTOCOL_MANGLING) != 0) ? 1 : 0;
+    
+    /* split the messages into ioctl calls, the bus stays locked over the whole batch */
+    if ((bus != NULL) && (a_iic_lock(bus) != 0))
+    {
+        batch->num = 0;
+        
+        return 1;
+    }
+    res = 0;
+    start = 0;
+    for (i = 0; i < batch->num; i++)
+    {
+        if ((batch->stop[i] != 0) && (mangling != 0))
+        {
+            batch->msgs[i].flags |= I2C_M_STOP;
+        }
+        if ((i == (batch->num - 1)) || ((i - start + 1) == I2C_RDWR_IOCTL_MAX_MSGS) ||
+            ((batch->stop[i] != 0) && (mangling == 0)))
+        {
+            res = a_iic_transfer(fd, &batch->msgs[start], i - start + 1, "iic: batch failed.\n");
+            if (res != 0)
+            {
+                break;
+            }
+            start = i + 1;
+        }
+    }
+    batch->num = 0;
+    if (bus != NULL)
+    {
+        (void)a_iic_unlock(bus);
+    }
+    
+    return res;
+}
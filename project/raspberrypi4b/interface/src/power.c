@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      power.c
+ * @brief     power source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "power.h"
+#include <gpiod.h>
+
+/**
+ * @brief power gpio handle definition
+ */
+static struct gpiod_chip *gs_chip = NULL;        /**< power gpio chip */
+static struct gpiod_line *gs_line = NULL;        /**< power gpio line */
+
+/**
+ * @brief     power enable gpio init
+ * @param[in] *chip pointer to a gpio chip name, path or number
+ * @param[in] line power enable gpio line, high is on
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the line is requested as an output and driven high
+ */
+uint8_t power_init(char *chip, uint32_t line)
+{
+    /* check the line */
+    if (gs_line != NULL)
+    {
+        printf("power: line is requested.\n");
+        
+        return 1;
+    }
+    
+    /* request the line */
+    gs_chip = gpiod_chip_open_lookup(chip);
+    if (gs_chip == NULL)
+    {
+        perror("power: open gpio chip failed.\n");
+        
+        return 1;
+    }
+    gs_line = gpiod_chip_get_line(gs_chip, line);
+    if ((gs_line == NULL) || (gpiod_line_request_output(gs_line, "sgp30-power", 1) < 0))
+    {
+        perror("power: request gpio failed.\n");
+        gpiod_chip_close(gs_chip);
+        gs_chip = NULL;
+        gs_line = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  power enable gpio deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the line is released and keeps its level
+ */
+uint8_t power_deinit(void)
+{
+    /* check the line */
+    if (gs_line == NULL)
+    {
+        return 1;
+    }
+    
+    /* release the line */
+    gpiod_line_release(gs_line);
+    gpiod_chip_close(gs_chip);
+    gs_line = NULL;
+    gs_chip = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief     power enable gpio set the level
+ * @param[in] enable power enable
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      power_init must be called before
+ */
+uint8_t power_set(uint8_t enable)
+{
+    /* check the line */
+    if (gs_line == NULL)
+    {
+        printf("power: line is not requested.\n");
+        
+        return 1;
+    }
+    
+    /* set the level */
+    if (gpiod_line_set_value(gs_line, (enable != 0) ? 1 : 0) < 0)
+    {
+        perror("power: set gpio failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,418 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rawcodec.c
+ * @brief     rawcodec source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "rawcodec.h"
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+/**
+ * @brief rawcodec unpack function definition
+ */
+typedef void (*rawcodec_unpack_t)(const uint8_t *packed, uint8_t bits, uint16_t base, uint16_t *out);
+
+/**
+ * @brief     rawcodec put a little endian 32 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_rawcodec_put32(uint8_t *buf, uint32_t v)
+{
+    buf[0] = (uint8_t)(v >> 0);
+    buf[1] = (uint8_t)(v >> 8);
+    buf[2] = (uint8_t)(v >> 16);
+    buf[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief     rawcodec get a little endian 32 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_rawcodec_get32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * @brief      rawcodec unpack a block without simd
+ * @param[in]  *packed pointer to the packed words
+ * @param[in]  bits bit width
+ * @param[in]  base first value
+ * @param[out] *out pointer to a buffer of RAWCODEC_BLOCK values
+ * @note       value i is the k = i / 4 field of lane i % 4, word w of a lane is at w * 4 + lane
+ */
+static void a_rawcodec_unpack_scalar(const uint8_t *packed, uint8_t bits, uint16_t base, uint16_t *out)
+{
+    uint32_t mask;
+    uint32_t prev;
+    uint32_t off;
+    uint32_t x;
+    uint32_t i;
+    uint32_t w;
+    uint32_t s;
+    
+    mask = (1U << bits) - 1;
+    prev = base;
+    for (i = 0; i < RAWCODEC_BLOCK; i++)
+    {
+        off = (i / RAWCODEC_LANE) * bits;
+        w = off >> 5;
+        s = off & 31;
+        x = a_rawcodec_get32(packed + (w * RAWCODEC_LANE + i % RAWCODEC_LANE) * 4) >> s;
+        if ((s + bits) > 32)
+        {
+            x |= a_rawcodec_get32(packed + ((w + 1) * RAWCODEC_LANE + i % RAWCODEC_LANE) * 4) << (32 - s);
+        }
+        x &= mask;
+        prev += (x >> 1) ^ (0U - (x & 1));
+        out[i] = (uint16_t)prev;
+    }
+}
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+/**
+ * @brief      rawcodec unpack a block with neon
+ * @param[in]  *packed pointer to the packed words
+ * @param[in]  bits bit width
+ * @param[in]  base first value
+ * @param[out] *out pointer to a buffer of RAWCODEC_BLOCK values
+ * @note       the four lanes are unpacked at once, then a prefix sum runs inside the vector
+ */
+static void a_rawcodec_unpack_simd(const uint8_t *packed, uint8_t bits, uint16_t base, uint16_t *out)
+{
+    uint32x4_t mask;
+    uint32x4_t prev;
+    uint32x4_t zero;
+    uint32x4_t one;
+    uint32x4_t x;
+    uint32x4_t d;
+    uint32_t off;
+    uint32_t k;
+    uint32_t w;
+    uint32_t s;
+    
+    mask = vdupq_n_u32((1U << bits) - 1);
+    prev = vdupq_n_u32(base);
+    zero = vdupq_n_u32(0);
+    one = vdupq_n_u32(1);
+    for (k = 0; k < RAWCODEC_BLOCK / RAWCODEC_LANE; k++)
+    {
+        off = k * bits;
+        w = off >> 5;
+        s = off & 31;
+        
+        /* a negative count shifts right */
+        x = vshlq_u32(vreinterpretq_u32_u8(vld1q_u8(packed + w * 16)), vdupq_n_s32(-(int32_t)s));
+        if ((s + bits) > 32)
+        {
+            x = vorrq_u32(x, vshlq_u32(vreinterpretq_u32_u8(vld1q_u8(packed + (w + 1) * 16)),
+                                       vdupq_n_s32((int32_t)(32 - s))));
+        }
+        x = vandq_u32(x, mask);
+        
+        /* zigzag and the prefix sum of the four deltas */
+        d = veorq_u32(vshrq_n_u32(x, 1), vsubq_u32(zero, vandq_u32(x, one)));
+        d = vaddq_u32(d, vextq_u32(zero, d, 3));
+        d = vaddq_u32(d, vextq_u32(zero, d, 2));
+        d = vaddq_u32(d, prev);
+        prev = vdupq_n_u32(vgetq_lane_u32(d, 3));
+        vst1_u16(out + k * RAWCODEC_LANE, vmovn_u32(d));
+    }
+}
+
+#elif defined(__SSE2__)
+
+/**
+ * @brief      rawcodec unpack a block with sse2
+ * @param[in]  *packed pointer to the packed words
+ * @param[in]  bits bit width
+ * @param[in]  base first value
+ * @param[out] *out pointer to a buffer of RAWCODEC_BLOCK values
+ * @note       the four lanes are unpacked at once, then a prefix sum runs inside the vector,
+ *             the values are biased by 32768 to narrow them with the signed saturating pack
+ */
+static void a_rawcodec_unpack_simd(const uint8_t *packed, uint8_t bits, uint16_t base, uint16_t *out)
+{
+    const __m128i *word;
+    __m128i mask;
+    __m128i prev;
+    __m128i one;
+    __m128i bias;
+    __m128i flip;
+    __m128i x;
+    __m128i d;
+    __m128i v[2];
+    uint32_t off;
+    uint32_t k;
+    uint32_t w;
+    uint32_t s;
+    
+    word = (const __m128i *)packed;
+    mask = _mm_set1_epi32((int32_t)((1U << bits) - 1));
+    prev = _mm_set1_epi32(base);
+    one = _mm_set1_epi32(1);
+    bias = _mm_set1_epi32(32768);
+    flip = _mm_set1_epi16((int16_t)0x8000);
+    for (k = 0; k < RAWCODEC_BLOCK / RAWCODEC_LANE; k++)
+    {
+        off = k * bits;
+        w = off >> 5;
+        s = off & 31;
+        x = _mm_srl_epi32(_mm_loadu_si128(word + w), _mm_cvtsi32_si128((int32_t)s));
+        if ((s + bits) > 32)
+        {
+            x = _mm_or_si128(x, _mm_sll_epi32(_mm_loadu_si128(word + w + 1), _mm_cvtsi32_si128((int32_t)(32 - s))));
+        }
+        x = _mm_and_si128(x, mask);
+        
+        /* zigzag and the prefix sum of the four deltas */
+        d = _mm_xor_si128(_mm_srli_epi32(x, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(x, one)));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi32(d, prev);
+        prev = _mm_shuffle_epi32(d, _MM_SHUFFLE(3, 3, 3, 3));
+        
+        /* narrow eight values at a time */
+        v[k & 1] = _mm_sub_epi32(d, bias);
+        if ((k & 1) != 0)
+        {
+            _mm_storeu_si128((__m128i *)(out + (k - 1) * RAWCODEC_LANE),
+                             _mm_xor_si128(_mm_packs_epi32(v[0], v[1]), flip));
+        }
+    }
+}
+
+#endif
+
+/**
+ * @brief      rawcodec decode blocks
+ * @param[in]  *in pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *out pointer to a buffer of count values
+ * @param[in]  count value number
+ * @param[in]  unpack block unpack function
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed
+ * @note       none
+ */
+static uint8_t a_rawcodec_decode(const uint8_t *in, uint32_t len, uint16_t *out, uint32_t count, rawcodec_unpack_t unpack)
+{
+    uint16_t tmp[RAWCODEC_BLOCK];
+    uint32_t pos;
+    uint32_t need;
+    uint32_t n;
+    uint32_t i;
+    uint16_t base;
+    uint8_t bits;
+    
+    pos = 0;
+    for (i = 0; i < count; i += RAWCODEC_BLOCK)
+    {
+        if ((len - pos) < RAWCODEC_BLOCK_HEADER_SIZE)
+        {
+            return 1;
+        }
+        base = (uint16_t)(in[pos] | (in[pos + 1] << 8));
+        bits = in[pos + 2];
+        if (bits > RAWCODEC_MAX_BITS)
+        {
+            return 1;
+        }
+        need = RAWCODEC_BLOCK_HEADER_SIZE + (uint32_t)bits * RAWCODEC_LANE * 4;
+        if ((len - pos) < need)
+        {
+            return 1;
+        }
+        n = ((count - i) < RAWCODEC_BLOCK) ? (count - i) : RAWCODEC_BLOCK;
+        if (bits == 0)
+        {
+            /* a flat block has no payload */
+            for (need = 0; need < n; need++)
+            {
+                out[i + need] = base;
+            }
+            pos += RAWCODEC_BLOCK_HEADER_SIZE;
+            
+            continue;
+        }
+        if (n == RAWCODEC_BLOCK)
+        {
+            unpack(in + pos + RAWCODEC_BLOCK_HEADER_SIZE, bits, base, out + i);
+        }
+        else
+        {
+            unpack(in + pos + RAWCODEC_BLOCK_HEADER_SIZE, bits, base, tmp);
+            memcpy(out + i, tmp, sizeof(uint16_t) * n);
+        }
+        pos += need;
+    }
+    
+    return (pos == len) ? 0 : 1;
+}
+
+/**
+ * @brief     rawcodec get the max encoded size
+ * @param[in] count value number
+ * @return    max encoded bytes
+ * @note      none
+ */
+uint32_t rawcodec_bound(uint32_t count)
+{
+    return ((count + RAWCODEC_BLOCK - 1) / RAWCODEC_BLOCK) *
+           (RAWCODEC_BLOCK_HEADER_SIZE + RAWCODEC_MAX_BITS * RAWCODEC_LANE * 4);
+}
+
+/**
+ * @brief      rawcodec encode a raw signal
+ * @param[in]  *in pointer to the values
+ * @param[in]  count value number
+ * @param[out] *out pointer to a buffer of rawcodec_bound(count) bytes
+ * @return     encoded bytes
+ * @note       every block of 128 values keeps its first value and the zigzag deltas packed
+ *             at the width of the largest one, the last block is padded with zero deltas
+ */
+uint32_t rawcodec_encode(const uint16_t *in, uint32_t count, uint8_t *out)
+{
+    uint32_t zz[RAWCODEC_BLOCK];
+    uint32_t word[RAWCODEC_MAX_BITS * RAWCODEC_LANE];
+    uint32_t pos;
+    uint32_t all;
+    uint32_t off;
+    uint32_t n;
+    uint32_t i;
+    uint32_t j;
+    uint32_t w;
+    uint32_t s;
+    int32_t delta;
+    uint8_t bits;
+    
+    pos = 0;
+    for (i = 0; i < count; i += RAWCODEC_BLOCK)
+    {
+        /* zigzag deltas, the first one is 0 against the base */
+        n = ((count - i) < RAWCODEC_BLOCK) ? (count - i) : RAWCODEC_BLOCK;
+        all = 0;
+        for (j = 0; j < RAWCODEC_BLOCK; j++)
+        {
+            delta = ((j == 0) || (j >= n)) ? 0 : ((int32_t)in[i + j] - (int32_t)in[i + j - 1]);
+            zz[j] = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            all |= zz[j];
+        }
+        bits = 0;
+        while (all != 0)
+        {
+            bits++;
+            all >>= 1;
+        }
+        
+        /* header */
+        out[pos + 0] = (uint8_t)(in[i] & 0xFF);
+        out[pos + 1] = (uint8_t)(in[i] >> 8);
+        out[pos + 2] = bits;
+        out[pos + 3] = 0;
+        pos += RAWCODEC_BLOCK_HEADER_SIZE;
+        if (bits == 0)
+        {
+            continue;
+        }
+        
+        /* pack every lane into its own interleaved words */
+        memset(word, 0, sizeof(uint32_t) * bits * RAWCODEC_LANE);
+        for (j = 0; j < RAWCODEC_BLOCK; j++)
+        {
+            off = (j / RAWCODEC_LANE) * bits;
+            w = off >> 5;
+            s = off & 31;
+            word[w * RAWCODEC_LANE + j % RAWCODEC_LANE] |= zz[j] << s;
+            if ((s + bits) > 32)
+            {
+                word[(w + 1) * RAWCODEC_LANE + j % RAWCODEC_LANE] |= zz[j] >> (32 - s);
+            }
+        }
+        for (j = 0; j < (uint32_t)bits * RAWCODEC_LANE; j++)
+        {
+            a_rawcodec_put32(out + pos + j * 4, word[j]);
+        }
+        pos += (uint32_t)bits * RAWCODEC_LANE * 4;
+    }
+    
+    return pos;
+}
+
+/**
+ * @brief      rawcodec decode a raw signal
+ * @param[in]  *in pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *out pointer to a buffer of count values
+ * @param[in]  count value number
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed
+ * @note       the simd path of RAWCODEC_SIMD is used if there is one
+ */
+uint8_t rawcodec_decode(const uint8_t *in, uint32_t len, uint16_t *out, uint32_t count)
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__SSE2__)
+    return a_rawcodec_decode(in, len, out, count, a_rawcodec_unpack_simd);
+#else
+    return a_rawcodec_decode(in, len, out, count, a_rawcodec_unpack_scalar);
+#endif
+}
+
+/**
+ * @brief      rawcodec decode a raw signal without simd
+ * @param[in]  *in pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *out pointer to a buffer of count values
+ * @param[in]  count value number
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed
+ * @note       the reference for the simd path
+ */
+uint8_t rawcodec_decode_scalar(const uint8_t *in, uint32_t len, uint16_t *out, uint32_t count)
+{
+    return a_rawcodec_decode(in, len, out, count, a_rawcodec_unpack_scalar);
+}
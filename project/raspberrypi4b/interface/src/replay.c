@@ -0,0 +1,655 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      replay.c
+ * @brief     replay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "replay.h"
+#include <errno.h>
+#include <string.h>
+
+/**
+ * @brief nanoseconds per second definition
+ */
+#define REPLAY_NS_PER_S        1000000000ULL        /**< 1 s */
+
+/**
+ * @brief replay bound definition
+ */
+static replay_t *gs_bound = NULL;        /**< replay behind the interface and the clock */
+
+/**
+ * @brief     replay put a little endian 16 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_replay_put16(uint8_t *buf, uint16_t v)
+{
+    buf[0] = (uint8_t)(v & 0xFF);
+    buf[1] = (uint8_t)((v >> 8) & 0xFF);
+}
+
+/**
+ * @brief     replay put a little endian 32 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_replay_put32(uint8_t *buf, uint32_t v)
+{
+    a_replay_put16(buf, (uint16_t)(v & 0xFFFF));
+    a_replay_put16(buf + 2, (uint16_t)((v >> 16) & 0xFFFF));
+}
+
+/**
+ * @brief     replay put a little endian 64 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_replay_put64(uint8_t *buf, uint64_t v)
+{
+    a_replay_put32(buf, (uint32_t)(v & 0xFFFFFFFFU));
+    a_replay_put32(buf + 4, (uint32_t)((v >> 32) & 0xFFFFFFFFU));
+}
+
+/**
+ * @brief     replay get a little endian 16 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint16_t a_replay_get16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+/**
+ * @brief     replay get a little endian 32 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_replay_get32(const uint8_t *buf)
+{
+    return (uint32_t)a_replay_get16(buf) | ((uint32_t)a_replay_get16(buf + 2) << 16);
+}
+
+/**
+ * @brief     replay get a little endian 64 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint64_t a_replay_get64(const uint8_t *buf)
+{
+    return (uint64_t)a_replay_get32(buf) | ((uint64_t)a_replay_get32(buf + 4) << 32);
+}
+
+/**
+ * @brief     replay get the real time of a clock
+ * @param[in] clock clock id
+ * @return    time in nanoseconds
+ * @note      none
+ */
+static uint64_t a_replay_clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(clock, &ts);
+    
+    return (uint64_t)ts.tv_sec * REPLAY_NS_PER_S + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief      replay read the next record of the trace
+ * @param[in]  *replay pointer to a replay structure
+ * @param[out] *record pointer to a record structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 end of the trace
+ * @note       a truncated record at the end is treated as the end of the trace
+ */
+static uint8_t a_replay_read_record(replay_t *replay, replay_record_t *record)
+{
+    uint8_t header[REPLAY_RECORD_HEADER_SIZE];
+    
+    if (fread(header, 1, REPLAY_RECORD_HEADER_SIZE, replay->fp) != REPLAY_RECORD_HEADER_SIZE)
+    {
+        return 1;
+    }
+    record->timestamp_ns = a_replay_get64(header);
+    record->type = header[8];
+    record->addr = header[9];
+    record->res = header[10];
+    record->len = a_replay_get16(header + 12);
+    if ((record->len > REPLAY_MAX_DATA) ||
+        (fread(record->data, 1, record->len, replay->fp) != record->len))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     replay fill the records read ahead
+ * @param[in] *replay pointer to a replay structure
+ * @note      none
+ */
+static void a_replay_fill(replay_t *replay)
+{
+    while ((replay->count < REPLAY_SYNC_WINDOW) && (replay->stats.eof == 0))
+    {
+        if (a_replay_read_record(replay, &replay->ahead[(replay->head + replay->count) % REPLAY_SYNC_WINDOW]) != 0)
+        {
+            replay->stats.eof = 1;
+            
+            break;
+        }
+        replay->count++;
+    }
+}
+
+/**
+ * @brief     replay find a record read ahead
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] type replay record type
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to the written bytes, NULL for a read
+ * @param[in] len data length
+ * @return    record index from the head, REPLAY_SYNC_WINDOW if none
+ * @note      none
+ */
+static uint32_t a_replay_find(replay_t *replay, uint8_t type, uint8_t addr, const uint8_t *buf, uint16_t len)
+{
+    replay_record_t *record;
+    uint32_t i;
+    
+    a_replay_fill(replay);
+    for (i = 0; i < replay->count; i++)
+    {
+        record = &replay->ahead[(replay->head + i) % REPLAY_SYNC_WINDOW];
+        if ((record->type == type) && (record->addr == addr) && (record->len == len) &&
+            ((buf == NULL) || (memcmp(record->data, buf, len) == 0)))
+        {
+            return i;
+        }
+    }
+    
+    return REPLAY_SYNC_WINDOW;
+}
+
+/**
+ * @brief     replay advance the virtual time
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] now_ns virtual time from the start
+ * @return    real monotonic time to wait for, 0 means no wait
+ * @note      the time never goes back, with a speed the real time is held back to the virtual time,
+ *            it is called under the mutex and the caller waits after the unlock
+ */
+static uint64_t a_replay_advance(replay_t *replay, uint64_t now_ns)
+{
+    if (now_ns <= replay->now_ns)
+    {
+        return 0;
+    }
+    replay->now_ns = now_ns;
+    if (replay->speed > 0.0f)
+    {
+        return replay->start_ns + (uint64_t)((double)now_ns / (double)replay->speed);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     replay wait for a real time
+ * @param[in] wake real monotonic time, 0 means no wait
+ * @note      the mutex must not be held, so the other threads keep replaying
+ */
+static void a_replay_wait(uint64_t wake)
+{
+    struct timespec ts;
+    
+    if (wake == 0)
+    {
+        return;
+    }
+    ts.tv_sec = (time_t)(wake / REPLAY_NS_PER_S);
+    ts.tv_nsec = (long)(wake % REPLAY_NS_PER_S);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+    }
+}
+
+/**
+ * @brief      replay take a record read ahead
+ * @param[in]  *replay pointer to a replay structure
+ * @param[in]  index record index from the head
+ * @param[out] *wake pointer to a real time buffer to wait for after the unlock
+ * @return     pointer to the record
+ * @note       the records before it are skipped and the virtual time moves on to the record
+ */
+static replay_record_t *a_replay_take(replay_t *replay, uint32_t index, uint64_t *wake)
+{
+    replay_record_t *record;
+    
+    record = &replay->ahead[(replay->head + index) % REPLAY_SYNC_WINDOW];
+    replay->stats.skipped += index;
+    replay->head = (replay->head + index + 1) % REPLAY_SYNC_WINDOW;
+    replay->count -= index + 1;
+    *wake = a_replay_advance(replay, record->timestamp_ns);
+    if (record->res != 0)
+    {
+        replay->stats.failed++;
+    }
+    
+    return record;
+}
+
+/**
+ * @brief     replay open a trace to serve the bus from
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *path pointer to a trace file path
+ * @param[in] speed virtual time per real time, 0 means as fast as possible and 1 means real time
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the virtual clock starts at the clocks of the capture
+ */
+uint8_t replay_open(replay_t *replay, const char *path, float speed)
+{
+    uint8_t header[REPLAY_HEADER_SIZE];
+    
+    if (speed < 0.0f)
+    {
+        return 1;
+    }
+    memset(replay, 0, sizeof(replay_t));
+    replay->fp = fopen(path, "rb");
+    if (replay->fp == NULL)
+    {
+        perror("replay: open failed.\n");
+        
+        return 1;
+    }
+    if ((fread(header, 1, REPLAY_HEADER_SIZE, replay->fp) != REPLAY_HEADER_SIZE) ||
+        (a_replay_get32(header) != REPLAY_MAGIC) || (a_replay_get16(header + 4) != REPLAY_VERSION))
+    {
+        printf("replay: file is not a trace file.\n");
+        (void)fclose(replay->fp);
+        replay->fp = NULL;
+        
+        return 1;
+    }
+    replay->mono_base_ns = a_replay_get64(header + 8);
+    replay->real_base_ns = a_replay_get64(header + 16);
+    replay->speed = speed;
+    replay->start_ns = a_replay_clock_ns(CLOCK_MONOTONIC);
+    (void)pthread_mutex_init(&replay->mutex, NULL);
+    replay->mode = REPLAY_MODE_PLAY;
+    
+    return 0;
+}
+
+/**
+ * @brief     replay open a trace to capture the bus to
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *path pointer to a trace file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      an existing file is truncated
+ */
+uint8_t replay_record_open(replay_t *replay, const char *path)
+{
+    uint8_t header[REPLAY_HEADER_SIZE];
+    
+    memset(replay, 0, sizeof(replay_t));
+    replay->fp = fopen(path, "wb");
+    if (replay->fp == NULL)
+    {
+        perror("replay: open failed.\n");
+        
+        return 1;
+    }
+    replay->start_ns = a_replay_clock_ns(CLOCK_MONOTONIC);
+    replay->mono_base_ns = replay->start_ns;
+    replay->real_base_ns = a_replay_clock_ns(CLOCK_REALTIME);
+    memset(header, 0, REPLAY_HEADER_SIZE);
+    a_replay_put32(header, REPLAY_MAGIC);
+    a_replay_put16(header + 4, REPLAY_VERSION);
+    a_replay_put64(header + 8, replay->mono_base_ns);
+    a_replay_put64(header + 16, replay->real_base_ns);
+    if (fwrite(header, 1, REPLAY_HEADER_SIZE, replay->fp) != REPLAY_HEADER_SIZE)
+    {
+        (void)fclose(replay->fp);
+        replay->fp = NULL;
+        
+        return 1;
+    }
+    (void)pthread_mutex_init(&replay->mutex, NULL);
+    replay->mode = REPLAY_MODE_RECORD;
+    
+    return 0;
+}
+
+/**
+ * @brief     replay close
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      a bound replay is unbound first
+ */
+uint8_t replay_close(replay_t *replay)
+{
+    uint8_t res;
+    
+    if (replay->mode == REPLAY_MODE_NONE)
+    {
+        return 1;
+    }
+    if (replay_get_bound() == replay)
+    {
+        replay_bind(NULL);
+    }
+    res = (fclose(replay->fp) != 0) ? 1 : 0;
+    replay->fp = NULL;
+    replay->mode = REPLAY_MODE_NONE;
+    (void)pthread_mutex_destroy(&replay->mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     replay bind the interface callbacks and the clock
+ * @param[in] *replay pointer to a replay structure, NULL unbinds
+ * @note      none
+ */
+void replay_bind(replay_t *replay)
+{
+    __atomic_store_n(&gs_bound, replay, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief  replay get the bound replay
+ * @return pointer to the bound replay structure, NULL if none
+ * @note   none
+ */
+replay_t *replay_get_bound(void)
+{
+    return __atomic_load_n(&gs_bound, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief     replay serve an iic write
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the write must match a captured write within REPLAY_SYNC_WINDOW records, the records
+ *            before it are skipped, the captured result is returned so a nack is replayed as a nack
+ */
+uint8_t replay_write_cmd(replay_t *replay, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    replay_record_t *record;
+    uint64_t wake;
+    uint32_t index;
+    uint8_t res;
+    
+    if (replay->mode != REPLAY_MODE_PLAY)
+    {
+        return 1;
+    }
+    
+    (void)pthread_mutex_lock(&replay->mutex);
+    index = a_replay_find(replay, REPLAY_RECORD_WRITE, addr, buf, len);
+    if (index == REPLAY_SYNC_WINDOW)
+    {
+        /* nothing to answer with, the driver sees a failed write */
+        if (replay->count != 0)
+        {
+            replay->stats.mismatched++;
+        }
+        (void)pthread_mutex_unlock(&replay->mutex);
+        
+        return 1;
+    }
+    record = a_replay_take(replay, index, &wake);
+    replay->stats.writes++;
+    res = record->res;
+    (void)pthread_mutex_unlock(&replay->mutex);
+    a_replay_wait(wake);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      replay serve an iic read
+ * @param[in]  *replay pointer to a replay structure
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the captured bytes are returned as they were, crc errors included
+ */
+uint8_t replay_read_cmd(replay_t *replay, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    replay_record_t *record;
+    uint64_t wake;
+    uint32_t index;
+    uint8_t res;
+    
+    if (replay->mode != REPLAY_MODE_PLAY)
+    {
+        return 1;
+    }
+    
+    (void)pthread_mutex_lock(&replay->mutex);
+    index = a_replay_find(replay, REPLAY_RECORD_READ, addr, NULL, len);
+    if (index == REPLAY_SYNC_WINDOW)
+    {
+        if (replay->count != 0)
+        {
+            replay->stats.mismatched++;
+        }
+        (void)pthread_mutex_unlock(&replay->mutex);
+        
+        return 1;
+    }
+    record = a_replay_take(replay, index, &wake);
+    replay->stats.reads++;
+    memcpy(buf, record->data, len);
+    res = record->res;
+    (void)pthread_mutex_unlock(&replay->mutex);
+    a_replay_wait(wake);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     replay capture a transfer
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] type replay record type
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] res result of the transfer
+ * @return    status code
+ *            - 0 success
+ *            - 1 capture failed
+ * @note      none
+ */
+uint8_t replay_capture(replay_t *replay, replay_record_type_t type, uint8_t addr, const uint8_t *buf, uint16_t len, uint8_t res)
+{
+    uint8_t header[REPLAY_RECORD_HEADER_SIZE];
+    uint8_t ok;
+    
+    if ((replay->mode != REPLAY_MODE_RECORD) || (len > REPLAY_MAX_DATA))
+    {
+        return 1;
+    }
+    
+    memset(header, 0, REPLAY_RECORD_HEADER_SIZE);
+    (void)pthread_mutex_lock(&replay->mutex);
+    replay->now_ns = a_replay_clock_ns(CLOCK_MONOTONIC) - replay->start_ns;
+    a_replay_put64(header, replay->now_ns);
+    header[8] = (uint8_t)type;
+    header[9] = addr;
+    header[10] = (res != 0) ? 1 : 0;
+    a_replay_put16(header + 12, len);
+    ok = (fwrite(header, 1, REPLAY_RECORD_HEADER_SIZE, replay->fp) == REPLAY_RECORD_HEADER_SIZE) &&
+         (fwrite(buf, 1, len, replay->fp) == len);
+    if (type == REPLAY_RECORD_WRITE)
+    {
+        replay->stats.writes++;
+    }
+    else
+    {
+        replay->stats.reads++;
+    }
+    if (res != 0)
+    {
+        replay->stats.failed++;
+    }
+    (void)pthread_mutex_unlock(&replay->mutex);
+    
+    return (ok != 0) ? 0 : 1;
+}
+
+/**
+ * @brief     replay delay in virtual time
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] ms delay time
+ * @note      none
+ */
+void replay_delay_ms(replay_t *replay, uint32_t ms)
+{
+    uint64_t wake;
+    
+    (void)pthread_mutex_lock(&replay->mutex);
+    wake = a_replay_advance(replay, replay->now_ns + (uint64_t)ms * 1000000ULL);
+    (void)pthread_mutex_unlock(&replay->mutex);
+    a_replay_wait(wake);
+}
+
+/**
+ * @brief      replay get the time of a clock
+ * @param[in]  clock CLOCK_MONOTONIC or CLOCK_REALTIME
+ * @param[out] *ts pointer to a timespec structure
+ * @return     0 on success, -1 on error
+ * @note       the virtual time of the bound trace, clock_gettime without one
+ */
+int replay_clock_gettime(clockid_t clock, struct timespec *ts)
+{
+    replay_t *replay;
+    uint64_t ns;
+    
+    replay = replay_get_bound();
+    if ((replay == NULL) || (replay->mode != REPLAY_MODE_PLAY))
+    {
+        return clock_gettime(clock, ts);
+    }
+    
+    (void)pthread_mutex_lock(&replay->mutex);
+    ns = replay->now_ns + ((clock == CLOCK_REALTIME) ? replay->real_base_ns : replay->mono_base_ns);
+    (void)pthread_mutex_unlock(&replay->mutex);
+    ts->tv_sec = (time_t)(ns / REPLAY_NS_PER_S);
+    ts->tv_nsec = (long)(ns % REPLAY_NS_PER_S);
+    
+    return 0;
+}
+
+/**
+ * @brief     replay sleep on a clock
+ * @param[in] clock CLOCK_MONOTONIC or CLOCK_REALTIME
+ * @param[in] flags 0 or TIMER_ABSTIME
+ * @param[in] *request pointer to a timespec structure
+ * @param[in] *remain pointer to a remaining time buffer, it can be NULL
+ * @return    0 on success, an error number on error
+ * @note      the virtual clock jumps to the wake up of the bound trace, clock_nanosleep without one
+ */
+int replay_clock_nanosleep(clockid_t clock, int flags, const struct timespec *request, struct timespec *remain)
+{
+    replay_t *replay;
+    uint64_t base;
+    uint64_t wake;
+    uint64_t ns;
+    
+    replay = replay_get_bound();
+    if ((replay == NULL) || (replay->mode != REPLAY_MODE_PLAY))
+    {
+        return clock_nanosleep(clock, flags, request, remain);
+    }
+    
+    ns = (uint64_t)request->tv_sec * REPLAY_NS_PER_S + (uint64_t)request->tv_nsec;
+    (void)pthread_mutex_lock(&replay->mutex);
+    if ((flags & TIMER_ABSTIME) != 0)
+    {
+        base = (clock == CLOCK_REALTIME) ? replay->real_base_ns : replay->mono_base_ns;
+        ns = (ns > base) ? (ns - base) : 0;
+    }
+    else
+    {
+        ns += replay->now_ns;
+    }
+    wake = a_replay_advance(replay, ns);
+    (void)pthread_mutex_unlock(&replay->mutex);
+    a_replay_wait(wake);
+    
+    return 0;
+}
+
+/**
+ * @brief      replay get the stats
+ * @param[in]  *replay pointer to a replay structure
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void replay_get_stats(replay_t *replay, replay_stats_t *stats)
+{
+    (void)pthread_mutex_lock(&replay->mutex);
+    *stats = replay->stats;
+    stats->eof = ((replay->stats.eof != 0) && (replay->count == 0)) ? 1 : 0;
+    stats->virtual_ns = replay->now_ns;
+    stats->real_ns = a_replay_clock_ns(CLOCK_MONOTONIC) - replay->start_ns;
+    (void)pthread_mutex_unlock(&replay->mutex);
+}
@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      rt.c
+ * @brief     rt source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+#include "rt.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief rt start structure definition
+ */
+typedef struct rt_start_s
+{
+    void *(*entry)(void *);         /**< thread entry */
+    void *arg;                      /**< thread argument */
+} rt_start_t;
+
+/**
+ * @brief      rt init the config with the defaults
+ * @param[out] *config pointer to a config structure
+ * @note       priority 80, no pinning, RT_DEFAULT_STACK_SIZE and locked memory
+ */
+void rt_config_init(rt_config_t *config)
+{
+    config->priority = 80;
+    config->cpu = -1;
+    config->stack_size = RT_DEFAULT_STACK_SIZE;
+    config->lock_memory = 1;
+}
+
+/**
+ * @brief     rt prefault a buffer
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len buffer length
+ * @note      every page is written once so the later accesses never fault,
+ *            call it on the sample buffers before the acquisition thread starts
+ */
+void rt_prefault(void *buf, size_t len)
+{
+    volatile uint8_t *p;
+    size_t page;
+    size_t i;
+    
+    p = (volatile uint8_t *)buf;
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    for (i = 0; i < len; i += page)
+    {
+        p[i] = p[i];
+    }
+    if (len != 0)
+    {
+        p[len - 1] = p[len - 1];
+    }
+}
+
+/**
+ * @brief  rt touch the stack
+ * @note   noinline keeps the frame below the caller, so the pages stay mapped for the entry
+ */
+static void __attribute__((noinline)) a_rt_prefault_stack(void)
+{
+    volatile uint8_t stack[RT_PREFAULT_STACK_SIZE];
+    
+    memset((void *)stack, 0, sizeof(stack));
+}
+
+/**
+ * @brief     rt thread trampoline
+ * @param[in] *arg pointer to a start structure
+ * @return    entry return value
+ * @note      none
+ */
+static void *a_rt_start(void *arg)
+{
+    rt_start_t start;
+    
+    /* take the start and free it before the hot path */
+    start = *(rt_start_t *)arg;
+    free(arg);
+    
+    /* fault in the stack */
+    a_rt_prefault_stack();
+    
+    return start.entry(start.arg);
+}
+
+/**
+ * @brief      rt create an acquisition thread
+ * @param[out] *thread pointer to a thread buffer
+ * @param[in]  *config pointer to a config structure
+ * @param[in]  *entry pointer to the thread entry
+ * @param[in]  *arg pointer to the thread argument
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       the memory is locked before the thread starts and RT_PREFAULT_STACK_SIZE of the stack
+ *             is touched before entry runs, SCHED_FIFO needs CAP_SYS_NICE or an rtprio limit,
+ *             the thread is not downgraded silently when the policy is refused
+ */
+uint8_t rt_thread_create(pthread_t *thread, const rt_config_t *config, void *(*entry)(void *), void *arg)
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    rt_start_t *start;
+    cpu_set_t set;
+    int res;
+    
+    if ((config->stack_size != 0) && (config->stack_size < RT_PREFAULT_STACK_SIZE + 16 * 1024))
+    {
+        fprintf(stderr, "rt: stack size is too small.\n");
+        
+        return 1;
+    }
+    
+    /* lock the current and the future pages, the thread stack is mapped after this */
+    if (config->lock_memory != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("rt: mlockall failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* set the attributes */
+    res = pthread_attr_init(&attr);
+    if (res != 0)
+    {
+        return 1;
+    }
+    if (config->stack_size != 0)
+    {
+        res = pthread_attr_setstacksize(&attr, config->stack_size);
+        if (res != 0)
+        {
+            fprintf(stderr, "rt: set stack size failed, %s.\n", strerror(res));
+            (void)pthread_attr_destroy(&attr);
+            
+            return 1;
+        }
+    }
+    if (config->priority > 0)
+    {
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = config->priority;
+        res = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        if (res == 0)
+        {
+            res = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        }
+        if (res == 0)
+        {
+            res = pthread_attr_setschedparam(&attr, &param);
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "rt: set priority %d failed, %s.\n", (int)config->priority, strerror(res));
+            (void)pthread_attr_destroy(&attr);
+            
+            return 1;
+        }
+    }
+    if (config->cpu >= 0)
+    {
+        CPU_ZERO(&set);
+        CPU_SET(config->cpu, &set);
+        res = pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &set);
+        if (res != 0)
+        {
+            fprintf(stderr, "rt: set cpu %d failed, %s.\n", (int)config->cpu, strerror(res));
+            (void)pthread_attr_destroy(&attr);
+            
+            return 1;
+        }
+    }
+    
+    /* start the thread */
+    start = (rt_start_t *)malloc(sizeof(rt_start_t));
+    if (start == NULL)
+    {
+        (void)pthread_attr_destroy(&attr);
+        
+        return 1;
+    }
+    start->entry = entry;
+    start->arg = arg;
+    res = pthread_create(thread, &attr, a_rt_start, start);
+    (void)pthread_attr_destroy(&attr);
+    if (res != 0)
+    {
+        fprintf(stderr, "rt: create thread failed, %s.\n", strerror(res));
+        free(start);
+        
+        return 1;
+    }
+    
+    return 0;
+}
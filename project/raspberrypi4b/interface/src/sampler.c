@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sampler.c
+ * @brief     sampler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sampler.h"
+#include "replay.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief nanoseconds per second definition
+ */
+#define SAMPLER_NS_PER_S        1000000000LL        /**< 1 s */
+
+/**
+ * @brief     sampler convert the timespec to nanoseconds
+ * @param[in] *ts pointer to a timespec structure
+ * @return    time in nanoseconds
+ * @note      none
+ */
+static int64_t a_sampler_ns(const struct timespec *ts)
+{
+    return (int64_t)ts->tv_sec * SAMPLER_NS_PER_S + ts->tv_nsec;
+}
+
+/**
+ * @brief      sampler convert nanoseconds to the timespec
+ * @param[in]  ns time in nanoseconds
+ * @param[out] *ts pointer to a timespec structure
+ * @note       none
+ */
+static void a_sampler_ts(int64_t ns, struct timespec *ts)
+{
+    ts->tv_sec = (time_t)(ns / SAMPLER_NS_PER_S);
+    ts->tv_nsec = (long)(ns % SAMPLER_NS_PER_S);
+}
+
+/**
+ * @brief     sampler init
+ * @param[in] *sampler pointer to a sampler structure
+ * @param[in] period_ms sampling period
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the first deadline is one period from now
+ */
+uint8_t sampler_init(sampler_t *sampler, uint32_t period_ms)
+{
+    struct timespec now;
+    
+    if (period_ms == 0)
+    {
+        return 1;
+    }
+    memset(sampler, 0, sizeof(sampler_t));
+    sampler->period_ns = (uint64_t)period_ms * 1000000ULL;
+    
+    /* set the first deadline */
+    if (replay_clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return 1;
+    }
+    a_sampler_ts(a_sampler_ns(&now) + (int64_t)sampler->period_ns, &sampler->next);
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler wait the next deadline
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *missed pointer to a missed deadline number buffer, it can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ * @note       deadlines are absolute on CLOCK_MONOTONIC, so the period does not drift with the work done between waits,
+ *             the deadlines that have already passed are skipped and counted as missed, a bound replay
+ *             runs them on its virtual clock
+ */
+uint8_t sampler_wait(sampler_t *sampler, uint32_t *missed)
+{
+    struct timespec now;
+    int64_t deadline;
+    int64_t late;
+    int64_t jitter;
+    uint64_t skip;
+    int res;
+    
+    /* skip the deadlines which have passed by one period or more */
+    skip = 0;
+    deadline = a_sampler_ns(&sampler->next);
+    if (replay_clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return 1;
+    }
+    late = a_sampler_ns(&now) - deadline;
+    if (late >= (int64_t)sampler->period_ns)
+    {
+        skip = (uint64_t)late / sampler->period_ns;
+        deadline += (int64_t)(skip * sampler->period_ns);
+        a_sampler_ts(deadline, &sampler->next);
+    }
+    
+    /* sleep until the deadline */
+    do
+    {
+        res = replay_clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sampler->next, NULL);
+    } while (res == EINTR);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* measure the wake up jitter */
+    if (replay_clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return 1;
+    }
+    jitter = a_sampler_ns(&now) - deadline;
+    
+    /* update the stats */
+    if ((sampler->stats.samples == 0) || (jitter < sampler->stats.jitter_min_ns))
+    {
+        sampler->stats.jitter_min_ns = jitter;
+    }
+    if ((sampler->stats.samples == 0) || (jitter > sampler->stats.jitter_max_ns))
+    {
+        sampler->stats.jitter_max_ns = jitter;
+    }
+    sampler->stats.jitter_last_ns = jitter;
+    sampler->stats.jitter_sum_ns += jitter;
+    sampler->stats.samples++;
+    sampler->stats.missed += skip;
+    if (missed != NULL)
+    {
+        *missed = (uint32_t)skip;
+    }
+    
+    /* the next deadline is on the same grid */
+    a_sampler_ts(deadline + (int64_t)sampler->period_ns, &sampler->next);
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler get the stats
+ * @param[in]  *sampler pointer to a sampler structure
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void sampler_get_stats(sampler_t *sampler, sampler_stats_t *stats)
+{
+    *stats = sampler->stats;
+}
+
+/**
+ * @brief     sampler print the stats
+ * @param[in] *sampler pointer to a sampler structure
+ * @note      none
+ */
+void sampler_print_stats(sampler_t *sampler)
+{
+    sampler_stats_t *s;
+    
+    s = &sampler->stats;
+    if (s->samples == 0)
+    {
+        return;
+    }
+    printf("sampler: %llu samples, %llu missed deadlines.\n",
+           (unsigned long long)s->samples, (unsigned long long)s->missed);
+    printf("sampler: jitter min %0.1f us, mean %0.1f us, max %0.1f us.\n",
+           (double)s->jitter_min_ns / 1000.0, (double)s->jitter_sum_ns / (double)s->samples / 1000.0,
+           (double)s->jitter_max_ns / 1000.0);
+}
@@ -0,0 +1,861 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      series.c
+ * @brief     series source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "series.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief series crc table definition
+ */
+static uint32_t gs_crc_table[256];        /**< crc-32 table */
+static uint8_t gs_crc_inited = 0;         /**< crc-32 table inited flag */
+
+/**
+ * @brief     series put a little endian 16 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_series_put16(uint8_t *buf, uint16_t v)
+{
+    buf[0] = (uint8_t)(v & 0xFF);
+    buf[1] = (uint8_t)((v >> 8) & 0xFF);
+}
+
+/**
+ * @brief     series put a little endian 32 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_series_put32(uint8_t *buf, uint32_t v)
+{
+    a_series_put16(buf, (uint16_t)(v & 0xFFFF));
+    a_series_put16(buf + 2, (uint16_t)((v >> 16) & 0xFFFF));
+}
+
+/**
+ * @brief     series put a little endian 64 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_series_put64(uint8_t *buf, uint64_t v)
+{
+    a_series_put32(buf, (uint32_t)(v & 0xFFFFFFFFU));
+    a_series_put32(buf + 4, (uint32_t)((v >> 32) & 0xFFFFFFFFU));
+}
+
+/**
+ * @brief     series get a little endian 16 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint16_t a_series_get16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+/**
+ * @brief     series get a little endian 32 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_series_get32(const uint8_t *buf)
+{
+    return (uint32_t)a_series_get16(buf) | ((uint32_t)a_series_get16(buf + 2) << 16);
+}
+
+/**
+ * @brief     series get a little endian 64 bits value
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint64_t a_series_get64(const uint8_t *buf)
+{
+    return (uint64_t)a_series_get32(buf) | ((uint64_t)a_series_get32(buf + 4) << 32);
+}
+
+/**
+ * @brief     series put a varint
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @return    written bytes
+ * @note      7 bits per byte, the high bit means more bytes follow
+ */
+static uint32_t a_series_put_varint(uint8_t *buf, uint64_t v)
+{
+    uint32_t n;
+    
+    n = 0;
+    while (v >= 0x80)
+    {
+        buf[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = (uint8_t)v;
+    
+    return n;
+}
+
+/**
+ * @brief         series get a varint
+ * @param[in,out] **p pointer to a read pointer
+ * @param[in]     *end pointer to the payload end
+ * @param[out]    *v pointer to a value buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 varint is truncated or too long
+ * @note          one byte values take the first branch, they are most of a 1 Hz trace
+ */
+static inline uint8_t a_series_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v)
+{
+    const uint8_t *q;
+    uint64_t r;
+    uint32_t shift;
+    
+    q = *p;
+    if ((q < end) && (q[0] < 0x80))
+    {
+        *v = q[0];
+        *p = q + 1;
+        
+        return 0;
+    }
+    r = 0;
+    for (shift = 0; shift < 64; shift += 7)
+    {
+        if (q >= end)
+        {
+            return 1;
+        }
+        r |= (uint64_t)(*q & 0x7F) << shift;
+        if ((*q++ & 0x80) == 0)
+        {
+            *v = r;
+            *p = q;
+            
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     series zigzag encode
+ * @param[in] v signed value
+ * @return    unsigned value, small magnitudes stay small
+ * @note      none
+ */
+static uint64_t a_series_zigzag(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+/**
+ * @brief     series zigzag decode
+ * @param[in] v unsigned value
+ * @return    signed value
+ * @note      none
+ */
+static int64_t a_series_unzigzag(uint64_t v)
+{
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+/**
+ * @brief      series serialize a chunk header
+ * @param[in]  *chunk pointer to a chunk structure
+ * @param[out] *header pointer to SERIES_CHUNK_HEADER_SIZE bytes
+ * @note       the crc field is written as it is in the structure
+ */
+static void a_series_chunk_put(const series_chunk_t *chunk, uint8_t *header)
+{
+    uint32_t c;
+    
+    memset(header, 0, SERIES_CHUNK_HEADER_SIZE);
+    a_series_put32(header + 0, SERIES_CHUNK_MAGIC);
+    a_series_put16(header + 4, chunk->count);
+    a_series_put16(header + 6, chunk->flags);
+    a_series_put32(header + 8, chunk->payload_len);
+    a_series_put32(header + 12, chunk->crc);
+    a_series_put64(header + 16, chunk->first_ts);
+    a_series_put64(header + 24, chunk->last_ts);
+    for (c = 0; c < SERIES_CHANNEL; c++)
+    {
+        a_series_put16(header + 32 + c * 2, chunk->first[c]);
+        a_series_put16(header + 40 + c * 2, chunk->min[c]);
+        a_series_put16(header + 48 + c * 2, chunk->max[c]);
+        a_series_put32(header + 56 + c * 4, chunk->sum[c]);
+    }
+}
+
+/**
+ * @brief     series crc of a chunk
+ * @param[in] *header pointer to SERIES_CHUNK_HEADER_SIZE bytes
+ * @param[in] *payload pointer to the payload
+ * @param[in] payload_len payload bytes
+ * @return    crc-32
+ * @note      the crc field itself is skipped
+ */
+static uint32_t a_series_chunk_crc(const uint8_t *header, const uint8_t *payload, uint32_t payload_len)
+{
+    uint32_t crc;
+    
+    crc = series_crc32(0, header, 12);
+    crc = series_crc32(crc, header + 16, SERIES_CHUNK_HEADER_SIZE - 16);
+    
+    return series_crc32(crc, payload, payload_len);
+}
+
+/**
+ * @brief     series crc-32
+ * @param[in] crc running crc, 0 at the start
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc-32 of the data
+ * @note      the ieee 802.3 polynomial
+ */
+uint32_t series_crc32(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t c;
+    
+    /* build the table once */
+    if (gs_crc_inited == 0)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            c = i;
+            for (j = 0; j < 8; j++)
+            {
+                c = ((c & 1) != 0) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+            }
+            gs_crc_table[i] = c;
+        }
+        __atomic_store_n(&gs_crc_inited, 1, __ATOMIC_RELEASE);
+    }
+    
+    crc = ~crc;
+    for (i = 0; i < len; i++)
+    {
+        crc = gs_crc_table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    }
+    
+    return ~crc;
+}
+
+/**
+ * @brief     series check a file header
+ * @param[in] *header pointer to SERIES_FILE_HEADER_SIZE bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 header is invalid
+ * @note      none
+ */
+uint8_t series_file_check(const uint8_t *header)
+{
+    if ((a_series_get32(header) != SERIES_FILE_MAGIC) || (a_series_get16(header + 4) != SERIES_VERSION) ||
+        (a_series_get16(header + 6) != SERIES_CHANNEL))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      series parse a chunk header
+ * @param[in]  *header pointer to SERIES_CHUNK_HEADER_SIZE bytes
+ * @param[out] *chunk pointer to a chunk structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 header is invalid
+ * @note       the payload is not checked
+ */
+uint8_t series_chunk_parse(const uint8_t *header, series_chunk_t *chunk)
+{
+    uint32_t c;
+    
+    if (a_series_get32(header) != SERIES_CHUNK_MAGIC)
+    {
+        return 1;
+    }
+    chunk->count = a_series_get16(header + 4);
+    chunk->flags = a_series_get16(header + 6);
+    chunk->payload_len = a_series_get32(header + 8);
+    chunk->crc = a_series_get32(header + 12);
+    chunk->first_ts = a_series_get64(header + 16);
+    chunk->last_ts = a_series_get64(header + 24);
+    for (c = 0; c < SERIES_CHANNEL; c++)
+    {
+        chunk->first[c] = a_series_get16(header + 32 + c * 2);
+        chunk->min[c] = a_series_get16(header + 40 + c * 2);
+        chunk->max[c] = a_series_get16(header + 48 + c * 2);
+        chunk->sum[c] = a_series_get32(header + 56 + c * 4);
+    }
+    if ((chunk->count == 0) || (chunk->count > SERIES_MAX_CHUNK) ||
+        (chunk->payload_len > (uint32_t)(chunk->count - 1) * SERIES_MAX_SAMPLE_BYTES) ||
+        (chunk->last_ts < chunk->first_ts))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     series check the crc of a chunk
+ * @param[in] *header pointer to SERIES_CHUNK_HEADER_SIZE bytes
+ * @param[in] *payload pointer to the payload
+ * @param[in] *chunk pointer to the parsed chunk
+ * @return    status code
+ *            - 0 success
+ *            - 1 crc is wrong
+ * @note      none
+ */
+uint8_t series_chunk_check(const uint8_t *header, const uint8_t *payload, const series_chunk_t *chunk)
+{
+    return (a_series_chunk_crc(header, payload, chunk->payload_len) == chunk->crc) ? 0 : 1;
+}
+
+/**
+ * @brief      series decode a chunk
+ * @param[in]  *chunk pointer to the parsed chunk
+ * @param[in]  *payload pointer to the payload
+ * @param[out] *sample pointer to a buffer of chunk->count samples
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is malformed
+ * @note       the payload is read in place, it can be a mapped file
+ */
+uint8_t series_chunk_decode(const series_chunk_t *chunk, const uint8_t *payload, series_sample_t *sample)
+{
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t ts;
+    int64_t delta;
+    uint64_t v;
+    uint32_t value[SERIES_CHANNEL];
+    uint32_t i;
+    uint32_t c;
+    
+    /* the first sample is in the header */
+    ts = chunk->first_ts;
+    delta = 0;
+    sample[0].timestamp_ms = ts;
+    for (c = 0; c < SERIES_CHANNEL; c++)
+    {
+        value[c] = chunk->first[c];
+        sample[0].value[c] = chunk->first[c];
+    }
+    
+    /* delta of delta timestamps and value deltas */
+    p = payload;
+    end = payload + chunk->payload_len;
+    for (i = 1; i < chunk->count; i++)
+    {
+        if (a_series_get_varint(&p, end, &v) != 0)
+        {
+            return 1;
+        }
+        delta += a_series_unzigzag(v);
+        ts += (uint64_t)delta;
+        sample[i].timestamp_ms = ts;
+        for (c = 0; c < SERIES_CHANNEL; c++)
+        {
+            if (a_series_get_varint(&p, end, &v) != 0)
+            {
+                return 1;
+            }
+            value[c] += (uint32_t)a_series_unzigzag(v);
+            sample[i].value[c] = (uint16_t)value[c];
+        }
+    }
+    
+    /* the last timestamp in the header must match */
+    return ((p == end) && (ts == chunk->last_ts)) ? 0 : 1;
+}
+
+/**
+ * @brief     series writer cut the file back to the end of the last valid chunk
+ * @param[in] *writer pointer to a series writer structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 cut failed
+ * @note      the damaged runs before the last valid chunk are kept, the reader skips them
+ */
+static uint8_t a_series_writer_recover(series_writer_t *writer, const char *path)
+{
+    series_reader_t reader;
+    series_chunk_t chunk;
+    uint64_t end;
+    off_t size;
+    uint8_t res;
+    
+    /* walk every chunk */
+    if (series_reader_open(&reader, path) != 0)
+    {
+        return 1;
+    }
+    end = reader.offset;
+    while ((res = series_reader_next(&reader, &chunk)) != 1)
+    {
+        if (res == 0)
+        {
+            end = reader.offset;
+        }
+    }
+    series_reader_close(&reader);
+    
+    /* cut the torn tail */
+    (void)fseeko(writer->fp, 0, SEEK_END);
+    size = ftello(writer->fp);
+    if ((size > 0) && ((uint64_t)size > end))
+    {
+        printf("series: %llu bytes after the last valid chunk are cut.\n", (unsigned long long)((uint64_t)size - end));
+        if ((fflush(writer->fp) != 0) || (ftruncate(fileno(writer->fp), (off_t)end) != 0))
+        {
+            perror("series: cut failed.\n");
+            
+            return 1;
+        }
+        (void)fseeko(writer->fp, 0, SEEK_END);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     series writer open
+ * @param[in] *writer pointer to a series writer structure
+ * @param[in] *path pointer to a file path
+ * @param[in] chunk_samples samples per chunk, 0 means SERIES_DEFAULT_CHUNK
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      an existing file is read once and cut back to the end of its last valid chunk before it is
+ *            appended to, so a chunk torn by a crash does not hide the chunks written after it,
+ *            the walk reads and checks the crc of the whole file
+ */
+uint8_t series_writer_open(series_writer_t *writer, const char *path, uint32_t chunk_samples)
+{
+    uint8_t header[SERIES_FILE_HEADER_SIZE];
+    
+    /* check the param */
+    if (chunk_samples == 0)
+    {
+        chunk_samples = SERIES_DEFAULT_CHUNK;
+    }
+    if ((chunk_samples < 2) || (chunk_samples > SERIES_MAX_CHUNK))
+    {
+        printf("series: param is invalid.\n");
+        
+        return 1;
+    }
+    memset(writer, 0, sizeof(series_writer_t));
+    writer->chunk_samples = chunk_samples;
+    writer->payload = (uint8_t *)malloc((size_t)chunk_samples * SERIES_MAX_SAMPLE_BYTES);
+    if (writer->payload == NULL)
+    {
+        return 1;
+    }
+    
+    /* open for append, a new file gets the file header */
+    writer->fp = fopen(path, "a+b");
+    if (writer->fp == NULL)
+    {
+        perror("series: open failed.\n");
+        free(writer->payload);
+        writer->payload = NULL;
+        
+        return 1;
+    }
+    (void)fseek(writer->fp, 0, SEEK_END);
+    if (ftell(writer->fp) == 0)
+    {
+        memset(header, 0, SERIES_FILE_HEADER_SIZE);
+        a_series_put32(header + 0, SERIES_FILE_MAGIC);
+        a_series_put16(header + 4, SERIES_VERSION);
+        a_series_put16(header + 6, SERIES_CHANNEL);
+        if (fwrite(header, 1, SERIES_FILE_HEADER_SIZE, writer->fp) != SERIES_FILE_HEADER_SIZE)
+        {
+            (void)series_writer_close(writer);
+            
+            return 1;
+        }
+    }
+    else
+    {
+        (void)fseek(writer->fp, 0, SEEK_SET);
+        if ((fread(header, 1, SERIES_FILE_HEADER_SIZE, writer->fp) != SERIES_FILE_HEADER_SIZE) ||
+            (series_file_check(header) != 0))
+        {
+            printf("series: file is not a series file.\n");
+            (void)series_writer_close(writer);
+            
+            return 1;
+        }
+        
+        /* a chunk torn by a crash would hide every chunk appended after it */
+        if (a_series_writer_recover(writer, path) != 0)
+        {
+            (void)series_writer_close(writer);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     series writer add a sample
+ * @param[in] *writer pointer to a series writer structure
+ * @param[in] *sample pointer to a sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 timestamp goes back
+ * @note      a full chunk is written at once
+ */
+uint8_t series_writer_write(series_writer_t *writer, const series_sample_t *sample)
+{
+    series_chunk_t *chunk;
+    int64_t delta;
+    uint32_t c;
+    
+    chunk = &writer->chunk;
+    
+    /* the first sample goes to the header */
+    if (chunk->count == 0)
+    {
+        memset(chunk, 0, sizeof(series_chunk_t));
+        chunk->count = 1;
+        chunk->first_ts = sample->timestamp_ms;
+        chunk->last_ts = sample->timestamp_ms;
+        for (c = 0; c < SERIES_CHANNEL; c++)
+        {
+            chunk->first[c] = sample->value[c];
+            chunk->min[c] = sample->value[c];
+            chunk->max[c] = sample->value[c];
+            chunk->sum[c] = sample->value[c];
+            writer->prev[c] = sample->value[c];
+        }
+        writer->prev_delta = 0;
+        writer->pos = 0;
+        writer->samples++;
+        
+        return 0;
+    }
+    if (sample->timestamp_ms < chunk->last_ts)
+    {
+        return 2;
+    }
+    
+    /* delta of delta timestamp */
+    delta = (int64_t)(sample->timestamp_ms - chunk->last_ts);
+    writer->pos += a_series_put_varint(writer->payload + writer->pos, a_series_zigzag(delta - writer->prev_delta));
+    writer->prev_delta = delta;
+    chunk->last_ts = sample->timestamp_ms;
+    
+    /* value deltas and the summary */
+    for (c = 0; c < SERIES_CHANNEL; c++)
+    {
+        writer->pos += a_series_put_varint(writer->payload + writer->pos,
+                                           a_series_zigzag((int64_t)sample->value[c] - (int64_t)writer->prev[c]));
+        writer->prev[c] = sample->value[c];
+        if (sample->value[c] < chunk->min[c])
+        {
+            chunk->min[c] = sample->value[c];
+        }
+        if (sample->value[c] > chunk->max[c])
+        {
+            chunk->max[c] = sample->value[c];
+        }
+        chunk->sum[c] += sample->value[c];
+    }
+    chunk->count++;
+    writer->samples++;
+    
+    /* write a full chunk */
+    if (chunk->count >= writer->chunk_samples)
+    {
+        return series_writer_flush(writer);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     series writer write the open chunk
+ * @param[in] *writer pointer to a series writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      the next sample starts a new chunk, so flush only as often as losing a chunk hurts
+ */
+uint8_t series_writer_flush(series_writer_t *writer)
+{
+    uint8_t header[SERIES_CHUNK_HEADER_SIZE];
+    series_chunk_t *chunk;
+    
+    chunk = &writer->chunk;
+    if (chunk->count == 0)
+    {
+        return 0;
+    }
+    
+    /* header with the crc over the header and the payload */
+    chunk->payload_len = writer->pos;
+    chunk->crc = 0;
+    a_series_chunk_put(chunk, header);
+    chunk->crc = a_series_chunk_crc(header, writer->payload, writer->pos);
+    a_series_put32(header + 12, chunk->crc);
+    
+    /* write */
+    chunk->count = 0;
+    if ((fwrite(header, 1, SERIES_CHUNK_HEADER_SIZE, writer->fp) != SERIES_CHUNK_HEADER_SIZE) ||
+        (fwrite(writer->payload, 1, writer->pos, writer->fp) != writer->pos) ||
+        (fflush(writer->fp) != 0))
+    {
+        perror("series: write failed.\n");
+        
+        return 1;
+    }
+    writer->bytes += SERIES_CHUNK_HEADER_SIZE + writer->pos;
+    
+    return 0;
+}
+
+/**
+ * @brief     series writer close
+ * @param[in] *writer pointer to a series writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      the open chunk is written first
+ */
+uint8_t series_writer_close(series_writer_t *writer)
+{
+    uint8_t res;
+    
+    res = 0;
+    if (writer->fp != NULL)
+    {
+        if (writer->payload != NULL)
+        {
+            res = series_writer_flush(writer);
+        }
+        if (fclose(writer->fp) != 0)
+        {
+            res = 1;
+        }
+        writer->fp = NULL;
+    }
+    free(writer->payload);
+    writer->payload = NULL;
+    
+    return res;
+}
+
+/**
+ * @brief     series reader search the next chunk magic
+ * @param[in] *reader pointer to a series reader structure
+ * @param[in] offset file offset to search from
+ * @note      the next offset is the end of the file when no magic is left
+ */
+static void a_series_reader_resync(series_reader_t *reader, uint64_t offset)
+{
+    uint8_t buf[4096];
+    size_t n;
+    size_t i;
+    
+    while (fseeko(reader->fp, (off_t)offset, SEEK_SET) == 0)
+    {
+        n = fread(buf, 1, sizeof(buf), reader->fp);
+        if (n < 4)
+        {
+            offset += n;
+            
+            break;
+        }
+        for (i = 0; (i + 4) <= n; i++)
+        {
+            if (a_series_get32(buf + i) == SERIES_CHUNK_MAGIC)
+            {
+                reader->offset = offset + i;
+                
+                return;
+            }
+        }
+        
+        /* a magic can span two reads */
+        offset += n - 3;
+    }
+    reader->offset = offset;
+}
+
+/**
+ * @brief     series reader open
+ * @param[in] *reader pointer to a series reader structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+uint8_t series_reader_open(series_reader_t *reader, const char *path)
+{
+    uint8_t header[SERIES_FILE_HEADER_SIZE];
+    
+    memset(reader, 0, sizeof(series_reader_t));
+    reader->payload = (uint8_t *)malloc((size_t)SERIES_MAX_CHUNK * SERIES_MAX_SAMPLE_BYTES);
+    if (reader->payload == NULL)
+    {
+        return 1;
+    }
+    reader->fp = fopen(path, "rb");
+    if (reader->fp == NULL)
+    {
+        perror("series: open failed.\n");
+        series_reader_close(reader);
+        
+        return 1;
+    }
+    if ((fread(header, 1, SERIES_FILE_HEADER_SIZE, reader->fp) != SERIES_FILE_HEADER_SIZE) ||
+        (series_file_check(header) != 0))
+    {
+        printf("series: file is not a series file.\n");
+        series_reader_close(reader);
+        
+        return 1;
+    }
+    reader->offset = SERIES_FILE_HEADER_SIZE;
+    
+    return 0;
+}
+
+/**
+ * @brief      series reader read the next chunk
+ * @param[in]  *reader pointer to a series reader structure
+ * @param[out] *chunk pointer to a chunk structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 end of file
+ *             - 2 chunk is damaged, the next call reads the following chunk
+ * @note       a damaged chunk is skipped up to the next SERIES_CHUNK_MAGIC that starts a valid header,
+ *             so the chunks after a torn one are still read, the chunk of a damaged run is cleared
+ *             when its header is not valid
+ */
+uint8_t series_reader_next(series_reader_t *reader, series_chunk_t *chunk)
+{
+    uint64_t offset;
+    size_t n;
+    
+    /* read the header */
+    offset = reader->offset;
+    if (fseeko(reader->fp, (off_t)offset, SEEK_SET) != 0)
+    {
+        return 1;
+    }
+    n = fread(reader->header, 1, SERIES_CHUNK_HEADER_SIZE, reader->fp);
+    if (n == 0)
+    {
+        return 1;
+    }
+    
+    /* read the payload and check the crc */
+    if ((n == SERIES_CHUNK_HEADER_SIZE) && (series_chunk_parse(reader->header, &reader->chunk) == 0))
+    {
+        *chunk = reader->chunk;
+        if ((fread(reader->payload, 1, reader->chunk.payload_len, reader->fp) == reader->chunk.payload_len) &&
+            (series_chunk_check(reader->header, reader->payload, &reader->chunk) == 0))
+        {
+            reader->offset = offset + SERIES_CHUNK_HEADER_SIZE + reader->chunk.payload_len;
+            
+            return 0;
+        }
+    }
+    else
+    {
+        memset(&reader->chunk, 0, sizeof(series_chunk_t));
+        *chunk = reader->chunk;
+    }
+    
+    /* damaged, search the next chunk after the first byte */
+    a_series_reader_resync(reader, offset + 1);
+    
+    return 2;
+}
+
+/**
+ * @brief      series reader decode the current chunk
+ * @param[in]  *reader pointer to a series reader structure
+ * @param[out] *sample pointer to a buffer of chunk.count samples
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode failed
+ * @note       none
+ */
+uint8_t series_reader_decode(series_reader_t *reader, series_sample_t *sample)
+{
+    return series_chunk_decode(&reader->chunk, reader->payload, sample);
+}
+
+/**
+ * @brief     series reader close
+ * @param[in] *reader pointer to a series reader structure
+ * @note      none
+ */
+void series_reader_close(series_reader_t *reader)
+{
+    if (reader->fp != NULL)
+    {
+        (void)fclose(reader->fp);
+        reader->fp = NULL;
+    }
+    free(reader->payload);
+    reader->payload = NULL;
+}
@@ -0,0 +1,324 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm.c
+ * @brief     shm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "shm.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief     shm get a slot of a region
+ * @param[in] *region pointer to a mapped region
+ * @param[in] slot slot index
+ * @return    pointer to the slot
+ * @note      none
+ */
+static shm_slot_t *a_shm_slot(const void *region, uint32_t slot)
+{
+    return (shm_slot_t *)((uint8_t *)region + sizeof(shm_header_t) + sizeof(shm_slot_t) * slot);
+}
+
+/**
+ * @brief     shm writer open
+ * @param[in] *writer pointer to a shm writer structure
+ * @param[in] *name pointer to a shm object name such as "/sgp30"
+ * @param[in] slots sensor slot number
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the object is created readable by every user and all slots start as SHM_STATE_NONE,
+ *            there must be only one writer per object
+ */
+uint8_t shm_writer_open(shm_writer_t *writer, const char *name, uint32_t slots)
+{
+    shm_header_t *header;
+    
+    /* check the param */
+    if ((slots == 0) || (slots > SHM_MAX_SLOT) || (strlen(name) >= sizeof(writer->name)))
+    {
+        printf("shm: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* create the object */
+    memset(writer, 0, sizeof(shm_writer_t));
+    (void)strncpy(writer->name, name, sizeof(writer->name) - 1);
+    writer->slots = slots;
+    writer->size = sizeof(shm_header_t) + sizeof(shm_slot_t) * slots;
+    writer->fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+    if (writer->fd < 0)
+    {
+        perror("shm: open failed.\n");
+        
+        return 1;
+    }
+    if (ftruncate(writer->fd, (off_t)writer->size) < 0)
+    {
+        perror("shm: truncate failed.\n");
+        (void)close(writer->fd);
+        
+        return 1;
+    }
+    writer->region = mmap(NULL, writer->size, PROT_READ | PROT_WRITE, MAP_SHARED, writer->fd, 0);
+    if (writer->region == MAP_FAILED)
+    {
+        perror("shm: mmap failed.\n");
+        writer->region = NULL;
+        (void)close(writer->fd);
+        
+        return 1;
+    }
+    
+    /* readers check the magic last, so it is stored after the rest of the header */
+    header = (shm_header_t *)writer->region;
+    __atomic_store_n(&header->magic, 0, __ATOMIC_RELAXED);
+    memset(writer->region, 0, writer->size);
+    header->version = SHM_VERSION;
+    header->slots = slots;
+    header->slot_size = sizeof(shm_slot_t);
+    header->pid = (uint32_t)getpid();
+    __atomic_store_n(&header->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     shm publish a sample
+ * @param[in] *writer pointer to a shm writer structure
+ * @param[in] slot sensor slot
+ * @param[in] *sample pointer to a sample, its seq is ignored and counted by the slot
+ * @return    status code
+ *            - 0 success
+ *            - 1 slot is invalid
+ * @note      the writer never waits for a reader, a reader inside the slot simply retries,
+ *            a SHM_STATE_FAILED sample keeps the last values of the slot
+ */
+uint8_t shm_publish(shm_writer_t *writer, uint32_t slot, const shm_sample_t *sample)
+{
+    shm_slot_t *s;
+    uint32_t lock;
+    
+    if ((writer->region == NULL) || (slot >= writer->slots))
+    {
+        return 1;
+    }
+    s = a_shm_slot(writer->region, slot);
+    
+    /* odd while writing, the fence keeps the payload stores after it */
+    lock = __atomic_load_n(&s->lock, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->lock, lock + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    
+    /* payload */
+    __atomic_store_n(&s->state, sample->state, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->seq, __atomic_load_n(&s->seq, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->timestamp_ns, sample->timestamp_ns, __ATOMIC_RELAXED);
+    if (sample->state != SHM_STATE_FAILED)
+    {
+        __atomic_store_n(&s->co2_eq_ppm, sample->co2_eq_ppm, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->tvoc_ppb, sample->tvoc_ppb, __ATOMIC_RELAXED);
+    }
+    
+    /* even again, the payload is visible before it */
+    __atomic_store_n(&s->lock, lock + 2, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     shm writer close
+ * @param[in] *writer pointer to a shm writer structure
+ * @param[in] unlink 1 removes the object, 0 leaves it for the readers
+ * @note      every slot is marked as SHM_STATE_STOPPED first
+ */
+void shm_writer_close(shm_writer_t *writer, uint8_t unlink)
+{
+    shm_sample_t sample;
+    shm_slot_t *s;
+    uint32_t i;
+    
+    if (writer->region == NULL)
+    {
+        return;
+    }
+    
+    /* keep the last values, only the state changes */
+    for (i = 0; i < writer->slots; i++)
+    {
+        s = a_shm_slot(writer->region, i);
+        sample.state = SHM_STATE_STOPPED;
+        sample.timestamp_ns = s->timestamp_ns;
+        sample.co2_eq_ppm = (uint16_t)s->co2_eq_ppm;
+        sample.tvoc_ppb = (uint16_t)s->tvoc_ppb;
+        (void)shm_publish(writer, i, &sample);
+    }
+    (void)munmap(writer->region, writer->size);
+    (void)close(writer->fd);
+    writer->region = NULL;
+    if (unlink != 0)
+    {
+        (void)shm_unlink(writer->name);
+    }
+}
+
+/**
+ * @brief     shm reader open
+ * @param[in] *reader pointer to a shm reader structure
+ * @param[in] *name pointer to a shm object name such as "/sgp30"
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the region is mapped read only, the fd is closed at once
+ */
+uint8_t shm_reader_open(shm_reader_t *reader, const char *name)
+{
+    const shm_header_t *header;
+    struct stat st;
+    int fd;
+    
+    memset(reader, 0, sizeof(shm_reader_t));
+    
+    /* map the object */
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        perror("shm: open failed.\n");
+        
+        return 1;
+    }
+    if ((fstat(fd, &st) < 0) || ((size_t)st.st_size < sizeof(shm_header_t)))
+    {
+        printf("shm: object is too small.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    reader->size = (size_t)st.st_size;
+    reader->region = mmap(NULL, reader->size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (reader->region == MAP_FAILED)
+    {
+        perror("shm: mmap failed.\n");
+        reader->region = NULL;
+        
+        return 1;
+    }
+    
+    /* check the layout */
+    header = (const shm_header_t *)reader->region;
+    if ((__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC) || (header->version != SHM_VERSION) ||
+        (header->slot_size != sizeof(shm_slot_t)) ||
+        (reader->size < sizeof(shm_header_t) + sizeof(shm_slot_t) * header->slots))
+    {
+        printf("shm: layout is invalid.\n");
+        shm_reader_close(reader);
+        
+        return 1;
+    }
+    reader->slots = header->slots;
+    
+    return 0;
+}
+
+/**
+ * @brief      shm read the latest sample of a slot
+ * @param[in]  *reader pointer to a shm reader structure
+ * @param[in]  slot sensor slot
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 slot is invalid
+ *             - 2 the writer stayed inside the slot for SHM_READ_RETRY retries
+ * @note       no syscall and no lock, the copy is retried while the writer is inside the slot
+ */
+uint8_t shm_read(const shm_reader_t *reader, uint32_t slot, shm_sample_t *sample)
+{
+    shm_slot_t *s;
+    uint32_t begin;
+    uint32_t end;
+    uint32_t i;
+    
+    if ((reader->region == NULL) || (slot >= reader->slots))
+    {
+        return 1;
+    }
+    s = a_shm_slot(reader->region, slot);
+    
+    for (i = 0; i < SHM_READ_RETRY; i++)
+    {
+        /* skip an odd sequence, the writer is inside */
+        begin = __atomic_load_n(&s->lock, __ATOMIC_ACQUIRE);
+        if ((begin & 1) != 0)
+        {
+            continue;
+        }
+        
+        /* copy */
+        sample->state = (uint8_t)__atomic_load_n(&s->state, __ATOMIC_RELAXED);
+        sample->seq = __atomic_load_n(&s->seq, __ATOMIC_RELAXED);
+        sample->timestamp_ns = __atomic_load_n(&s->timestamp_ns, __ATOMIC_RELAXED);
+        sample->co2_eq_ppm = (uint16_t)__atomic_load_n(&s->co2_eq_ppm, __ATOMIC_RELAXED);
+        sample->tvoc_ppb = (uint16_t)__atomic_load_n(&s->tvoc_ppb, __ATOMIC_RELAXED);
+        
+        /* the copy is good if the sequence did not move */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&s->lock, __ATOMIC_RELAXED);
+        if (begin == end)
+        {
+            return 0;
+        }
+    }
+    
+    return 2;
+}
+
+/**
+ * @brief     shm reader close
+ * @param[in] *reader pointer to a shm reader structure
+ * @note      none
+ */
+void shm_reader_close(shm_reader_t *reader)
+{
+    if (reader->region != NULL)
+    {
+        (void)munmap((void *)reader->region, reader->size);
+        reader->region = NULL;
+    }
+}
@@ -0,0 +1,483 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sketch.c
+ * @brief     sketch source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sketch.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief sketch mapping definition
+ */
+static double gs_log_gamma = 0.0;        /**< ln((1 + a) / (1 - a)), 0 until the first use */
+
+/**
+ * @brief  sketch get ln of the bin ratio
+ * @return ln((1 + a) / (1 - a))
+ * @note   none
+ */
+static double a_sketch_log_gamma(void)
+{
+    if (gs_log_gamma == 0.0)
+    {
+        gs_log_gamma = log((1.0 + SKETCH_ALPHA) / (1.0 - SKETCH_ALPHA));
+    }
+    
+    return gs_log_gamma;
+}
+
+/**
+ * @brief     sketch put a varint
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @return    written bytes
+ * @note      none
+ */
+static uint32_t a_sketch_put_varint(uint8_t *buf, uint64_t v)
+{
+    uint32_t n;
+    
+    n = 0;
+    while (v >= 0x80)
+    {
+        buf[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = (uint8_t)v;
+    
+    return n;
+}
+
+/**
+ * @brief         sketch get a varint
+ * @param[in,out] **p pointer to the read position
+ * @param[in]     *end pointer to the end of the data
+ * @param[out]    *v pointer to the value
+ * @return        status code
+ *                - 0 success
+ *                - 1 varint is truncated or too long
+ * @note          none
+ */
+static uint8_t a_sketch_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v)
+{
+    uint32_t shift;
+    
+    *v = 0;
+    for (shift = 0; shift < 64; shift += 7)
+    {
+        if (*p >= end)
+        {
+            return 1;
+        }
+        *v |= (uint64_t)(**p & 0x7F) << shift;
+        if ((*((*p)++) & 0x80) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     sketch clear
+ * @param[in] *sketch pointer to a sketch structure
+ * @note      none
+ */
+void sketch_clear(sketch_t *sketch)
+{
+    memset(sketch, 0, sizeof(sketch_t));
+    sketch->min = 0xFFFF;
+    sketch->lo = SKETCH_BIN;
+}
+
+/**
+ * @brief     sketch add a value
+ * @param[in] *sketch pointer to a sketch structure
+ * @param[in] value value
+ * @note      none
+ */
+void sketch_add(sketch_t *sketch, uint16_t value)
+{
+    uint32_t i;
+    
+    sketch->count++;
+    if (value < sketch->min)
+    {
+        sketch->min = value;
+    }
+    if (value > sketch->max)
+    {
+        sketch->max = value;
+    }
+    if (value == 0)
+    {
+        sketch->zero++;
+        
+        return;
+    }
+    
+    /* bin i holds (g^(i-1), g^i] */
+    i = (uint32_t)ceil(log((double)value) / a_sketch_log_gamma());
+    if (i >= SKETCH_BIN)
+    {
+        i = SKETCH_BIN - 1;
+    }
+    sketch->bin[i]++;
+    if (i < sketch->lo)
+    {
+        sketch->lo = (uint16_t)i;
+    }
+    if (i > sketch->hi)
+    {
+        sketch->hi = (uint16_t)i;
+    }
+}
+
+/**
+ * @brief     sketch merge a sketch into another
+ * @param[in] *dst pointer to the sketch merged into
+ * @param[in] *src pointer to the sketch merged
+ * @note      the result is the sketch of both streams, the error bound stays the same
+ */
+void sketch_merge(sketch_t *dst, const sketch_t *src)
+{
+    uint32_t i;
+    
+    if (src->count == 0)
+    {
+        return;
+    }
+    dst->count += src->count;
+    dst->zero += src->zero;
+    if (src->min < dst->min)
+    {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max)
+    {
+        dst->max = src->max;
+    }
+    if (src->lo > src->hi)
+    {
+        return;
+    }
+    for (i = src->lo; i <= src->hi; i++)
+    {
+        dst->bin[i] += src->bin[i];
+    }
+    if (src->lo < dst->lo)
+    {
+        dst->lo = src->lo;
+    }
+    if (src->hi > dst->hi)
+    {
+        dst->hi = src->hi;
+    }
+}
+
+/**
+ * @brief      sketch get a quantile
+ * @param[in]  *sketch pointer to a sketch structure
+ * @param[in]  q quantile in [0, 1]
+ * @param[out] *value pointer to the quantile
+ * @return     status code
+ *             - 0 success
+ *             - 1 sketch is empty or q is invalid
+ * @note       for the value v of rank floor(q * (count - 1)) the result is within SKETCH_ALPHA * v,
+ *             0 is exact and the result is clamped to the exact min and max
+ */
+uint8_t sketch_quantile(const sketch_t *sketch, double q, double *value)
+{
+    uint64_t rank;
+    uint64_t seen;
+    uint32_t i;
+    double v;
+    
+    if ((sketch->count == 0) || (q < 0.0) || (q > 1.0))
+    {
+        return 1;
+    }
+    rank = (uint64_t)(q * (double)(sketch->count - 1));
+    if (rank < sketch->zero)
+    {
+        *value = 0.0;
+        
+        return 0;
+    }
+    seen = sketch->zero;
+    v = (double)sketch->max;
+    for (i = sketch->lo; i <= sketch->hi; i++)
+    {
+        seen += sketch->bin[i];
+        if (seen > rank)
+        {
+            /* the point of the bin with the same relative error to both edges */
+            v = 2.0 * exp((double)i * a_sketch_log_gamma()) / (1.0 + exp(a_sketch_log_gamma()));
+            
+            break;
+        }
+    }
+    if (v < (double)sketch->min)
+    {
+        v = (double)sketch->min;
+    }
+    if (v > (double)sketch->max)
+    {
+        v = (double)sketch->max;
+    }
+    *value = v;
+    
+    return 0;
+}
+
+/**
+ * @brief      sketch encode
+ * @param[in]  *sketch pointer to a sketch structure
+ * @param[out] *buf pointer to a buffer of SKETCH_MAX_ENCODED bytes
+ * @return     encoded bytes
+ * @note       only the used bins are written, so a sketch can be sent to be merged elsewhere
+ */
+uint32_t sketch_encode(const sketch_t *sketch, uint8_t *buf)
+{
+    uint32_t alpha;
+    uint32_t last;
+    uint32_t pos;
+    uint32_t i;
+    
+    /* magic, accuracy in 1e-4, min, max, reserved */
+    alpha = (uint32_t)(SKETCH_ALPHA * 10000.0 + 0.5);
+    buf[0] = (uint8_t)(SKETCH_MAGIC >> 0);
+    buf[1] = (uint8_t)(SKETCH_MAGIC >> 8);
+    buf[2] = (uint8_t)(SKETCH_MAGIC >> 16);
+    buf[3] = (uint8_t)(SKETCH_MAGIC >> 24);
+    buf[4] = (uint8_t)(alpha >> 0);
+    buf[5] = (uint8_t)(alpha >> 8);
+    buf[6] = (uint8_t)(sketch->min >> 0);
+    buf[7] = (uint8_t)(sketch->min >> 8);
+    buf[8] = (uint8_t)(sketch->max >> 0);
+    buf[9] = (uint8_t)(sketch->max >> 8);
+    buf[10] = 0;
+    buf[11] = 0;
+    pos = 12;
+    
+    /* the zero count, then the index gap and the count of every used bin */
+    pos += a_sketch_put_varint(buf + pos, sketch->zero);
+    last = 0;
+    for (i = sketch->lo; (i <= sketch->hi) && (i < SKETCH_BIN); i++)
+    {
+        if (sketch->bin[i] == 0)
+        {
+            continue;
+        }
+        pos += a_sketch_put_varint(buf + pos, i - last);
+        pos += a_sketch_put_varint(buf + pos, sketch->bin[i]);
+        last = i;
+    }
+    
+    return pos;
+}
+
+/**
+ * @brief      sketch decode
+ * @param[in]  *buf pointer to the encoded bytes
+ * @param[in]  len encoded bytes
+ * @param[out] *sketch pointer to a sketch structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 data is malformed or has another accuracy
+ * @note       none
+ */
+uint8_t sketch_decode(const uint8_t *buf, uint32_t len, sketch_t *sketch)
+{
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t gap;
+    uint64_t n;
+    uint32_t alpha;
+    uint32_t i;
+    
+    sketch_clear(sketch);
+    alpha = (uint32_t)(SKETCH_ALPHA * 10000.0 + 0.5);
+    if ((len < 13) ||
+        (((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24)) != SKETCH_MAGIC) ||
+        (((uint32_t)buf[4] | ((uint32_t)buf[5] << 8)) != alpha))
+    {
+        return 1;
+    }
+    sketch->min = (uint16_t)(buf[6] | (buf[7] << 8));
+    sketch->max = (uint16_t)(buf[8] | (buf[9] << 8));
+    p = buf + 12;
+    end = buf + len;
+    if (a_sketch_get_varint(&p, end, &sketch->zero) != 0)
+    {
+        return 1;
+    }
+    sketch->count = sketch->zero;
+    i = 0;
+    while (p < end)
+    {
+        if ((a_sketch_get_varint(&p, end, &gap) != 0) || (a_sketch_get_varint(&p, end, &n) != 0) ||
+            ((i + gap) >= SKETCH_BIN) || (n == 0) || (n > (UINT64_MAX - sketch->count)) ||
+            ((gap == 0) && (sketch->count != sketch->zero)))
+        {
+            sketch_clear(sketch);
+            
+            return 1;
+        }
+        i += (uint32_t)gap;
+        sketch->bin[i] = n;
+        sketch->count += n;
+        if (i < sketch->lo)
+        {
+            sketch->lo = (uint16_t)i;
+        }
+        sketch->hi = (uint16_t)i;
+    }
+    if ((sketch->count != 0) && (sketch->min > sketch->max))
+    {
+        sketch_clear(sketch);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sketch ring init
+ * @param[in] *ring pointer to a sketch ring structure
+ * @param[in] buckets bucket number
+ * @param[in] bucket_ms bucket length
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the ring covers buckets * bucket_ms of history
+ */
+uint8_t sketch_ring_init(sketch_ring_t *ring, uint32_t buckets, uint64_t bucket_ms)
+{
+    uint32_t i;
+    
+    memset(ring, 0, sizeof(sketch_ring_t));
+    if ((buckets == 0) || (bucket_ms == 0))
+    {
+        return 1;
+    }
+    ring->start = (uint64_t *)malloc(sizeof(uint64_t) * buckets);
+    ring->sketch = (sketch_t *)malloc(sizeof(sketch_t) * buckets);
+    if ((ring->start == NULL) || (ring->sketch == NULL))
+    {
+        sketch_ring_deinit(ring);
+        
+        return 1;
+    }
+    for (i = 0; i < buckets; i++)
+    {
+        ring->start[i] = UINT64_MAX;
+        sketch_clear(&ring->sketch[i]);
+    }
+    ring->buckets = buckets;
+    ring->bucket_ms = bucket_ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     sketch ring add a value
+ * @param[in] *ring pointer to a sketch ring structure
+ * @param[in] timestamp_ms value timestamp
+ * @param[in] value value
+ * @note      a bucket is cleared when a new span of time reuses it
+ */
+void sketch_ring_add(sketch_ring_t *ring, uint64_t timestamp_ms, uint16_t value)
+{
+    uint64_t start;
+    uint32_t i;
+    
+    if (ring->buckets == 0)
+    {
+        return;
+    }
+    start = timestamp_ms - timestamp_ms % ring->bucket_ms;
+    i = (uint32_t)((timestamp_ms / ring->bucket_ms) % ring->buckets);
+    if (ring->start[i] != start)
+    {
+        if ((ring->start[i] != UINT64_MAX) && (ring->start[i] > start))
+        {
+            /* older than the history */
+            return;
+        }
+        ring->start[i] = start;
+        sketch_clear(&ring->sketch[i]);
+    }
+    sketch_add(&ring->sketch[i], value);
+}
+
+/**
+ * @brief      sketch ring merge the buckets of a window
+ * @param[in]  *ring pointer to a sketch ring structure
+ * @param[in]  now_ms window end
+ * @param[in]  window_ms window length
+ * @param[out] *sketch pointer to a sketch structure
+ * @note       the buckets that start in (now_ms - window_ms, now_ms] are merged, so the window
+ *             is rounded to whole buckets
+ */
+void sketch_ring_window(const sketch_ring_t *ring, uint64_t now_ms, uint64_t window_ms, sketch_t *sketch)
+{
+    uint32_t i;
+    
+    sketch_clear(sketch);
+    for (i = 0; i < ring->buckets; i++)
+    {
+        if ((ring->start[i] != UINT64_MAX) && (ring->start[i] <= now_ms) &&
+            ((ring->start[i] + window_ms) > now_ms))
+        {
+            sketch_merge(sketch, &ring->sketch[i]);
+        }
+    }
+}
+
+/**
+ * @brief     sketch ring deinit
+ * @param[in] *ring pointer to a sketch ring structure
+ * @note      none
+ */
+void sketch_ring_deinit(sketch_ring_t *ring)
+{
+    free(ring->start);
+    free(ring->sketch);
+    memset(ring, 0, sizeof(sketch_ring_t));
+}
@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      window.c
+ * @brief     window source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "window.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief     window drop the oldest sample of a window
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensor sensor index
+ * @param[in] index window index
+ * @note      a deque front of the same sequence leaves with it
+ */
+static void a_window_evict(window_t *window, uint32_t sensor, uint32_t index)
+{
+    uint32_t ws;
+    uint32_t wc;
+    uint32_t seq;
+    uint32_t mask;
+    uint32_t c;
+    uint64_t v;
+    
+    ws = sensor * window->windows + index;
+    seq = window->tail[ws];
+    mask = window->window_mask[index];
+    for (c = 0; c < WINDOW_CHANNEL; c++)
+    {
+        wc = ws * WINDOW_CHANNEL + c;
+        v = window->value[(sensor * WINDOW_CHANNEL + c) * window->cap + (seq & window->mask)];
+        window->sum[wc] -= v;
+        window->sumsq[wc] -= v * v;
+        if ((window->min_front[wc] != window->min_back[wc]) &&
+            (window->min_q[(sensor * WINDOW_CHANNEL + c) * window->total + window->window_off[index] +
+                           (window->min_front[wc] & mask)] == seq))
+        {
+            window->min_front[wc]++;
+        }
+        if ((window->max_front[wc] != window->max_back[wc]) &&
+            (window->max_q[(sensor * WINDOW_CHANNEL + c) * window->total + window->window_off[index] +
+                           (window->max_front[wc] & mask)] == seq))
+        {
+            window->max_front[wc]++;
+        }
+    }
+    window->tail[ws] = seq + 1;
+}
+
+/**
+ * @brief     window init
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensors sensor number
+ * @param[in] *length_ms pointer to the window lengths
+ * @param[in] windows window number
+ * @param[in] period_ms shortest sample period
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      a window holds length_ms / period_ms + 1 samples at most, a faster stream keeps
+ *            only the newest of them, all memory is allocated here
+ */
+uint8_t window_init(window_t *window, uint32_t sensors, const uint64_t *length_ms, uint32_t windows, uint32_t period_ms)
+{
+    uint64_t cap;
+    uint64_t ring;
+    uint64_t sw;
+    uint8_t *p;
+    uint32_t i;
+    size_t size;
+    
+    memset(window, 0, sizeof(window_t));
+    if ((sensors == 0) || (length_ms == NULL) || (windows == 0) || (windows > WINDOW_MAX_WINDOW) || (period_ms == 0))
+    {
+        return 1;
+    }
+    for (i = 0; i < windows; i++)
+    {
+        cap = length_ms[i] / period_ms + 1;
+        if ((length_ms[i] < period_ms) || (cap > 0x1000000ULL))
+        {
+            return 1;
+        }
+        
+        /* rings of a power of 2 index by a mask instead of a division */
+        ring = 1;
+        while (ring < cap)
+        {
+            ring <<= 1;
+        }
+        window->length_ms[i] = length_ms[i];
+        window->window_cap[i] = (uint32_t)cap;
+        window->window_mask[i] = (uint32_t)(ring - 1);
+        window->window_off[i] = window->total;
+        window->total += (uint32_t)ring;
+        if (ring > window->cap)
+        {
+            window->cap = (uint32_t)ring;
+        }
+    }
+    window->mask = window->cap - 1;
+    if (((uint64_t)sensors * WINDOW_CHANNEL * window->total) > 0xFFFFFFFFULL)
+    {
+        return 1;
+    }
+    window->sensors = sensors;
+    window->windows = windows;
+    
+    /* one block, 8 bytes arrays first */
+    sw = (uint64_t)sensors * windows * WINDOW_CHANNEL;
+    size = (size_t)((uint64_t)sensors * window->cap * sizeof(uint64_t) +
+                    sw * sizeof(uint64_t) * 2 +
+                    (uint64_t)sensors * sizeof(uint32_t) +
+                    (uint64_t)sensors * windows * sizeof(uint32_t) +
+                    sw * sizeof(uint32_t) * 4 +
+                    (uint64_t)sensors * WINDOW_CHANNEL * window->total * sizeof(uint32_t) * 2 +
+                    (uint64_t)sensors * WINDOW_CHANNEL * window->cap * sizeof(uint16_t));
+    window->arena = calloc(1, size);
+    if (window->arena == NULL)
+    {
+        return 1;
+    }
+    p = (uint8_t *)window->arena;
+    window->ts = (uint64_t *)p;
+    p += (size_t)sensors * window->cap * sizeof(uint64_t);
+    window->sum = (uint64_t *)p;
+    p += (size_t)sw * sizeof(uint64_t);
+    window->sumsq = (uint64_t *)p;
+    p += (size_t)sw * sizeof(uint64_t);
+    window->head = (uint32_t *)p;
+    p += (size_t)sensors * sizeof(uint32_t);
+    window->tail = (uint32_t *)p;
+    p += (size_t)sensors * windows * sizeof(uint32_t);
+    window->min_front = (uint32_t *)p;
+    p += (size_t)sw * sizeof(uint32_t);
+    window->min_back = (uint32_t *)p;
+    p += (size_t)sw * sizeof(uint32_t);
+    window->max_front = (uint32_t *)p;
+    p += (size_t)sw * sizeof(uint32_t);
+    window->max_back = (uint32_t *)p;
+    p += (size_t)sw * sizeof(uint32_t);
+    window->min_q = (uint32_t *)p;
+    p += (size_t)sensors * WINDOW_CHANNEL * window->total * sizeof(uint32_t);
+    window->max_q = (uint32_t *)p;
+    p += (size_t)sensors * WINDOW_CHANNEL * window->total * sizeof(uint32_t);
+    window->value = (uint16_t *)p;
+    
+    return 0;
+}
+
+/**
+ * @brief     window push a sample of a sensor
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensor sensor index
+ * @param[in] timestamp_ms sample timestamp
+ * @param[in] *value pointer to WINDOW_CHANNEL values
+ * @return    status code
+ *            - 0 success
+ *            - 1 push failed
+ *            - 2 timestamp goes back
+ * @note      amortized O(1) per window and channel, samples older than a window length
+ *            before this one leave the window
+ */
+uint8_t window_push(window_t *window, uint32_t sensor, uint64_t timestamp_ms, const uint16_t *value)
+{
+    uint16_t *history;
+    uint32_t *q;
+    uint32_t seq;
+    uint32_t mask;
+    uint32_t ws;
+    uint32_t wc;
+    uint32_t w;
+    uint32_t c;
+    uint16_t v;
+    
+    if ((window->arena == NULL) || (sensor >= window->sensors) || (value == NULL))
+    {
+        return 1;
+    }
+    seq = window->head[sensor];
+    if ((seq != 0) && (timestamp_ms < window->ts[sensor * window->cap + ((seq - 1) & window->mask)]))
+    {
+        return 2;
+    }
+    
+    /* a full window drops its oldest sample before the history slot is reused */
+    for (w = 0; w < window->windows; w++)
+    {
+        if ((seq - window->tail[sensor * window->windows + w]) >= window->window_cap[w])
+        {
+            a_window_evict(window, sensor, w);
+        }
+    }
+    window->ts[sensor * window->cap + (seq & window->mask)] = timestamp_ms;
+    for (c = 0; c < WINDOW_CHANNEL; c++)
+    {
+        window->value[(sensor * WINDOW_CHANNEL + c) * window->cap + (seq & window->mask)] = value[c];
+    }
+    
+    /* add to every window, a deque keeps its values monotonic from the front */
+    for (w = 0; w < window->windows; w++)
+    {
+        ws = sensor * window->windows + w;
+        mask = window->window_mask[w];
+        for (c = 0; c < WINDOW_CHANNEL; c++)
+        {
+            wc = ws * WINDOW_CHANNEL + c;
+            v = value[c];
+            history = window->value + (sensor * WINDOW_CHANNEL + c) * window->cap;
+            window->sum[wc] += v;
+            window->sumsq[wc] += (uint64_t)v * v;
+            q = window->min_q + (sensor * WINDOW_CHANNEL + c) * window->total + window->window_off[w];
+            while ((window->min_back[wc] != window->min_front[wc]) &&
+                   (history[q[(window->min_back[wc] - 1) & mask] & window->mask] >= v))
+            {
+                window->min_back[wc]--;
+            }
+            q[window->min_back[wc] & mask] = seq;
+            window->min_back[wc]++;
+            q = window->max_q + (sensor * WINDOW_CHANNEL + c) * window->total + window->window_off[w];
+            while ((window->max_back[wc] != window->max_front[wc]) &&
+                   (history[q[(window->max_back[wc] - 1) & mask] & window->mask] <= v))
+            {
+                window->max_back[wc]--;
+            }
+            q[window->max_back[wc] & mask] = seq;
+            window->max_back[wc]++;
+        }
+    }
+    window->head[sensor] = seq + 1;
+    
+    /* samples out of the time span leave */
+    for (w = 0; w < window->windows; w++)
+    {
+        ws = sensor * window->windows + w;
+        while ((window->tail[ws] != window->head[sensor]) &&
+               ((window->ts[sensor * window->cap + (window->tail[ws] & window->mask)] + window->length_ms[w]) <= timestamp_ms))
+        {
+            a_window_evict(window, sensor, w);
+        }
+    }
+    
+    return 0;
+}
+
+#ifndef __SIZEOF_INT128__
+/**
+ * @brief      window multiply two 64 bits numbers into 128 bits
+ * @param[in]  a first number
+ * @param[in]  b second number
+ * @param[out] *hi pointer to a high 64 bits buffer
+ * @param[out] *lo pointer to a low 64 bits buffer
+ * @note       used by the 32 bits targets which have no 128 bits integer
+ */
+static void a_window_mul_u64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
+{
+    uint64_t ll, lh, hl, hh, mid;
+    
+    ll = (a & 0xFFFFFFFFULL) * (b & 0xFFFFFFFFULL);
+    lh = (a & 0xFFFFFFFFULL) * (b >> 32);
+    hl = (a >> 32) * (b & 0xFFFFFFFFULL);
+    hh = (a >> 32) * (b >> 32);
+    mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+    *lo = (mid << 32) | (ll & 0xFFFFFFFFULL);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+#endif
+
+/**
+ * @brief      window get the stat of a window
+ * @param[in]  *window pointer to a window engine structure
+ * @param[in]  sensor sensor index
+ * @param[in]  index window index
+ * @param[in]  channel channel index
+ * @param[out] *stat pointer to a window stat structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       O(1), an empty window gives a zero stat
+ */
+uint8_t window_get(window_t *window, uint32_t sensor, uint32_t index, uint32_t channel, window_stat_t *stat)
+{
+    const uint16_t *history;
+    uint32_t ws;
+    uint32_t wc;
+    uint32_t mask;
+    uint32_t off;
+    double n;
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 d;
+#else
+    uint64_t a_hi, a_lo;
+    uint64_t b_hi, b_lo;
+#endif
+    
+    if ((window->arena == NULL) || (sensor >= window->sensors) || (index >= window->windows) ||
+        (channel >= WINDOW_CHANNEL) || (stat == NULL))
+    {
+        return 1;
+    }
+    memset(stat, 0, sizeof(window_stat_t));
+    ws = sensor * window->windows + index;
+    wc = ws * WINDOW_CHANNEL + channel;
+    stat->count = window->head[sensor] - window->tail[ws];
+    if (stat->count == 0)
+    {
+        return 0;
+    }
+    history = window->value + (sensor * WINDOW_CHANNEL + channel) * window->cap;
+    mask = window->window_mask[index];
+    off = (sensor * WINDOW_CHANNEL + channel) * window->total + window->window_off[index];
+    stat->sum = window->sum[wc];
+    stat->min = history[window->min_q[off + (window->min_front[wc] & mask)] & window->mask];
+    stat->max = history[window->max_q[off + (window->max_front[wc] & mask)] & window->mask];
+    
+    /* n * sumsq - sum * sum is taken exactly in 128 bits, it is never negative and a double would cancel it
+     * to zero or below once both products pass 2^53, so only the final division rounds */
+    n = (double)stat->count;
+    stat->mean = (double)stat->sum / n;
+#ifdef __SIZEOF_INT128__
+    d = (unsigned __int128)stat->count * window->sumsq[wc] - (unsigned __int128)stat->sum * stat->sum;
+    stat->variance = (double)d / (n * n);
+#else
+    a_window_mul_u64(stat->count, window->sumsq[wc], &a_hi, &a_lo);
+    a_window_mul_u64(stat->sum, stat->sum, &b_hi, &b_lo);
+    a_hi = a_hi - b_hi - ((a_lo < b_lo) ? 1 : 0);
+    a_lo = a_lo - b_lo;
+    stat->variance = ((double)a_hi * 18446744073709551616.0 + (double)a_lo) / (n * n);
+#endif
+    
+    return 0;
+}
+
+/**
+ * @brief     window reset the windows of a sensor
+ * @param[in] *window pointer to a window engine structure
+ * @param[in] sensor sensor index
+ * @return    status code
+ *            - 0 success
+ *            - 1 reset failed
+ * @note      none
+ */
+uint8_t window_reset(window_t *window, uint32_t sensor)
+{
+    uint32_t sw;
+    
+    if ((window->arena == NULL) || (sensor >= window->sensors))
+    {
+        return 1;
+    }
+    sw = window->windows * WINDOW_CHANNEL;
+    window->head[sensor] = 0;
+    memset(window->tail + sensor * window->windows, 0, sizeof(uint32_t) * window->windows);
+    memset(window->sum + sensor * sw, 0, sizeof(uint64_t) * sw);
+    memset(window->sumsq + sensor * sw, 0, sizeof(uint64_t) * sw);
+    memset(window->min_front + sensor * sw, 0, sizeof(uint32_t) * sw);
+    memset(window->min_back + sensor * sw, 0, sizeof(uint32_t) * sw);
+    memset(window->max_front + sensor * sw, 0, sizeof(uint32_t) * sw);
+    memset(window->max_back + sensor * sw, 0, sizeof(uint32_t) * sw);
+    
+    return 0;
+}
+
+/**
+ * @brief     window deinit
+ * @param[in] *window pointer to a window engine structure
+ * @note      none
+ */
+void window_deinit(window_t *window)
+{
+    free(window->arena);
+    memset(window, 0, sizeof(window_t));
+}
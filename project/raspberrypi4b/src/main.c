@@ -38,8 +38,261 @@
 #include "driver_sgp30_advance.h"
 #include "driver_sgp30_register_test.h"
 #include "driver_sgp30_read_test.h"
+#include "bench.h"
+#include "sampler.h"
+#include "rt.h"
+#include "fleet.h"
+#include "event.h"
+#include "cache.h"
+#include "shm.h"
+#include "series.h"
+#include "archive.h"
+#include "detect.h"
+#include "replay.h"
+#include "iic.h"
+#include "power.h"
 #include <getopt.h>
+#include <time.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+
+/**
+ * @brief rt read ring size definition
+ */
+#define RT_READ_RING        64        /**< 64 samples */
+
+/**
+ * @brief rt read structure definition
+ */
+typedef struct rt_read_s
+{
+    uint32_t times;                            /**< running times */
+    uint32_t count;                            /**< published sample number */
+    uint8_t done;                              /**< thread done flag */
+    uint8_t res;                               /**< thread result */
+    uint16_t co2_eq_ppm[RT_READ_RING];         /**< co2 eq ring */
+    uint16_t tvoc_ppb[RT_READ_RING];           /**< tvoc ring */
+    sampler_t sampler;                         /**< sampler */
+} rt_read_t;
+
+static rt_read_t gs_rt_read;        /**< rt read state */
+
+/**
+ * @brief shm definition
+ */
+#define SHM_NAME                 "/sgp30"        /**< shm object of the published samples */
+#define SHM_WARMUP_ROUNDS        15              /**< the iaq algorithm returns fixed values for 15 s */
+
+/**
+ * @brief replay state definition
+ */
+static replay_t gs_replay;        /**< trace player or recorder of the default bus */
+
+/**
+ * @brief cache reader max definition
+ */
+#define CACHE_MAX_READER        16        /**< max reader threads */
+
+/**
+ * @brief cache reader structure definition
+ */
+typedef struct cache_reader_s
+{
+    pthread_t thread;                /**< thread */
+    cache_t *cache;                  /**< shared cache */
+    uint32_t interval_ms;            /**< read interval */
+    volatile uint8_t *stop;          /**< stop flag */
+    uint32_t reads;                  /**< read number */
+    uint32_t failed;                 /**< failed read number */
+    uint32_t age_max_ms;             /**< max sample age */
+} cache_reader_t;
+
+/**
+ * @brief     rt read acquisition thread
+ * @param[in] *arg pointer to a rt read structure
+ * @return    NULL
+ * @note      the samples go to a preallocated ring and are printed by the main thread,
+ *            so the loop only sleeps, reads the bus and stores
+ */
+static void *a_rt_read(void *arg)
+{
+    rt_read_t *r;
+    uint16_t co2_eq_ppm;
+    uint16_t tvoc_ppb;
+    uint32_t i;
+    
+    r = (rt_read_t *)arg;
+    
+    /* one read before the first deadline faults in the driver and the bus path */
+    if (sgp30_basic_read(&co2_eq_ppm, &tvoc_ppb) != 0)
+    {
+        r->res = 1;
+        __atomic_store_n(&r->done, 1, __ATOMIC_RELEASE);
+        
+        return NULL;
+    }
+    
+    /* 1 Hz absolute deadlines */
+    if (sampler_init(&r->sampler, 1000) != 0)
+    {
+        r->res = 1;
+        __atomic_store_n(&r->done, 1, __ATOMIC_RELEASE);
+        
+        return NULL;
+    }
+    
+    /* loop */
+    for (i = 0; i < r->times; i++)
+    {
+        /* wait the next deadline */
+        if (sampler_wait(&r->sampler, NULL) != 0)
+        {
+            r->res = 1;
+            
+            break;
+        }
+        
+        /* read data */
+        if (sgp30_basic_read(&co2_eq_ppm, &tvoc_ppb) != 0)
+        {
+            r->res = 1;
+            
+            break;
+        }
+        
+        /* publish */
+        r->co2_eq_ppm[i % RT_READ_RING] = co2_eq_ppm;
+        r->tvoc_ppb[i % RT_READ_RING] = tvoc_ppb;
+        __atomic_store_n(&r->count, i + 1, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&r->done, 1, __ATOMIC_RELEASE);
+    
+    return NULL;
+}
+
+/**
+ * @brief     event sample callback
+ * @param[in] *sensor pointer to a sensor structure
+ * @param[in] res 0 means the read succeeded
+ * @param[in] co2_eq_ppm co2 eq
+ * @param[in] tvoc_ppb tvoc
+ * @param[in] *arg pointer to the iic device name
+ * @note      none
+ */
+static void a_event_sample(event_sensor_t *sensor, uint8_t res, uint16_t co2_eq_ppm, uint16_t tvoc_ppb, void *arg)
+{
+    if (res != 0)
+    {
+        sgp30_interface_debug_print("sgp30: %s channel %d read failed.\n", (char *)arg, sensor->channel);
+        
+        return;
+    }
+    sgp30_interface_debug_print("sgp30: %s channel %d co2 eq is %d ppm, tvoc is %d ppb.\n",
+                                (char *)arg, sensor->channel, co2_eq_ppm, tvoc_ppb);
+}
+
+/**
+ * @brief     cache reader thread
+ * @param[in] *arg pointer to a cache reader structure
+ * @return    NULL
+ * @note      it stands for another subsystem polling the air quality at its own rate
+ */
+static void *a_cache_reader(void *arg)
+{
+    cache_reader_t *reader;
+    cache_sample_t sample;
+    uint32_t age_ms;
+    
+    reader = (cache_reader_t *)arg;
+    while (*reader->stop == 0)
+    {
+        reader->reads++;
+        if (cache_read(reader->cache, &sample, &age_ms, 2000) != 0)
+        {
+            reader->failed++;
+        }
+        else if (age_ms > reader->age_max_ms)
+        {
+            reader->age_max_ms = age_ms;
+        }
+        usleep(reader->interval_ms * 1000);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     series print samples
+ * @param[in] *sample pointer to a run of samples
+ * @param[in] count sample number
+ * @param[in] *arg unused
+ * @return    status code
+ *            - 0 continue
+ * @note      none
+ */
+static uint8_t a_series_print(const series_sample_t *sample, uint32_t count, void *arg)
+{
+    uint32_t i;
+    
+    (void)arg;
+    for (i = 0; i < count; i++)
+    {
+        sgp30_interface_debug_print("sgp30: %llu ms, co2 eq is %d ppm, tvoc is %d ppb, h2 raw is %d, ethanol raw is %d.\n",
+                                    (unsigned long long)sample[i].timestamp_ms,
+                                    sample[i].value[SERIES_CHANNEL_CO2_EQ], sample[i].value[SERIES_CHANNEL_TVOC],
+                                    sample[i].value[SERIES_CHANNEL_H2], sample[i].value[SERIES_CHANNEL_ETHANOL]);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     detect event callback
+ * @param[in] *event pointer to a detect event structure
+ * @param[in] *arg unused
+ * @note      none
+ */
+static void a_detect_event(const detect_event_t *event, void *arg)
+{
+    (void)arg;
+    if (event->type == DETECT_EVENT_START)
+    {
+        sgp30_interface_debug_print("sgp30: %s event at %d from the baseline %0.1f, %llu ms after the onset.\n",
+                                    (event->channel == DETECT_CHANNEL_TVOC) ? "tvoc" : "ethanol raw",
+                                    event->value, event->baseline, (unsigned long long)event->latency_ms);
+    }
+    else
+    {
+        sgp30_interface_debug_print("sgp30: %s event ends at %d after %llu ms.\n",
+                                    (event->channel == DETECT_CHANNEL_TVOC) ? "tvoc" : "ethanol raw",
+                                    event->value, (unsigned long long)event->latency_ms);
+    }
+}
+
+/**
+ * @brief  replay print the stats and close the trace
+ * @note   none
+ */
+static void a_replay_finish(void)
+{
+    replay_stats_t stats;
+    
+    if (gs_replay.mode == REPLAY_MODE_NONE)
+    {
+        return;
+    }
+    replay_get_stats(&gs_replay, &stats);
+    sgp30_interface_debug_print("replay: %llu writes, %llu reads, %llu failed on the bus, %llu skipped, %llu mismatched.\n",
+                                (unsigned long long)stats.writes, (unsigned long long)stats.reads,
+                                (unsigned long long)stats.failed, (unsigned long long)stats.skipped,
+                                (unsigned long long)stats.mismatched);
+    sgp30_interface_debug_print("replay: %0.1f s of virtual time in %0.3f s%s.\n",
+                                (double)stats.virtual_ns / 1e9, (double)stats.real_ns / 1e9,
+                                (stats.eof != 0) ? ", the trace is used up" : "");
+    (void)replay_close(&gs_replay);
+}
 
 /**
  * @brief     sgp30 full function
@@ -68,6 +321,22 @@ uint8_t sgp30(uint8_t argc, char **argv)
         {"humidity-rh", required_argument, NULL, 3},
         {"humidity-temperature", required_argument, NULL, 4},
         {"times", required_argument, NULL, 5},
+        {"mux-addr", required_argument, NULL, 6},
+        {"channel", required_argument, NULL, 7},
+        {"priority", required_argument, NULL, 8},
+        {"cpu", required_argument, NULL, 9},
+        {"bus", required_argument, NULL, 10},
+        {"readers", required_argument, NULL, 11},
+        {"file", required_argument, NULL, 12},
+        {"start", required_argument, NULL, 13},
+        {"end", required_argument, NULL, 14},
+        {"sensors", required_argument, NULL, 15},
+        {"record", required_argument, NULL, 16},
+        {"replay", required_argument, NULL, 17},
+        {"speed", required_argument, NULL, 18},
+        {"peer-addr", required_argument, NULL, 19},
+        {"power-chip", required_argument, NULL, 20},
+        {"power-line", required_argument, NULL, 21},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -76,6 +345,22 @@ uint8_t sgp30(uint8_t argc, char **argv)
     uint16_t tvoc_ppb = 0;
     float rh = 50.0f;
     float temp = 25.0f;
+    uint8_t mux_addr = 0;
+    uint8_t channel = 1;
+    int32_t priority = 80;
+    int32_t cpu = -1;
+    char bus[129] = "/dev/i2c-1";
+    uint32_t readers = 4;
+    char file[129] = "sgp30.ts";
+    uint64_t start_ms = 0;
+    uint64_t end_ms = 0;
+    uint32_t sensors = 16;
+    char record[129] = "";
+    char replay[129] = "";
+    float speed = 0.0f;
+    uint8_t peer_addr = 0;
+    char power_chip[33] = "gpiochip0";
+    int32_t power_line = -1;
 
     /* if no params */
     if (argc == 1)
@@ -189,6 +474,155 @@ uint8_t sgp30(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* mux address */
+            case 6 :
+            {
+                /* set the 7 bits mux address */
+                mux_addr = (uint8_t)(strtol(optarg, NULL, 0) << 1);
+                
+                break;
+            }
+            
+            /* mux channel number */
+            case 7 :
+            {
+                /* set the channel */
+                channel = (uint8_t)atoi(optarg);
+                
+                break;
+            }
+            
+            /* rt priority */
+            case 8 :
+            {
+                /* set the priority */
+                priority = atoi(optarg);
+                
+                break;
+            }
+            
+            /* rt cpu */
+            case 9 :
+            {
+                /* set the cpu */
+                cpu = atoi(optarg);
+                
+                break;
+            }
+            
+            /* iic adapter list */
+            case 10 :
+            {
+                /* set the bus */
+                memset(bus, 0, sizeof(char) * 129);
+                snprintf(bus, 128, "%s", optarg);
+                
+                break;
+            }
+            
+            /* cache readers */
+            case 11 :
+            {
+                /* set the readers */
+                readers = atol(optarg);
+                
+                break;
+            }
+            
+            /* series file */
+            case 12 :
+            {
+                /* set the file */
+                memset(file, 0, sizeof(char) * 129);
+                snprintf(file, 128, "%s", optarg);
+                
+                break;
+            }
+            
+            /* range start */
+            case 13 :
+            {
+                /* set the start */
+                start_ms = strtoull(optarg, NULL, 10);
+                
+                break;
+            }
+            
+            /* range end */
+            case 14 :
+            {
+                /* set the end */
+                end_ms = strtoull(optarg, NULL, 10);
+                
+                break;
+            }
+            
+            /* window sensors */
+            case 15 :
+            {
+                /* set the sensors */
+                sensors = atol(optarg);
+                
+                break;
+            }
+            
+            /* capture trace */
+            case 16 :
+            {
+                /* set the record */
+                memset(record, 0, sizeof(char) * 129);
+                snprintf(record, 128, "%s", optarg);
+                
+                break;
+            }
+            
+            /* replay trace */
+            case 17 :
+            {
+                /* set the replay */
+                memset(replay, 0, sizeof(char) * 129);
+                snprintf(replay, 128, "%s", optarg);
+                
+                break;
+            }
+            
+            /* replay speed */
+            case 18 :
+            {
+                /* set the speed */
+                speed = atof(optarg);
+                
+                break;
+            }
+            
+            /* peer device address */
+            case 19 :
+            {
+                /* set the 7 bits peer address */
+                peer_addr = (uint8_t)(strtol(optarg, NULL, 0) << 1);
+                
+                break;
+            }
+            
+            /* power enable gpio chip */
+            case 20 :
+            {
+                /* set the power chip */
+                memset(power_chip, 0, sizeof(char) * 33);
+                snprintf(power_chip, 32, "%s", optarg);
+                
+                break;
+            }
+            
+            /* power enable gpio line */
+            case 21 :
+            {
+                /* set the power line */
+                power_line = atol(optarg);
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -202,6 +636,24 @@ uint8_t sgp30(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* serve the default bus from a trace or capture it */
+    if (replay[0] != 0)
+    {
+        if (replay_open(&gs_replay, replay, speed) != 0)
+        {
+            return 1;
+        }
+        replay_bind(&gs_replay);
+    }
+    else if (record[0] != 0)
+    {
+        if (replay_record_open(&gs_replay, record) != 0)
+        {
+            return 1;
+        }
+        replay_bind(&gs_replay);
+    }
 
     /* run the function */
     if (strcmp("t_reg", type) == 0)
@@ -232,6 +684,7 @@ uint8_t sgp30(uint8_t argc, char **argv)
     {
         uint8_t res;
         uint32_t i;
+        sampler_t sampler;
         
         /* init */
         res = sgp30_basic_init();
@@ -240,11 +693,24 @@ uint8_t sgp30(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* 1 Hz absolute deadlines */
+        if (sampler_init(&sampler, 1000) != 0)
+        {
+            (void)sgp30_basic_deinit();
+            
+            return 1;
+        }
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
-            /* delay 1000ms */
-            sgp30_interface_delay_ms(1000);
+            /* wait the next deadline */
+            if (sampler_wait(&sampler, NULL) != 0)
+            {
+                (void)sgp30_basic_deinit();
+                
+                return 1;
+            }
             
             /* read data */
             res = sgp30_basic_read((uint16_t *)&co2_eq_ppm, (uint16_t *)&tvoc_ppb);
@@ -261,6 +727,9 @@ uint8_t sgp30(uint8_t argc, char **argv)
             sgp30_interface_debug_print("sgp30: tvoc is %d ppb.\n", tvoc_ppb);
         }
         
+        /* output the timing */
+        sampler_print_stats(&sampler);
+        
         /* deinit */
         (void)sgp30_basic_deinit();
         
@@ -270,6 +739,7 @@ uint8_t sgp30(uint8_t argc, char **argv)
     {
         uint8_t res;
         uint32_t i;
+        sampler_t sampler;
         
         /* init */
         res = sgp30_advance_init();
@@ -296,11 +766,24 @@ uint8_t sgp30(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* 1 Hz absolute deadlines */
+        if (sampler_init(&sampler, 1000) != 0)
+        {
+            (void)sgp30_advance_deinit();
+            
+            return 1;
+        }
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
-            /* delay 1000ms */
-            sgp30_interface_delay_ms(1000);
+            /* wait the next deadline */
+            if (sampler_wait(&sampler, NULL) != 0)
+            {
+                (void)sgp30_advance_deinit();
+                
+                return 1;
+            }
             
             /* read data */
             res = sgp30_advance_read((uint16_t *)&co2_eq_ppm, (uint16_t *)&tvoc_ppb);
@@ -317,11 +800,782 @@ uint8_t sgp30(uint8_t argc, char **argv)
             sgp30_interface_debug_print("sgp30: tvoc is %d ppb.\n", tvoc_ppb);
         }
         
+        /* output the timing */
+        sampler_print_stats(&sampler);
+        
         /* deinit */
         (void)sgp30_advance_deinit();
         
         return 0;
     }
+    else if (strcmp("e_rt-read", type) == 0)
+    {
+        uint8_t res;
+        uint8_t done;
+        uint32_t count;
+        uint32_t printed;
+        pthread_t thread;
+        rt_config_t config;
+        
+        /* init */
+        res = sgp30_basic_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* lock, pin and raise the acquisition thread */
+        rt_config_init(&config);
+        config.priority = priority;
+        config.cpu = cpu;
+        memset(&gs_rt_read, 0, sizeof(rt_read_t));
+        gs_rt_read.times = times;
+        rt_prefault(&gs_rt_read, sizeof(rt_read_t));
+        if (rt_thread_create(&thread, &config, a_rt_read, &gs_rt_read) != 0)
+        {
+            (void)sgp30_basic_deinit();
+            
+            return 1;
+        }
+        
+        /* print the published samples */
+        printed = 0;
+        while (1)
+        {
+            done = __atomic_load_n(&gs_rt_read.done, __ATOMIC_ACQUIRE);
+            count = __atomic_load_n(&gs_rt_read.count, __ATOMIC_ACQUIRE);
+            while (printed < count)
+            {
+                sgp30_interface_debug_print("sgp30: %d/%d.\n", (uint32_t)(printed + 1), (uint32_t)times);
+                sgp30_interface_debug_print("sgp30: co2 eq is %d ppm.\n", gs_rt_read.co2_eq_ppm[printed % RT_READ_RING]);
+                sgp30_interface_debug_print("sgp30: tvoc is %d ppb.\n", gs_rt_read.tvoc_ppb[printed % RT_READ_RING]);
+                printed++;
+            }
+            if (done != 0)
+            {
+                break;
+            }
+            usleep(100 * 1000);
+        }
+        (void)pthread_join(thread, NULL);
+        
+        /* output the timing */
+        sampler_print_stats(&gs_rt_read.sampler);
+        
+        /* deinit */
+        (void)sgp30_basic_deinit();
+        
+        return gs_rt_read.res;
+    }
+    else if (strcmp("e_recover", type) == 0)
+    {
+        uint8_t res;
+        uint32_t ms;
+        sgp30_recovery_level_t level;
+        struct timespec start;
+        struct timespec stop;
+        const char *name[4] = {"none", "retry", "soft reset", "power cycle"};
+        
+        /* the power cycle is only used with a configured power enable */
+        if (power_line >= 0)
+        {
+            if (power_init(power_chip, (uint32_t)power_line) != 0)
+            {
+                return 1;
+            }
+        }
+        
+        /* init, a wedged chip fails the soft reset in the init and is recovered below */
+        (void)sgp30_advance_init();
+        
+        /* recover and measure the time */
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        res = sgp30_advance_recover(tvoc_ppb, co2_eq_ppm, (power_line >= 0) ? sgp30_interface_power_set : NULL, &level);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        ms = (uint32_t)((stop.tv_sec - start.tv_sec) * 1000 + (stop.tv_nsec - start.tv_nsec) / 1000000);
+        if (res != 0)
+        {
+            sgp30_interface_debug_print("sgp30: recover failed after %d ms.\n", ms);
+            (void)sgp30_advance_deinit();
+            if (power_line >= 0)
+            {
+                (void)power_deinit();
+            }
+            
+            return 1;
+        }
+        
+        /* output */
+        sgp30_interface_debug_print("sgp30: recovered by %s in %d ms.\n", name[level], ms);
+        
+        /* deinit */
+        (void)sgp30_advance_deinit();
+        if (power_line >= 0)
+        {
+            (void)power_deinit();
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_batch-bench", type) == 0)
+    {
+        /* run the batch bench */
+        if (bench_iic_batch("/dev/i2c-1", 0x58 << 1, mux_addr, channel, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_lock-bench", type) == 0)
+    {
+        /* run the lock bench */
+        if (bench_lock_contention("/dev/i2c-1", peer_addr, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_fleet", type) == 0)
+    {
+        static fleet_t fleet;
+        fleet_sample_t sample[FLEET_MAX_BUS * FLEET_MAX_CHANNEL];
+        shm_writer_t writer;
+        shm_sample_t pub;
+        uint8_t publish;
+        char *name;
+        char *save;
+        uint32_t n;
+        uint32_t i;
+        
+        /* 1 Hz rounds */
+        if (fleet_init(&fleet, 1000, 1024) != 0)
+        {
+            return 1;
+        }
+        
+        /* one worker per adapter */
+        for (name = strtok_r(bus, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save))
+        {
+            if (fleet_add_bus(&fleet, name, mux_addr, channel) != 0)
+            {
+                fleet_deinit(&fleet);
+                
+                return 1;
+            }
+        }
+        if (fleet_start(&fleet, times) != 0)
+        {
+            fleet_deinit(&fleet);
+            
+            return 1;
+        }
+        
+        /* publish every sensor to the local readers, one slot per bus and channel */
+        publish = (shm_writer_open(&writer, SHM_NAME, FLEET_MAX_BUS * FLEET_MAX_CHANNEL) == 0) ? 1 : 0;
+        
+        /* print the shared sink until every worker is done */
+        while ((n = fleet_read(&fleet, sample, FLEET_MAX_BUS * FLEET_MAX_CHANNEL)) != 0)
+        {
+            for (i = 0; i < n; i++)
+            {
+                if (publish != 0)
+                {
+                    pub.timestamp_ns = sample[i].timestamp_ns;
+                    pub.co2_eq_ppm = sample[i].co2_eq_ppm;
+                    pub.tvoc_ppb = sample[i].tvoc_ppb;
+                    if (sample[i].res != 0)
+                    {
+                        pub.state = SHM_STATE_FAILED;
+                    }
+                    else if (sample[i].round < SHM_WARMUP_ROUNDS)
+                    {
+                        pub.state = SHM_STATE_WARMUP;
+                    }
+                    else
+                    {
+                        pub.state = SHM_STATE_VALID;
+                    }
+                    (void)shm_publish(&writer, sample[i].bus * FLEET_MAX_CHANNEL + sample[i].channel, &pub);
+                }
+                if (sample[i].res != 0)
+                {
+                    sgp30_interface_debug_print("sgp30: %s channel %d round %d read failed.\n",
+                                                fleet.bus[sample[i].bus].name, sample[i].channel, sample[i].round + 1);
+                    
+                    continue;
+                }
+                sgp30_interface_debug_print("sgp30: %s channel %d round %d co2 eq is %d ppm, tvoc is %d ppb.\n",
+                                            fleet.bus[sample[i].bus].name, sample[i].channel, sample[i].round + 1,
+                                            sample[i].co2_eq_ppm, sample[i].tvoc_ppb);
+            }
+        }
+        fleet_stop(&fleet);
+        if (publish != 0)
+        {
+            shm_writer_close(&writer, 0);
+        }
+        
+        /* output the stats */
+        fleet_print_stats(&fleet);
+        fleet_deinit(&fleet);
+        
+        return 0;
+    }
+    else if (strcmp("e_event", type) == 0)
+    {
+        static event_loop_t loop;
+        static event_sensor_t sensor[FLEET_MAX_BUS * FLEET_MAX_CHANNEL];
+        static char name[FLEET_MAX_BUS][32];
+        struct epoll_event ev;
+        int fd[FLEET_MAX_BUS];
+        int efd;
+        char *p;
+        char *save;
+        uint32_t num;
+        uint32_t i;
+        uint8_t bus_num;
+        uint8_t done;
+        uint8_t ch;
+        int n;
+        
+        /* check the channel */
+        if ((channel == 0) || (channel > FLEET_MAX_CHANNEL) || ((mux_addr == 0) && (channel != 1)))
+        {
+            return 5;
+        }
+        
+        /* open every adapter */
+        bus_num = 0;
+        for (p = strtok_r(bus, ",", &save); (p != NULL) && (bus_num < FLEET_MAX_BUS); p = strtok_r(NULL, ",", &save))
+        {
+            snprintf(name[bus_num], 32, "%s", p);
+            if (iic_init(name[bus_num], &fd[bus_num]) != 0)
+            {
+                while (bus_num > 0)
+                {
+                    bus_num--;
+                    (void)iic_deinit(fd[bus_num]);
+                }
+                
+                return 1;
+            }
+            bus_num++;
+        }
+        
+        /* every sensor is one state machine of the loop */
+        if (event_init(&loop) != 0)
+        {
+            for (i = 0; i < bus_num; i++)
+            {
+                (void)iic_deinit(fd[i]);
+            }
+            
+            return 1;
+        }
+        num = 0;
+        for (i = 0; i < bus_num; i++)
+        {
+            for (ch = 0; ch < channel; ch++)
+            {
+                if (event_add_sensor(&loop, &sensor[num], fd[i], mux_addr, ch, 1000, a_event_sample, name[i]) == 0)
+                {
+                    num++;
+                }
+            }
+        }
+        
+        /* the service loop owns the only epoll_wait, the sensors only add one fd to it */
+        efd = epoll_create1(0);
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = event_get_fd(&loop);
+        if ((efd < 0) || (epoll_ctl(efd, EPOLL_CTL_ADD, event_get_fd(&loop), &ev) != 0))
+        {
+            num = 0;
+        }
+        done = (num == 0) ? 1 : 0;
+        while (done == 0)
+        {
+            n = epoll_wait(efd, &ev, 1, -1);
+            if ((n < 0) && (errno != EINTR))
+            {
+                break;
+            }
+            if (n > 0)
+            {
+                (void)event_process_ready(&loop);
+            }
+            
+            /* stop when every sensor has reported the running times */
+            done = 1;
+            for (i = 0; i < num; i++)
+            {
+                if (sensor[i].samples + sensor[i].failed < times)
+                {
+                    done = 0;
+                }
+            }
+        }
+        
+        /* output the stats */
+        for (i = 0; i < num; i++)
+        {
+            sgp30_interface_debug_print("sgp30: %s channel %d %d samples, %d failed, %d missed, %d reinit.\n",
+                                        (char *)sensor[i].arg, sensor[i].channel, (uint32_t)sensor[i].samples,
+                                        (uint32_t)sensor[i].failed, (uint32_t)sensor[i].missed, (uint32_t)sensor[i].reinit);
+            event_remove_sensor(&loop, &sensor[i]);
+        }
+        if (efd >= 0)
+        {
+            (void)close(efd);
+        }
+        event_deinit(&loop);
+        for (i = 0; i < bus_num; i++)
+        {
+            (void)iic_deinit(fd[i]);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_cache", type) == 0)
+    {
+        static cache_t cache;
+        static cache_reader_t reader[CACHE_MAX_READER];
+        volatile uint8_t stop;
+        cache_sample_t sample;
+        uint32_t age_ms;
+        uint32_t i;
+        uint8_t res;
+        
+        /* check the readers */
+        if ((readers == 0) || (readers > CACHE_MAX_READER))
+        {
+            sgp30_interface_debug_print("sgp30: readers is invalid.\n");
+            
+            return 1;
+        }
+        
+        /* init */
+        res = sgp30_basic_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* the cache thread is the only one measuring, at 1 Hz */
+        if (cache_init(&cache, 1000, 0, sgp30_basic_read) != 0)
+        {
+            (void)sgp30_basic_deinit();
+            
+            return 1;
+        }
+        if (cache_start(&cache) != 0)
+        {
+            cache_deinit(&cache);
+            (void)sgp30_basic_deinit();
+            
+            return 1;
+        }
+        
+        /* the other readers poll at their own rates */
+        stop = 0;
+        for (i = 1; i < readers; i++)
+        {
+            memset(&reader[i], 0, sizeof(cache_reader_t));
+            reader[i].cache = &cache;
+            reader[i].interval_ms = 37 * i;
+            reader[i].stop = &stop;
+            if (pthread_create(&reader[i].thread, NULL, a_cache_reader, &reader[i]) != 0)
+            {
+                readers = i;
+                
+                break;
+            }
+        }
+        
+        /* the main thread reads once a second */
+        res = 0;
+        for (i = 0; i < times; i++)
+        {
+            usleep(1000 * 1000);
+            if (cache_read(&cache, &sample, &age_ms, 2000) != 0)
+            {
+                sgp30_interface_debug_print("sgp30: read failed.\n");
+                res = 1;
+                
+                break;
+            }
+            sgp30_interface_debug_print("sgp30: %d/%d.\n", (uint32_t)(i + 1), (uint32_t)times);
+            sgp30_interface_debug_print("sgp30: co2 eq is %d ppm.\n", sample.co2_eq_ppm);
+            sgp30_interface_debug_print("sgp30: tvoc is %d ppb.\n", sample.tvoc_ppb);
+            sgp30_interface_debug_print("sgp30: sample %d is %d ms old.\n", sample.seq, age_ms);
+        }
+        
+        /* stop the readers */
+        stop = 1;
+        for (i = 1; i < readers; i++)
+        {
+            (void)pthread_join(reader[i].thread, NULL);
+            sgp30_interface_debug_print("sgp30: reader %d every %d ms, %d reads, %d failed, max age %d ms.\n",
+                                        i, reader[i].interval_ms, reader[i].reads, reader[i].failed, reader[i].age_max_ms);
+        }
+        cache_stop(&cache);
+        cache_print_stats(&cache);
+        
+        /* deinit */
+        cache_deinit(&cache);
+        (void)sgp30_basic_deinit();
+        
+        return res;
+    }
+    else if (strcmp("e_shm-read", type) == 0)
+    {
+        const char *state[5] = {"none", "warmup", "valid", "failed", "stopped"};
+        struct timespec now;
+        shm_reader_t reader;
+        shm_sample_t sample;
+        uint64_t now_ns;
+        uint32_t slot;
+        uint32_t i;
+        
+        /* map the samples of the publisher */
+        if (shm_reader_open(&reader, SHM_NAME) != 0)
+        {
+            return 1;
+        }
+        
+        /* print every published slot once a second */
+        for (i = 0; i < times; i++)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            now_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+            sgp30_interface_debug_print("sgp30: %d/%d.\n", (uint32_t)(i + 1), (uint32_t)times);
+            for (slot = 0; slot < reader.slots; slot++)
+            {
+                if ((shm_read(&reader, slot, &sample) != 0) || (sample.state == SHM_STATE_NONE))
+                {
+                    continue;
+                }
+                sgp30_interface_debug_print("sgp30: bus %d channel %d sample %d %s, co2 eq is %d ppm, tvoc is %d ppb, %d ms old.\n",
+                                            slot / FLEET_MAX_CHANNEL, slot % FLEET_MAX_CHANNEL, (uint32_t)sample.seq,
+                                            state[(sample.state <= SHM_STATE_STOPPED) ? sample.state : 0],
+                                            sample.co2_eq_ppm, sample.tvoc_ppb, (uint32_t)((now_ns - sample.timestamp_ns) / 1000000ULL));
+            }
+            if (i != (times - 1))
+            {
+                usleep(1000 * 1000);
+            }
+        }
+        shm_reader_close(&reader);
+        
+        return 0;
+    }
+    else if (strcmp("e_log", type) == 0)
+    {
+        static series_writer_t writer;
+        series_sample_t sample;
+        struct timespec now;
+        sampler_t sampler;
+        uint32_t i;
+        uint8_t res;
+        
+        /* init */
+        res = sgp30_advance_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* append to the series file */
+        if (series_writer_open(&writer, file, 0) != 0)
+        {
+            (void)sgp30_advance_deinit();
+            
+            return 1;
+        }
+        
+        /* 1 Hz absolute deadlines */
+        if (sampler_init(&sampler, 1000) != 0)
+        {
+            (void)series_writer_close(&writer);
+            (void)sgp30_advance_deinit();
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* wait the next deadline */
+            if (sampler_wait(&sampler, NULL) != 0)
+            {
+                res = 1;
+                
+                break;
+            }
+            
+            /* read data */
+            if ((sgp30_advance_read(&sample.value[SERIES_CHANNEL_CO2_EQ], &sample.value[SERIES_CHANNEL_TVOC]) != 0) ||
+                (sgp30_advance_read_raw(&sample.value[SERIES_CHANNEL_H2], &sample.value[SERIES_CHANNEL_ETHANOL]) != 0))
+            {
+                res = 1;
+                
+                break;
+            }
+            
+            /* the archive keeps the wall clock */
+            replay_clock_gettime(CLOCK_REALTIME, &now);
+            sample.timestamp_ms = (uint64_t)now.tv_sec * 1000ULL + (uint64_t)now.tv_nsec / 1000000ULL;
+            if (series_writer_write(&writer, &sample) != 0)
+            {
+                res = 1;
+                
+                break;
+            }
+            
+            /* output */
+            sgp30_interface_debug_print("sgp30: %d/%d.\n", (uint32_t)(i + 1), (uint32_t)times);
+            sgp30_interface_debug_print("sgp30: co2 eq is %d ppm, tvoc is %d ppb, h2 raw is %d, ethanol raw is %d.\n",
+                                        sample.value[SERIES_CHANNEL_CO2_EQ], sample.value[SERIES_CHANNEL_TVOC],
+                                        sample.value[SERIES_CHANNEL_H2], sample.value[SERIES_CHANNEL_ETHANOL]);
+        }
+        
+        /* the open chunk is written at the close */
+        if (series_writer_close(&writer) != 0)
+        {
+            res = 1;
+        }
+        sgp30_interface_debug_print("sgp30: %d samples in %llu bytes appended to %s.\n", (uint32_t)writer.samples,
+                                    (unsigned long long)writer.bytes, file);
+        
+        /* deinit */
+        (void)sgp30_advance_deinit();
+        
+        return res;
+    }
+    else if (strcmp("e_detect", type) == 0)
+    {
+        detect_t detect;
+        struct timespec now;
+        sampler_t sampler;
+        uint16_t co2_eq_ppm;
+        uint16_t tvoc_ppb;
+        uint16_t h2_raw;
+        uint16_t ethanol_raw;
+        uint32_t i;
+        uint8_t res;
+        
+        /* init */
+        res = sgp30_advance_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        if (detect_init(&detect, 1, NULL, a_detect_event, NULL) != 0)
+        {
+            (void)sgp30_advance_deinit();
+            
+            return 1;
+        }
+        
+        /* 1 Hz absolute deadlines */
+        if (sampler_init(&sampler, 1000) != 0)
+        {
+            detect_deinit(&detect);
+            (void)sgp30_advance_deinit();
+            
+            return 1;
+        }
+        
+        /* every sample goes through the detector as soon as it is read */
+        for (i = 0; i < times; i++)
+        {
+            if (sampler_wait(&sampler, NULL) != 0)
+            {
+                res = 1;
+                
+                break;
+            }
+            if ((sgp30_advance_read(&co2_eq_ppm, &tvoc_ppb) != 0) ||
+                (sgp30_advance_read_raw(&h2_raw, &ethanol_raw) != 0))
+            {
+                res = 1;
+                
+                break;
+            }
+            replay_clock_gettime(CLOCK_MONOTONIC, &now);
+            (void)detect_push(&detect, 0, (uint64_t)now.tv_sec * 1000ULL + (uint64_t)now.tv_nsec / 1000000ULL,
+                              tvoc_ppb, ethanol_raw);
+            sgp30_interface_debug_print("sgp30: %d/%d tvoc is %d ppb, ethanol raw is %d.\n",
+                                        (uint32_t)(i + 1), (uint32_t)times, tvoc_ppb, ethanol_raw);
+        }
+        sgp30_interface_debug_print("sgp30: %llu events.\n", (unsigned long long)detect.events);
+        
+        /* deinit */
+        detect_deinit(&detect);
+        (void)sgp30_advance_deinit();
+        
+        return res;
+    }
+    else if (strcmp("e_dump", type) == 0)
+    {
+        static series_sample_t sample[SERIES_MAX_CHUNK];
+        series_reader_t reader;
+        series_chunk_t chunk;
+        uint32_t index;
+        uint8_t res;
+        
+        /* open */
+        if (series_reader_open(&reader, file) != 0)
+        {
+            return 1;
+        }
+        
+        /* print every chunk, a corrupted one is reported and skipped */
+        index = 0;
+        while ((res = series_reader_next(&reader, &chunk)) != 1)
+        {
+            if ((res != 0) && (chunk.count == 0))
+            {
+                sgp30_interface_debug_print("sgp30: damaged bytes before chunk %d are skipped.\n", index);
+                
+                continue;
+            }
+            if ((res != 0) || (series_reader_decode(&reader, sample) != 0))
+            {
+                sgp30_interface_debug_print("sgp30: chunk %d with %d samples is corrupted.\n", index, chunk.count);
+                index++;
+                
+                continue;
+            }
+            sgp30_interface_debug_print("sgp30: chunk %d, %d samples, %d bytes.\n", index, chunk.count,
+                                        SERIES_CHUNK_HEADER_SIZE + chunk.payload_len);
+            (void)a_series_print(sample, chunk.count, NULL);
+            index++;
+        }
+        series_reader_close(&reader);
+        
+        return 0;
+    }
+    else if (strcmp("e_query", type) == 0)
+    {
+        archive_t archive;
+        uint8_t res;
+        
+        /* map the file and index the chunks */
+        if (archive_open(&archive, file, 0) != 0)
+        {
+            return 1;
+        }
+        sgp30_interface_debug_print("sgp30: %d chunks, %llu samples from %llu ms to %llu ms.\n", archive.chunks,
+                                    (unsigned long long)archive.samples, (unsigned long long)archive.first_ts,
+                                    (unsigned long long)archive.last_ts);
+        if (archive.tail_bytes != 0)
+        {
+            sgp30_interface_debug_print("sgp30: %llu damaged bytes outside the chunks are skipped.\n",
+                                        (unsigned long long)archive.tail_bytes);
+        }
+        
+        /* 0 means the end of the file */
+        res = archive_query(&archive, start_ms, (end_ms == 0) ? UINT64_MAX : end_ms, a_series_print, NULL);
+        archive_close(&archive);
+        
+        return (res != 0) ? 1 : 0;
+    }
+    else if (strcmp("e_aggregate", type) == 0)
+    {
+        static const char *const name[SERIES_CHANNEL] = {"co2 eq", "tvoc", "h2 raw", "ethanol raw"};
+        archive_aggregate_t aggregate;
+        archive_t archive;
+        uint32_t c;
+        uint8_t res;
+        
+        /* map the file and index the chunks */
+        if (archive_open(&archive, file, 0) != 0)
+        {
+            return 1;
+        }
+        
+        /* whole chunks are answered by the summaries */
+        res = archive_aggregate(&archive, start_ms, (end_ms == 0) ? UINT64_MAX : end_ms, &aggregate);
+        archive_close(&archive);
+        if (res != 0)
+        {
+            return 1;
+        }
+        sgp30_interface_debug_print("sgp30: %llu samples, %d chunks by summary, %d decoded, %d corrupted.\n",
+                                    (unsigned long long)aggregate.count, aggregate.summary_chunks,
+                                    aggregate.decoded_chunks, aggregate.corrupted_chunks);
+        for (c = 0; c < SERIES_CHANNEL; c++)
+        {
+            sgp30_interface_debug_print("sgp30: %s min is %d, max is %d, avg is %0.2f.\n", name[c],
+                                        aggregate.min[c], aggregate.max[c], aggregate.avg[c]);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_raw-bench", type) == 0)
+    {
+        /* run the raw codec bench on the captured trace */
+        if (bench_rawcodec(file) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_window-bench", type) == 0)
+    {
+        /* run the window bench */
+        if (bench_window(sensors, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_sketch-bench", type) == 0)
+    {
+        /* run the sketch bench */
+        if (bench_sketch(sensors, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_detect-bench", type) == 0)
+    {
+        /* run the detect bench */
+        if (bench_detect(sensors, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_convert-bench", type) == 0)
+    {
+        /* run the convert bench */
+        if (bench_convert(times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_series-bench", type) == 0)
+    {
+        /* run the series bench */
+        if (bench_series("/tmp/sgp30-series-bench.ts", times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
     else if (strcmp("e_info", type) == 0)
     {
         uint8_t res;
@@ -373,21 +1627,58 @@ uint8_t sgp30(uint8_t argc, char **argv)
         sgp30_interface_debug_print("  sgp30 (-p | --port)\n");
         sgp30_interface_debug_print("  sgp30 (-t reg | --test=reg)\n");
         sgp30_interface_debug_print("  sgp30 (-t read | --test=read) [--times=<num>]\n");
-        sgp30_interface_debug_print("  sgp30 (-e read | --example=read) [--times=<num>]\n");
-        sgp30_interface_debug_print("  sgp30 (-e advance-read | --example=advance-read) [--times=<num>] [--baseline-tvoc=<ppb>] [--baseline-co2eq=<ppm>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e read | --example=read) [--times=<num>] [--record=<path> | --replay=<path> [--speed=<x>]]\n");
+        sgp30_interface_debug_print("  sgp30 (-e advance-read | --example=advance-read) [--times=<num>] [--baseline-tvoc=<ppb>] [--baseline-co2eq=<ppm>] [--record=<path> | --replay=<path> [--speed=<x>]]\n");
         sgp30_interface_debug_print("        [--humidity-temperature=<temp>] [--humidity-rh=<rh>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e rt-read | --example=rt-read) [--times=<num>] [--priority=<prio>] [--cpu=<cpu>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e cache | --example=cache) [--times=<num>] [--readers=<num>]\n");
         sgp30_interface_debug_print("  sgp30 (-e info | --example=info)\n");
+        sgp30_interface_debug_print("  sgp30 (-e recover | --example=recover) [--baseline-tvoc=<ppb>] [--baseline-co2eq=<ppm>]\n");
+        sgp30_interface_debug_print("        [--power-chip=<chip>] [--power-line=<line>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e batch-bench | --example=batch-bench) [--times=<num>] [--mux-addr=<addr>] [--channel=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e lock-bench | --example=lock-bench) [--times=<num>] [--peer-addr=<addr>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e fleet | --example=fleet) [--times=<num>] [--bus=<name[,name]>] [--mux-addr=<addr>] [--channel=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e shm-read | --example=shm-read) [--times=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e log | --example=log) [--times=<num>] [--file=<path>] [--record=<path> | --replay=<path> [--speed=<x>]]\n");
+        sgp30_interface_debug_print("  sgp30 (-e dump | --example=dump) [--file=<path>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e query | --example=query) [--file=<path>] [--start=<ms>] [--end=<ms>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e aggregate | --example=aggregate) [--file=<path>] [--start=<ms>] [--end=<ms>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e series-bench | --example=series-bench) [--times=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e raw-bench | --example=raw-bench) [--file=<path>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e window-bench | --example=window-bench) [--times=<num>] [--sensors=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e sketch-bench | --example=sketch-bench) [--times=<num>] [--sensors=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e detect | --example=detect) [--times=<num>] [--record=<path> | --replay=<path> [--speed=<x>]]\n");
+        sgp30_interface_debug_print("  sgp30 (-e detect-bench | --example=detect-bench) [--times=<num>] [--sensors=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e convert-bench | --example=convert-bench) [--times=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e event | --example=event) [--times=<num>] [--bus=<name[,name]>] [--mux-addr=<addr>] [--channel=<num>]\n");
         sgp30_interface_debug_print("\n");
         sgp30_interface_debug_print("Options:\n");
         sgp30_interface_debug_print("      --baseline-co2eq=<ppm>              Set the co2eq baseline.([default: 0])\n");
         sgp30_interface_debug_print("      --baseline-tvoc=<ppb>               Set the tvoc baseline.([default: 0])\n");
-        sgp30_interface_debug_print("  -e <read | advance-read | info>, --example=<read | advance-read | info>\n");
+        sgp30_interface_debug_print("      --bus=<name[,name]>                 Set the iic adapters, one worker runs on each.([default: /dev/i2c-1])\n");
+        sgp30_interface_debug_print("      --channel=<num>                     Set the mux channel number.([default: 1])\n");
+        sgp30_interface_debug_print("      --cpu=<cpu>                         Set the cpu the rt thread is pinned on, -1 means no pinning.([default: -1])\n");
+        sgp30_interface_debug_print("  -e <read | advance-read | rt-read | cache | info | recover | batch-bench | lock-bench | fleet | shm-read | log | dump | query | aggregate | series-bench | raw-bench | window-bench | sketch-bench | detect | detect-bench | convert-bench | event>, ");
+        sgp30_interface_debug_print("--example=<read | advance-read | rt-read | cache | info | recover | batch-bench | lock-bench | fleet | shm-read | log | dump | query | aggregate | series-bench | raw-bench | window-bench | sketch-bench | detect | detect-bench | convert-bench | event>\n");
         sgp30_interface_debug_print("                                          Run the driver example.\n");
+        sgp30_interface_debug_print("      --end=<ms>                          Set the timestamp after the range, 0 means the end of the file.([default: 0])\n");
+        sgp30_interface_debug_print("      --file=<path>                       Set the series file.([default: sgp30.ts])\n");
         sgp30_interface_debug_print("  -h, --help                              Show the help.\n");
         sgp30_interface_debug_print("      --humidity-rh=<rh>                  Set the humidity rh.([default: 50.0f])\n");
         sgp30_interface_debug_print("      --humidity-temperature=<temp>       Set the humidity temperature.([default: 25.0f])\n");
+        sgp30_interface_debug_print("      --mux-addr=<addr>                   Set the 7 bits iic mux address, 0 means no mux.([default: 0])\n");
         sgp30_interface_debug_print("  -i, --information                       Show the chip information.\n");
+        sgp30_interface_debug_print("      --peer-addr=<addr>                  Set the 7 bits iic address of the peer device of the lock bench, 0 means a simulated peer.([default: 0])\n");
         sgp30_interface_debug_print("  -p, --port                              Display the pin connections of the current board.\n");
+        sgp30_interface_debug_print("      --power-chip=<chip>                 Set the gpio chip of the power enable.([default: gpiochip0])\n");
+        sgp30_interface_debug_print("      --power-line=<line>                 Set the gpio line of the power enable, -1 means no power cycle.([default: -1])\n");
+        sgp30_interface_debug_print("      --priority=<prio>                   Set the SCHED_FIFO priority of the rt thread, 0 means SCHED_OTHER.([default: 80])\n");
+        sgp30_interface_debug_print("      --readers=<num>                     Set the cache reader number, the main thread is one of them.([default: 4])\n");
+        sgp30_interface_debug_print("      --record=<path>                     Capture the default bus to a trace file.\n");
+        sgp30_interface_debug_print("      --replay=<path>                     Serve the default bus from a trace file on virtual time.\n");
+        sgp30_interface_debug_print("      --sensors=<num>                     Set the sensor number of the window, sketch and detect bench.([default: 16])\n");
+        sgp30_interface_debug_print("      --speed=<x>                         Set the replay speed, 1 means real time and 0 means as fast as possible.([default: 0])\n");
+        sgp30_interface_debug_print("      --start=<ms>                        Set the first timestamp of the range.([default: 0])\n");
         sgp30_interface_debug_print("  -t <reg | read>, --test=<reg | read>    Run the driver test.\n");
         sgp30_interface_debug_print("      --times=<num>                       Set the running times.([default: 3])\n");
         
@@ -438,6 +1729,7 @@ int main(uint8_t argc, char **argv)
     uint8_t res;
 
     res = sgp30(argc, argv);
+    a_replay_finish();
     if (res == 0)
     {
         /* run success */
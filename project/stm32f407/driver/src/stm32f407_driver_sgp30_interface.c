@@ -41,6 +41,14 @@
 #include "iic.h"
 #include <stdarg.h>
 
+/**
+ * @brief power enable gpio definition
+ */
+#define POWER_GPIO_PORT        GPIOB             /**< power enable port */
+#define POWER_GPIO_PIN         GPIO_PIN_0        /**< power enable pin, high is on */
+
+static uint8_t gs_power_inited = 0;              /**< power gpio inited flag */
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -124,3 +132,52 @@ void sgp30_interface_debug_print(const char *const fmt, ...)
     len = strlen((char *)str);
     (void)uart_write((uint8_t *)str, len);
 }
+
+/**
+ * @brief     interface set the power
+ * @param[in] enable power enable
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      PB0 drives the power enable of the chip
+ */
+uint8_t sgp30_interface_power_set(uint8_t enable)
+{
+    GPIO_InitTypeDef GPIO_Initure;
+    
+    /* init the gpio once */
+    if (gs_power_inited == 0)
+    {
+        __HAL_RCC_GPIOB_CLK_ENABLE();
+        GPIO_Initure.Pin = POWER_GPIO_PIN;
+        GPIO_Initure.Mode = GPIO_MODE_OUTPUT_PP;
+        GPIO_Initure.Pull = GPIO_NOPULL;
+        GPIO_Initure.Speed = GPIO_SPEED_FREQ_LOW;
+        HAL_GPIO_WritePin(POWER_GPIO_PORT, POWER_GPIO_PIN, GPIO_PIN_SET);
+        HAL_GPIO_Init(POWER_GPIO_PORT, &GPIO_Initure);
+        gs_power_inited = 1;
+    }
+    
+    /* set the level */
+    HAL_GPIO_WritePin(POWER_GPIO_PORT, POWER_GPIO_PIN, (enable != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    
+    return 0;
+}
+
+/**
+ * @brief interface lock the bus
+ * @note  the tasks run in one context, so there is nothing to lock
+ */
+void sgp30_interface_lock(void)
+{
+    
+}
+
+/**
+ * @brief interface unlock the bus
+ * @note  none
+ */
+void sgp30_interface_unlock(void)
+{
+    
+}
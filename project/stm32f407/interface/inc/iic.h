@@ -23,13 +23,14 @@
  *
  * @file      iic.h
  * @brief     iic header file
- * @version   1.0.0
+ * @version   1.1.0
  * @author    Shifeng Li
- * @date      2022-11-11
+ * @date      2026-10-19
  *
  * <h3>history</h3>
  * <table>
  * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.1      <td>Shifeng Li  <td>calibrated timing, open drain pins and clock stretching
  * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
  * </table>
  */
@@ -49,6 +50,20 @@
  * @{
  */
 
+/**
+ * @brief iic default frequency definition
+ */
+#ifndef IIC_DEFAULT_FREQUENCY
+    #define IIC_DEFAULT_FREQUENCY 100000
+#endif
+
+/**
+ * @brief iic default clock stretch timeout definition
+ */
+#ifndef IIC_DEFAULT_STRETCH_TIMEOUT_US
+    #define IIC_DEFAULT_STRETCH_TIMEOUT_US 25000
+#endif
+
 /**
  * @brief  iic bus init
  * @return status code
@@ -65,6 +80,32 @@ uint8_t iic_init(void);
  */
 uint8_t iic_deinit(void);
 
+/**
+ * @brief     iic bus set the frequency
+ * @param[in] hz bus frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 frequency is invalid
+ * @note      10000 <= hz <= 400000
+ */
+uint8_t iic_set_frequency(uint32_t hz);
+
+/**
+ * @brief  iic bus get the frequency
+ * @return bus frequency
+ * @note   none
+ */
+uint32_t iic_get_frequency(void);
+
+/**
+ * @brief     iic bus set the clock stretch timeout
+ * @param[in] us timeout in microseconds
+ * @return    status code
+ *            - 0 success
+ * @note      a transfer fails when a slave holds scl low longer than the timeout
+ */
+uint8_t iic_set_stretch_timeout(uint32_t us);
+
 /**
  * @brief     iic bus write command
  * @param[in] addr iic device write address
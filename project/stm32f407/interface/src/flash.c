@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      flash.c
+ * @brief     flash source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "flash.h"
+#include <string.h>
+
+/**
+ * @brief     flash erase one sector
+ * @param[in] sector flash sector number
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ * @note      the cpu stalls while the sector is being erased
+ */
+uint8_t flash_erase_sector(uint32_t sector)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t error;
+    HAL_StatusTypeDef ret;
+    
+    /* set the erase param */
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = FLASH_BANK_1;
+    erase.Sector = sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    
+    /* erase */
+    HAL_FLASH_Unlock();
+    ret = HAL_FLASHEx_Erase(&erase, &error);
+    HAL_FLASH_Lock();
+    if (ret != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     flash write data
+ * @param[in] addr flash address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the written area must be erased before
+ */
+uint8_t flash_write(uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint32_t word;
+    
+    HAL_FLASH_Unlock();
+    i = 0;
+    
+    /* write bytes until the address is word aligned */
+    while ((i < len) && (((addr + i) & 0x3) != 0))
+    {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_BYTE, addr + i, buf[i]) != HAL_OK)
+        {
+            HAL_FLASH_Lock();
+            
+            return 1;
+        }
+        i++;
+    }
+    
+    /* write words */
+    while ((len - i) >= 4)
+    {
+        memcpy(&word, &buf[i], 4);
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i, word) != HAL_OK)
+        {
+            HAL_FLASH_Lock();
+            
+            return 1;
+        }
+        i += 4;
+    }
+    
+    /* write the last bytes */
+    while (i < len)
+    {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_BYTE, addr + i, buf[i]) != HAL_OK)
+        {
+            HAL_FLASH_Lock();
+            
+            return 1;
+        }
+        i++;
+    }
+    HAL_FLASH_Lock();
+    
+    return 0;
+}
+
+/**
+ * @brief      flash read data
+ * @param[in]  addr flash address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t flash_read(uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    /* the flash is memory mapped */
+    memcpy(buf, (const void *)addr, len);
+    
+    return 0;
+}
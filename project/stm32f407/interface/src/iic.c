@@ -23,39 +23,117 @@
  *
  * @file      iic.c
  * @brief     iic source file
- * @version   1.0.0
+ * @version   1.1.0
  * @author    Shifeng Li
- * @date      2022-11-11
+ * @date      2026-10-19
  *
  * <h3>history</h3>
  * <table>
  * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.1      <td>Shifeng Li  <td>calibrated timing, open drain pins and clock stretching
  * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
  * </table>
  */
 
 #include "iic.h"
-#include "delay.h"
 
 /**
- * @brief bit operate definition
+ * @brief iic gpio operate definition
  */
-#define BITBAND(addr, bitnum)    ((addr & 0xF0000000) + 0x2000000 + ((addr & 0xFFFFF) << 5) + (bitnum << 2)) 
-#define MEM_ADDR(addr)           *((uint32_t *)(addr)) 
-#define BIT_ADDR(addr, bitnum)   MEM_ADDR(BITBAND(addr, bitnum))
+#define IIC_PORT            GPIOB                                         /**< iic gpio port */
+#define IIC_SCL_PIN         GPIO_PIN_8                                    /**< scl pin */
+#define IIC_SDA_PIN         GPIO_PIN_9                                    /**< sda pin */
+#define IIC_SCL_H()         (IIC_PORT->BSRR = IIC_SCL_PIN)                /**< release scl */
+#define IIC_SCL_L()         (IIC_PORT->BSRR = (uint32_t)IIC_SCL_PIN << 16)  /**< drive scl low */
+#define IIC_SDA_H()         (IIC_PORT->BSRR = IIC_SDA_PIN)                /**< release sda */
+#define IIC_SDA_L()         (IIC_PORT->BSRR = (uint32_t)IIC_SDA_PIN << 16)  /**< drive sda low */
+#define IIC_READ_SCL()      ((IIC_PORT->IDR & IIC_SCL_PIN) != 0)          /**< read scl */
+#define IIC_READ_SDA()      ((IIC_PORT->IDR & IIC_SDA_PIN) != 0)          /**< read sda */
+
+static uint32_t gs_frequency = IIC_DEFAULT_FREQUENCY;             /**< bus frequency */
+static uint32_t gs_stretch_us = IIC_DEFAULT_STRETCH_TIMEOUT_US;   /**< clock stretch timeout */
+static uint32_t gs_low_ticks;                                     /**< scl low ticks */
+static uint32_t gs_high_ticks;                                    /**< scl high ticks */
+static uint32_t gs_stretch_ticks;                                 /**< clock stretch timeout ticks */
+static uint32_t gs_overhead_ticks;                                /**< measured overhead of one pin write and delay call */
 
 /**
- * @brief iic gpio operate definition
+ * @brief     iic delay core clock cycles
+ * @param[in] ticks core clock cycles
+ * @note      none
+ */
+static inline void a_iic_delay(uint32_t ticks)
+{
+    uint32_t start;
+    
+    start = DWT->CYCCNT;
+    while ((DWT->CYCCNT - start) < ticks)
+    {
+        
+    }
+}
+
+/**
+ * @brief     iic convert nanoseconds to delay ticks
+ * @param[in] ns time in nanoseconds
+ * @return    delay ticks without the overhead
+ * @note      none
  */
-#define GPIOB_ODR_Addr    (GPIOB_BASE + 0x14)
-#define GPIOB_IDR_Addr    (GPIOB_BASE + 0x10)
-#define PBout(n)          BIT_ADDR(GPIOB_ODR_Addr, n)
-#define PBin(n)           BIT_ADDR(GPIOB_IDR_Addr, n)
-#define SDA_IN()          {GPIOB->MODER &= ~(3 << (9 * 2)); GPIOB->MODER |= 0 << 9 * 2;}
-#define SDA_OUT()         {GPIOB->MODER &= ~(3 << (9 * 2)); GPIOB->MODER |= 1 << 9 * 2;}
-#define IIC_SCL           PBout(8)
-#define IIC_SDA           PBout(9)
-#define READ_SDA          PBin(9)
+static uint32_t a_iic_ns_to_ticks(uint32_t ns)
+{
+    uint32_t ticks;
+    
+    /* round up to keep the bus timing above the minimum */
+    ticks = (uint32_t)(((uint64_t)SystemCoreClock * ns + 999999999ULL) / 1000000000ULL);
+    if (ticks > gs_overhead_ticks)
+    {
+        return ticks - gs_overhead_ticks;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief iic update the delay ticks from the core clock
+ * @note  the low part takes 52% of the period to meet tLOW and tHIGH of both modes
+ */
+static void a_iic_calibrate(void)
+{
+    uint32_t period_ns;
+    
+    period_ns = 1000000000UL / gs_frequency;
+    gs_low_ticks = a_iic_ns_to_ticks(period_ns * 52 / 100);
+    gs_high_ticks = a_iic_ns_to_ticks(period_ns - period_ns * 52 / 100);
+    gs_stretch_ticks = (uint32_t)((uint64_t)SystemCoreClock * gs_stretch_us / 1000000ULL);
+}
+
+/**
+ * @brief  iic release scl and wait for the clock stretching
+ * @return status code
+ *         - 0 success
+ *         - 1 stretch timeout
+ * @note   none
+ */
+static inline uint8_t a_iic_scl_high(void)
+{
+    uint32_t start;
+    
+    IIC_SCL_H();
+    
+    /* the slave may hold scl low */
+    start = DWT->CYCCNT;
+    while (IIC_READ_SCL() == 0)
+    {
+        if ((DWT->CYCCNT - start) > gs_stretch_ticks)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
 
 /**
  * @brief  iic bus init
@@ -66,22 +144,38 @@
 uint8_t iic_init(void)
 {
     GPIO_InitTypeDef GPIO_Initure;
+    uint32_t start;
+    uint8_t i;
+    
+    /* enable the cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
     
     /* enable iic gpio clock */
     __HAL_RCC_GPIOB_CLK_ENABLE();
     
-    /* iic gpio init */
-    GPIO_Initure.Pin = GPIO_PIN_8 | GPIO_PIN_9;
-    GPIO_Initure.Mode = GPIO_MODE_OUTPUT_PP;   
+    /* set sda and scl high before the pins are enabled */
+    IIC_SDA_H();
+    IIC_SCL_H();
+    
+    /* iic gpio init, open drain so the pins can be read back without direction switching */
+    GPIO_Initure.Pin = IIC_SCL_PIN | IIC_SDA_PIN;
+    GPIO_Initure.Mode = GPIO_MODE_OUTPUT_OD;
     GPIO_Initure.Pull = GPIO_PULLUP;
     GPIO_Initure.Speed = GPIO_SPEED_FREQ_HIGH;
-    HAL_GPIO_Init(GPIOB, &GPIO_Initure);
+    HAL_GPIO_Init(IIC_PORT, &GPIO_Initure);
     
-    /* set sda high */
-    IIC_SDA = 1;
+    /* measure the overhead of one pin write and delay call */
+    start = DWT->CYCCNT;
+    for (i = 0; i < 8; i++)
+    {
+        IIC_SCL_H();
+        a_iic_delay(0);
+    }
+    gs_overhead_ticks = (DWT->CYCCNT - start) / 8;
     
-    /* set scl high */
-    IIC_SCL = 1;
+    /* calibrate the delays */
+    a_iic_calibrate();
     
     return 0;
 }
@@ -95,160 +189,218 @@ uint8_t iic_init(void)
 uint8_t iic_deinit(void)
 {
     /* iic gpio deinit */
-    HAL_GPIO_DeInit(GPIOB, GPIO_PIN_8 | GPIO_PIN_9);
+    HAL_GPIO_DeInit(IIC_PORT, IIC_SCL_PIN | IIC_SDA_PIN);
     
     return 0;
 }
 
 /**
- * @brief iic bus send start
- * @note  none
+ * @brief     iic bus set the frequency
+ * @param[in] hz bus frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 frequency is invalid
+ * @note      10000 <= hz <= 400000
  */
-static void a_iic_start(void)
+uint8_t iic_set_frequency(uint32_t hz)
 {
-    SDA_OUT();
-    IIC_SDA = 1;
-    IIC_SCL = 1;
-    delay_us(4);
-    IIC_SDA = 0;
-    delay_us(4);
-    IIC_SCL = 0;
+    if ((hz < 10000) || (hz > 400000))
+    {
+        return 1;
+    }
+    
+    /* save and calibrate */
+    gs_frequency = hz;
+    a_iic_calibrate();
+    
+    return 0;
 }
 
 /**
- * @brief iic bus send stop
- * @note  none
+ * @brief  iic bus get the frequency
+ * @return bus frequency
+ * @note   none
  */
-static void a_iic_stop(void)
+uint32_t iic_get_frequency(void)
 {
-    SDA_OUT();
-    IIC_SCL = 0;
-    IIC_SDA = 0;
-    delay_us(4);
-    IIC_SCL = 1;
-    delay_us(4);
-    IIC_SDA = 1;
-    delay_us(4);
+    return gs_frequency;
 }
 
 /**
- * @brief  iic wait ack
- * @return status code
- *         - 0 get ack
- *         - 1 no ack
- * @note   none
+ * @brief     iic bus set the clock stretch timeout
+ * @param[in] us timeout in microseconds
+ * @return    status code
+ *            - 0 success
+ * @note      a transfer fails when a slave holds scl low longer than the timeout
  */
-static uint8_t a_iic_wait_ack(void)
+uint8_t iic_set_stretch_timeout(uint32_t us)
 {
-    uint16_t uc_err_time = 0;
-    
-    SDA_IN();
-    IIC_SDA = 1; 
-    delay_us(1);
-    IIC_SCL = 1; 
-    delay_us(1);
-    while (READ_SDA != 0)
-    {
-        uc_err_time++;
-        if (uc_err_time > 250)
-        {
-            a_iic_stop();
-            
-            return 1;
-        }
-    }
-    IIC_SCL = 0;
+    gs_stretch_us = us;
+    a_iic_calibrate();
     
     return 0;
 }
 
 /**
- * @brief iic bus send ack
- * @note  none
+ * @brief  iic bus send start
+ * @return status code
+ *         - 0 success
+ *         - 1 stretch timeout
+ * @note   also used as a repeated start
  */
-static void a_iic_ack(void)
+static uint8_t a_iic_start(void)
 {
-    IIC_SCL = 0;
-    SDA_OUT();
-    IIC_SDA = 0;
-    delay_us(2);
-    IIC_SCL = 1;
-    delay_us(2);
-    IIC_SCL = 0;
+    IIC_SDA_H();
+    if (a_iic_scl_high() != 0)
+    {
+        return 1;
+    }
+    a_iic_delay(gs_high_ticks);
+    IIC_SDA_L();
+    a_iic_delay(gs_high_ticks);
+    IIC_SCL_L();
+    
+    return 0;
 }
 
 /**
- * @brief iic bus send nack
+ * @brief iic bus send stop
  * @note  none
  */
-static void a_iic_nack(void)
+static void a_iic_stop(void)
 {
-    IIC_SCL = 0;
-    SDA_OUT();
-    IIC_SDA = 1;
-    delay_us(2);
-    IIC_SCL = 1;
-    delay_us(2);
-    IIC_SCL = 0; 
+    IIC_SCL_L();
+    IIC_SDA_L();
+    a_iic_delay(gs_low_ticks);
+    (void)a_iic_scl_high();
+    a_iic_delay(gs_high_ticks);
+    IIC_SDA_H();
+    a_iic_delay(gs_low_ticks);
 }
 
 /**
- * @brief     iic send one byte
+ * @brief     iic send one byte and wait ack
  * @param[in] txd sent byte
+ * @return    status code
+ *            - 0 get ack
+ *            - 1 no ack or stretch timeout
  * @note      none
  */
-static void a_iic_send_byte(uint8_t txd)
+static uint8_t a_iic_send_byte(uint8_t txd)
 {
     uint8_t t;
+    uint8_t nack;
     
-    SDA_OUT();
-    IIC_SCL = 0;
     for (t = 0; t < 8; t++)
     {
-        IIC_SDA = (txd & 0x80) >> 7;
+        if ((txd & 0x80) != 0)
+        {
+            IIC_SDA_H();
+        }
+        else
+        {
+            IIC_SDA_L();
+        }
         txd <<= 1;
-        delay_us(2);
-        IIC_SCL = 1;
-        delay_us(2);
-        IIC_SCL = 0;
-        delay_us(2);
+        a_iic_delay(gs_low_ticks);
+        if (a_iic_scl_high() != 0)
+        {
+            return 1;
+        }
+        a_iic_delay(gs_high_ticks);
+        IIC_SCL_L();
+    }
+    
+    /* release sda and sample the ack at the high level */
+    IIC_SDA_H();
+    a_iic_delay(gs_low_ticks);
+    if (a_iic_scl_high() != 0)
+    {
+        return 1;
     }
+    a_iic_delay(gs_high_ticks);
+    nack = IIC_READ_SDA();
+    IIC_SCL_L();
+    
+    return nack;
 }
 
 /**
- * @brief     iic read one byte
- * @param[in] ack sent ack
- * @return    read byte
- * @note      none
+ * @brief      iic read one byte
+ * @param[in]  ack sent ack
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 stretch timeout
+ * @note       none
  */
-static uint8_t a_iic_read_byte(uint8_t ack)
+static uint8_t a_iic_read_byte(uint8_t ack, uint8_t *data)
 {
     uint8_t i;
     uint8_t receive = 0;
     
-    SDA_IN();
+    IIC_SDA_H();
     for (i = 0; i < 8; i++)
     {
-        IIC_SCL = 0;
-        delay_us(2);
-        IIC_SCL = 1;
+        a_iic_delay(gs_low_ticks);
+        if (a_iic_scl_high() != 0)
+        {
+            return 1;
+        }
+        a_iic_delay(gs_high_ticks);
         receive <<= 1;
-        if (READ_SDA != 0)
+        if (IIC_READ_SDA() != 0)
         {
             receive++;
         }
-        delay_us(1);
+        IIC_SCL_L();
     }
+    
+    /* send ack or nack */
     if (ack != 0)
     {
-        a_iic_ack();
+        IIC_SDA_L();
     }
     else
     {
-        a_iic_nack();
+        IIC_SDA_H();
     }
+    a_iic_delay(gs_low_ticks);
+    if (a_iic_scl_high() != 0)
+    {
+        return 1;
+    }
+    a_iic_delay(gs_high_ticks);
+    IIC_SCL_L();
+    IIC_SDA_H();
+    *data = receive;
     
-    return receive;
+    return 0;
+}
+
+/**
+ * @brief      iic read the data bytes
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       nack is sent after the last byte
+ */
+static uint8_t a_iic_read_bytes(uint8_t *buf, uint16_t len)
+{
+    while (len != 0)
+    {
+        /* nack the last */
+        if (a_iic_read_byte((len == 1) ? 0 : 1, buf) != 0)
+        {
+            return 1;
+        }
+        len--;
+        buf++;
+    }
+    
+    return 0;
 }
 
 /**
@@ -266,11 +418,15 @@ uint8_t iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
     uint16_t i; 
     
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the write addr */
-    a_iic_send_byte(addr);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr) != 0)
     {
         a_iic_stop();
         
@@ -281,8 +437,7 @@ uint8_t iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
     for (i = 0; i < len; i++)
     {
         /* send one byte */
-        a_iic_send_byte(buf[i]);
-        if (a_iic_wait_ack() != 0)
+        if (a_iic_send_byte(buf[i]) != 0)
         {
             a_iic_stop();
             
@@ -312,11 +467,15 @@ uint8_t iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     uint16_t i; 
     
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the write addr */
-    a_iic_send_byte(addr);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr) != 0)
     {
         a_iic_stop();
         
@@ -324,8 +483,7 @@ uint8_t iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     }
     
     /* send the reg */
-    a_iic_send_byte(reg);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(reg) != 0)
     {
         a_iic_stop();
         
@@ -336,8 +494,7 @@ uint8_t iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     for (i = 0; i < len; i++)
     {
         /* send one byte */
-        a_iic_send_byte(buf[i]);
-        if (a_iic_wait_ack() != 0)
+        if (a_iic_send_byte(buf[i]) != 0)
         {
             a_iic_stop(); 
             
@@ -367,11 +524,15 @@ uint8_t iic_write_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t l
     uint16_t i; 
     
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the write addr */
-    a_iic_send_byte(addr);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr) != 0)
     {
         a_iic_stop();
         
@@ -379,8 +540,7 @@ uint8_t iic_write_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t l
     }
     
     /* send the reg high part */
-    a_iic_send_byte((reg >> 8) & 0xFF);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte((reg >> 8) & 0xFF) != 0)
     {
         a_iic_stop();
         
@@ -388,8 +548,7 @@ uint8_t iic_write_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t l
     }
     
     /* send the reg low part */
-    a_iic_send_byte(reg & 0xFF);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(reg & 0xFF) != 0)
     {
         a_iic_stop();
         
@@ -400,8 +559,7 @@ uint8_t iic_write_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t l
     for (i = 0; i < len; i++)
     {
         /* send one byte */
-        a_iic_send_byte(buf[i]);
-        if (a_iic_wait_ack() != 0)
+        if (a_iic_send_byte(buf[i]) != 0)
         {
             a_iic_stop();
             
@@ -428,11 +586,15 @@ uint8_t iic_write_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t l
 uint8_t iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
 {
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the read addr */
-    a_iic_send_byte(addr + 1);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr + 1) != 0)
     {
         a_iic_stop();
         
@@ -440,21 +602,11 @@ uint8_t iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
     }
     
     /* read the data */
-    while (len != 0)
+    if (a_iic_read_bytes(buf, len) != 0)
     {
-        /* if the last */
-        if (len == 1)
-        {
-            /* send nack */
-            *buf = a_iic_read_byte(0);
-        }
-        else
-        {
-            /* send ack */
-            *buf = a_iic_read_byte(1); 
-        }
-        len--;
-        buf++;
+        a_iic_stop();
+        
+        return 1;
     }
     
     /* send a stop */
@@ -477,11 +629,15 @@ uint8_t iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
 uint8_t iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the write addr */
-    a_iic_send_byte(addr);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr) != 0)
     {
         a_iic_stop();
         
@@ -489,8 +645,7 @@ uint8_t iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     }
     
     /* send the reg */
-    a_iic_send_byte(reg);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(reg) != 0)
     {
         a_iic_stop();
         
@@ -498,11 +653,15 @@ uint8_t iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     }
     
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the read addr */
-    a_iic_send_byte(addr + 1);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr + 1) != 0)
     {
         a_iic_stop();
         
@@ -510,21 +669,11 @@ uint8_t iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     }
     
     /* read the data */
-    while (len != 0)
+    if (a_iic_read_bytes(buf, len) != 0)
     {
-        /* if the last */
-        if (len == 1)
-        {
-            /* send nack */
-            *buf = a_iic_read_byte(0);
-        }
-        else
-        {
-            /* send ack */
-            *buf = a_iic_read_byte(1);
-        }
-        len--;
-        buf++;
+        a_iic_stop();
+        
+        return 1;
     }
     
     /* send a stop */
@@ -547,11 +696,15 @@ uint8_t iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 uint8_t iic_read_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len)
 {
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the write addr */
-    a_iic_send_byte(addr);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr) != 0)
     {
         a_iic_stop();
         
@@ -559,8 +712,7 @@ uint8_t iic_read_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t le
     }
     
     /* send the reg high part */
-    a_iic_send_byte((reg >> 8) & 0xFF);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte((reg >> 8) & 0xFF) != 0)
     {
         a_iic_stop();
         
@@ -568,8 +720,7 @@ uint8_t iic_read_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t le
     }
     
     /* send the reg low part */
-    a_iic_send_byte(reg & 0xFF);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(reg & 0xFF) != 0)
     {
         a_iic_stop();
         
@@ -577,11 +728,15 @@ uint8_t iic_read_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t le
     }
     
     /* send a start */
-    a_iic_start();
+    if (a_iic_start() != 0)
+    {
+        a_iic_stop();
+        
+        return 1;
+    }
     
     /* send the read addr */
-    a_iic_send_byte(addr + 1);
-    if (a_iic_wait_ack() != 0)
+    if (a_iic_send_byte(addr + 1) != 0)
     {
         a_iic_stop();
         
@@ -589,21 +744,11 @@ uint8_t iic_read_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t le
     }
     
     /* read the data */
-    while (len != 0)
+    if (a_iic_read_bytes(buf, len) != 0)
     {
-        /* if the last */
-        if (len == 1)
-        {
-            /* send nack */
-            *buf = a_iic_read_byte(0);
-        }
-        else
-        {
-            /* send ack */
-            *buf = a_iic_read_byte(1);
-        }
-        len--;
-        buf++;
+        a_iic_stop();
+        
+        return 1;
     }
     
     /* send a stop */
@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sample_log.h
+ * @brief     sample log header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SAMPLE_LOG_H
+#define SAMPLE_LOG_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sample_log sample log function
+ * @brief    sample log function modules
+ * @{
+ */
+
+/**
+ * @brief sample log param definition
+ */
+#define SAMPLE_LOG_BASE_ADDR           0x08080000UL        /**< sector 8 address */
+#define SAMPLE_LOG_FIRST_SECTOR        8                   /**< first used flash sector */
+#define SAMPLE_LOG_SECTOR_NUM          4                   /**< sector 8 - 11 */
+#define SAMPLE_LOG_SECTOR_SIZE         0x20000UL           /**< 128 KB per sector */
+#define SAMPLE_LOG_SECTOR_MAGIC        0x324C5347UL        /**< "GSL2", records carry the boot counter */
+#define SAMPLE_LOG_MAX_PAYLOAD         240                 /**< max payload length of one record */
+#define SAMPLE_LOG_DUMP_MAGIC          0x32445347UL        /**< "GSD2" */
+
+/**
+ * @brief sample log information structure definition
+ */
+typedef struct sample_log_info_s
+{
+    uint32_t used;                                      /**< used bytes */
+    uint32_t size;                                      /**< total bytes */
+    uint32_t records;                                   /**< valid record number */
+    uint32_t torn;                                      /**< torn record number */
+    uint32_t pending;                                   /**< samples in the ram block */
+    uint32_t boot;                                      /**< boot counter of this run */
+    uint32_t dropped;                                   /**< records dropped in the realtime mode */
+    uint32_t erase_count[SAMPLE_LOG_SECTOR_NUM];        /**< erase count of each sector */
+} sample_log_info_t;
+
+/**
+ * @brief  sample log init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the flash is scanned to find the write position and torn records are skipped,
+ *         the boot counter is one more than the newest one in the records
+ */
+uint8_t sample_log_init(void);
+
+/**
+ * @brief     sample log append one sample
+ * @param[in] time_s sample time in seconds since the boot
+ * @param[in] co2_eq_ppm co2 eq
+ * @param[in] tvoc_ppb tvoc
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ * @note      samples are delta packed in ram and written as one record when the block is full,
+ *            every record has the boot counter so the times of two boots do not overlap
+ */
+uint8_t sample_log_append(uint32_t time_s, uint16_t co2_eq_ppm, uint16_t tvoc_ppb);
+
+/**
+ * @brief  sample log flush the ram block
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   none
+ */
+uint8_t sample_log_flush(void);
+
+/**
+ * @brief  sample log erase all sectors
+ * @return status code
+ *         - 0 success
+ *         - 1 erase failed
+ * @note   it is refused in the realtime mode and during a dump, because it stalls the cpu for seconds
+ */
+uint8_t sample_log_erase(void);
+
+/**
+ * @brief     sample log set the realtime mode
+ * @param[in] enable realtime enable
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      enabling it erases the sector after the current one once if it is not blank,
+ *            after that the log moves into the blank sector without an erase and drops the records
+ *            when no blank sector is left, so the cpu never stalls for an erase while it is enabled
+ */
+uint8_t sample_log_set_realtime(uint8_t enable);
+
+/**
+ * @brief      sample log get the information
+ * @param[out] *info pointer to an information structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t sample_log_info(sample_log_info_t *info);
+
+/**
+ * @brief     sample log dump all records in binary
+ * @param[in] *write pointer to a write function
+ * @return    status code
+ *            - 0 success
+ *            - 1 dump failed
+ * @note      the frame is magic(4) + length(4) + records + crc16(2) in little endian,
+ *            every record is length(1) + payload and records are sent from the oldest to the newest,
+ *            a payload is boot(4) + time(4) + co2 eq(2) + tvoc(2) followed by the deltas,
+ *            the host orders the samples by the boot and then by the time,
+ *            it blocks until the whole frame is sent, a scheduler task runs the steps instead
+ */
+uint8_t sample_log_dump(uint8_t (*write)(uint8_t *buf, uint16_t len));
+
+/**
+ * @brief     sample log start a binary dump
+ * @param[in] *write pointer to a write function
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the frame is sent by sample_log_dump_step
+ */
+uint8_t sample_log_dump_start(uint8_t (*write)(uint8_t *buf, uint16_t len));
+
+/**
+ * @brief  sample log run one step of the binary dump
+ * @return status code
+ *         - 0 success, the frame is sent
+ *         - 1 dump failed
+ *         - 2 more steps are needed
+ * @note   one step reads or sends at most one chunk of 256 bytes, so a caller can run the other
+ *         work between two steps
+ */
+uint8_t sample_log_dump_step(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scheduler.h
+ * @brief     scheduler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup scheduler scheduler function
+ * @brief    scheduler function modules
+ * @{
+ */
+
+/**
+ * @brief scheduler param definition
+ */
+#define SCHEDULER_MAX_TASK         8         /**< scheduler max task number */
+#define SCHEDULER_MAX_TIMER        8         /**< scheduler max timer number */
+#define SCHEDULER_MAX_EVENT        16        /**< scheduler max pending event number */
+
+/**
+ * @brief task structure definition
+ */
+typedef struct scheduler_task_s
+{
+    char name[16];                          /**< task name */
+    void (*handler)(uint8_t event);         /**< task event handler */
+} scheduler_task_t;
+
+/**
+ * @brief timer structure definition
+ */
+typedef struct scheduler_timer_s
+{
+    uint8_t used;               /**< used flag */
+    uint8_t task;               /**< task id */
+    uint8_t event;              /**< posted event */
+    uint32_t deadline;          /**< next deadline in ms */
+    uint32_t period;            /**< period in ms, 0 means one shot */
+} scheduler_timer_t;
+
+/**
+ * @brief event structure definition
+ */
+typedef struct scheduler_event_s
+{
+    uint8_t task;         /**< task id */
+    uint8_t event;        /**< event */
+} scheduler_event_t;
+
+/**
+ * @brief scheduler statistics structure definition
+ */
+typedef struct scheduler_stats_s
+{
+    uint32_t dispatched;          /**< dispatched event number */
+    uint32_t dropped;             /**< dropped event number because of a full queue */
+    uint32_t late_max;            /**< max lateness of a timer event in ms */
+    uint32_t run_max;             /**< max run time of an event handler in ms */
+} scheduler_stats_t;
+
+/**
+ * @brief  scheduler init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t scheduler_init(void);
+
+/**
+ * @brief      scheduler register a task
+ * @param[in]  *name pointer to a name buffer
+ * @param[in]  *handler pointer to an event handler
+ * @param[out] *id pointer to a task id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 task buffer is full
+ * @note       every handler must run to completion and never block for long
+ */
+uint8_t scheduler_task_register(char *name, void (*handler)(uint8_t event), uint8_t *id);
+
+/**
+ * @brief     scheduler post an event to a task
+ * @param[in] task task id
+ * @param[in] event posted event
+ * @return    status code
+ *            - 0 success
+ *            - 1 event queue is full
+ *            - 2 task is invalid
+ * @note      this function can be called in the irq handler
+ */
+uint8_t scheduler_post(uint8_t task, uint8_t event);
+
+/**
+ * @brief      scheduler start a timer
+ * @param[in]  task task id
+ * @param[in]  event posted event when the timer expires
+ * @param[in]  delay_ms first expiration time in ms
+ * @param[in]  period_ms period in ms, 0 means one shot
+ * @param[out] *timer pointer to a timer id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 timer buffer is full
+ *             - 2 task is invalid
+ * @note       periodic timers use absolute deadlines, so the period never drifts
+ */
+uint8_t scheduler_timer_start(uint8_t task, uint8_t event, uint32_t delay_ms, uint32_t period_ms, uint8_t *timer);
+
+/**
+ * @brief     scheduler stop a timer
+ * @param[in] timer timer id
+ * @return    status code
+ *            - 0 success
+ *            - 1 timer is invalid
+ * @note      none
+ */
+uint8_t scheduler_timer_stop(uint8_t timer);
+
+/**
+ * @brief  scheduler run once
+ * @return dispatched event number
+ * @note   this function checks all timers and dispatches all pending events
+ */
+uint16_t scheduler_run_once(void);
+
+/**
+ * @brief scheduler run forever
+ * @note  the cpu sleeps until the next interrupt when no event is pending
+ */
+void scheduler_run(void);
+
+/**
+ * @brief      scheduler get the statistics
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void scheduler_get_stats(scheduler_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sgp30_task.h
+ * @brief     sgp30 task header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SGP30_TASK_H
+#define SGP30_TASK_H
+
+#include "driver_sgp30_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sgp30_task sgp30 task function
+ * @brief    sgp30 task function modules
+ * @{
+ */
+
+/**
+ * @brief sgp30 task event enumeration definition
+ */
+typedef enum
+{
+    SGP30_TASK_EVENT_PERIOD  = 0x00,       /**< 1 Hz period event */
+    SGP30_TASK_EVENT_FETCH   = 0x01,       /**< conversion done event */
+    SGP30_TASK_EVENT_RECOVER = 0x02,       /**< next recovery step event */
+} sgp30_task_event_t;
+
+/**
+ * @brief sgp30 task state enumeration definition
+ */
+typedef enum
+{
+    SGP30_TASK_STATE_STOP       = 0x00,        /**< stop state */
+    SGP30_TASK_STATE_IDLE       = 0x01,        /**< wait for the next period */
+    SGP30_TASK_STATE_CONVERTING = 0x02,        /**< wait for the conversion */
+    SGP30_TASK_STATE_RETRY      = 0x03,        /**< probe the chip again */
+    SGP30_TASK_STATE_SOFT_RESET = 0x04,        /**< wait for the soft reset */
+    SGP30_TASK_STATE_POWER_OFF  = 0x05,        /**< wait for the supply to drop */
+    SGP30_TASK_STATE_POWER_ON   = 0x06,        /**< wait for the power up */
+} sgp30_task_state_t;
+
+/**
+ * @brief  task init and register the task to the scheduler
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   scheduler_init must be called before
+ */
+uint8_t sgp30_task_init(void);
+
+/**
+ * @brief     task start the 1 Hz measurement
+ * @param[in] times measurement times, 0 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the results are printed in the background
+ */
+uint8_t sgp30_task_start(uint32_t times);
+
+/**
+ * @brief  task stop the measurement
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t sgp30_task_stop(void);
+
+/**
+ * @brief  task get the running status
+ * @return status code
+ *         - 0 stopped
+ *         - 1 running
+ * @note   none
+ */
+uint8_t sgp30_task_is_running(void);
+
+/**
+ * @brief     task set the quiet mode
+ * @param[in] enable quiet enable
+ * @note      the measurement keeps running and only the output is dropped
+ */
+void sgp30_task_set_quiet(uint8_t enable);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -39,17 +39,36 @@
 #include "driver_sgp30_register_test.h"
 #include "driver_sgp30_read_test.h"
 #include "shell.h"
+#include "scheduler.h"
+#include "sgp30_task.h"
+#include "sample_log.h"
 #include "clock.h"
 #include "delay.h"
 #include "uart.h"
 #include "getopt.h"
 #include <stdlib.h>
 
+/**
+ * @brief log dump event definition
+ */
+#define DUMP_EVENT_START        0        /**< switch the baud rate */
+#define DUMP_EVENT_BEGIN        1        /**< start the frame */
+#define DUMP_EVENT_STEP         2        /**< send one chunk */
+#define DUMP_EVENT_END          3        /**< restore the baud rate */
+#define DUMP_WAIT_MS            100      /**< wait of the host before and after a baud switch */
+
 /**
  * @brief global var definition
  */
 uint8_t g_buf[256];        /**< uart buffer */
 volatile uint16_t g_len;   /**< uart buffer length */
+uint8_t g_shell_task;      /**< shell task id */
+uint8_t g_shell_timer;     /**< shell timer id */
+uint8_t g_dump_task;       /**< log dump task id */
+uint32_t g_dump_baud;      /**< log dump baud rate */
+uint8_t g_dump_running;    /**< log dump running flag */
+uint8_t g_dump_res;        /**< log dump result */
+uint8_t g_dump_timer;      /**< log dump timer id */
 
 /**
  * @brief     sgp30 full function
@@ -78,6 +97,7 @@ uint8_t sgp30(uint8_t argc, char **argv)
         {"humidity-rh", required_argument, NULL, 3},
         {"humidity-temperature", required_argument, NULL, 4},
         {"times", required_argument, NULL, 5},
+        {"baud", required_argument, NULL, 6},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -86,6 +106,7 @@ uint8_t sgp30(uint8_t argc, char **argv)
     uint16_t tvoc_ppb = 0;
     float rh = 50.0f;
     float temp = 25.0f;
+    uint32_t baud = 115200;
 
     /* if no params */
     if (argc == 1)
@@ -199,6 +220,15 @@ uint8_t sgp30(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* dump baud rate */
+            case 6 :
+            {
+                /* set the baud */
+                baud = atol(optarg);
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -213,6 +243,15 @@ uint8_t sgp30(uint8_t argc, char **argv)
         }
     } while (c != -1);
 
+    /* the background task owns the chip */
+    if ((sgp30_task_is_running() != 0) && (strncmp("e_monitor", type, 9) != 0) &&
+        (strncmp("e_log", type, 5) != 0) && ((type[0] == 'e') || (type[0] == 't')))
+    {
+        sgp30_interface_debug_print("sgp30: monitor is running, stop it first.\n");
+        
+        return 1;
+    }
+    
     /* run the function */
     if (strcmp("t_reg", type) == 0)
     {
@@ -332,6 +371,117 @@ uint8_t sgp30(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("e_monitor", type) == 0)
+    {
+        /* start the non-blocking measurement */
+        if (sgp30_task_start(times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_monitor-stop", type) == 0)
+    {
+        /* stop the non-blocking measurement */
+        if (sgp30_task_stop() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_log-info", type) == 0)
+    {
+        uint8_t i;
+        sample_log_info_t info;
+        
+        /* get the log information */
+        if (sample_log_info(&info) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        sgp30_interface_debug_print("sgp30: log used %d/%d bytes.\n", info.used, info.size);
+        sgp30_interface_debug_print("sgp30: log records %d, torn %d, pending samples %d.\n", info.records, info.torn, info.pending);
+        sgp30_interface_debug_print("sgp30: log boot counter %d.\n", info.boot);
+        sgp30_interface_debug_print("sgp30: log dropped records %d.\n", info.dropped);
+        for (i = 0; i < SAMPLE_LOG_SECTOR_NUM; i++)
+        {
+            sgp30_interface_debug_print("sgp30: log sector %d erase count %d.\n", SAMPLE_LOG_FIRST_SECTOR + i, info.erase_count[i]);
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_log-erase", type) == 0)
+    {
+        /* the erase stalls the cpu for seconds */
+        if (sgp30_task_is_running() != 0)
+        {
+            sgp30_interface_debug_print("sgp30: monitor is running, stop it first.\n");
+            
+            return 1;
+        }
+        
+        /* erase all sectors */
+        sgp30_interface_debug_print("sgp30: erasing the log...\n");
+        if (sample_log_erase() != 0)
+        {
+            return 1;
+        }
+        sgp30_interface_debug_print("sgp30: log erased.\n");
+        
+        return 0;
+    }
+    else if (strcmp("e_log-dump", type) == 0)
+    {
+        /* the dump task sends the frame in chunks between the measurements */
+        sgp30_interface_debug_print("sgp30: dump the log at %d baud.\n", baud);
+        g_dump_baud = baud;
+        g_dump_res = 0;
+        g_dump_running = 1;
+        sgp30_task_set_quiet(1);
+        if (scheduler_timer_start(g_dump_task, DUMP_EVENT_START, DUMP_WAIT_MS, 0, &g_dump_timer) != 0)
+        {
+            sgp30_task_set_quiet(0);
+            g_dump_running = 0;
+            
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_recover", type) == 0)
+    {
+        uint8_t res;
+        uint32_t ms;
+        sgp30_recovery_level_t level;
+        const char *name[4] = {"none", "retry", "soft reset", "power cycle"};
+        
+        /* init, a wedged chip fails the soft reset in the init and is recovered below */
+        (void)sgp30_advance_init();
+        
+        /* recover and measure the time */
+        ms = HAL_GetTick();
+        res = sgp30_advance_recover(tvoc_ppb, co2_eq_ppm, sgp30_interface_power_set, &level);
+        ms = HAL_GetTick() - ms;
+        if (res != 0)
+        {
+            sgp30_interface_debug_print("sgp30: recover failed after %d ms.\n", ms);
+            (void)sgp30_advance_deinit();
+            
+            return 1;
+        }
+        
+        /* output */
+        sgp30_interface_debug_print("sgp30: recovered by %s in %d ms.\n", name[level], ms);
+        
+        /* deinit */
+        (void)sgp30_advance_deinit();
+        
+        return 0;
+    }
     else if (strcmp("e_info", type) == 0)
     {
         uint8_t res;
@@ -387,11 +537,19 @@ uint8_t sgp30(uint8_t argc, char **argv)
         sgp30_interface_debug_print("  sgp30 (-e advance-read | --example=advance-read) [--times=<num>] [--baseline-tvoc=<ppb>] [--baseline-co2eq=<ppm>]\n");
         sgp30_interface_debug_print("        [--humidity-temperature=<temp>] [--humidity-rh=<rh>]\n");
         sgp30_interface_debug_print("  sgp30 (-e info | --example=info)\n");
+        sgp30_interface_debug_print("  sgp30 (-e monitor | --example=monitor) [--times=<num>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e monitor-stop | --example=monitor-stop)\n");
+        sgp30_interface_debug_print("  sgp30 (-e recover | --example=recover) [--baseline-tvoc=<ppb>] [--baseline-co2eq=<ppm>]\n");
+        sgp30_interface_debug_print("  sgp30 (-e log-info | --example=log-info)\n");
+        sgp30_interface_debug_print("  sgp30 (-e log-erase | --example=log-erase)\n");
+        sgp30_interface_debug_print("  sgp30 (-e log-dump | --example=log-dump) [--baud=<rate>]\n");
         sgp30_interface_debug_print("\n");
         sgp30_interface_debug_print("Options:\n");
+        sgp30_interface_debug_print("      --baud=<rate>                       Set the log dump baud rate.([default: 115200])\n");
         sgp30_interface_debug_print("      --baseline-co2eq=<ppm>              Set the co2eq baseline.([default: 0])\n");
         sgp30_interface_debug_print("      --baseline-tvoc=<ppb>               Set the tvoc baseline.([default: 0])\n");
-        sgp30_interface_debug_print("  -e <read | advance-read | info>, --example=<read | advance-read | info>\n");
+        sgp30_interface_debug_print("  -e <read | advance-read | info | recover | monitor | monitor-stop | log-info | log-erase | log-dump>,\n");
+        sgp30_interface_debug_print("     --example=<read | advance-read | info | recover | monitor | monitor-stop | log-info | log-erase | log-dump>\n");
         sgp30_interface_debug_print("                                          Run the driver example.\n");
         sgp30_interface_debug_print("  -h, --help                              Show the help.\n");
         sgp30_interface_debug_print("      --humidity-rh=<rh>                  Set the humidity rh.([default: 50.0f])\n");
@@ -435,14 +593,151 @@ uint8_t sgp30(uint8_t argc, char **argv)
     }
 }
 
+/**
+ * @brief     log dump task event handler
+ * @param[in] event task event
+ * @note      one chunk is sent per event, so the 1 Hz measurement keeps its cadence during the dump
+ */
+static void a_dump_task_handler(uint8_t event)
+{
+    uint8_t res;
+    
+    if (event == DUMP_EVENT_START)
+    {
+        /* switch the baud rate */
+        if (g_dump_baud != 115200)
+        {
+            (void)uart_deinit();
+            if (uart_init(g_dump_baud) != 0)
+            {
+                (void)uart_init(115200);
+                g_dump_res = 1;
+                (void)scheduler_post(g_dump_task, DUMP_EVENT_END);
+                
+                return;
+            }
+            if (scheduler_timer_start(g_dump_task, DUMP_EVENT_BEGIN, DUMP_WAIT_MS, 0, &g_dump_timer) != 0)
+            {
+                g_dump_res = 1;
+                (void)scheduler_post(g_dump_task, DUMP_EVENT_END);
+            }
+        }
+        else
+        {
+            (void)scheduler_post(g_dump_task, DUMP_EVENT_BEGIN);
+        }
+    }
+    else if (event == DUMP_EVENT_BEGIN)
+    {
+        /* start the frame */
+        if (sample_log_dump_start(uart_write) != 0)
+        {
+            g_dump_res = 1;
+            (void)scheduler_post(g_dump_task, DUMP_EVENT_END);
+            
+            return;
+        }
+        (void)scheduler_post(g_dump_task, DUMP_EVENT_STEP);
+    }
+    else if (event == DUMP_EVENT_STEP)
+    {
+        /* the next chunk is queued behind the other events */
+        res = sample_log_dump_step();
+        if (res == 2)
+        {
+            (void)scheduler_post(g_dump_task, DUMP_EVENT_STEP);
+            
+            return;
+        }
+        g_dump_res = res;
+        if ((g_dump_baud == 115200) ||
+            (scheduler_timer_start(g_dump_task, DUMP_EVENT_END, DUMP_WAIT_MS, 0, &g_dump_timer) != 0))
+        {
+            (void)scheduler_post(g_dump_task, DUMP_EVENT_END);
+        }
+    }
+    else if (event == DUMP_EVENT_END)
+    {
+        /* restore the baud rate */
+        if (g_dump_baud != 115200)
+        {
+            (void)uart_deinit();
+            (void)uart_init(115200);
+        }
+        g_dump_running = 0;
+        sgp30_task_set_quiet(0);
+        if (g_dump_res != 0)
+        {
+            uart_print("sgp30: run failed.\n");
+        }
+    }
+    else
+    {
+        /* unknown event */
+    }
+}
+
+/**
+ * @brief     shell task event handler
+ * @param[in] event task event
+ * @note      none
+ */
+static void a_shell_task_handler(uint8_t event)
+{
+    uint8_t res;
+    
+    (void)event;
+    
+    /* read uart */
+    g_len = uart_read(g_buf, 256);
+    
+    /* the host only reads the binary frame during a dump, so the input is dropped */
+    if (g_dump_running != 0)
+    {
+        return;
+    }
+    if (g_len != 0)
+    {
+        /* run shell */
+        res = shell_parse((char *)g_buf, g_len);
+        if (res == 0)
+        {
+            /* run success */
+        }
+        else if (res == 1)
+        {
+            uart_print("sgp30: run failed.\n");
+        }
+        else if (res == 2)
+        {
+            uart_print("sgp30: unknown command.\n");
+        }
+        else if (res == 3)
+        {
+            uart_print("sgp30: length is too long.\n");
+        }
+        else if (res == 4)
+        {
+            uart_print("sgp30: pretreat failed.\n");
+        }
+        else if (res == 5)
+        {
+            uart_print("sgp30: param is invalid.\n");
+        }
+        else
+        {
+            uart_print("sgp30: unknown status code.\n");
+        }
+        uart_flush();
+    }
+}
+
 /**
  * @brief main function
  * @note  none
  */
 int main(void)
 {
-    uint8_t res;
-    
     /* stm32f407 clock init and hal init */
     clock_init();
     
@@ -457,44 +752,25 @@ int main(void)
     shell_register("sgp30", sgp30);
     uart_print("sgp30: welcome to libdriver sgp30.\n");
     
-    while (1)
+    /* scheduler init */
+    scheduler_init();
+    
+    /* poll the shell every 10 ms */
+    scheduler_task_register("shell", a_shell_task_handler, &g_shell_task);
+    scheduler_timer_start(g_shell_task, 0, 10, 10, &g_shell_timer);
+    
+    /* send the log dump in chunks */
+    scheduler_task_register("dump", a_dump_task_handler, &g_dump_task);
+    
+    /* sample log init */
+    if (sample_log_init() != 0)
     {
-        /* read uart */
-        g_len = uart_read(g_buf, 256);
-        if (g_len != 0)
-        {
-            /* run shell */
-            res = shell_parse((char *)g_buf, g_len);
-            if (res == 0)
-            {
-                /* run success */
-            }
-            else if (res == 1)
-            {
-                uart_print("sgp30: run failed.\n");
-            }
-            else if (res == 2)
-            {
-                uart_print("sgp30: unknown command.\n");
-            }
-            else if (res == 3)
-            {
-                uart_print("sgp30: length is too long.\n");
-            }
-            else if (res == 4)
-            {
-                uart_print("sgp30: pretreat failed.\n");
-            }
-            else if (res == 5)
-            {
-                uart_print("sgp30: param is invalid.\n");
-            }
-            else
-            {
-                uart_print("sgp30: unknown status code.\n");
-            }
-            uart_flush();
-        }
-        delay_ms(100);
+        uart_print("sgp30: sample log init failed.\n");
     }
+    
+    /* register the sgp30 background task */
+    sgp30_task_init();
+    
+    /* run forever */
+    scheduler_run();
 }
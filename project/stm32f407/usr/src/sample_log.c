@@ -0,0 +1,936 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sample_log.c
+ * @brief     sample log source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sample_log.h"
+#include "flash.h"
+
+/**
+ * @brief sample log layout definition
+ */
+#define SAMPLE_LOG_SECTOR_HEADER_SIZE        16        /**< magic(4) + seq(4) + erase(4) + crc(4) */
+#define SAMPLE_LOG_RECORD_HEADER_SIZE        4         /**< len(1) + crc16(2) + commit(1) */
+#define SAMPLE_LOG_RECORD_FREE               0xFF      /**< erased record length */
+#define SAMPLE_LOG_RECORD_COMMIT             0x00      /**< committed flag */
+#define SAMPLE_LOG_DUMP_CHUNK                256       /**< bytes sent by one dump step */
+
+/**
+ * @brief sample log structure definition
+ */
+typedef struct sample_log_s
+{
+    uint8_t inited;                                         /**< inited flag */
+    uint8_t valid[SAMPLE_LOG_SECTOR_NUM];                   /**< sector valid flag */
+    uint8_t blank[SAMPLE_LOG_SECTOR_NUM];                   /**< sector erased without a header flag */
+    uint32_t seq[SAMPLE_LOG_SECTOR_NUM];                    /**< sector sequence */
+    uint32_t erase[SAMPLE_LOG_SECTOR_NUM];                  /**< sector erase count */
+    uint8_t current;                                        /**< current sector */
+    uint32_t offset;                                        /**< write offset in the current sector */
+    uint32_t next_seq;                                      /**< next sector sequence */
+    uint32_t boot;                                          /**< boot counter */
+    uint8_t block[SAMPLE_LOG_MAX_PAYLOAD];                  /**< ram block */
+    uint16_t block_len;                                     /**< ram block length */
+    uint16_t block_count;                                   /**< samples in the ram block */
+    uint32_t last_time;                                     /**< last sample time */
+    uint16_t last_co2;                                      /**< last co2 eq */
+    uint16_t last_tvoc;                                     /**< last tvoc */
+    uint8_t realtime;                                       /**< realtime flag, no erase is allowed */
+    uint32_t dropped;                                       /**< dropped record number */
+    uint8_t dump_running;                                   /**< dump running flag */
+    uint8_t (*dump_write)(uint8_t *buf, uint16_t len);      /**< dump write function */
+    uint8_t dump_order[SAMPLE_LOG_SECTOR_NUM];              /**< dumped sectors from the oldest */
+    uint8_t dump_num;                                       /**< dumped sector number */
+    uint8_t dump_current;                                   /**< current sector when the dump started */
+    uint32_t dump_end;                                      /**< write offset when the dump started */
+    uint8_t dump_pass;                                      /**< 0 counts the body and 1 sends it */
+    uint8_t dump_header;                                    /**< frame header sent flag */
+    uint8_t dump_index;                                     /**< index of the dumped sector */
+    uint32_t dump_offset;                                   /**< offset in the dumped sector */
+    uint32_t dump_body;                                     /**< body length */
+    uint16_t dump_crc;                                      /**< body crc */
+} sample_log_t;
+
+static sample_log_t gs_log;        /**< sample log handle */
+
+/**
+ * @brief     update the crc16 ccitt
+ * @param[in] crc current crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc
+ * @note      none
+ */
+static uint16_t a_sample_log_crc16(uint16_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    for (i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)buf[i] << 8;
+        for (j = 0; j < 8; j++)
+        {
+            if ((crc & 0x8000) != 0)
+            {
+                crc = (uint16_t)((crc << 1) ^ 0x1021);
+            }
+            else
+            {
+                crc = (uint16_t)(crc << 1);
+            }
+        }
+    }
+    
+    return crc;
+}
+
+/**
+ * @brief     get the sector address
+ * @param[in] sector log sector index
+ * @return    sector address
+ * @note      none
+ */
+static uint32_t a_sample_log_addr(uint8_t sector)
+{
+    return SAMPLE_LOG_BASE_ADDR + (uint32_t)sector * SAMPLE_LOG_SECTOR_SIZE;
+}
+
+/**
+ * @brief     put a little endian u32
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_sample_log_put_u32(uint8_t *buf, uint32_t v)
+{
+    buf[0] = (uint8_t)(v >> 0);
+    buf[1] = (uint8_t)(v >> 8);
+    buf[2] = (uint8_t)(v >> 16);
+    buf[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief     get a little endian u32
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_sample_log_get_u32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * @brief     read the sector header
+ * @param[in] sector log sector index
+ * @return    status code
+ *            - 0 valid
+ *            - 1 invalid
+ * @note      none
+ */
+static uint8_t a_sample_log_read_header(uint8_t sector)
+{
+    uint8_t buf[SAMPLE_LOG_SECTOR_HEADER_SIZE];
+    
+    (void)flash_read(a_sample_log_addr(sector), buf, SAMPLE_LOG_SECTOR_HEADER_SIZE);
+    if (a_sample_log_get_u32(&buf[0]) != SAMPLE_LOG_SECTOR_MAGIC)
+    {
+        return 1;
+    }
+    if (a_sample_log_get_u32(&buf[12]) != a_sample_log_crc16(0xFFFF, buf, 12))
+    {
+        return 1;
+    }
+    gs_log.seq[sector] = a_sample_log_get_u32(&buf[4]);
+    gs_log.erase[sector] = a_sample_log_get_u32(&buf[8]);
+    
+    return 0;
+}
+
+/**
+ * @brief      scan the records of a sector
+ * @param[in]  sector log sector index
+ * @param[out] *records pointer to a valid record number buffer
+ * @param[out] *torn pointer to a torn record number buffer
+ * @return     end offset of the records
+ * @note       a torn record is skipped with its length, a broken length closes the sector
+ */
+static uint32_t a_sample_log_scan(uint8_t sector, uint32_t *records, uint32_t *torn)
+{
+    uint32_t addr;
+    uint32_t offset;
+    const uint8_t *p;
+    uint8_t len;
+    
+    addr = a_sample_log_addr(sector);
+    offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+    while ((offset + SAMPLE_LOG_RECORD_HEADER_SIZE) <= SAMPLE_LOG_SECTOR_SIZE)
+    {
+        p = (const uint8_t *)(addr + offset);
+        len = p[0];
+        
+        /* free space */
+        if (len == SAMPLE_LOG_RECORD_FREE)
+        {
+            break;
+        }
+        
+        /* the length is broken, close the sector */
+        if ((len == 0) || (len > SAMPLE_LOG_MAX_PAYLOAD) ||
+            ((offset + SAMPLE_LOG_RECORD_HEADER_SIZE + len) > SAMPLE_LOG_SECTOR_SIZE))
+        {
+            offset = SAMPLE_LOG_SECTOR_SIZE;
+            
+            break;
+        }
+        
+        /* check the commit flag and the crc */
+        if ((p[3] == SAMPLE_LOG_RECORD_COMMIT) &&
+            (((uint16_t)p[1] | ((uint16_t)p[2] << 8)) == a_sample_log_crc16(0xFFFF, &p[4], len)))
+        {
+            (*records)++;
+        }
+        else
+        {
+            (*torn)++;
+        }
+        offset += SAMPLE_LOG_RECORD_HEADER_SIZE + len;
+    }
+    
+    return offset;
+}
+
+/**
+ * @brief         find the newest boot counter in the records of a sector
+ * @param[in]     sector log sector index
+ * @param[in,out] *boot pointer to a boot counter buffer
+ * @note          only the committed records with the right crc are used
+ */
+static void a_sample_log_find_boot(uint8_t sector, uint32_t *boot)
+{
+    uint32_t records;
+    uint32_t torn;
+    uint32_t offset;
+    uint32_t end;
+    const uint8_t *p;
+    
+    records = 0;
+    torn = 0;
+    end = a_sample_log_scan(sector, &records, &torn);
+    offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+    while ((offset + SAMPLE_LOG_RECORD_HEADER_SIZE) <= end)
+    {
+        p = (const uint8_t *)(a_sample_log_addr(sector) + offset);
+        offset += SAMPLE_LOG_RECORD_HEADER_SIZE + p[0];
+        if (offset > end)
+        {
+            break;
+        }
+        if ((p[3] == SAMPLE_LOG_RECORD_COMMIT) && (p[0] >= 4) &&
+            (((uint16_t)p[1] | ((uint16_t)p[2] << 8)) == a_sample_log_crc16(0xFFFF, &p[4], p[0])) &&
+            (a_sample_log_get_u32(&p[4]) > *boot))
+        {
+            *boot = a_sample_log_get_u32(&p[4]);
+        }
+    }
+}
+
+/**
+ * @brief     check a sector is erased
+ * @param[in] sector log sector index
+ * @return    status code
+ *            - 0 blank
+ *            - 1 not blank
+ * @note      none
+ */
+static uint8_t a_sample_log_check_blank(uint8_t sector)
+{
+    const uint32_t *p;
+    uint32_t i;
+    
+    p = (const uint32_t *)a_sample_log_addr(sector);
+    for (i = 0; i < (SAMPLE_LOG_SECTOR_SIZE / 4); i++)
+    {
+        if (p[i] != 0xFFFFFFFFUL)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     erase a sector
+ * @param[in] sector log sector index
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ * @note      the cpu stalls for about 1 s, the header is written when the sector is opened
+ */
+static uint8_t a_sample_log_erase(uint8_t sector)
+{
+    gs_log.valid[sector] = 0;
+    gs_log.blank[sector] = 0;
+    if (flash_erase_sector(SAMPLE_LOG_FIRST_SECTOR + sector) != 0)
+    {
+        return 1;
+    }
+    
+    /* keep the erase count for wear statistics */
+    gs_log.erase[sector]++;
+    gs_log.blank[sector] = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     write a new header to an erased sector
+ * @param[in] sector log sector index
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+static uint8_t a_sample_log_open(uint8_t sector)
+{
+    uint8_t buf[SAMPLE_LOG_SECTOR_HEADER_SIZE];
+    
+    /* write the header */
+    a_sample_log_put_u32(&buf[0], SAMPLE_LOG_SECTOR_MAGIC);
+    a_sample_log_put_u32(&buf[4], gs_log.next_seq);
+    a_sample_log_put_u32(&buf[8], gs_log.erase[sector]);
+    a_sample_log_put_u32(&buf[12], a_sample_log_crc16(0xFFFF, buf, 12));
+    gs_log.blank[sector] = 0;
+    if (flash_write(a_sample_log_addr(sector), buf, SAMPLE_LOG_SECTOR_HEADER_SIZE) != 0)
+    {
+        return 1;
+    }
+    gs_log.seq[sector] = gs_log.next_seq;
+    gs_log.valid[sector] = 1;
+    gs_log.next_seq++;
+    
+    return 0;
+}
+
+/**
+ * @brief     erase a sector and write a new header
+ * @param[in] sector log sector index
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ * @note      none
+ */
+static uint8_t a_sample_log_format(uint8_t sector)
+{
+    if (a_sample_log_erase(sector) != 0)
+    {
+        return 1;
+    }
+    
+    return a_sample_log_open(sector);
+}
+
+/**
+ * @brief     write one record
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the commit flag is written last, so a power loss leaves a torn record,
+ *            in the realtime mode or during a dump a full log drops the record instead of erasing a sector
+ */
+static uint8_t a_sample_log_write_record(uint8_t *payload, uint8_t len)
+{
+    uint8_t header[SAMPLE_LOG_RECORD_HEADER_SIZE - 1];
+    uint8_t commit;
+    uint8_t next;
+    uint16_t crc;
+    uint32_t addr;
+    
+    /* move to the oldest sector when the current one is full */
+    if ((gs_log.offset + SAMPLE_LOG_RECORD_HEADER_SIZE + len) > SAMPLE_LOG_SECTOR_SIZE)
+    {
+        next = (gs_log.current + 1) % SAMPLE_LOG_SECTOR_NUM;
+        if (gs_log.blank[next] == 0)
+        {
+            if ((gs_log.realtime != 0) || (gs_log.dump_running != 0))
+            {
+                gs_log.dropped++;
+                
+                return 1;
+            }
+            if (a_sample_log_erase(next) != 0)
+            {
+                return 1;
+            }
+        }
+        if (a_sample_log_open(next) != 0)
+        {
+            return 1;
+        }
+        gs_log.current = next;
+        gs_log.offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+    }
+    
+    /* write the length, crc and payload */
+    addr = a_sample_log_addr(gs_log.current) + gs_log.offset;
+    crc = a_sample_log_crc16(0xFFFF, payload, len);
+    header[0] = len;
+    header[1] = (uint8_t)(crc & 0xFF);
+    header[2] = (uint8_t)(crc >> 8);
+    gs_log.offset += SAMPLE_LOG_RECORD_HEADER_SIZE + len;
+    if (flash_write(addr, header, 3) != 0)
+    {
+        return 1;
+    }
+    if (flash_write(addr + SAMPLE_LOG_RECORD_HEADER_SIZE, payload, len) != 0)
+    {
+        return 1;
+    }
+    
+    /* commit */
+    commit = SAMPLE_LOG_RECORD_COMMIT;
+    if (flash_write(addr + 3, &commit, 1) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief         put a zigzag varint
+ * @param[in]     diff signed delta
+ * @param[in,out] *buf pointer to a data buffer
+ * @return        used length
+ * @note          none
+ */
+static uint8_t a_sample_log_put_varint(int32_t diff, uint8_t *buf)
+{
+    uint32_t z;
+    uint8_t i;
+    
+    z = ((uint32_t)diff << 1) ^ (uint32_t)(diff >> 31);
+    i = 0;
+    while (z >= 0x80)
+    {
+        buf[i++] = (uint8_t)(z | 0x80);
+        z >>= 7;
+    }
+    buf[i++] = (uint8_t)z;
+    
+    return i;
+}
+
+/**
+ * @brief  sample log init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the flash is scanned to find the write position and torn records are skipped,
+ *         the boot counter is one more than the newest one in the records
+ */
+uint8_t sample_log_init(void)
+{
+    uint8_t i;
+    uint8_t found;
+    uint32_t records;
+    uint32_t torn;
+    
+    memset(&gs_log, 0, sizeof(sample_log_t));
+    
+    /* find the newest sector and the erased ones */
+    found = 0;
+    for (i = 0; i < SAMPLE_LOG_SECTOR_NUM; i++)
+    {
+        if (a_sample_log_read_header(i) == 0)
+        {
+            gs_log.valid[i] = 1;
+            if ((found == 0) || (gs_log.seq[i] > gs_log.seq[gs_log.current]))
+            {
+                gs_log.current = i;
+            }
+            found = 1;
+        }
+        else if (a_sample_log_check_blank(i) == 0)
+        {
+            gs_log.blank[i] = 1;
+        }
+        else
+        {
+            /* not used */
+        }
+    }
+    
+    if (found == 0)
+    {
+        /* first use */
+        gs_log.current = 0;
+        gs_log.next_seq = 1;
+        if (a_sample_log_format(0) != 0)
+        {
+            return 1;
+        }
+        gs_log.offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+    }
+    else
+    {
+        /* continue after the last record */
+        records = 0;
+        torn = 0;
+        gs_log.next_seq = gs_log.seq[gs_log.current] + 1;
+        gs_log.offset = a_sample_log_scan(gs_log.current, &records, &torn);
+    }
+    
+    /* every record of the log is read once to find the last boot */
+    for (i = 0; i < SAMPLE_LOG_SECTOR_NUM; i++)
+    {
+        if (gs_log.valid[i] != 0)
+        {
+            a_sample_log_find_boot(i, &gs_log.boot);
+        }
+    }
+    gs_log.boot++;
+    gs_log.inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  sample log flush the ram block
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   none
+ */
+uint8_t sample_log_flush(void)
+{
+    uint8_t res;
+    
+    if (gs_log.inited == 0)
+    {
+        return 1;
+    }
+    if (gs_log.block_count == 0)
+    {
+        return 0;
+    }
+    
+    /* write the block */
+    res = a_sample_log_write_record(gs_log.block, (uint8_t)gs_log.block_len);
+    gs_log.block_len = 0;
+    gs_log.block_count = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     sample log append one sample
+ * @param[in] time_s sample time in seconds since the boot
+ * @param[in] co2_eq_ppm co2 eq
+ * @param[in] tvoc_ppb tvoc
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ * @note      samples are delta packed in ram and written as one record when the block is full,
+ *            every record has the boot counter so the times of two boots do not overlap
+ */
+uint8_t sample_log_append(uint32_t time_s, uint16_t co2_eq_ppm, uint16_t tvoc_ppb)
+{
+    if (gs_log.inited == 0)
+    {
+        return 1;
+    }
+    
+    /* a time gap or a full block starts a new block, 6 bytes are the worst case of two deltas */
+    if ((gs_log.block_count != 0) &&
+        ((time_s != (gs_log.last_time + 1)) || ((gs_log.block_len + 6) > SAMPLE_LOG_MAX_PAYLOAD)))
+    {
+        if (sample_log_flush() != 0)
+        {
+            return 1;
+        }
+    }
+    
+    if (gs_log.block_count == 0)
+    {
+        /* block base: boot(4) + time(4) + co2 eq(2) + tvoc(2) */
+        a_sample_log_put_u32(&gs_log.block[0], gs_log.boot);
+        a_sample_log_put_u32(&gs_log.block[4], time_s);
+        gs_log.block[8] = (uint8_t)(co2_eq_ppm & 0xFF);
+        gs_log.block[9] = (uint8_t)(co2_eq_ppm >> 8);
+        gs_log.block[10] = (uint8_t)(tvoc_ppb & 0xFF);
+        gs_log.block[11] = (uint8_t)(tvoc_ppb >> 8);
+        gs_log.block_len = 12;
+    }
+    else
+    {
+        /* zigzag varint deltas, the time is implied by the 1 Hz cadence */
+        gs_log.block_len += a_sample_log_put_varint((int32_t)co2_eq_ppm - (int32_t)gs_log.last_co2,
+                                                    &gs_log.block[gs_log.block_len]);
+        gs_log.block_len += a_sample_log_put_varint((int32_t)tvoc_ppb - (int32_t)gs_log.last_tvoc,
+                                                    &gs_log.block[gs_log.block_len]);
+    }
+    gs_log.block_count++;
+    gs_log.last_time = time_s;
+    gs_log.last_co2 = co2_eq_ppm;
+    gs_log.last_tvoc = tvoc_ppb;
+    
+    return 0;
+}
+
+/**
+ * @brief  sample log erase all sectors
+ * @return status code
+ *         - 0 success
+ *         - 1 erase failed
+ * @note   it is refused in the realtime mode and during a dump, because it stalls the cpu for seconds
+ */
+uint8_t sample_log_erase(void)
+{
+    uint8_t i;
+    
+    if ((gs_log.inited == 0) || (gs_log.realtime != 0) || (gs_log.dump_running != 0))
+    {
+        return 1;
+    }
+    
+    /* drop the ram block */
+    gs_log.block_len = 0;
+    gs_log.block_count = 0;
+    gs_log.dropped = 0;
+    
+    /* erase all sectors and restart from the first one, the others stay blank */
+    for (i = 0; i < SAMPLE_LOG_SECTOR_NUM; i++)
+    {
+        if (a_sample_log_erase(i) != 0)
+        {
+            return 1;
+        }
+    }
+    if (a_sample_log_open(0) != 0)
+    {
+        return 1;
+    }
+    gs_log.current = 0;
+    gs_log.offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+    
+    return 0;
+}
+
+/**
+ * @brief     sample log set the realtime mode
+ * @param[in] enable realtime enable
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      enabling it erases the sector after the current one once if it is not blank,
+ *            after that the log moves into the blank sector without an erase and drops the records
+ *            when no blank sector is left, so the cpu never stalls for an erase while it is enabled
+ */
+uint8_t sample_log_set_realtime(uint8_t enable)
+{
+    uint8_t next;
+    
+    if (gs_log.inited == 0)
+    {
+        return 1;
+    }
+    
+    /* prepare a blank sector before the realtime work starts */
+    if ((enable != 0) && (gs_log.realtime == 0))
+    {
+        next = (gs_log.current + 1) % SAMPLE_LOG_SECTOR_NUM;
+        if ((gs_log.blank[next] == 0) && (gs_log.dump_running == 0))
+        {
+            if (a_sample_log_erase(next) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    gs_log.realtime = (enable != 0) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      sample log get the information
+ * @param[out] *info pointer to an information structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t sample_log_info(sample_log_info_t *info)
+{
+    uint8_t i;
+    
+    memset(info, 0, sizeof(sample_log_info_t));
+    info->size = SAMPLE_LOG_SECTOR_NUM * (SAMPLE_LOG_SECTOR_SIZE - SAMPLE_LOG_SECTOR_HEADER_SIZE);
+    info->pending = gs_log.block_count;
+    info->boot = gs_log.boot;
+    info->dropped = gs_log.dropped;
+    for (i = 0; i < SAMPLE_LOG_SECTOR_NUM; i++)
+    {
+        info->erase_count[i] = gs_log.erase[i];
+        if (gs_log.valid[i] != 0)
+        {
+            info->used += a_sample_log_scan(i, &info->records, &info->torn) - SAMPLE_LOG_SECTOR_HEADER_SIZE;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      find the next committed record of the dump
+ * @param[out] **record pointer to a record address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no record is left
+ * @note       the current sector is only read up to the write offset of the dump start,
+ *             so both passes see the same records while the log is still written
+ */
+static uint8_t a_sample_log_dump_next(const uint8_t **record)
+{
+    uint8_t sector;
+    uint32_t limit;
+    const uint8_t *p;
+    
+    while (gs_log.dump_index < gs_log.dump_num)
+    {
+        sector = gs_log.dump_order[gs_log.dump_index];
+        limit = (sector == gs_log.dump_current) ? gs_log.dump_end : SAMPLE_LOG_SECTOR_SIZE;
+        p = (const uint8_t *)(a_sample_log_addr(sector) + gs_log.dump_offset);
+        
+        /* free space or a broken length closes the sector */
+        if (((gs_log.dump_offset + SAMPLE_LOG_RECORD_HEADER_SIZE) > limit) ||
+            (p[0] == SAMPLE_LOG_RECORD_FREE) || (p[0] == 0) || (p[0] > SAMPLE_LOG_MAX_PAYLOAD) ||
+            ((gs_log.dump_offset + SAMPLE_LOG_RECORD_HEADER_SIZE + p[0]) > limit))
+        {
+            gs_log.dump_index++;
+            gs_log.dump_offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+            
+            continue;
+        }
+        
+        /* only send the committed records with the right crc */
+        if ((p[3] != SAMPLE_LOG_RECORD_COMMIT) ||
+            (((uint16_t)p[1] | ((uint16_t)p[2] << 8)) != a_sample_log_crc16(0xFFFF, &p[4], p[0])))
+        {
+            gs_log.dump_offset += SAMPLE_LOG_RECORD_HEADER_SIZE + p[0];
+            
+            continue;
+        }
+        *record = p;
+        
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     sample log start a binary dump
+ * @param[in] *write pointer to a write function
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the frame is sent by sample_log_dump_step
+ */
+uint8_t sample_log_dump_start(uint8_t (*write)(uint8_t *buf, uint16_t len))
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t t;
+    
+    if ((gs_log.inited == 0) || (gs_log.dump_running != 0))
+    {
+        return 1;
+    }
+    
+    /* write the ram block first, a dropped block is counted and the records in flash are still sent */
+    (void)sample_log_flush();
+    
+    /* sort the valid sectors from the oldest to the newest */
+    gs_log.dump_num = 0;
+    for (i = 0; i < SAMPLE_LOG_SECTOR_NUM; i++)
+    {
+        if (gs_log.valid[i] != 0)
+        {
+            gs_log.dump_order[gs_log.dump_num++] = i;
+        }
+    }
+    for (i = 1; i < gs_log.dump_num; i++)
+    {
+        for (j = i; (j > 0) && (gs_log.seq[gs_log.dump_order[j - 1]] > gs_log.seq[gs_log.dump_order[j]]); j--)
+        {
+            t = gs_log.dump_order[j];
+            gs_log.dump_order[j] = gs_log.dump_order[j - 1];
+            gs_log.dump_order[j - 1] = t;
+        }
+    }
+    
+    /* the first pass counts the body length and the second pass sends it */
+    gs_log.dump_write = write;
+    gs_log.dump_current = gs_log.current;
+    gs_log.dump_end = gs_log.offset;
+    gs_log.dump_pass = 0;
+    gs_log.dump_header = 0;
+    gs_log.dump_index = 0;
+    gs_log.dump_offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+    gs_log.dump_body = 0;
+    gs_log.dump_crc = 0xFFFF;
+    gs_log.dump_running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  sample log run one step of the binary dump
+ * @return status code
+ *         - 0 success, the frame is sent
+ *         - 1 dump failed
+ *         - 2 more steps are needed
+ * @note   one step reads or sends at most one chunk of 256 bytes, so a caller can run the other
+ *         work between two steps
+ */
+uint8_t sample_log_dump_step(void)
+{
+    uint8_t chunk[SAMPLE_LOG_DUMP_CHUNK];
+    uint16_t chunk_len;
+    uint32_t read;
+    const uint8_t *p;
+    
+    if (gs_log.dump_running == 0)
+    {
+        return 1;
+    }
+    
+    if (gs_log.dump_pass == 0)
+    {
+        /* count one chunk of records */
+        read = 0;
+        while (read < SAMPLE_LOG_DUMP_CHUNK)
+        {
+            if (a_sample_log_dump_next(&p) != 0)
+            {
+                gs_log.dump_pass = 1;
+                gs_log.dump_index = 0;
+                gs_log.dump_offset = SAMPLE_LOG_SECTOR_HEADER_SIZE;
+                
+                return 2;
+            }
+            gs_log.dump_body += 1 + p[0];
+            gs_log.dump_offset += SAMPLE_LOG_RECORD_HEADER_SIZE + p[0];
+            read += 1 + p[0];
+        }
+        
+        return 2;
+    }
+    
+    /* the frame starts with the header */
+    chunk_len = 0;
+    if (gs_log.dump_header == 0)
+    {
+        a_sample_log_put_u32(&chunk[0], SAMPLE_LOG_DUMP_MAGIC);
+        a_sample_log_put_u32(&chunk[4], gs_log.dump_body);
+        chunk_len = 8;
+        gs_log.dump_header = 1;
+    }
+    
+    /* fill one chunk with the records */
+    while (a_sample_log_dump_next(&p) == 0)
+    {
+        if ((chunk_len + 1 + p[0]) > SAMPLE_LOG_DUMP_CHUNK)
+        {
+            gs_log.dump_running = (gs_log.dump_write(chunk, chunk_len) != 0) ? 0 : 1;
+            
+            return (gs_log.dump_running != 0) ? 2 : 1;
+        }
+        chunk[chunk_len] = p[0];
+        memcpy(&chunk[chunk_len + 1], &p[4], p[0]);
+        gs_log.dump_crc = a_sample_log_crc16(gs_log.dump_crc, &chunk[chunk_len], 1 + p[0]);
+        chunk_len += 1 + p[0];
+        gs_log.dump_offset += SAMPLE_LOG_RECORD_HEADER_SIZE + p[0];
+    }
+    
+    /* the crc goes into the next chunk when this one is full */
+    if ((chunk_len + 2) > SAMPLE_LOG_DUMP_CHUNK)
+    {
+        gs_log.dump_running = (gs_log.dump_write(chunk, chunk_len) != 0) ? 0 : 1;
+        
+        return (gs_log.dump_running != 0) ? 2 : 1;
+    }
+    chunk[chunk_len++] = (uint8_t)(gs_log.dump_crc & 0xFF);
+    chunk[chunk_len++] = (uint8_t)(gs_log.dump_crc >> 8);
+    gs_log.dump_running = 0;
+    if (gs_log.dump_write(chunk, chunk_len) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sample log dump all records in binary
+ * @param[in] *write pointer to a write function
+ * @return    status code
+ *            - 0 success
+ *            - 1 dump failed
+ * @note      the frame is magic(4) + length(4) + records + crc16(2) in little endian,
+ *            every record is length(1) + payload and records are sent from the oldest to the newest,
+ *            a payload is boot(4) + time(4) + co2 eq(2) + tvoc(2) followed by the deltas,
+ *            the host orders the samples by the boot and then by the time,
+ *            it blocks until the whole frame is sent, a scheduler task runs the steps instead
+ */
+uint8_t sample_log_dump(uint8_t (*write)(uint8_t *buf, uint16_t len))
+{
+    uint8_t res;
+    
+    if (sample_log_dump_start(write) != 0)
+    {
+        return 1;
+    }
+    do
+    {
+        res = sample_log_dump_step();
+    } while (res == 2);
+    
+    return res;
+}
@@ -0,0 +1,326 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scheduler.c
+ * @brief     scheduler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "scheduler.h"
+#include "stm32f4xx_hal.h"
+
+/**
+ * @brief scheduler structure definition
+ */
+typedef struct scheduler_s
+{
+    scheduler_task_t task[SCHEDULER_MAX_TASK];              /**< task buffer */
+    uint8_t task_num;                                       /**< task number */
+    scheduler_timer_t timer[SCHEDULER_MAX_TIMER];           /**< timer buffer */
+    scheduler_event_t queue[SCHEDULER_MAX_EVENT];           /**< event queue */
+    volatile uint8_t head;                                  /**< queue head */
+    volatile uint8_t tail;                                  /**< queue tail */
+    volatile uint8_t count;                                 /**< queue count */
+    scheduler_stats_t stats;                                /**< statistics */
+} scheduler_t;
+
+static scheduler_t gs_scheduler;        /**< scheduler handle */
+
+/**
+ * @brief  scheduler init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t scheduler_init(void)
+{
+    /* clear all */
+    memset(&gs_scheduler, 0, sizeof(scheduler_t));
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler register a task
+ * @param[in]  *name pointer to a name buffer
+ * @param[in]  *handler pointer to an event handler
+ * @param[out] *id pointer to a task id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 task buffer is full
+ * @note       every handler must run to completion and never block for long
+ */
+uint8_t scheduler_task_register(char *name, void (*handler)(uint8_t event), uint8_t *id)
+{
+    /* check the task number */
+    if (gs_scheduler.task_num >= SCHEDULER_MAX_TASK)
+    {
+        return 1;
+    }
+    
+    /* save the task */
+    memset(gs_scheduler.task[gs_scheduler.task_num].name, 0, sizeof(char) * 16);
+    strncpy(gs_scheduler.task[gs_scheduler.task_num].name, name, 15);
+    gs_scheduler.task[gs_scheduler.task_num].handler = handler;
+    *id = gs_scheduler.task_num;
+    gs_scheduler.task_num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     scheduler post an event to a task
+ * @param[in] task task id
+ * @param[in] event posted event
+ * @return    status code
+ *            - 0 success
+ *            - 1 event queue is full
+ *            - 2 task is invalid
+ * @note      this function can be called in the irq handler
+ */
+uint8_t scheduler_post(uint8_t task, uint8_t event)
+{
+    uint32_t primask;
+    
+    /* check the task */
+    if (task >= gs_scheduler.task_num)
+    {
+        return 2;
+    }
+    
+    /* enter the critical section */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    /* check the queue */
+    if (gs_scheduler.count >= SCHEDULER_MAX_EVENT)
+    {
+        gs_scheduler.stats.dropped++;
+        __set_PRIMASK(primask);
+        
+        return 1;
+    }
+    
+    /* push the event */
+    gs_scheduler.queue[gs_scheduler.tail].task = task;
+    gs_scheduler.queue[gs_scheduler.tail].event = event;
+    gs_scheduler.tail = (gs_scheduler.tail + 1) % SCHEDULER_MAX_EVENT;
+    gs_scheduler.count++;
+    
+    /* exit the critical section */
+    __set_PRIMASK(primask);
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler start a timer
+ * @param[in]  task task id
+ * @param[in]  event posted event when the timer expires
+ * @param[in]  delay_ms first expiration time in ms
+ * @param[in]  period_ms period in ms, 0 means one shot
+ * @param[out] *timer pointer to a timer id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 timer buffer is full
+ *             - 2 task is invalid
+ * @note       periodic timers use absolute deadlines, so the period never drifts
+ */
+uint8_t scheduler_timer_start(uint8_t task, uint8_t event, uint32_t delay_ms, uint32_t period_ms, uint8_t *timer)
+{
+    uint8_t i;
+    
+    /* check the task */
+    if (task >= gs_scheduler.task_num)
+    {
+        return 2;
+    }
+    
+    /* find a free timer */
+    for (i = 0; i < SCHEDULER_MAX_TIMER; i++)
+    {
+        if (gs_scheduler.timer[i].used == 0)
+        {
+            gs_scheduler.timer[i].task = task;
+            gs_scheduler.timer[i].event = event;
+            gs_scheduler.timer[i].deadline = HAL_GetTick() + delay_ms;
+            gs_scheduler.timer[i].period = period_ms;
+            gs_scheduler.timer[i].used = 1;
+            *timer = i;
+            
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     scheduler stop a timer
+ * @param[in] timer timer id
+ * @return    status code
+ *            - 0 success
+ *            - 1 timer is invalid
+ * @note      none
+ */
+uint8_t scheduler_timer_stop(uint8_t timer)
+{
+    /* check the timer */
+    if (timer >= SCHEDULER_MAX_TIMER)
+    {
+        return 1;
+    }
+    
+    /* free the timer */
+    gs_scheduler.timer[timer].used = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief scheduler check all timers
+ * @note  none
+ */
+static void a_scheduler_check_timer(void)
+{
+    uint8_t i;
+    uint32_t now;
+    uint32_t late;
+    
+    now = HAL_GetTick();
+    for (i = 0; i < SCHEDULER_MAX_TIMER; i++)
+    {
+        /* check the deadline with the wrap */
+        if ((gs_scheduler.timer[i].used != 0) && ((int32_t)(now - gs_scheduler.timer[i].deadline) >= 0))
+        {
+            /* save the lateness */
+            late = now - gs_scheduler.timer[i].deadline;
+            if (late > gs_scheduler.stats.late_max)
+            {
+                gs_scheduler.stats.late_max = late;
+            }
+            
+            /* post the event */
+            (void)scheduler_post(gs_scheduler.timer[i].task, gs_scheduler.timer[i].event);
+            
+            /* one shot or periodic */
+            if (gs_scheduler.timer[i].period == 0)
+            {
+                gs_scheduler.timer[i].used = 0;
+            }
+            else
+            {
+                /* keep the absolute deadline and skip the missed periods */
+                gs_scheduler.timer[i].deadline += gs_scheduler.timer[i].period;
+                while ((int32_t)(now - gs_scheduler.timer[i].deadline) >= 0)
+                {
+                    gs_scheduler.timer[i].deadline += gs_scheduler.timer[i].period;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief  scheduler run once
+ * @return dispatched event number
+ * @note   this function checks all timers and dispatches all pending events
+ */
+uint16_t scheduler_run_once(void)
+{
+    uint16_t num;
+    uint32_t primask;
+    uint32_t start;
+    uint32_t run;
+    scheduler_event_t e;
+    
+    /* check the timers */
+    a_scheduler_check_timer();
+    
+    /* dispatch the events */
+    num = 0;
+    while (gs_scheduler.count != 0)
+    {
+        /* pop one event */
+        primask = __get_PRIMASK();
+        __disable_irq();
+        e = gs_scheduler.queue[gs_scheduler.head];
+        gs_scheduler.head = (gs_scheduler.head + 1) % SCHEDULER_MAX_EVENT;
+        gs_scheduler.count--;
+        __set_PRIMASK(primask);
+        
+        /* run to completion */
+        start = HAL_GetTick();
+        if (gs_scheduler.task[e.task].handler != NULL)
+        {
+            gs_scheduler.task[e.task].handler(e.event);
+        }
+        run = HAL_GetTick() - start;
+        if (run > gs_scheduler.stats.run_max)
+        {
+            gs_scheduler.stats.run_max = run;
+        }
+        gs_scheduler.stats.dispatched++;
+        num++;
+        
+        /* a handler may wait long enough to hit the next deadline */
+        a_scheduler_check_timer();
+    }
+    
+    return num;
+}
+
+/**
+ * @brief scheduler run forever
+ * @note  the cpu sleeps until the next interrupt when no event is pending
+ */
+void scheduler_run(void)
+{
+    while (1)
+    {
+        /* sleep until the systick or another irq wakes up the cpu */
+        if (scheduler_run_once() == 0)
+        {
+            __WFI();
+        }
+    }
+}
+
+/**
+ * @brief      scheduler get the statistics
+ * @param[out] *stats pointer to a stats structure
+ * @note       none
+ */
+void scheduler_get_stats(scheduler_stats_t *stats)
+{
+    /* copy the stats */
+    memcpy(stats, &gs_scheduler.stats, sizeof(scheduler_stats_t));
+}
@@ -0,0 +1,617 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      sgp30_task.c
+ * @brief     sgp30 task source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sgp30_task.h"
+#include "scheduler.h"
+#include "sample_log.h"
+#include "stm32f4xx_hal.h"
+#include <stdarg.h>
+
+/**
+ * @brief sgp30 task period definition
+ */
+#define SGP30_TASK_PERIOD_MS        1000        /**< measure iaq must be called at 1 Hz */
+#define SGP30_TASK_BASELINE_TIMES   3600        /**< save the baseline every hour */
+
+/**
+ * @brief sgp30 task recovery definition
+ */
+#define SGP30_TASK_RETRY_TIMES      3           /**< probe retry times */
+#define SGP30_TASK_RETRY_MS         10          /**< probe retry interval */
+#define SGP30_TASK_SOFT_RESET_MS    10          /**< soft reset time */
+#define SGP30_TASK_POWER_OFF_MS     200         /**< power off time */
+#define SGP30_TASK_POWER_ON_MS      10          /**< power up time */
+
+static sgp30_handle_t gs_handle;                /**< sgp30 handle */
+static volatile sgp30_task_state_t gs_state;    /**< task state */
+static uint8_t gs_task;                         /**< task id */
+static uint8_t gs_timer;                        /**< period timer id */
+static uint32_t gs_times;                       /**< measurement times */
+static uint32_t gs_count;                       /**< measurement count */
+static uint32_t gs_overrun;                     /**< overrun count */
+static uint32_t gs_start_s;                     /**< start time in seconds */
+static uint32_t gs_start_ms;                    /**< start tick in ms */
+static uint32_t gs_stamp;                       /**< time of the running conversion in seconds */
+static uint16_t gs_tvoc_baseline;               /**< saved tvoc baseline */
+static uint16_t gs_co2_eq_baseline;             /**< saved co2 eq baseline */
+static uint32_t gs_recovery;                    /**< recovery count */
+static uint8_t gs_retry;                        /**< recovery probe count */
+static uint32_t gs_recover_ms;                  /**< recovery start tick in ms */
+static uint8_t gs_quiet;                        /**< quiet flag */
+
+/**
+ * @brief     task print the output
+ * @param[in] fmt format data
+ * @note      nothing is printed in the quiet mode, so a binary dump on the same port stays intact
+ */
+static void a_sgp30_task_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    if (gs_quiet != 0)
+    {
+        return;
+    }
+    memset((char *)str, 0, sizeof(char) * 256);
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    sgp30_interface_debug_print("%s", str);
+}
+
+/**
+ * @brief task stop the period timer and close the chip
+ * @note  none
+ */
+static void a_sgp30_task_close(void)
+{
+    /* stop the timer */
+    (void)scheduler_timer_stop(gs_timer);
+    
+    /* never leave the chip off in the middle of a power cycle */
+    if (gs_state == SGP30_TASK_STATE_POWER_OFF)
+    {
+        (void)gs_handle.power_set(1);
+    }
+    
+    /* save the samples left in ram and allow the erases again */
+    (void)sample_log_flush();
+    (void)sample_log_set_realtime(0);
+    
+    /* close the chip */
+    (void)sgp30_deinit(&gs_handle);
+    gs_state = SGP30_TASK_STATE_STOP;
+}
+
+/**
+ * @brief     task wait for the next recovery step
+ * @param[in] state next state
+ * @param[in] ms wait time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      none
+ */
+static uint8_t a_sgp30_task_recover_wait(sgp30_task_state_t state, uint32_t ms)
+{
+    uint8_t timer;
+    
+    /* the step runs from the scheduler, so the other tasks keep running */
+    if (scheduler_timer_start(gs_task, SGP30_TASK_EVENT_RECOVER, ms, 0, &timer) != 0)
+    {
+        a_sgp30_task_print("sgp30: start timer failed.\n");
+        
+        return 1;
+    }
+    gs_state = state;
+    
+    return 0;
+}
+
+/**
+ * @brief  task restart the iaq algorithm and restore the saved baseline
+ * @return status code
+ *         - 0 success
+ *         - 1 restart failed
+ * @note   none
+ */
+static uint8_t a_sgp30_task_restart(void)
+{
+    uint16_t id[3];
+    
+    /* check the chip answers */
+    if (sgp30_get_serial_id(&gs_handle, id) != 0)
+    {
+        return 1;
+    }
+    
+    /* restart the iaq algorithm */
+    if (sgp30_iaq_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* restore the baseline */
+    if ((gs_tvoc_baseline != 0) && (gs_co2_eq_baseline != 0))
+    {
+        if (sgp30_set_iaq_baseline(&gs_handle, gs_tvoc_baseline, gs_co2_eq_baseline) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     task finish the recovery
+ * @param[in] level recovery level
+ * @note      the measurement goes on at the next period
+ */
+static void a_sgp30_task_recover_done(sgp30_recovery_level_t level)
+{
+    const char *name[4] = {"none", "retry", "soft reset", "power cycle"};
+    
+    gs_recovery++;
+    gs_state = SGP30_TASK_STATE_IDLE;
+    a_sgp30_task_print("sgp30: recovered by %s in %d ms.\n", name[level], HAL_GetTick() - gs_recover_ms);
+}
+
+/**
+ * @brief task give up the recovery
+ * @note  none
+ */
+static void a_sgp30_task_recover_fail(void)
+{
+    a_sgp30_task_print("sgp30: recover failed after %d ms.\n", HAL_GetTick() - gs_recover_ms);
+    a_sgp30_task_close();
+}
+
+/**
+ * @brief task power off the chip
+ * @note  the recovery fails if no power switch is linked
+ */
+static void a_sgp30_task_power_off(void)
+{
+    if (gs_handle.power_set == NULL)
+    {
+        a_sgp30_task_print("sgp30: power_set is null.\n");
+        a_sgp30_task_recover_fail();
+        
+        return;
+    }
+    if (gs_handle.power_set(0) != 0)
+    {
+        a_sgp30_task_print("sgp30: power off failed.\n");
+        a_sgp30_task_recover_fail();
+        
+        return;
+    }
+    if (a_sgp30_task_recover_wait(SGP30_TASK_STATE_POWER_OFF, SGP30_TASK_POWER_OFF_MS) != 0)
+    {
+        (void)gs_handle.power_set(1);
+        a_sgp30_task_close();
+    }
+}
+
+/**
+ * @brief task start the recovery after a failure
+ * @note  the chip is retried, soft reset and power cycled in order like sgp30_recover,
+ *        but every wait is a scheduler timer, so the handler never blocks
+ */
+static void a_sgp30_task_recover(void)
+{
+    gs_retry = 0;
+    gs_recover_ms = HAL_GetTick();
+    gs_state = SGP30_TASK_STATE_RETRY;
+    if (scheduler_post(gs_task, SGP30_TASK_EVENT_RECOVER) != 0)
+    {
+        a_sgp30_task_recover_fail();
+    }
+}
+
+/**
+ * @brief task run the next recovery step
+ * @note  none
+ */
+static void a_sgp30_task_recover_step(void)
+{
+    uint16_t id[3];
+    
+    if (gs_state == SGP30_TASK_STATE_RETRY)
+    {
+        /* check the chip answers */
+        if (sgp30_get_serial_id(&gs_handle, id) == 0)
+        {
+            a_sgp30_task_recover_done(SGP30_RECOVERY_LEVEL_RETRY);
+            
+            return;
+        }
+        gs_retry++;
+        if (gs_retry < SGP30_TASK_RETRY_TIMES)
+        {
+            if (a_sgp30_task_recover_wait(SGP30_TASK_STATE_RETRY, SGP30_TASK_RETRY_MS) != 0)
+            {
+                a_sgp30_task_close();
+            }
+            
+            return;
+        }
+        
+        /* soft reset */
+        if (sgp30_soft_reset(&gs_handle) == 0)
+        {
+            if (a_sgp30_task_recover_wait(SGP30_TASK_STATE_SOFT_RESET, SGP30_TASK_SOFT_RESET_MS) != 0)
+            {
+                a_sgp30_task_close();
+            }
+            
+            return;
+        }
+        a_sgp30_task_power_off();
+    }
+    else if (gs_state == SGP30_TASK_STATE_SOFT_RESET)
+    {
+        /* restart after the soft reset */
+        if (a_sgp30_task_restart() == 0)
+        {
+            a_sgp30_task_recover_done(SGP30_RECOVERY_LEVEL_SOFT_RESET);
+            
+            return;
+        }
+        a_sgp30_task_power_off();
+    }
+    else if (gs_state == SGP30_TASK_STATE_POWER_OFF)
+    {
+        /* power on */
+        if (gs_handle.power_set(1) != 0)
+        {
+            a_sgp30_task_print("sgp30: power on failed.\n");
+            a_sgp30_task_recover_fail();
+            
+            return;
+        }
+        if (a_sgp30_task_recover_wait(SGP30_TASK_STATE_POWER_ON, SGP30_TASK_POWER_ON_MS) != 0)
+        {
+            a_sgp30_task_close();
+        }
+    }
+    else if (gs_state == SGP30_TASK_STATE_POWER_ON)
+    {
+        /* restart after the power cycle */
+        if (a_sgp30_task_restart() == 0)
+        {
+            a_sgp30_task_recover_done(SGP30_RECOVERY_LEVEL_POWER_CYCLE);
+            
+            return;
+        }
+        a_sgp30_task_print("sgp30: restart after power cycle failed.\n");
+        a_sgp30_task_recover_fail();
+    }
+    else
+    {
+        /* a stale step of a stopped recovery */
+    }
+}
+
+/**
+ * @brief     task event handler
+ * @param[in] event task event
+ * @note      none
+ */
+static void a_sgp30_task_handler(uint8_t event)
+{
+    uint8_t res;
+    uint8_t timer;
+    uint16_t co2_eq_ppm;
+    uint16_t tvoc_ppb;
+    
+    if (gs_state == SGP30_TASK_STATE_STOP)
+    {
+        return;
+    }
+    
+    if (event == SGP30_TASK_EVENT_PERIOD)
+    {
+        /* the recovery is running, skip this period */
+        if (gs_state >= SGP30_TASK_STATE_RETRY)
+        {
+            return;
+        }
+        
+        /* the previous conversion is still running */
+        if (gs_state != SGP30_TASK_STATE_IDLE)
+        {
+            gs_overrun++;
+            
+            return;
+        }
+        
+        /* stamp the sample with its deadline, a late dispatch or a skipped period never shifts the time */
+        gs_stamp = gs_start_s + (HAL_GetTick() - gs_start_ms + SGP30_TASK_PERIOD_MS / 2) / SGP30_TASK_PERIOD_MS;
+        
+        /* send the command */
+        res = sgp30_start_measure_iaq(&gs_handle);
+        if (res != 0)
+        {
+            a_sgp30_task_print("sgp30: start measure iaq failed.\n");
+            
+            /* skip this period and recover the chip in the background */
+            a_sgp30_task_recover();
+            
+            return;
+        }
+        
+        /* wait the conversion without blocking */
+        res = scheduler_timer_start(gs_task, SGP30_TASK_EVENT_FETCH, SGP30_MEASURE_IAQ_TIME_MS, 0, &timer);
+        if (res != 0)
+        {
+            a_sgp30_task_print("sgp30: start timer failed.\n");
+            a_sgp30_task_close();
+            
+            return;
+        }
+        gs_state = SGP30_TASK_STATE_CONVERTING;
+    }
+    else if (event == SGP30_TASK_EVENT_FETCH)
+    {
+        /* a stale fetch of a stopped conversion */
+        if (gs_state != SGP30_TASK_STATE_CONVERTING)
+        {
+            return;
+        }
+        
+        /* get the result */
+        gs_state = SGP30_TASK_STATE_IDLE;
+        res = sgp30_get_measure_iaq_result(&gs_handle, &co2_eq_ppm, &tvoc_ppb);
+        if (res != 0)
+        {
+            a_sgp30_task_print("sgp30: get measure iaq result failed.\n");
+            
+            /* skip this sample and recover the chip in the background */
+            a_sgp30_task_recover();
+            
+            return;
+        }
+        gs_count++;
+        
+        /* save the baseline for the recovery */
+        if ((gs_count % SGP30_TASK_BASELINE_TIMES) == 0)
+        {
+            if (sgp30_get_iaq_baseline(&gs_handle, &gs_tvoc_baseline, &gs_co2_eq_baseline) != 0)
+            {
+                a_sgp30_task_print("sgp30: get iaq baseline failed.\n");
+            }
+        }
+        
+        /* log the sample */
+        if (sample_log_append(gs_stamp, co2_eq_ppm, tvoc_ppb) != 0)
+        {
+            a_sgp30_task_print("sgp30: log append failed.\n");
+        }
+        
+        /* output */
+        if (gs_times != 0)
+        {
+            a_sgp30_task_print("sgp30: %d/%d.\n", gs_count, gs_times);
+        }
+        else
+        {
+            a_sgp30_task_print("sgp30: %d.\n", gs_count);
+        }
+        a_sgp30_task_print("sgp30: co2 eq is %d ppm.\n", co2_eq_ppm);
+        a_sgp30_task_print("sgp30: tvoc is %d ppb.\n", tvoc_ppb);
+        
+        /* check the times */
+        if ((gs_times != 0) && (gs_count >= gs_times))
+        {
+            if (gs_overrun != 0)
+            {
+                a_sgp30_task_print("sgp30: %d periods overrun.\n", gs_overrun);
+            }
+            if (gs_recovery != 0)
+            {
+                a_sgp30_task_print("sgp30: %d recoveries.\n", gs_recovery);
+            }
+            a_sgp30_task_close();
+        }
+    }
+    else if (event == SGP30_TASK_EVENT_RECOVER)
+    {
+        a_sgp30_task_recover_step();
+    }
+    else
+    {
+        /* unknown event */
+    }
+}
+
+/**
+ * @brief  task init and register the task to the scheduler
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   scheduler_init must be called before
+ */
+uint8_t sgp30_task_init(void)
+{
+    gs_state = SGP30_TASK_STATE_STOP;
+    
+    /* register the task */
+    if (scheduler_task_register("sgp30", a_sgp30_task_handler, &gs_task) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     task start the 1 Hz measurement
+ * @param[in] times measurement times, 0 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the results are printed in the background and appended to the sample log,
+ *            the sample time is the uptime in seconds and the log adds the boot counter to it
+ */
+uint8_t sgp30_task_start(uint32_t times)
+{
+    uint8_t res;
+    
+    /* check the state */
+    if (gs_state != SGP30_TASK_STATE_STOP)
+    {
+        a_sgp30_task_print("sgp30: task is running.\n");
+        
+        return 1;
+    }
+    
+    /* link functions */
+    DRIVER_SGP30_LINK_INIT(&gs_handle, sgp30_handle_t);
+    DRIVER_SGP30_LINK_IIC_INIT(&gs_handle, sgp30_interface_iic_init);
+    DRIVER_SGP30_LINK_IIC_DEINIT(&gs_handle, sgp30_interface_iic_deinit);
+    DRIVER_SGP30_LINK_IIC_WRITE_COMMAND(&gs_handle, sgp30_interface_iic_write_cmd);
+    DRIVER_SGP30_LINK_IIC_READ_COMMAND(&gs_handle, sgp30_interface_iic_read_cmd);
+    DRIVER_SGP30_LINK_DELAY_MS(&gs_handle, sgp30_interface_delay_ms);
+    DRIVER_SGP30_LINK_DEBUG_PRINT(&gs_handle, a_sgp30_task_print);
+    DRIVER_SGP30_LINK_POWER_SET(&gs_handle, sgp30_interface_power_set);
+    
+    /* sgp30 init */
+    res = sgp30_init(&gs_handle);
+    if (res != 0)
+    {
+        a_sgp30_task_print("sgp30: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* soft reset */
+    res = sgp30_soft_reset(&gs_handle);
+    if (res != 0)
+    {
+        a_sgp30_task_print("sgp30: soft reset failed.\n");
+        (void)sgp30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* wait 100 ms once at the start */
+    sgp30_interface_delay_ms(100);
+    
+    /* iaq init */
+    res = sgp30_iaq_init(&gs_handle);
+    if (res != 0)
+    {
+        a_sgp30_task_print("sgp30: iaq init failed.\n");
+        (void)sgp30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* no flash erase may stall the 1 Hz cadence */
+    if (sample_log_set_realtime(1) != 0)
+    {
+        a_sgp30_task_print("sgp30: log realtime mode failed.\n");
+    }
+    
+    /* start the 1 Hz timer */
+    gs_times = times;
+    gs_count = 0;
+    gs_overrun = 0;
+    gs_recovery = 0;
+    gs_tvoc_baseline = 0;
+    gs_co2_eq_baseline = 0;
+    gs_start_ms = HAL_GetTick();
+    gs_start_s = gs_start_ms / 1000;
+    gs_state = SGP30_TASK_STATE_IDLE;
+    res = scheduler_timer_start(gs_task, SGP30_TASK_EVENT_PERIOD, SGP30_TASK_PERIOD_MS, SGP30_TASK_PERIOD_MS, &gs_timer);
+    if (res != 0)
+    {
+        a_sgp30_task_print("sgp30: start timer failed.\n");
+        (void)sample_log_set_realtime(0);
+        (void)sgp30_deinit(&gs_handle);
+        gs_state = SGP30_TASK_STATE_STOP;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  task stop the measurement
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t sgp30_task_stop(void)
+{
+    /* check the state */
+    if (gs_state == SGP30_TASK_STATE_STOP)
+    {
+        return 1;
+    }
+    
+    /* close the task */
+    a_sgp30_task_close();
+    
+    return 0;
+}
+
+/**
+ * @brief  task get the running status
+ * @return status code
+ *         - 0 stopped
+ *         - 1 running
+ * @note   none
+ */
+uint8_t sgp30_task_is_running(void)
+{
+    return (gs_state != SGP30_TASK_STATE_STOP) ? 1 : 0;
+}
+
+/**
+ * @brief     task set the quiet mode
+ * @param[in] enable quiet enable
+ * @note      the measurement keeps running and only the output is dropped
+ */
+void sgp30_task_set_quiet(uint8_t enable)
+{
+    gs_quiet = (enable != 0) ? 1 : 0;
+}
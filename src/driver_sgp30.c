@@ -71,12 +71,81 @@
 #define SGP30_COMMAND_SOFT_RESET                         0x0006U        /**< soft reset command */
 #define SGP30_COMMAND_GET_SERIAL_ID                      0x3682U        /**< get serial id command */
 
+/**
+ * @brief chip recovery definition
+ */
+#define SGP30_RECOVERY_RETRY_TIMES       3              /**< probe retry times */
+#define SGP30_RECOVERY_POWER_OFF_MS      200            /**< power off time */
+#define SGP30_RECOVERY_POWER_ON_MS       10             /**< power up time */
+
 /**
  * @brief crc8 definition
  */
 #define SGP30_CRC8_POLYNOMIAL                            0x31
 #define SGP30_CRC8_INIT                                  0xFF
 
+/**
+ * @brief     lock the bus and take the chip
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @note      a caller of the same chip which released the bus during its wait keeps the chip busy,
+ *            so the lock is dropped and polled every 1 ms until the chip is free
+ */
+static void a_sgp30_acquire(sgp30_handle_t *handle)
+{
+    if ((handle->lock == NULL) || (handle->unlock == NULL))        /* check the hooks */
+    {
+        return;                                                    /* no locking */
+    }
+    handle->lock();                                                /* lock the bus */
+    while (handle->busy != 0)                                      /* wait the chip */
+    {
+        handle->unlock();                                          /* unlock the bus */
+        handle->delay_ms(1);                                       /* delay 1 ms */
+        handle->lock();                                            /* lock the bus */
+    }
+    handle->busy = 1;                                              /* take the chip */
+}
+
+/**
+ * @brief     free the chip and unlock the bus
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @note      none
+ */
+static void a_sgp30_release(sgp30_handle_t *handle)
+{
+    if ((handle->lock == NULL) || (handle->unlock == NULL))        /* check the hooks */
+    {
+        return;                                                    /* no locking */
+    }
+    handle->busy = 0;                                              /* free the chip */
+    handle->unlock();                                              /* unlock the bus */
+}
+
+/**
+ * @brief     wait the command execution inside a transaction
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @param[in] delay_ms delay time in ms
+ * @note      the bus is unlocked during the wait if bus_release is set, the chip stays busy
+ */
+static void a_sgp30_wait(sgp30_handle_t *handle, uint16_t delay_ms)
+{
+    if (delay_ms == 0)                                             /* check the delay */
+    {
+        return;                                                    /* no wait */
+    }
+    if ((handle->bus_release != 0) && (handle->lock != NULL) &&
+        (handle->unlock != NULL))                                  /* check the release */
+    {
+        handle->unlock();                                          /* unlock the bus */
+        handle->delay_ms(delay_ms);                                /* delay ms */
+        handle->lock();                                            /* lock the bus */
+    }
+    else
+    {
+        handle->delay_ms(delay_ms);                                /* delay ms */
+    }
+}
+
 /**
  * @brief      read bytes
  * @param[in]  *handle pointer to an sgp30 handle structure
@@ -88,28 +157,48 @@
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the write, wait and read are one transaction
  */
 static uint8_t a_sgp30_iic_read(sgp30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len, uint16_t delay_ms)
 {
     uint8_t buf[2];
+    uint8_t res;
     
     memset(buf, 0, sizeof(uint8_t) * 2);                            /* clear the buffer */
     buf[0] = (uint8_t)((reg >> 8) & 0xFF);                          /* set reg MSB */
     buf[1] = (uint8_t)(reg & 0xFF);                                 /* set reg LSB */
-    if (handle->iic_write_cmd(addr, (uint8_t *)buf, 2) != 0)        /* write command */
-    {   
-        return 1;                                                   /* return error */
-    }
-    handle->delay_ms(delay_ms);                                     /* delay ms */
-    if (handle->iic_read_cmd(addr, data, len) != 0)                 /* read data */
-    {
-        return 1;                                                   /* return error */
-    }
-    else
+    a_sgp30_acquire(handle);                                        /* take the bus */
+    res = handle->iic_write_cmd(addr, (uint8_t *)buf, 2);           /* write command */
+    if (res == 0)                                                   /* check result */
     {
-        return 0;                                                   /* success return 0 */
+        a_sgp30_wait(handle, delay_ms);                             /* delay ms */
+        res = handle->iic_read_cmd(addr, data, len);                /* read data */
     }
+    a_sgp30_release(handle);                                        /* free the bus */
+    
+    return (res != 0) ? 1 : 0;                                      /* return the result */
+}
+
+/**
+ * @brief      read bytes without a command
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[in]  addr iic device address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       it fetches the result of a command written before as one transaction
+ */
+static uint8_t a_sgp30_iic_read_data(sgp30_handle_t *handle, uint8_t addr, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    a_sgp30_acquire(handle);                                        /* take the bus */
+    res = handle->iic_read_cmd(addr, data, len);                    /* read data */
+    a_sgp30_release(handle);                                        /* free the bus */
+    
+    return (res != 0) ? 1 : 0;                                      /* return the result */
 }
 
 /**
@@ -119,16 +208,18 @@ static uint8_t a_sgp30_iic_read(sgp30_handle_t *handle, uint8_t addr, uint16_t r
  * @param[in] reg iic register address
  * @param[in] *data pointer to a data buffer
  * @param[in] len data length
+ * @param[in] delay_ms execution time waited after the write
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the write and the execution wait are one transaction
  */
-static uint8_t a_sgp30_iic_write(sgp30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len)
+static uint8_t a_sgp30_iic_write(sgp30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len, uint16_t delay_ms)
 {
     uint8_t buf[16];
     uint16_t i;
-        
+    uint8_t res;
+    
     if ((len + 2) > 16)                                                   /* check length */
     {
         return 1;                                                         /* return error */
@@ -141,14 +232,15 @@ static uint8_t a_sgp30_iic_write(sgp30_handle_t *handle, uint8_t addr, uint16_t
         buf[2 + i] = data[i];                                             /* copy write data */
     }
     
-    if (handle->iic_write_cmd(addr, (uint8_t *)buf, len + 2) != 0)        /* write iic command */
+    a_sgp30_acquire(handle);                                              /* take the bus */
+    res = handle->iic_write_cmd(addr, (uint8_t *)buf, len + 2);           /* write iic command */
+    if (res == 0)                                                         /* check result */
     {
-        return 1;                                                         /* return error */
-    }
-    else
-    {
-        return 0;                                                         /* success return 0 */
+        a_sgp30_wait(handle, delay_ms);                                   /* wait the execution */
     }
+    a_sgp30_release(handle);                                              /* free the bus */
+    
+    return (res != 0) ? 1 : 0;                                            /* return the result */
 }
 
 /**
@@ -212,14 +304,13 @@ uint8_t sgp30_set_tvoc_baseline(sgp30_handle_t *handle, uint16_t tvoc_baseline)
     buf[0] = (tvoc_baseline >> 8) & 0xFF;                                                                        /* get high part */
     buf[1] = (tvoc_baseline >> 0) & 0xFF;                                                                        /* get low part */
     buf[2] = a_sgp30_generate_crc((uint8_t *)buf, 2);                                                            /* generate crc */
-    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_SET_TVOC_BASELINE, (uint8_t *)buf, 3);          /* write set tvoc baseline command */
+    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_SET_TVOC_BASELINE, (uint8_t *)buf, 3, 10);      /* write set tvoc baseline command */
     if (res != 0)                                                                                                /* check result */
     {
         handle->debug_print("sgp30: write tvoc baseline failed.\n");                                             /* write tvoc baseline failed */
        
         return 1;                                                                                                /* return error */
     }
-    handle->delay_ms(10);                                                                                        /* wait 10 ms */
     
     return 0;                                                                                                    /* success return 0 */
 }
@@ -291,14 +382,13 @@ uint8_t sgp30_iaq_init(sgp30_handle_t *handle)
         return 3;                                                                             /* return error */
     }
 
-    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_IAQ_INIT, NULL, 0);          /* write iaq init command */
+    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_IAQ_INIT, NULL, 0, 10);      /* write iaq init command */
     if (res != 0)                                                                             /* check result */
     {
         handle->debug_print("sgp30: write iaq init failed.\n");                               /* write iaq init failed */
        
         return 1;                                                                             /* return error */
     }
-    handle->delay_ms(10);                                                                     /* wait 10 ms */
     
     return 0;                                                                                 /* success return 0 */
 }
@@ -328,7 +418,9 @@ uint8_t sgp30_soft_reset(sgp30_handle_t *handle)
     }
 
     reg = 0x06;                                                          /* soft reset command */
+    a_sgp30_acquire(handle);                                             /* take the bus */
     res = handle->iic_write_cmd(0x00, (uint8_t *)&reg, 1);               /* write reset config */
+    a_sgp30_release(handle);                                             /* free the bus */
     if (res != 0)                                                        /* check result */
     {
         handle->debug_print("sgp30: write soft reset failed.\n");        /* write soft reset failed */
@@ -339,6 +431,174 @@ uint8_t sgp30_soft_reset(sgp30_handle_t *handle)
     return 0;                                                            /* success return 0 */
 }
 
+/**
+ * @brief     restart the iaq algorithm after a reset
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @param[in] tvoc_baseline restored tvoc baseline
+ * @param[in] co2_eq_baseline restored co2 eq baseline
+ * @return    status code
+ *            - 0 success
+ *            - 1 restart failed
+ * @note      none
+ */
+static uint8_t a_sgp30_restart(sgp30_handle_t *handle, uint16_t tvoc_baseline, uint16_t co2_eq_baseline)
+{
+    uint16_t id[3];
+    
+    if (sgp30_get_serial_id(handle, id) != 0)                                             /* check the chip answers */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if (sgp30_iaq_init(handle) != 0)                                                      /* restart the iaq algorithm */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if ((tvoc_baseline != 0) && (co2_eq_baseline != 0))                                   /* check the baseline */
+    {
+        if (sgp30_set_iaq_baseline(handle, tvoc_baseline, co2_eq_baseline) != 0)          /* restore the baseline */
+        {
+            return 1;                                                                     /* return error */
+        }
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      recover the chip by retry, soft reset and power cycle
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[in]  tvoc_baseline restored tvoc baseline
+ * @param[in]  co2_eq_baseline restored co2 eq baseline
+ * @param[out] *level pointer to a recovery level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 recover failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       after a reset the iaq algorithm is restarted and the baseline is restored if both baselines are not 0,
+ *             the power cycle is skipped if power_set is not linked
+ */
+uint8_t sgp30_recover(sgp30_handle_t *handle, uint16_t tvoc_baseline, uint16_t co2_eq_baseline, sgp30_recovery_level_t *level)
+{
+    uint8_t i;
+    uint16_t id[3];
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    *level = SGP30_RECOVERY_LEVEL_NONE;                                                   /* not recovered */
+    for (i = 0; i < SGP30_RECOVERY_RETRY_TIMES; i++)                                      /* retry */
+    {
+        if (sgp30_get_serial_id(handle, id) == 0)                                         /* check the chip answers */
+        {
+            *level = SGP30_RECOVERY_LEVEL_RETRY;                                          /* set the level */
+            
+            return 0;                                                                     /* success return 0 */
+        }
+        handle->delay_ms(10);                                                             /* delay 10 ms */
+    }
+    
+    if (sgp30_soft_reset(handle) == 0)                                                    /* soft reset */
+    {
+        handle->delay_ms(10);                                                             /* wait the reset */
+        if (a_sgp30_restart(handle, tvoc_baseline, co2_eq_baseline) == 0)                 /* restart */
+        {
+            *level = SGP30_RECOVERY_LEVEL_SOFT_RESET;                                     /* set the level */
+            
+            return 0;                                                                     /* success return 0 */
+        }
+    }
+    
+    if (handle->power_set == NULL)                                                        /* check power_set */
+    {
+        handle->debug_print("sgp30: power_set is null.\n");                               /* power_set is null */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (handle->power_set(0) != 0)                                                        /* power off */
+    {
+        handle->debug_print("sgp30: power off failed.\n");                                /* power off failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    handle->delay_ms(SGP30_RECOVERY_POWER_OFF_MS);                                        /* wait the supply to drop */
+    if (handle->power_set(1) != 0)                                                        /* power on */
+    {
+        handle->debug_print("sgp30: power on failed.\n");                                 /* power on failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    handle->delay_ms(SGP30_RECOVERY_POWER_ON_MS);                                         /* wait the power up */
+    if (a_sgp30_restart(handle, tvoc_baseline, co2_eq_baseline) != 0)                     /* restart */
+    {
+        handle->debug_print("sgp30: restart after power cycle failed.\n");                /* restart failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    *level = SGP30_RECOVERY_LEVEL_POWER_CYCLE;                                            /* set the level */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable releasing the bus during the execution wait
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @param[in] enable 1 releases the bus, 0 holds it
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when it is enabled other devices can use the bus while the chip executes a command,
+ *            another caller of the same chip still waits until the transaction is done
+ */
+uint8_t sgp30_set_bus_release(sgp30_handle_t *handle, uint8_t enable)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    handle->bus_release = (enable != 0) ? 1 : 0;        /* set the release */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the bus release status
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[out] *enable pointer to an enable buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sgp30_get_bus_release(sgp30_handle_t *handle, uint8_t *enable)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    *enable = handle->bus_release;                      /* get the release */
+    
+    return 0;                                           /* success return 0 */
+}
+
 /**
  * @brief      get the chip serial id
  * @param[in]  *handle pointer to an sgp30 handle structure
@@ -449,6 +709,91 @@ uint8_t sgp30_measure_iaq(sgp30_handle_t *handle, uint16_t *co2_eq_ppm, uint16_t
     return 0;                                                                                             /* success return 0 */
 }
 
+/**
+ * @brief     start the iaq measurement without waiting for the result
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start measure iaq failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the result can be fetched by sgp30_get_measure_iaq_result after SGP30_MEASURE_IAQ_TIME_MS,
+ *            the chip is not reserved between the two calls when lock hooks are linked
+ */
+uint8_t sgp30_start_measure_iaq(sgp30_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_MEASURE_IAQ, NULL, 0, 0);       /* write measure iaq command */
+    if (res != 0)                                                                                /* check result */
+    {
+        handle->debug_print("sgp30: write measure iaq failed.\n");                               /* write measure iaq failed */
+       
+        return 1;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the iaq measurement result started by sgp30_start_measure_iaq
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[out] *co2_eq_ppm pointer to a co2 buffer
+ * @param[out] *tvoc_ppb pointer to a tvoc buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measure iaq result failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sgp30_get_measure_iaq_result(sgp30_handle_t *handle, uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb)
+{
+    uint8_t buf[6];
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 6);                                          /* clear the buffer */
+    if (a_sgp30_iic_read_data(handle, SGP30_ADDRESS, (uint8_t *)buf, 6) != 0)     /* read measure iaq result */
+    {
+        handle->debug_print("sgp30: read measure iaq failed.\n");                 /* read measure iaq failed */
+       
+        return 1;                                                                 /* return error */
+    }
+    if (buf[2] != a_sgp30_generate_crc((uint8_t *)buf, 2))                        /* check 1st crc */
+    {
+        handle->debug_print("sgp30: co2 eq crc check error.\n");                  /* co2 eq crc check error */
+       
+        return 1;                                                                 /* return error */
+    }
+    if (buf[5] != a_sgp30_generate_crc((uint8_t *)&buf[3], 2))                    /* check 2nd crc */
+    {
+        handle->debug_print("sgp30: tvoc crc check error.\n");                    /* tvoc crc check error */
+       
+        return 1;                                                                 /* return error */
+    }
+    *co2_eq_ppm = (uint16_t)(((uint16_t)buf[0]) << 8 | buf[1]);                   /* get co2 eq ppm data */
+    *tvoc_ppb = (uint16_t)(((uint16_t)buf[3]) << 8 | buf[4]);                     /* get tvoc ppb data */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
 /**
  * @brief      get the chip iaq baseline
  * @param[in]  *handle pointer to an sgp30 handle structure
@@ -534,14 +879,13 @@ uint8_t sgp30_set_iaq_baseline(sgp30_handle_t *handle, uint16_t tvoc, uint16_t c
     buf[3] = (co2_eq >> 8) & 0xFF;                                                                              /* set co2 eq high part */
     buf[4] = co2_eq & 0xFF;                                                                                     /* set co2 eq low part */
     buf[5] = a_sgp30_generate_crc((uint8_t *)&buf[3], 2);                                                       /* generate co2_eq crc */
-    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_SET_IAQ_BASELINE, (uint8_t *)buf, 6);          /* write iaq baseline command */
+    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_SET_IAQ_BASELINE, (uint8_t *)buf, 6, 10);      /* write iaq baseline command */
     if (res != 0)                                                                                               /* check result */
     {
         handle->debug_print("sgp30: write iaq baseline failed.\n");                                             /* write iaq baseline failed */
        
         return 1;                                                                                               /* return error */
     }
-    handle->delay_ms(10);                                                                                       /* delay 10 ms */
     
     return 0;                                                                                                   /* success return 0 */
 }
@@ -575,14 +919,13 @@ uint8_t sgp30_set_absolute_humidity(sgp30_handle_t *handle, uint16_t humidity)
     buf[0] = (humidity >> 8) & 0xFF;                                                                                 /* set humidity high part */
     buf[1] = (humidity >> 0) & 0xFF;                                                                                 /* set humidity low part */
     buf[2] = a_sgp30_generate_crc((uint8_t *)buf, 2);                                                                /* generate crc */
-    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_SET_ABSOLUTE_HUMIDITY, (uint8_t *)buf, 3);          /* write set absolute humidity command */
+    res = a_sgp30_iic_write(handle, SGP30_ADDRESS, SGP30_COMMAND_SET_ABSOLUTE_HUMIDITY, (uint8_t *)buf, 3, 10);      /* write set absolute humidity command */
     if (res != 0)                                                                                                    /* check result */
     {
         handle->debug_print("sgp30: write absolute humidity failed.\n");                                             /* write absolute humidity failed */
        
         return 1;                                                                                                    /* return error */
     }
-    handle->delay_ms(10);                                                                                            /* delay 10 ms */
     
     return 0;                                                                                                        /* success return 0 */
 }
@@ -814,6 +1157,12 @@ uint8_t sgp30_init(sgp30_handle_t *handle)
     
         return 3;                                                            /* return error */
     }
+    if ((handle->lock == NULL) != (handle->unlock == NULL))                  /* check lock and unlock */
+    {
+        handle->debug_print("sgp30: lock and unlock must be linked together.\n");
+    
+        return 3;                                                            /* return error */
+    }
     
     if (handle->iic_init() != 0)                                             /* iic init */
     {
@@ -941,7 +1290,7 @@ uint8_t sgp30_set_reg(sgp30_handle_t *handle, uint16_t reg, uint8_t *buf, uint16
         return 3;                                                            /* return error */
     }
   
-    return a_sgp30_iic_write(handle, SGP30_ADDRESS, reg, buf, len);          /* write data */
+    return a_sgp30_iic_write(handle, SGP30_ADDRESS, reg, buf, len, 0);       /* write data */
 }
 
 /**
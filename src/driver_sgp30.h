@@ -58,6 +58,22 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief sgp30 command execution time definition
+ */
+#define SGP30_MEASURE_IAQ_TIME_MS        12        /**< measure iaq max execution time in ms */
+
+/**
+ * @brief sgp30 recovery level enumeration definition
+ */
+typedef enum
+{
+    SGP30_RECOVERY_LEVEL_NONE        = 0x00,        /**< not recovered */
+    SGP30_RECOVERY_LEVEL_RETRY       = 0x01,        /**< the chip answers again */
+    SGP30_RECOVERY_LEVEL_SOFT_RESET  = 0x02,        /**< recovered by a soft reset */
+    SGP30_RECOVERY_LEVEL_POWER_CYCLE = 0x03,        /**< recovered by a power cycle */
+} sgp30_recovery_level_t;
+
 /**
  * @brief sgp30 handle structure definition
  */
@@ -69,6 +85,11 @@ typedef struct sgp30_handle_s
     uint8_t (*iic_read_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);         /**< point to an iic_read_cmd function address */
     void (*delay_ms)(uint32_t ms);                                             /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                           /**< point to a debug_print function address */
+    uint8_t (*power_set)(uint8_t enable);                                      /**< point to a power_set function address, optional */
+    void (*lock)(void);                                                        /**< point to a bus lock function address, optional */
+    void (*unlock)(void);                                                      /**< point to a bus unlock function address, optional */
+    uint8_t bus_release;                                                       /**< release the bus during the execution wait */
+    uint8_t busy;                                                              /**< a transaction is running on the chip */
     uint8_t inited;                                                            /**< inited flag */
 } sgp30_handle_t;
 
@@ -155,6 +176,31 @@ typedef struct sgp30_info_s
  */
 #define DRIVER_SGP30_LINK_DEBUG_PRINT(HANDLE, FUC)          (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link power_set function
+ * @param[in] HANDLE pointer to an sgp30 handle structure
+ * @param[in] FUC pointer to a power_set function address
+ * @note      this function is optional and used by sgp30_recover to power cycle the chip
+ */
+#define DRIVER_SGP30_LINK_POWER_SET(HANDLE, FUC)            (HANDLE)->power_set = FUC
+
+/**
+ * @brief     link lock function
+ * @param[in] HANDLE pointer to an sgp30 handle structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      this function is optional, it must be linked with unlock and is held across
+ *            every command write, execution wait and result read
+ */
+#define DRIVER_SGP30_LINK_LOCK(HANDLE, FUC)                 (HANDLE)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] HANDLE pointer to an sgp30 handle structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      this function is optional
+ */
+#define DRIVER_SGP30_LINK_UNLOCK(HANDLE, FUC)               (HANDLE)->unlock = FUC
+
 /**
  * @}
  */
@@ -241,6 +287,33 @@ uint8_t sgp30_read(sgp30_handle_t *handle, uint16_t *co2_eq_ppm, uint16_t *tvoc_
  */
 uint8_t sgp30_measure_iaq(sgp30_handle_t *handle, uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb);
 
+/**
+ * @brief     start the iaq measurement without waiting for the result
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start measure iaq failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the result can be fetched by sgp30_get_measure_iaq_result after SGP30_MEASURE_IAQ_TIME_MS,
+ *            the chip is not reserved between the two calls when lock hooks are linked
+ */
+uint8_t sgp30_start_measure_iaq(sgp30_handle_t *handle);
+
+/**
+ * @brief      get the iaq measurement result started by sgp30_start_measure_iaq
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[out] *co2_eq_ppm pointer to a co2 buffer
+ * @param[out] *tvoc_ppb pointer to a tvoc buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measure iaq result failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sgp30_get_measure_iaq_result(sgp30_handle_t *handle, uint16_t *co2_eq_ppm, uint16_t *tvoc_ppb);
+
 /**
  * @brief      get measure raw
  * @param[in]  *handle pointer to an sgp30 handle structure
@@ -293,6 +366,47 @@ uint8_t sgp30_get_tvoc_inceptive_baseline(sgp30_handle_t *handle, uint16_t *tvoc
  */
 uint8_t sgp30_soft_reset(sgp30_handle_t *handle);
 
+/**
+ * @brief      recover the chip by retry, soft reset and power cycle
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[in]  tvoc_baseline restored tvoc baseline
+ * @param[in]  co2_eq_baseline restored co2 eq baseline
+ * @param[out] *level pointer to a recovery level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 recover failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       after a reset the iaq algorithm is restarted and the baseline is restored if both baselines are not 0,
+ *             the power cycle is skipped if power_set is not linked
+ */
+uint8_t sgp30_recover(sgp30_handle_t *handle, uint16_t tvoc_baseline, uint16_t co2_eq_baseline, sgp30_recovery_level_t *level);
+
+/**
+ * @brief     enable or disable releasing the bus during the execution wait
+ * @param[in] *handle pointer to an sgp30 handle structure
+ * @param[in] enable 1 releases the bus, 0 holds it
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when it is enabled other devices can use the bus while the chip executes a command,
+ *            another caller of the same chip still waits until the transaction is done
+ */
+uint8_t sgp30_set_bus_release(sgp30_handle_t *handle, uint8_t enable);
+
+/**
+ * @brief      get the bus release status
+ * @param[in]  *handle pointer to an sgp30 handle structure
+ * @param[out] *enable pointer to an enable buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sgp30_get_bus_release(sgp30_handle_t *handle, uint8_t *enable);
+
 /**
  * @brief      get the chip serial id
  * @param[in]  *handle pointer to an sgp30 handle structure
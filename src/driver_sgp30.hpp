@@ -0,0 +1,819 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sgp30.hpp
+ * @brief     driver sgp30 c++ header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SGP30_HPP
+#define DRIVER_SGP30_HPP
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @defgroup sgp30_cpp sgp30 c++ function
+ * @brief    sgp30 header-only c++17 driver modules
+ * @note     the protocol is implemented in this header and does not link the c core,
+ *           BusPolicy and ClockPolicy are template parameters so every bus and clock call
+ *           is resolved at compile time and can be inlined
+ * @{
+ */
+
+namespace sgp30
+{
+
+/**
+ * @brief sgp30 error enumeration definition
+ */
+enum class Error : uint8_t
+{
+    Bus   = 0x01,        /**< iic transfer failed */
+    Crc   = 0x02,        /**< crc check failed */
+    Param = 0x03,        /**< param is invalid */
+};
+
+/**
+ * @brief sgp30 result class definition
+ * @note  an expected-like value or error, it never allocates and never throws
+ */
+template <typename T>
+class Result
+{
+    public:
+        /**
+         * @brief     construct a value
+         * @param[in] value result value
+         * @note      none
+         */
+        constexpr Result(T value) noexcept : m_value(value), m_error(), m_ok(true) {}
+        
+        /**
+         * @brief     construct an error
+         * @param[in] error result error
+         * @note      none
+         */
+        constexpr Result(Error error) noexcept : m_value(), m_error(error), m_ok(false) {}
+        
+        /**
+         * @brief  check the result holds a value
+         * @return true if it holds a value
+         * @note   none
+         */
+        constexpr bool has_value() const noexcept { return m_ok; }
+        
+        /**
+         * @brief  check the result holds a value
+         * @return true if it holds a value
+         * @note   none
+         */
+        constexpr explicit operator bool() const noexcept { return m_ok; }
+        
+        /**
+         * @brief  get the value
+         * @return value
+         * @note   only valid when has_value() is true
+         */
+        constexpr const T &value() const noexcept { return m_value; }
+        
+        /**
+         * @brief  get the value
+         * @return value
+         * @note   only valid when has_value() is true
+         */
+        constexpr const T &operator*() const noexcept { return m_value; }
+        
+        /**
+         * @brief  get the value members
+         * @return pointer to the value
+         * @note   only valid when has_value() is true
+         */
+        constexpr const T *operator->() const noexcept { return &m_value; }
+        
+        /**
+         * @brief     get the value or a fallback
+         * @param[in] fallback value returned on error
+         * @return    value
+         * @note      none
+         */
+        constexpr T value_or(T fallback) const noexcept { return m_ok ? m_value : fallback; }
+        
+        /**
+         * @brief  get the error
+         * @return error
+         * @note   only valid when has_value() is false
+         */
+        constexpr Error error() const noexcept { return m_error; }
+        
+        /**
+         * @brief  convert to an optional
+         * @return optional value
+         * @note   none
+         */
+        constexpr std::optional<T> optional() const noexcept { return m_ok ? std::optional<T>(m_value) : std::nullopt; }
+    
+    private:
+        T m_value;            /**< value */
+        Error m_error;        /**< error */
+        bool m_ok;            /**< value flag */
+};
+
+/**
+ * @brief sgp30 result class definition of the commands without a value
+ */
+template <>
+class Result<void>
+{
+    public:
+        /**
+         * @brief construct a success
+         * @note  none
+         */
+        constexpr Result() noexcept : m_error(), m_ok(true) {}
+        
+        /**
+         * @brief     construct an error
+         * @param[in] error result error
+         * @note      none
+         */
+        constexpr Result(Error error) noexcept : m_error(error), m_ok(false) {}
+        
+        /**
+         * @brief  check the command succeeded
+         * @return true on success
+         * @note   none
+         */
+        constexpr bool has_value() const noexcept { return m_ok; }
+        
+        /**
+         * @brief  check the command succeeded
+         * @return true on success
+         * @note   none
+         */
+        constexpr explicit operator bool() const noexcept { return m_ok; }
+        
+        /**
+         * @brief  get the error
+         * @return error
+         * @note   only valid when has_value() is false
+         */
+        constexpr Error error() const noexcept { return m_error; }
+    
+    private:
+        Error m_error;        /**< error */
+        bool m_ok;            /**< success flag */
+};
+
+/**
+ * @brief sgp30 iaq structure definition
+ */
+struct Iaq
+{
+    uint16_t co2_eq_ppm;        /**< co2 eq in ppm */
+    uint16_t tvoc_ppb;          /**< tvoc in ppb */
+};
+
+/**
+ * @brief sgp30 raw structure definition
+ */
+struct Raw
+{
+    uint16_t h2;             /**< h2 raw signal */
+    uint16_t ethanol;        /**< ethanol raw signal */
+};
+
+/**
+ * @brief sgp30 baseline structure definition
+ */
+struct Baseline
+{
+    uint16_t co2_eq;        /**< co2 eq baseline */
+    uint16_t tvoc;          /**< tvoc baseline */
+};
+
+/**
+ * @brief sgp30 feature structure definition
+ */
+struct Feature
+{
+    uint8_t product_type;           /**< product type */
+    uint8_t product_version;        /**< product version */
+};
+
+/**
+ * @brief sgp30 serial id definition
+ */
+using SerialId = std::array<uint16_t, 3>;
+
+/**
+ * @brief sgp30 command execution time definition
+ */
+inline constexpr std::chrono::milliseconds kIaqInitTime{10};              /**< iaq init */
+inline constexpr std::chrono::milliseconds kMeasureIaqTime{12};           /**< measure iaq */
+inline constexpr std::chrono::milliseconds kGetBaselineTime{10};          /**< get iaq baseline */
+inline constexpr std::chrono::milliseconds kSetBaselineTime{10};          /**< set iaq baseline */
+inline constexpr std::chrono::milliseconds kSetHumidityTime{10};          /**< set absolute humidity */
+inline constexpr std::chrono::milliseconds kMeasureTestTime{220};         /**< measure test */
+inline constexpr std::chrono::milliseconds kGetFeatureSetTime{10};        /**< get feature set */
+inline constexpr std::chrono::milliseconds kMeasureRawTime{25};           /**< measure raw */
+inline constexpr std::chrono::milliseconds kSerialIdTime{10};             /**< get serial id */
+
+/**
+ * @brief sgp30 chip definition
+ */
+inline constexpr uint8_t kAddress = 0x58 << 1;            /**< iic write address */
+inline constexpr uint16_t kMeasureTestPassed = 0xD400;    /**< measure test pattern */
+
+namespace detail
+{
+
+/**
+ * @brief sgp30 command definition
+ */
+inline constexpr uint16_t kIaqInit                 = 0x2003U;        /**< iaq init command */
+inline constexpr uint16_t kMeasureIaq              = 0x2008U;        /**< measure iaq command */
+inline constexpr uint16_t kGetIaqBaseline          = 0x2015U;        /**< get iaq baseline command */
+inline constexpr uint16_t kSetIaqBaseline          = 0x201EU;        /**< set iaq baseline command */
+inline constexpr uint16_t kSetAbsoluteHumidity     = 0x2061U;        /**< set absolute humidity command */
+inline constexpr uint16_t kMeasureTest             = 0x2032U;        /**< measure test command */
+inline constexpr uint16_t kGetFeatureSet           = 0x202FU;        /**< get feature set command */
+inline constexpr uint16_t kMeasureRaw              = 0x2050U;        /**< measure raw command */
+inline constexpr uint16_t kGetTvocInceptiveBaseline = 0x20B3U;       /**< get tvoc inceptive baseline command */
+inline constexpr uint16_t kSetTvocBaseline         = 0x2077U;        /**< set tvoc baseline command */
+inline constexpr uint16_t kGetSerialId             = 0x3682U;        /**< get serial id command */
+
+/**
+ * @brief     generate the crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    crc
+ * @note      crc8 with polynomial 0x31 and init 0xFF
+ */
+constexpr uint8_t crc(const uint8_t *data, size_t count) noexcept
+{
+    uint8_t crc = 0xFF;
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = ((crc & 0x80) != 0) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    
+    return crc;
+}
+
+/**
+ * @brief     get one checked word
+ * @param[in] *buf pointer to a word and its crc
+ * @return    word or nullopt on a crc error
+ * @note      none
+ */
+constexpr std::optional<uint16_t> word(const uint8_t *buf) noexcept
+{
+    if (buf[2] != crc(buf, 2))
+    {
+        return std::nullopt;
+    }
+    
+    return static_cast<uint16_t>((static_cast<uint16_t>(buf[0]) << 8) | buf[1]);
+}
+
+/**
+ * @brief      put one word with its crc
+ * @param[out] *buf pointer to a 3 bytes buffer
+ * @param[in]  value word
+ * @note       none
+ */
+constexpr void put(uint8_t *buf, uint16_t value) noexcept
+{
+    buf[0] = static_cast<uint8_t>(value >> 8);
+    buf[1] = static_cast<uint8_t>(value & 0xFF);
+    buf[2] = crc(buf, 2);
+}
+
+}
+
+/**
+ * @brief sgp30 driver class definition
+ * @note  BusPolicy needs bool write(uint8_t addr, const uint8_t *buf, size_t len) and
+ *        bool read(uint8_t addr, uint8_t *buf, size_t len), true means success and addr is the iic write address,
+ *        ClockPolicy needs void sleep(std::chrono::milliseconds), both can be empty classes
+ */
+template <typename BusPolicy, typename ClockPolicy>
+class Sgp30
+{
+    public:
+        /**
+         * @brief     construct the driver
+         * @param[in] bus bus policy
+         * @param[in] clock clock policy
+         * @note      nothing is sent to the chip
+         */
+        constexpr explicit Sgp30(BusPolicy bus = BusPolicy(), ClockPolicy clock = ClockPolicy()) noexcept
+            : m_bus(bus), m_clock(clock) {}
+        
+        /**
+         * @brief  get the bus policy
+         * @return reference to the bus policy
+         * @note   none
+         */
+        BusPolicy &bus() noexcept { return m_bus; }
+        
+        /**
+         * @brief  get the clock policy
+         * @return reference to the clock policy
+         * @note   none
+         */
+        ClockPolicy &clock() noexcept { return m_clock; }
+        
+        /**
+         * @brief  initialize the chip iaq
+         * @return result
+         * @note   the first 15 s after it return the fixed 400 ppm and 0 ppb
+         */
+        Result<void> iaq_init() noexcept
+        {
+            return wait(start_iaq_init());
+        }
+        
+        /**
+         * @brief  send iaq init without waiting
+         * @return result with the time the chip needs before the next command
+         * @note   none
+         */
+        Result<std::chrono::milliseconds> start_iaq_init() noexcept
+        {
+            return send(detail::kIaqInit, nullptr, 0, kIaqInitTime);
+        }
+        
+        /**
+         * @brief  read the iaq result
+         * @return result with the co2 eq and tvoc
+         * @note   it should be called every second to keep the baseline algorithm running
+         */
+        Result<Iaq> measure_iaq() noexcept
+        {
+            if (!start_measure_iaq())
+            {
+                return Error::Bus;
+            }
+            m_clock.sleep(kMeasureIaqTime);
+            
+            return get_measure_iaq_result();
+        }
+        
+        /**
+         * @brief  start the iaq measurement
+         * @return result with the time until the result can be fetched
+         * @note   the caller does other work and calls get_measure_iaq_result after the returned time
+         */
+        Result<std::chrono::milliseconds> start_measure_iaq() noexcept
+        {
+            return send(detail::kMeasureIaq, nullptr, 0, kMeasureIaqTime);
+        }
+        
+        /**
+         * @brief  get the iaq result started by start_measure_iaq
+         * @return result with the co2 eq and tvoc
+         * @note   none
+         */
+        Result<Iaq> get_measure_iaq_result() noexcept
+        {
+            std::array<uint16_t, 2> w{};
+            Result<void> res = fetch(w.data(), w.size());
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return Iaq{w[0], w[1]};
+        }
+        
+        /**
+         * @brief  read the raw signals
+         * @return result with the h2 and ethanol raw signals
+         * @note   none
+         */
+        Result<Raw> measure_raw() noexcept
+        {
+            if (!wait(start_measure_raw()))
+            {
+                return Error::Bus;
+            }
+            
+            return get_measure_raw_result();
+        }
+        
+        /**
+         * @brief  start the raw measurement
+         * @return result with the time until the result can be fetched
+         * @note   none
+         */
+        Result<std::chrono::milliseconds> start_measure_raw() noexcept
+        {
+            return send(detail::kMeasureRaw, nullptr, 0, kMeasureRawTime);
+        }
+        
+        /**
+         * @brief  get the raw result started by start_measure_raw
+         * @return result with the h2 and ethanol raw signals
+         * @note   none
+         */
+        Result<Raw> get_measure_raw_result() noexcept
+        {
+            std::array<uint16_t, 2> w{};
+            Result<void> res = fetch(w.data(), w.size());
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return Raw{w[0], w[1]};
+        }
+        
+        /**
+         * @brief  get the iaq baseline
+         * @return result with the co2 eq and tvoc baseline
+         * @note   none
+         */
+        Result<Baseline> get_iaq_baseline() noexcept
+        {
+            if (!wait(start_get_iaq_baseline()))
+            {
+                return Error::Bus;
+            }
+            
+            return get_iaq_baseline_result();
+        }
+        
+        /**
+         * @brief  start reading the iaq baseline
+         * @return result with the time until the result can be fetched
+         * @note   none
+         */
+        Result<std::chrono::milliseconds> start_get_iaq_baseline() noexcept
+        {
+            return send(detail::kGetIaqBaseline, nullptr, 0, kGetBaselineTime);
+        }
+        
+        /**
+         * @brief  get the iaq baseline started by start_get_iaq_baseline
+         * @return result with the co2 eq and tvoc baseline
+         * @note   none
+         */
+        Result<Baseline> get_iaq_baseline_result() noexcept
+        {
+            std::array<uint16_t, 2> w{};
+            Result<void> res = fetch(w.data(), w.size());
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return Baseline{w[0], w[1]};
+        }
+        
+        /**
+         * @brief     set the iaq baseline
+         * @param[in] baseline co2 eq and tvoc baseline
+         * @return    result
+         * @note      the chip takes the tvoc word first
+         */
+        Result<void> set_iaq_baseline(const Baseline &baseline) noexcept
+        {
+            return wait(start_set_iaq_baseline(baseline));
+        }
+        
+        /**
+         * @brief     send the iaq baseline without waiting
+         * @param[in] baseline co2 eq and tvoc baseline
+         * @return    result with the time the chip needs before the next command
+         * @note      the chip takes the tvoc word first
+         */
+        Result<std::chrono::milliseconds> start_set_iaq_baseline(const Baseline &baseline) noexcept
+        {
+            uint8_t buf[6] = {};
+            
+            detail::put(&buf[0], baseline.tvoc);
+            detail::put(&buf[3], baseline.co2_eq);
+            
+            return send(detail::kSetIaqBaseline, buf, sizeof(buf), kSetBaselineTime);
+        }
+        
+        /**
+         * @brief     set the tvoc baseline
+         * @param[in] tvoc tvoc baseline
+         * @return    result
+         * @note      none
+         */
+        Result<void> set_tvoc_baseline(uint16_t tvoc) noexcept
+        {
+            uint8_t buf[3] = {};
+            
+            detail::put(buf, tvoc);
+            
+            return command(detail::kSetTvocBaseline, buf, sizeof(buf), kSetBaselineTime);
+        }
+        
+        /**
+         * @brief  get the tvoc inceptive baseline
+         * @return result with the tvoc inceptive baseline
+         * @note   none
+         */
+        Result<uint16_t> get_tvoc_inceptive_baseline() noexcept
+        {
+            uint16_t w = 0;
+            Result<void> res = query(detail::kGetTvocInceptiveBaseline, kGetBaselineTime, &w, 1);
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return w;
+        }
+        
+        /**
+         * @brief     set the absolute humidity
+         * @param[in] reg absolute humidity register, 8.8 fixed point g/m3, 0 disables the compensation
+         * @return    result
+         * @note      none
+         */
+        Result<void> set_absolute_humidity(uint16_t reg) noexcept
+        {
+            uint8_t buf[3] = {};
+            
+            detail::put(buf, reg);
+            
+            return command(detail::kSetAbsoluteHumidity, buf, sizeof(buf), kSetHumidityTime);
+        }
+        
+        /**
+         * @brief     convert the temperature and relative humidity to the absolute humidity register
+         * @param[in] temp temperature in C
+         * @param[in] rh relative humidity in %
+         * @return    result with the register
+         * @note      the same formula as sgp30_absolute_humidity_convert_to_register
+         */
+        static Result<uint16_t> absolute_humidity_to_register(float temp, float rh) noexcept
+        {
+            float ah;
+            float intpart;
+            float fractpart;
+            
+            if ((rh < 0.0f) || (rh > 100.0f) || (temp <= -243.12f))
+            {
+                return Error::Param;
+            }
+            ah = (rh / 100.0f * 6.112f * std::exp((17.62f * temp) / (243.12f + temp))) / (273.15f + temp) * 216.7f;
+            fractpart = std::modf(ah, &intpart);
+            
+            return static_cast<uint16_t>((static_cast<uint16_t>(intpart) << 8) | static_cast<uint8_t>(fractpart * 256));
+        }
+        
+        /**
+         * @brief  run the chip measure test
+         * @return result with the test pattern, kMeasureTestPassed means passed
+         * @note   none
+         */
+        Result<uint16_t> measure_test() noexcept
+        {
+            uint16_t w = 0;
+            Result<void> res = query(detail::kMeasureTest, kMeasureTestTime, &w, 1);
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return w;
+        }
+        
+        /**
+         * @brief  get the feature set
+         * @return result with the product type and version
+         * @note   none
+         */
+        Result<Feature> get_feature_set() noexcept
+        {
+            uint16_t w = 0;
+            Result<void> res = query(detail::kGetFeatureSet, kGetFeatureSetTime, &w, 1);
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return Feature{static_cast<uint8_t>((w >> 8) & 0xF), static_cast<uint8_t>(w & 0xFF)};
+        }
+        
+        /**
+         * @brief  get the serial id
+         * @return result with the serial id
+         * @note   none
+         */
+        Result<SerialId> get_serial_id() noexcept
+        {
+            SerialId id{};
+            Result<void> res = query(detail::kGetSerialId, kSerialIdTime, id.data(), id.size());
+            
+            if (!res)
+            {
+                return res.error();
+            }
+            
+            return id;
+        }
+        
+        /**
+         * @brief  soft reset the chip
+         * @return result
+         * @note   it is a general call, every chip on the bus which supports it is reset
+         */
+        Result<void> soft_reset() noexcept
+        {
+            const uint8_t reg = 0x06;
+            
+            return m_bus.write(0x00, &reg, 1) ? Result<void>() : Result<void>(Error::Bus);
+        }
+    
+    private:
+        /**
+         * @brief     write a command and return its execution time
+         * @param[in] cmd command
+         * @param[in] *data pointer to the argument words with crc
+         * @param[in] len argument length
+         * @param[in] time execution time
+         * @return    result with the execution time
+         * @note      none
+         */
+        Result<std::chrono::milliseconds> send(uint16_t cmd, const uint8_t *data, size_t len, std::chrono::milliseconds time) noexcept
+        {
+            if (!write(cmd, data, len))
+            {
+                return Error::Bus;
+            }
+            
+            return time;
+        }
+        
+        /**
+         * @brief     wait the execution time of a sent command
+         * @param[in] sent result of send
+         * @return    result
+         * @note      none
+         */
+        Result<void> wait(const Result<std::chrono::milliseconds> &sent) noexcept
+        {
+            if (!sent)
+            {
+                return sent.error();
+            }
+            m_clock.sleep(*sent);
+            
+            return Result<void>();
+        }
+        
+        /**
+         * @brief     write a command with its arguments
+         * @param[in] cmd command
+         * @param[in] *data pointer to the argument words with crc
+         * @param[in] len argument length
+         * @return    true on success
+         * @note      none
+         */
+        bool write(uint16_t cmd, const uint8_t *data, size_t len) noexcept
+        {
+            uint8_t buf[8] = {};
+            
+            buf[0] = static_cast<uint8_t>(cmd >> 8);
+            buf[1] = static_cast<uint8_t>(cmd & 0xFF);
+            for (size_t i = 0; i < len; i++)
+            {
+                buf[2 + i] = data[i];
+            }
+            
+            return m_bus.write(kAddress, buf, len + 2);
+        }
+        
+        /**
+         * @brief     write a command and wait its execution
+         * @param[in] cmd command
+         * @param[in] *data pointer to the argument words with crc
+         * @param[in] len argument length
+         * @param[in] wait execution time
+         * @return    result
+         * @note      none
+         */
+        Result<void> command(uint16_t cmd, const uint8_t *data, size_t len, std::chrono::milliseconds wait) noexcept
+        {
+            if (!write(cmd, data, len))
+            {
+                return Error::Bus;
+            }
+            m_clock.sleep(wait);
+            
+            return Result<void>();
+        }
+        
+        /**
+         * @brief      read checked words
+         * @param[out] *w pointer to a word buffer
+         * @param[in]  num word number, at most 3
+         * @return     result
+         * @note       none
+         */
+        Result<void> fetch(uint16_t *w, size_t num) noexcept
+        {
+            uint8_t buf[9] = {};
+            
+            if (!m_bus.read(kAddress, buf, num * 3))
+            {
+                return Error::Bus;
+            }
+            for (size_t i = 0; i < num; i++)
+            {
+                std::optional<uint16_t> v = detail::word(&buf[i * 3]);
+                
+                if (!v)
+                {
+                    return Error::Crc;
+                }
+                w[i] = *v;
+            }
+            
+            return Result<void>();
+        }
+        
+        /**
+         * @brief      write a command, wait and read the checked words
+         * @param[in]  cmd command
+         * @param[in]  wait execution time
+         * @param[out] *w pointer to a word buffer
+         * @param[in]  num word number, at most 3
+         * @return     result
+         * @note       none
+         */
+        Result<void> query(uint16_t cmd, std::chrono::milliseconds wait, uint16_t *w, size_t num) noexcept
+        {
+            Result<void> res = command(cmd, nullptr, 0, wait);
+            
+            if (!res)
+            {
+                return res;
+            }
+            
+            return fetch(w, num);
+        }
+    
+    private:
+        BusPolicy m_bus;            /**< bus policy */
+        ClockPolicy m_clock;        /**< clock policy */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
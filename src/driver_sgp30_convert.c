@@ -0,0 +1,613 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sgp30_convert.c
+ * @brief     driver sgp30 convert source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sgp30_convert.h"
+#include <math.h>
+#include <stddef.h>
+
+#if !defined(SGP30_CONVERT_NO_SIMD) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define SGP30_CONVERT_AVX2
+#elif !defined(SGP30_CONVERT_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #include <arm_neon.h>
+    #define SGP30_CONVERT_NEON
+#elif !defined(SGP30_CONVERT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+    #include <emmintrin.h>
+    #define SGP30_CONVERT_SSE2
+#endif
+
+/**
+ * @brief exp approximation constant definition
+ * @note  exp(x) = 2^n * exp(r) with n = round(x * log2(e)) and r = x - n * ln(2), ln(2) is split
+ *        into an exact high part and a low part so r keeps full precision, exp(r) on
+ *        [-ln(2) / 2, ln(2) / 2] is a degree 7 minimax polynomial, x is clamped so that 2^n
+ *        stays a normal float
+ */
+#define CONVERT_EXP_HI           88.0f                   /**< max input */
+#define CONVERT_EXP_LO           -87.0f                  /**< min input */
+#define CONVERT_LOG2E            1.44269504088896341f    /**< log2(e) */
+#define CONVERT_LN2_HI           0.693359375f            /**< ln(2) high part */
+#define CONVERT_LN2_LO           -2.12194440e-4f         /**< ln(2) low part */
+#define CONVERT_P0               1.9875691500e-4f        /**< polynomial coefficient 0 */
+#define CONVERT_P1               1.3981999507e-3f        /**< polynomial coefficient 1 */
+#define CONVERT_P2               8.3334519073e-3f        /**< polynomial coefficient 2 */
+#define CONVERT_P3               4.1665795894e-2f        /**< polynomial coefficient 3 */
+#define CONVERT_P4               1.6666665459e-1f        /**< polynomial coefficient 4 */
+#define CONVERT_P5               5.0000001201e-1f        /**< polynomial coefficient 5 */
+#define CONVERT_ROUND            12582912.0f             /**< 1.5 * 2^23 rounds a float to an integer */
+#define CONVERT_RAW_SCALE        (1.0f / 512.0f)         /**< raw signal scale */
+#define CONVERT_AH_A             17.62f                  /**< magnus coefficient */
+#define CONVERT_AH_B             243.12f                 /**< magnus temperature in degrees */
+#define CONVERT_AH_E             6.112f                  /**< saturation vapour pressure at 0 degrees in hPa */
+#define CONVERT_AH_K             273.15f                 /**< zero degrees in kelvin */
+#define CONVERT_AH_G             216.7f                  /**< water vapour gas constant factor */
+#define CONVERT_AH_REG_MAX       65535.0f                /**< max register scaled by 256 */
+
+/**
+ * @brief     exp approximation of one value
+ * @param[in] x input value
+ * @return    exp(x)
+ * @note      none
+ */
+static inline float a_sgp30_convert_exp(float x)
+{
+    union
+    {
+        float f;
+        int32_t i;
+    } scale;
+    int32_t ni;
+    float t;
+    float n;
+    float r;
+    float p;
+    
+    x = (x > CONVERT_EXP_HI) ? CONVERT_EXP_HI : x;        /* clamp the max */
+    x = (x < CONVERT_EXP_LO) ? CONVERT_EXP_LO : x;        /* clamp the min */
+    t = x * CONVERT_LOG2E;                                /* power of two */
+    n = (t + CONVERT_ROUND) - CONVERT_ROUND;              /* round the power of two */
+    ni = (int32_t)n;                                      /* power as integer */
+    r = x - n * CONVERT_LN2_HI;                           /* reduce with the high part */
+    r = r - n * CONVERT_LN2_LO;                           /* reduce with the low part */
+    p = CONVERT_P0;                                       /* start the polynomial */
+    p = p * r + CONVERT_P1;                               /* horner step */
+    p = p * r + CONVERT_P2;                               /* horner step */
+    p = p * r + CONVERT_P3;                               /* horner step */
+    p = p * r + CONVERT_P4;                               /* horner step */
+    p = p * r + CONVERT_P5;                               /* horner step */
+    p = p * r * r + r + 1.0f;                             /* exp(r) */
+    scale.i = (ni + 127) << 23;                           /* build 2^n */
+    
+    return p * scale.f;                                   /* scale the result */
+}
+
+/**
+ * @brief     absolute humidity of one pair
+ * @param[in] temp temperature in degrees
+ * @param[in] rh relative humidity in %
+ * @return    absolute humidity in g/m3
+ * @note      none
+ */
+static inline float a_sgp30_convert_ah(float temp, float rh)
+{
+    float e;
+    
+    e = a_sgp30_convert_exp((CONVERT_AH_A * temp) / (CONVERT_AH_B + temp));              /* magnus exp term */
+    
+    return rh / 100.0f * CONVERT_AH_E * e / (CONVERT_AH_K + temp) * CONVERT_AH_G;        /* same order as the driver */
+}
+
+/**
+ * @brief     absolute humidity to the 8.8 register
+ * @param[in] ah absolute humidity in g/m3
+ * @return    register data
+ * @note      the truncation equals the integer and fraction split of the driver below 256 g/m3
+ */
+static inline uint16_t a_sgp30_convert_ah_reg(float ah)
+{
+    float v;
+    
+    v = ah * 256.0f;                    /* scale to 8.8 */
+    if (!(v > 0.0f))                    /* check the min and nan */
+    {
+        return 0;                       /* clamp the min */
+    }
+    if (v >= CONVERT_AH_REG_MAX)        /* check the max */
+    {
+        return 0xFFFF;                  /* clamp the max */
+    }
+    
+    return (uint16_t)v;                 /* truncate the fraction */
+}
+
+#if defined(SGP30_CONVERT_AVX2)
+/**
+ * @brief     exp approximation of 8 values
+ * @param[in] x input vector
+ * @return    exp(x)
+ * @note      none
+ */
+static inline __m256 a_sgp30_convert_exp8(__m256 x)
+{
+    __m256i ni;
+    __m256 n;
+    __m256 r;
+    __m256 p;
+    
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(CONVERT_EXP_LO)), _mm256_set1_ps(CONVERT_EXP_HI));        /* clamp the input */
+    ni = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(CONVERT_LOG2E)));                                   /* round the power of two */
+    n = _mm256_cvtepi32_ps(ni);                                                                                 /* power as float */
+    r = _mm256_sub_ps(x, _mm256_mul_ps(n, _mm256_set1_ps(CONVERT_LN2_HI)));                                     /* reduce with the high part */
+    r = _mm256_sub_ps(r, _mm256_mul_ps(n, _mm256_set1_ps(CONVERT_LN2_LO)));                                     /* reduce with the low part */
+    p = _mm256_set1_ps(CONVERT_P0);                                                                             /* start the polynomial */
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(CONVERT_P1));                                         /* horner step */
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(CONVERT_P2));                                         /* horner step */
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(CONVERT_P3));                                         /* horner step */
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(CONVERT_P4));                                         /* horner step */
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(CONVERT_P5));                                         /* horner step */
+    p = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, r), r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));           /* exp(r) */
+    ni = _mm256_slli_epi32(_mm256_add_epi32(ni, _mm256_set1_epi32(127)), 23);                                   /* build 2^n */
+    
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(ni));                                                           /* scale the result */
+}
+/**
+ * @brief     absolute humidity of 8 pairs
+ * @param[in] t temperature vector in degrees
+ * @param[in] h relative humidity vector in %
+ * @return    absolute humidity in g/m3
+ * @note      none
+ */
+static inline __m256 a_sgp30_convert_ah8(__m256 t, __m256 h)
+{
+    __m256 x;
+    __m256 a;
+    
+    x = _mm256_div_ps(_mm256_mul_ps(_mm256_set1_ps(CONVERT_AH_A), t), _mm256_add_ps(_mm256_set1_ps(CONVERT_AH_B), t));        /* magnus argument */
+    a = _mm256_mul_ps(_mm256_div_ps(h, _mm256_set1_ps(100.0f)), _mm256_set1_ps(CONVERT_AH_E));                                /* vapour pressure scale */
+    a = _mm256_div_ps(_mm256_mul_ps(a, a_sgp30_convert_exp8(x)), _mm256_add_ps(_mm256_set1_ps(CONVERT_AH_K), t));             /* over the kelvin temperature */
+    
+    return _mm256_mul_ps(a, _mm256_set1_ps(CONVERT_AH_G));                                                                    /* same order as the driver */
+}
+
+/**
+ * @brief      absolute humidity of 8 pairs to the 8.8 register
+ * @param[out] *reg pointer to a register buffer
+ * @param[in]  a absolute humidity vector in g/m3
+ * @note       max takes the 0 for a nan
+ */
+static inline void a_sgp30_convert_ah_reg8(uint16_t *reg, __m256 a)
+{
+    __m256 v;
+    __m256i n;
+    
+    v = _mm256_max_ps(_mm256_mul_ps(a, _mm256_set1_ps(256.0f)), _mm256_setzero_ps());        /* clamp the min */
+    v = _mm256_min_ps(v, _mm256_set1_ps(CONVERT_AH_REG_MAX));                                /* clamp the max */
+    n = _mm256_cvttps_epi32(v);                                                              /* truncate the fraction */
+    n = _mm256_permute4x64_epi64(_mm256_packus_epi32(n, n), 0x08);                           /* narrow to 16 bits */
+    _mm_storeu_si128((__m128i *)reg, _mm256_castsi256_si128(n));                             /* store the registers */
+}
+#elif defined(SGP30_CONVERT_NEON)
+/**
+ * @brief     exp approximation of 4 values
+ * @param[in] x input vector
+ * @return    exp(x)
+ * @note      armv7 has no rounding convert, so the truncation of t + 0.5 is corrected to a floor
+ */
+static inline float32x4_t a_sgp30_convert_exp4(float32x4_t x)
+{
+    float32x4_t t;
+    float32x4_t n;
+    float32x4_t r;
+    float32x4_t p;
+    int32x4_t ni;
+    
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(CONVERT_EXP_LO)), vdupq_n_f32(CONVERT_EXP_HI));        /* clamp the input */
+    t = vaddq_f32(vmulq_n_f32(x, CONVERT_LOG2E), vdupq_n_f32(0.5f));                              /* shift for the rounding */
+    ni = vcvtq_s32_f32(t);                                                                        /* truncate toward zero */
+    n = vcvtq_f32_s32(ni);                                                                        /* power as float */
+    ni = vaddq_s32(ni, vreinterpretq_s32_u32(vcgtq_f32(n, t)));                                   /* correct to the floor */
+    n = vcvtq_f32_s32(ni);                                                                        /* power as float */
+    r = vsubq_f32(x, vmulq_n_f32(n, CONVERT_LN2_HI));                                             /* reduce with the high part */
+    r = vsubq_f32(r, vmulq_n_f32(n, CONVERT_LN2_LO));                                             /* reduce with the low part */
+    p = vdupq_n_f32(CONVERT_P0);                                                                  /* start the polynomial */
+    p = vaddq_f32(vmulq_f32(p, r), vdupq_n_f32(CONVERT_P1));                                      /* horner step */
+    p = vaddq_f32(vmulq_f32(p, r), vdupq_n_f32(CONVERT_P2));                                      /* horner step */
+    p = vaddq_f32(vmulq_f32(p, r), vdupq_n_f32(CONVERT_P3));                                      /* horner step */
+    p = vaddq_f32(vmulq_f32(p, r), vdupq_n_f32(CONVERT_P4));                                      /* horner step */
+    p = vaddq_f32(vmulq_f32(p, r), vdupq_n_f32(CONVERT_P5));                                      /* horner step */
+    p = vaddq_f32(vmulq_f32(vmulq_f32(p, r), r), vaddq_f32(r, vdupq_n_f32(1.0f)));                /* exp(r) */
+    ni = vshlq_n_s32(vaddq_s32(ni, vdupq_n_s32(127)), 23);                                        /* build 2^n */
+    
+    return vmulq_f32(p, vreinterpretq_f32_s32(ni));                                               /* scale the result */
+}
+/**
+ * @brief     divide 4 values
+ * @param[in] a dividend vector
+ * @param[in] b divisor vector
+ * @return    a / b
+ * @note      armv7 has no vector divide and a reciprocal estimate with newton steps is off by
+ *            several ulp, so the lanes are divided one by one to stay rounded like the driver
+ */
+static inline float32x4_t a_sgp30_convert_div4(float32x4_t a, float32x4_t b)
+{
+#if defined(__aarch64__)
+    return vdivq_f32(a, b);                                                       /* divide */
+#else
+    float32x4_t r;
+    
+    r = vdupq_n_f32(vgetq_lane_f32(a, 0) / vgetq_lane_f32(b, 0));                 /* divide lane 0 */
+    r = vsetq_lane_f32(vgetq_lane_f32(a, 1) / vgetq_lane_f32(b, 1), r, 1);        /* divide lane 1 */
+    r = vsetq_lane_f32(vgetq_lane_f32(a, 2) / vgetq_lane_f32(b, 2), r, 2);        /* divide lane 2 */
+    r = vsetq_lane_f32(vgetq_lane_f32(a, 3) / vgetq_lane_f32(b, 3), r, 3);        /* divide lane 3 */
+    
+    return r;                                                                     /* return the quotients */
+#endif
+}
+
+/**
+ * @brief     absolute humidity of 4 pairs
+ * @param[in] t temperature vector in degrees
+ * @param[in] h relative humidity vector in %
+ * @return    absolute humidity in g/m3
+ * @note      none
+ */
+static inline float32x4_t a_sgp30_convert_ah4(float32x4_t t, float32x4_t h)
+{
+    float32x4_t x;
+    float32x4_t a;
+    
+    x = a_sgp30_convert_div4(vmulq_n_f32(t, CONVERT_AH_A), vaddq_f32(vdupq_n_f32(CONVERT_AH_B), t));                 /* magnus argument */
+    a = vmulq_n_f32(a_sgp30_convert_div4(h, vdupq_n_f32(100.0f)), CONVERT_AH_E);                                     /* vapour pressure scale */
+    a = a_sgp30_convert_div4(vmulq_f32(a, a_sgp30_convert_exp4(x)), vaddq_f32(vdupq_n_f32(CONVERT_AH_K), t));        /* over the kelvin temperature */
+    
+    return vmulq_n_f32(a, CONVERT_AH_G);                                                                             /* same order as the driver */
+}
+
+/**
+ * @brief      absolute humidity of 4 pairs to the 8.8 register
+ * @param[out] *reg pointer to a register buffer
+ * @param[in]  a absolute humidity vector in g/m3
+ * @note       the convert saturates a negative value and a nan to 0
+ */
+static inline void a_sgp30_convert_ah_reg4(uint16_t *reg, float32x4_t a)
+{
+    float32x4_t v;
+    
+    v = vminq_f32(vmulq_n_f32(a, 256.0f), vdupq_n_f32(CONVERT_AH_REG_MAX));        /* clamp the max */
+    vst1_u16(reg, vmovn_u32(vcvtq_u32_f32(v)));                                    /* truncate and store the registers */
+}
+#elif defined(SGP30_CONVERT_SSE2)
+/**
+ * @brief     exp approximation of 4 values
+ * @param[in] x input vector
+ * @return    exp(x)
+ * @note      none
+ */
+static inline __m128 a_sgp30_convert_exp4(__m128 x)
+{
+    __m128i ni;
+    __m128 n;
+    __m128 r;
+    __m128 p;
+    
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(CONVERT_EXP_LO)), _mm_set1_ps(CONVERT_EXP_HI));        /* clamp the input */
+    ni = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(CONVERT_LOG2E)));                                /* round the power of two */
+    n = _mm_cvtepi32_ps(ni);                                                                        /* power as float */
+    r = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(CONVERT_LN2_HI)));                                  /* reduce with the high part */
+    r = _mm_sub_ps(r, _mm_mul_ps(n, _mm_set1_ps(CONVERT_LN2_LO)));                                  /* reduce with the low part */
+    p = _mm_set1_ps(CONVERT_P0);                                                                    /* start the polynomial */
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(CONVERT_P1));                                      /* horner step */
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(CONVERT_P2));                                      /* horner step */
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(CONVERT_P3));                                      /* horner step */
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(CONVERT_P4));                                      /* horner step */
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(CONVERT_P5));                                      /* horner step */
+    p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, r), r), _mm_add_ps(r, _mm_set1_ps(1.0f)));              /* exp(r) */
+    ni = _mm_slli_epi32(_mm_add_epi32(ni, _mm_set1_epi32(127)), 23);                                /* build 2^n */
+    
+    return _mm_mul_ps(p, _mm_castsi128_ps(ni));                                                     /* scale the result */
+}
+
+/**
+ * @brief     absolute humidity of 4 pairs
+ * @param[in] t temperature vector in degrees
+ * @param[in] h relative humidity vector in %
+ * @return    absolute humidity in g/m3
+ * @note      none
+ */
+static inline __m128 a_sgp30_convert_ah4(__m128 t, __m128 h)
+{
+    __m128 x;
+    __m128 a;
+    
+    x = _mm_div_ps(_mm_mul_ps(_mm_set1_ps(CONVERT_AH_A), t), _mm_add_ps(_mm_set1_ps(CONVERT_AH_B), t));        /* magnus argument */
+    a = _mm_mul_ps(_mm_div_ps(h, _mm_set1_ps(100.0f)), _mm_set1_ps(CONVERT_AH_E));                             /* vapour pressure scale */
+    a = _mm_div_ps(_mm_mul_ps(a, a_sgp30_convert_exp4(x)), _mm_add_ps(_mm_set1_ps(CONVERT_AH_K), t));          /* over the kelvin temperature */
+    
+    return _mm_mul_ps(a, _mm_set1_ps(CONVERT_AH_G));                                                           /* same order as the driver */
+}
+
+/**
+ * @brief      absolute humidity of 4 pairs to the 8.8 register
+ * @param[out] *reg pointer to a register buffer
+ * @param[in]  a absolute humidity vector in g/m3
+ * @note       sse2 has no unsigned pack, so the values are biased into the signed range and back
+ */
+static inline void a_sgp30_convert_ah_reg4(uint16_t *reg, __m128 a)
+{
+    __m128 v;
+    __m128i n;
+    
+    v = _mm_max_ps(_mm_mul_ps(a, _mm_set1_ps(256.0f)), _mm_setzero_ps());             /* clamp the min */
+    v = _mm_min_ps(v, _mm_set1_ps(CONVERT_AH_REG_MAX));                               /* clamp the max */
+    n = _mm_sub_epi32(_mm_cvttps_epi32(v), _mm_set1_epi32(32768));                    /* truncate and bias */
+    n = _mm_xor_si128(_mm_packs_epi32(n, n), _mm_set1_epi16((int16_t)0x8000));        /* narrow and unbias */
+    _mm_storel_epi64((__m128i *)reg, n);                                              /* store the registers */
+}
+#endif
+
+/**
+ * @brief      convert a batch of raw signals to gas concentrations
+ * @param[in]  *raw pointer to a raw signal buffer
+ * @param[in]  len buffer length
+ * @param[in]  s_ref raw signal of the clean air reference
+ * @param[in]  c_ref concentration of the clean air reference in ppm
+ * @param[out] *ppm pointer to a concentration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       ppm = c_ref * exp((s_ref - raw) / 512), the exp is a range reduced polynomial
+ *             evaluated SGP30_CONVERT_SIMD lanes at a time with a relative error below
+ *             SGP30_CONVERT_EXP_ERROR, the result is clamped to the normal float range
+ */
+uint8_t sgp30_convert_raw(const uint16_t *raw, uint32_t len, uint16_t s_ref, float c_ref, float *ppm)
+{
+    uint32_t i;
+    
+    if ((raw == NULL) || (ppm == NULL))                                                                             /* check the buffer */
+    {
+        return 1;                                                                                                   /* return error */
+    }
+    
+    i = 0;                                                                                                          /* start from the first sample */
+#if defined(SGP30_CONVERT_AVX2)
+    {
+        __m256i ref = _mm256_set1_epi32((int32_t)s_ref);
+        __m256 scale = _mm256_set1_ps(CONVERT_RAW_SCALE);
+        __m256 c = _mm256_set1_ps(c_ref);
+        
+        for (; i + 8 <= len; i += 8)                                                                                /* 8 samples per step */
+        {
+            __m256i s = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(raw + i)));                         /* widen the raw signals */
+            __m256 x = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(ref, s)), scale);                          /* exp argument */
+            
+            _mm256_storeu_ps(ppm + i, _mm256_mul_ps(c, a_sgp30_convert_exp8(x)));                                   /* store the concentrations */
+        }
+    }
+#elif defined(SGP30_CONVERT_NEON)
+    {
+        int32x4_t ref = vdupq_n_s32((int32_t)s_ref);
+        
+        for (; i + 8 <= len; i += 8)                                                                                /* 8 samples per step */
+        {
+            uint16x8_t s = vld1q_u16(raw + i);                                                                      /* load the raw signals */
+            int32x4_t lo = vsubq_s32(ref, vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(s))));                       /* low half difference */
+            int32x4_t hi = vsubq_s32(ref, vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(s))));                      /* high half difference */
+            float32x4_t xl = vmulq_n_f32(vcvtq_f32_s32(lo), CONVERT_RAW_SCALE);                                     /* low half argument */
+            float32x4_t xh = vmulq_n_f32(vcvtq_f32_s32(hi), CONVERT_RAW_SCALE);                                     /* high half argument */
+            
+            vst1q_f32(ppm + i, vmulq_n_f32(a_sgp30_convert_exp4(xl), c_ref));                                       /* store the low half */
+            vst1q_f32(ppm + i + 4, vmulq_n_f32(a_sgp30_convert_exp4(xh), c_ref));                                   /* store the high half */
+        }
+    }
+#elif defined(SGP30_CONVERT_SSE2)
+    {
+        __m128i ref = _mm_set1_epi32((int32_t)s_ref);
+        __m128i zero = _mm_setzero_si128();
+        __m128 scale = _mm_set1_ps(CONVERT_RAW_SCALE);
+        __m128 c = _mm_set1_ps(c_ref);
+        
+        for (; i + 8 <= len; i += 8)                                                                                /* 8 samples per step */
+        {
+            __m128i s = _mm_loadu_si128((const __m128i *)(raw + i));                                                /* load the raw signals */
+            __m128i lo = _mm_sub_epi32(ref, _mm_unpacklo_epi16(s, zero));                                           /* low half difference */
+            __m128i hi = _mm_sub_epi32(ref, _mm_unpackhi_epi16(s, zero));                                           /* high half difference */
+            __m128 xl = _mm_mul_ps(_mm_cvtepi32_ps(lo), scale);                                                     /* low half argument */
+            __m128 xh = _mm_mul_ps(_mm_cvtepi32_ps(hi), scale);                                                     /* high half argument */
+            
+            _mm_storeu_ps(ppm + i, _mm_mul_ps(c, a_sgp30_convert_exp4(xl)));                                        /* store the low half */
+            _mm_storeu_ps(ppm + i + 4, _mm_mul_ps(c, a_sgp30_convert_exp4(xh)));                                    /* store the high half */
+        }
+    }
+#endif
+    for (; i < len; i++)                                                                                            /* convert the tail */
+    {
+        ppm[i] = c_ref * a_sgp30_convert_exp((float)((int32_t)s_ref - (int32_t)raw[i]) * CONVERT_RAW_SCALE);        /* convert one sample */
+    }
+    
+    return 0;                                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      convert a batch of raw signals to gas concentrations one sample at a time
+ * @param[in]  *raw pointer to a raw signal buffer
+ * @param[in]  len buffer length
+ * @param[in]  s_ref raw signal of the clean air reference
+ * @param[in]  c_ref concentration of the clean air reference in ppm
+ * @param[out] *ppm pointer to a concentration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       same polynomial as sgp30_convert_raw without simd, kept for targets and checks
+ *             that need the portable path
+ */
+uint8_t sgp30_convert_raw_scalar(const uint16_t *raw, uint32_t len, uint16_t s_ref, float c_ref, float *ppm)
+{
+    uint32_t i;
+    
+    if ((raw == NULL) || (ppm == NULL))                                                                             /* check the buffer */
+    {
+        return 1;                                                                                                   /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                                                                                       /* convert all samples */
+    {
+        ppm[i] = c_ref * a_sgp30_convert_exp((float)((int32_t)s_ref - (int32_t)raw[i]) * CONVERT_RAW_SCALE);        /* convert one sample */
+    }
+    
+    return 0;                                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      convert a batch of temperature and relative humidity pairs to absolute humidity
+ * @param[in]  *temp pointer to a temperature buffer in degrees
+ * @param[in]  *rh pointer to a relative humidity buffer in %
+ * @param[in]  len buffer length
+ * @param[out] *reg pointer to an 8.8 register buffer, NULL means not needed
+ * @param[out] *ah pointer to an absolute humidity buffer in g/m3, NULL means not needed
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       the formula and its operation order are those of sgp30_absolute_humidity_convert_to_register
+ *             with the exp polynomial, so ah is within SGP30_CONVERT_AH_ERROR of it, a register is
+ *             clamped to 0x0000 - 0xFFFF where the single conversion wraps, no handle is needed
+ */
+uint8_t sgp30_convert_absolute_humidity(const float *temp, const float *rh, uint32_t len, uint16_t *reg, float *ah)
+{
+    uint32_t i;
+    float a;
+    
+    if ((temp == NULL) || (rh == NULL) || ((reg == NULL) && (ah == NULL)))                         /* check the buffer */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    
+    i = 0;                                                                                         /* start from the first pair */
+#if defined(SGP30_CONVERT_AVX2)
+    for (; i + 8 <= len; i += 8)                                                                   /* 8 pairs per step */
+    {
+        __m256 v = a_sgp30_convert_ah8(_mm256_loadu_ps(temp + i), _mm256_loadu_ps(rh + i));        /* convert 8 pairs */
+        
+        if (ah != NULL)                                                                            /* check the ah buffer */
+        {
+            _mm256_storeu_ps(ah + i, v);                                                           /* store the absolute humidity */
+        }
+        if (reg != NULL)                                                                           /* check the register buffer */
+        {
+            a_sgp30_convert_ah_reg8(reg + i, v);                                                   /* store the registers */
+        }
+    }
+#elif defined(SGP30_CONVERT_NEON)
+    for (; i + 4 <= len; i += 4)                                                                   /* 4 pairs per step */
+    {
+        float32x4_t v = a_sgp30_convert_ah4(vld1q_f32(temp + i), vld1q_f32(rh + i));               /* convert 4 pairs */
+        
+        if (ah != NULL)                                                                            /* check the ah buffer */
+        {
+            vst1q_f32(ah + i, v);                                                                  /* store the absolute humidity */
+        }
+        if (reg != NULL)                                                                           /* check the register buffer */
+        {
+            a_sgp30_convert_ah_reg4(reg + i, v);                                                   /* store the registers */
+        }
+    }
+#elif defined(SGP30_CONVERT_SSE2)
+    for (; i + 4 <= len; i += 4)                                                                   /* 4 pairs per step */
+    {
+        __m128 v = a_sgp30_convert_ah4(_mm_loadu_ps(temp + i), _mm_loadu_ps(rh + i));              /* convert 4 pairs */
+        
+        if (ah != NULL)                                                                            /* check the ah buffer */
+        {
+            _mm_storeu_ps(ah + i, v);                                                              /* store the absolute humidity */
+        }
+        if (reg != NULL)                                                                           /* check the register buffer */
+        {
+            a_sgp30_convert_ah_reg4(reg + i, v);                                                   /* store the registers */
+        }
+    }
+#endif
+    for (; i < len; i++)                                                                           /* convert the tail */
+    {
+        a = a_sgp30_convert_ah(temp[i], rh[i]);                                                    /* convert one pair */
+        if (ah != NULL)                                                                            /* check the ah buffer */
+        {
+            ah[i] = a;                                                                             /* save the absolute humidity */
+        }
+        if (reg != NULL)                                                                           /* check the register buffer */
+        {
+            reg[i] = a_sgp30_convert_ah_reg(a);                                                    /* save the register */
+        }
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      convert a batch of temperature and relative humidity pairs to absolute humidity one pair at a time
+ * @param[in]  *temp pointer to a temperature buffer in degrees
+ * @param[in]  *rh pointer to a relative humidity buffer in %
+ * @param[in]  len buffer length
+ * @param[out] *reg pointer to an 8.8 register buffer, NULL means not needed
+ * @param[out] *ah pointer to an absolute humidity buffer in g/m3, NULL means not needed
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       same polynomial as sgp30_convert_absolute_humidity without simd
+ */
+uint8_t sgp30_convert_absolute_humidity_scalar(const float *temp, const float *rh, uint32_t len, uint16_t *reg, float *ah)
+{
+    uint32_t i;
+    float a;
+    
+    if ((temp == NULL) || (rh == NULL) || ((reg == NULL) && (ah == NULL)))        /* check the buffer */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                                                     /* convert all pairs */
+    {
+        a = a_sgp30_convert_ah(temp[i], rh[i]);                                   /* convert one pair */
+        if (ah != NULL)                                                           /* check the ah buffer */
+        {
+            ah[i] = a;                                                            /* save the absolute humidity */
+        }
+        if (reg != NULL)                                                          /* check the register buffer */
+        {
+            reg[i] = a_sgp30_convert_ah_reg(a);                                   /* save the register */
+        }
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
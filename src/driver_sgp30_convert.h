@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sgp30_convert.h
+ * @brief     driver sgp30 convert header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SGP30_CONVERT_H
+#define DRIVER_SGP30_CONVERT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sgp30_convert_driver sgp30 convert driver function
+ * @brief    sgp30 batch convert driver modules
+ * @ingroup  sgp30_driver
+ * @{
+ */
+
+/**
+ * @brief sgp30 convert reference concentration definition
+ */
+#define SGP30_CONVERT_H2_REF_PPM             0.5f        /**< h2 concentration of the clean air reference in ppm */
+#define SGP30_CONVERT_ETHANOL_REF_PPM        0.4f        /**< ethanol concentration of the clean air reference in ppm */
+
+/**
+ * @brief sgp30 convert simd path definition
+ * @note  define SGP30_CONVERT_NO_SIMD to force the portable scalar path
+ */
+#if !defined(SGP30_CONVERT_NO_SIMD) && defined(__AVX2__)
+    #define SGP30_CONVERT_SIMD "avx2"                    /**< 8 lanes */
+#elif !defined(SGP30_CONVERT_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define SGP30_CONVERT_SIMD "neon"                    /**< 4 lanes */
+#elif !defined(SGP30_CONVERT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+    #define SGP30_CONVERT_SIMD "sse2"                    /**< 4 lanes */
+#else
+    #define SGP30_CONVERT_SIMD "scalar"                  /**< 1 lane */
+#endif
+
+/**
+ * @brief sgp30 convert exp error definition
+ * @note  max relative error of the exp approximation against the exact exp,
+ *        measured over the full uint16 raw range with a double reference
+ */
+#define SGP30_CONVERT_EXP_ERROR              3.0e-7f
+
+/**
+ * @brief sgp30 convert absolute humidity error definition
+ * @note  max relative error of the absolute humidity against the float formula of
+ *        sgp30_absolute_humidity_convert_to_register, measured from -40 to 85 degrees and 0
+ *        to 100 %rh, a register differs by 1 lsb only where the exact value is this close to a step
+ */
+#define SGP30_CONVERT_AH_ERROR               5.0e-7f
+
+/**
+ * @brief      convert a batch of raw signals to gas concentrations
+ * @param[in]  *raw pointer to a raw signal buffer
+ * @param[in]  len buffer length
+ * @param[in]  s_ref raw signal of the clean air reference
+ * @param[in]  c_ref concentration of the clean air reference in ppm
+ * @param[out] *ppm pointer to a concentration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       ppm = c_ref * exp((s_ref - raw) / 512), the exp is a range reduced polynomial
+ *             evaluated SGP30_CONVERT_SIMD lanes at a time with a relative error below
+ *             SGP30_CONVERT_EXP_ERROR, the result is clamped to the normal float range
+ */
+uint8_t sgp30_convert_raw(const uint16_t *raw, uint32_t len, uint16_t s_ref, float c_ref, float *ppm);
+
+/**
+ * @brief      convert a batch of raw signals to gas concentrations one sample at a time
+ * @param[in]  *raw pointer to a raw signal buffer
+ * @param[in]  len buffer length
+ * @param[in]  s_ref raw signal of the clean air reference
+ * @param[in]  c_ref concentration of the clean air reference in ppm
+ * @param[out] *ppm pointer to a concentration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       same polynomial as sgp30_convert_raw without simd, kept for targets and checks
+ *             that need the portable path
+ */
+uint8_t sgp30_convert_raw_scalar(const uint16_t *raw, uint32_t len, uint16_t s_ref, float c_ref, float *ppm);
+
+/**
+ * @brief      convert a batch of temperature and relative humidity pairs to absolute humidity
+ * @param[in]  *temp pointer to a temperature buffer in degrees
+ * @param[in]  *rh pointer to a relative humidity buffer in %
+ * @param[in]  len buffer length
+ * @param[out] *reg pointer to an 8.8 register buffer, NULL means not needed
+ * @param[out] *ah pointer to an absolute humidity buffer in g/m3, NULL means not needed
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       the formula and its operation order are those of sgp30_absolute_humidity_convert_to_register
+ *             with the exp polynomial, so ah is within SGP30_CONVERT_AH_ERROR of it, a register is
+ *             clamped to 0x0000 - 0xFFFF where the single conversion wraps, no handle is needed
+ */
+uint8_t sgp30_convert_absolute_humidity(const float *temp, const float *rh, uint32_t len, uint16_t *reg, float *ah);
+
+/**
+ * @brief      convert a batch of temperature and relative humidity pairs to absolute humidity one pair at a time
+ * @param[in]  *temp pointer to a temperature buffer in degrees
+ * @param[in]  *rh pointer to a relative humidity buffer in %
+ * @param[in]  len buffer length
+ * @param[out] *reg pointer to an 8.8 register buffer, NULL means not needed
+ * @param[out] *ah pointer to an absolute humidity buffer in g/m3, NULL means not needed
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ * @note       same polynomial as sgp30_convert_absolute_humidity without simd
+ */
+uint8_t sgp30_convert_absolute_humidity_scalar(const float *temp, const float *rh, uint32_t len, uint16_t *reg, float *ah);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,487 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sgp30_coro.hpp
+ * @brief     driver sgp30 c++20 coroutine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SGP30_CORO_HPP
+#define DRIVER_SGP30_CORO_HPP
+
+#include "driver_sgp30.hpp"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+/**
+ * @defgroup sgp30_coro sgp30 c++20 coroutine function
+ * @brief    sgp30 awaitable operations on the split-phase driver
+ * @note     an Executor needs void schedule_after(std::chrono::milliseconds, std::coroutine_handle<>),
+ *           every conversion wait suspends the coroutine and is resumed by the executor,
+ *           so one thread can drive many sensors
+ * @{
+ */
+
+namespace sgp30
+{
+
+template <typename T>
+class Task;
+
+namespace detail
+{
+
+/**
+ * @brief sgp30 task promise base class definition
+ */
+class PromiseBase
+{
+    public:
+        /**
+         * @brief final awaiter class definition
+         * @note  the continuation is resumed by symmetric transfer
+         */
+        struct FinalAwaiter
+        {
+            /**
+             * @brief  always suspend at the end
+             * @return false
+             * @note   none
+             */
+            bool await_ready() const noexcept { return false; }
+            
+            /**
+             * @brief     get the coroutine to run next
+             * @param[in] h finished coroutine
+             * @return    awaiting coroutine or a noop coroutine
+             * @note      none
+             */
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+            {
+                std::coroutine_handle<> next = h.promise().m_continuation;
+                
+                return next ? next : std::noop_coroutine();
+            }
+            
+            /**
+             * @brief nothing to return
+             * @note  none
+             */
+            void await_resume() const noexcept {}
+        };
+        
+        /**
+         * @brief  start suspended, the task runs when it is awaited
+         * @return suspend always
+         * @note   none
+         */
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        
+        /**
+         * @brief  resume the awaiting coroutine at the end
+         * @return final awaiter
+         * @note   none
+         */
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        
+        /**
+         * @brief exceptions are not used by the driver
+         * @note  none
+         */
+        void unhandled_exception() const noexcept { std::terminate(); }
+        
+        std::coroutine_handle<> m_continuation;        /**< awaiting coroutine */
+};
+
+/**
+ * @brief sgp30 task promise class definition
+ */
+template <typename T>
+class Promise : public PromiseBase
+{
+    public:
+        /**
+         * @brief  create the task
+         * @return task
+         * @note   none
+         */
+        Task<T> get_return_object() noexcept;
+        
+        /**
+         * @brief     store the value
+         * @param[in] value returned value
+         * @note      none
+         */
+        void return_value(T value) noexcept { m_value.emplace(std::move(value)); }
+        
+        std::optional<T> m_value;        /**< returned value */
+};
+
+/**
+ * @brief sgp30 task promise class definition of the tasks without a value
+ */
+template <>
+class Promise<void> : public PromiseBase
+{
+    public:
+        /**
+         * @brief  create the task
+         * @return task
+         * @note   none
+         */
+        Task<void> get_return_object() noexcept;
+        
+        /**
+         * @brief nothing to store
+         * @note  none
+         */
+        void return_void() const noexcept {}
+};
+
+}
+
+/**
+ * @brief sgp30 task class definition
+ * @note  a lazy coroutine, it starts when it is awaited and resumes the awaiting coroutine when it returns
+ */
+template <typename T>
+class Task
+{
+    public:
+        using promise_type = detail::Promise<T>;
+        
+        /**
+         * @brief     construct from the coroutine
+         * @param[in] h coroutine handle
+         * @note      none
+         */
+        explicit Task(std::coroutine_handle<promise_type> h) noexcept : m_handle(h) {}
+        
+        /**
+         * @brief     move construct
+         * @param[in] other moved task
+         * @note      none
+         */
+        Task(Task &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+        
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+        
+        /**
+         * @brief     move assign
+         * @param[in] other moved task
+         * @return    reference to the task
+         * @note      none
+         */
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            
+            return *this;
+        }
+        
+        /**
+         * @brief destroy the coroutine frame
+         * @note  none
+         */
+        ~Task()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+        
+        /**
+         * @brief  check the task has not been started
+         * @return false
+         * @note   none
+         */
+        bool await_ready() const noexcept { return false; }
+        
+        /**
+         * @brief     start the task
+         * @param[in] awaiting awaiting coroutine
+         * @return    task coroutine
+         * @note      none
+         */
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            m_handle.promise().m_continuation = awaiting;
+            
+            return m_handle;
+        }
+        
+        /**
+         * @brief  get the returned value
+         * @return value
+         * @note   none
+         */
+        T await_resume() noexcept
+        {
+            if constexpr (!std::is_void_v<T>)
+            {
+                return std::move(*m_handle.promise().m_value);
+            }
+        }
+    
+    private:
+        std::coroutine_handle<promise_type> m_handle;        /**< coroutine */
+};
+
+namespace detail
+{
+
+/**
+ * @brief  create the task
+ * @return task
+ * @note   none
+ */
+template <typename T>
+inline Task<T> Promise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+/**
+ * @brief  create the task
+ * @return task
+ * @note   none
+ */
+inline Task<void> Promise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief sgp30 clock class definition for the async driver
+ * @note  the waits are suspensions so the blocking sleep is never used
+ */
+struct NoClock
+{
+    /**
+     * @brief do not sleep
+     * @note  none
+     */
+    void sleep(std::chrono::milliseconds) const noexcept {}
+};
+
+}
+
+/**
+ * @brief sgp30 sleep awaiter class definition
+ */
+template <typename Executor>
+class SleepAwaiter
+{
+    public:
+        /**
+         * @brief     construct the awaiter
+         * @param[in] &executor reference to the executor
+         * @param[in] time sleep time
+         * @note      none
+         */
+        SleepAwaiter(Executor &executor, std::chrono::milliseconds time) noexcept : m_executor(executor), m_time(time) {}
+        
+        /**
+         * @brief  check the sleep can be skipped
+         * @return true if the time is not positive
+         * @note   none
+         */
+        bool await_ready() const noexcept { return m_time.count() <= 0; }
+        
+        /**
+         * @brief     hand the coroutine to the executor
+         * @param[in] h suspended coroutine
+         * @note      none
+         */
+        void await_suspend(std::coroutine_handle<> h) { m_executor.schedule_after(m_time, h); }
+        
+        /**
+         * @brief nothing to return
+         * @note  none
+         */
+        void await_resume() const noexcept {}
+    
+    private:
+        Executor &m_executor;                 /**< executor */
+        std::chrono::milliseconds m_time;     /**< sleep time */
+};
+
+/**
+ * @brief sgp30 async driver class definition
+ * @note  every operation sends the command, suspends for the execution time on the executor and fetches the result,
+ *        one sensor must be driven by one coroutine at a time, the commands of two coroutines would interleave
+ */
+template <typename BusPolicy, typename Executor>
+class AsyncSgp30
+{
+    public:
+        /**
+         * @brief     construct the driver
+         * @param[in] &executor reference to the executor
+         * @param[in] bus bus policy
+         * @note      nothing is sent to the chip
+         */
+        explicit AsyncSgp30(Executor &executor, BusPolicy bus = BusPolicy()) noexcept
+            : m_executor(executor), m_device(bus) {}
+        
+        /**
+         * @brief  get the bus policy
+         * @return reference to the bus policy
+         * @note   none
+         */
+        BusPolicy &bus() noexcept { return m_device.bus(); }
+        
+        /**
+         * @brief  initialize the chip iaq
+         * @return task of the result
+         * @note   none
+         */
+        Task<Result<void>> iaq_init()
+        {
+            Result<std::chrono::milliseconds> sent = m_device.start_iaq_init();
+            
+            if (!sent)
+            {
+                co_return sent.error();
+            }
+            co_await SleepAwaiter<Executor>(m_executor, *sent);
+            
+            co_return Result<void>();
+        }
+        
+        /**
+         * @brief  read the iaq result
+         * @return task of the result with the co2 eq and tvoc
+         * @note   none
+         */
+        Task<Result<Iaq>> measure_iaq()
+        {
+            Result<std::chrono::milliseconds> sent = m_device.start_measure_iaq();
+            
+            if (!sent)
+            {
+                co_return sent.error();
+            }
+            co_await SleepAwaiter<Executor>(m_executor, *sent);
+            
+            co_return m_device.get_measure_iaq_result();
+        }
+        
+        /**
+         * @brief  read the raw signals
+         * @return task of the result with the h2 and ethanol raw signals
+         * @note   none
+         */
+        Task<Result<Raw>> measure_raw()
+        {
+            Result<std::chrono::milliseconds> sent = m_device.start_measure_raw();
+            
+            if (!sent)
+            {
+                co_return sent.error();
+            }
+            co_await SleepAwaiter<Executor>(m_executor, *sent);
+            
+            co_return m_device.get_measure_raw_result();
+        }
+        
+        /**
+         * @brief  get the iaq baseline
+         * @return task of the result with the co2 eq and tvoc baseline
+         * @note   none
+         */
+        Task<Result<Baseline>> get_baseline()
+        {
+            Result<std::chrono::milliseconds> sent = m_device.start_get_iaq_baseline();
+            
+            if (!sent)
+            {
+                co_return sent.error();
+            }
+            co_await SleepAwaiter<Executor>(m_executor, *sent);
+            
+            co_return m_device.get_iaq_baseline_result();
+        }
+        
+        /**
+         * @brief     set the iaq baseline
+         * @param[in] baseline co2 eq and tvoc baseline
+         * @return    task of the result
+         * @note      none
+         */
+        Task<Result<void>> set_baseline(Baseline baseline)
+        {
+            Result<std::chrono::milliseconds> sent = m_device.start_set_iaq_baseline(baseline);
+            
+            if (!sent)
+            {
+                co_return sent.error();
+            }
+            co_await SleepAwaiter<Executor>(m_executor, *sent);
+            
+            co_return Result<void>();
+        }
+        
+        /**
+         * @brief     suspend the calling coroutine
+         * @param[in] time sleep time
+         * @return    awaiter
+         * @note      for the 1 s cadence of the measurement loop
+         */
+        SleepAwaiter<Executor> sleep(std::chrono::milliseconds time) noexcept
+        {
+            return SleepAwaiter<Executor>(m_executor, time);
+        }
+    
+    private:
+        Executor &m_executor;                               /**< executor */
+        Sgp30<BusPolicy, detail::NoClock> m_device;         /**< split-phase driver */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif